@@ -0,0 +1,254 @@
+#!/usr/bin/python3
+
+'''
+  Post-processes google-benchmark JSON results ( as written with
+  `--benchmark_out=<file> --benchmark_out_format=json`, say by `make sweep` )
+
+  python3 bench/compare.py csv <results.json>
+    Prints results as CSV, one row per run, with all user counters as columns
+
+  python3 bench/compare.py compare <baseline.json> <contender.json>
+    Flags benchmarks, whose median time got slower than threshold ( default
+    5% ), where slowdown is statistically significant, as per two-sided Mann-
+    Whitney U test ( default alpha 0.05 ) over repetitions. Record both files
+    with `--benchmark_repetitions=N` | N >= 5 ; with too few repetitions ( say
+    3 vs. 3, for which even complete separation gives p = 0.1 ), significance
+    can't be reached at given alpha, so slowdown beyond threshold is enough.
+    Exits with non-zero status, when any benchmark is flagged.
+
+  python3 bench/compare.py fit <results.json>
+    Fits time = fixed + per_byte * len, for each benchmark family, over runs
+    without associated data, reporting per-call fixed cost, per-byte cost and
+    length, beyond which per-byte cost dominates, both in nanoseconds & in
+    cycles ( or TSC ticks ), when those were counted
+'''
+
+import argparse
+import csv
+import functools
+import json
+import math
+import statistics
+import sys
+from collections import defaultdict
+
+# nanoseconds per time unit, used by google-benchmark
+UNITS = {'ns': 1., 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+# fields of a run, which aren't user counters
+FIELDS = {'name', 'family_index', 'per_family_instance_index', 'run_name',
+          'run_type', 'repetitions', 'repetition_index', 'threads',
+          'iterations', 'real_time', 'cpu_time', 'time_unit',
+          'aggregate_name', 'aggregate_unit', 'error_occurred',
+          'error_message', 'label'}
+
+
+def load(path: str) -> list:
+    '''
+    Returns all non-aggregate, successful runs, recorded in JSON file
+    '''
+    with open(path) as fd:
+        runs = json.load(fd)['benchmarks']
+    return [r for r in runs
+            if r.get('run_type', 'iteration') == 'iteration' and not r.get('error_occurred')]
+
+
+def nanos(run: dict, metric: str) -> float:
+    '''
+    Returns `metric` ( real_time/ cpu_time ) of a run, in nanoseconds
+    '''
+    return run[metric] * UNITS[run.get('time_unit', 'ns')]
+
+
+def to_csv(args):
+    runs = load(args.results)
+    counters = sorted({k for r in runs for k in r if k not in FIELDS})
+    cols = ['name', 'repetition_index', 'iterations', 'real_time_ns', 'cpu_time_ns'] + counters
+
+    out = csv.writer(sys.stdout)
+    out.writerow(cols)
+    for r in runs:
+        out.writerow([r['name'], r.get('repetition_index', 0), r['iterations'],
+                      nanos(r, 'real_time'), nanos(r, 'cpu_time')] +
+                     [r.get(c, '') for c in counters])
+
+
+@functools.lru_cache(maxsize=None)
+def u_counts(n1: int, n2: int) -> tuple:
+    '''
+    Returns # -of orderings of n1 + n2 distinct observations, for which U
+    statistic of first sample takes each value in [0, n1 * n2]
+    '''
+    if n1 == 0 or n2 == 0:
+        return (1,)
+
+    # largest observation either belongs to first sample, adding n2 to U, or
+    # to second one, adding nothing
+    first, second = u_counts(n1 - 1, n2), u_counts(n1, n2 - 1)
+    counts = [0] * (n1 * n2 + 1)
+    for u, c in enumerate(first):
+        counts[u + n2] += c
+    for u, c in enumerate(second):
+        counts[u] += c
+    return tuple(counts)
+
+
+def min_p_value(n1: int, n2: int) -> float:
+    '''
+    Returns smallest two-sided p-value, Mann-Whitney U test can ever report for
+    given sample sizes i.e. when samples are completely separated
+    '''
+    return min(1., 2 / math.comb(n1 + n2, n1))
+
+
+def mann_whitney(a: list, b: list) -> float:
+    '''
+    Returns p-value of two-sided Mann-Whitney U test, using exact distribution
+    of U for small samples without ties, otherwise normal approximation with
+    tie & continuity correction, or None, when either sample is empty
+    '''
+    n1, n2 = len(a), len(b)
+    if min(n1, n2) == 0:
+        return None
+
+    if n1 + n2 <= 40 and len(set(a) | set(b)) == n1 + n2:
+        u = sum(1 for x in a for y in b if x > y)
+        counts = u_counts(n1, n2)
+        tail = sum(counts[:min(u, n1 * n2 - u) + 1])
+        return min(1., 2 * tail / math.comb(n1 + n2, n1))
+
+    pooled = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    n = n1 + n2
+
+    ranks, ties, i = [0.] * n, 0., 0
+    while i < n:
+        j = i
+        while j + 1 < n and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(rk for rk, (_, s) in zip(ranks, pooled) if s == 0)
+    u = r1 - n1 * (n1 + 1) / 2
+    mu = n1 * n2 / 2
+    sigma = math.sqrt(n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1))))
+    if sigma == 0:
+        return 1.
+
+    z = max(abs(u - mu) - .5, 0.) / sigma
+    return math.erfc(z / math.sqrt(2))
+
+
+def compare(args):
+    base, cont = defaultdict(list), defaultdict(list)
+    for r in load(args.baseline):
+        base[r['run_name'] if 'run_name' in r else r['name']].append(nanos(r, args.metric))
+    for r in load(args.contender):
+        cont[r['run_name'] if 'run_name' in r else r['name']].append(nanos(r, args.metric))
+
+    flagged = []
+    print(f"{'benchmark':<48} {'baseline':>12} {'contender':>12} {'change':>8} {'p':>7}")
+
+    for name in base:
+        if name not in cont:
+            print(f"{name:<48} {'missing in contender':>42}")
+            continue
+
+        b, c = statistics.median(base[name]), statistics.median(cont[name])
+        change = c / b - 1.
+        p = mann_whitney(base[name], cont[name])
+        if min_p_value(len(base[name]), len(cont[name])) >= args.alpha:
+            p = None  # can't ever be significant, so threshold alone decides
+
+        slower = change > args.threshold and (p is None or p < args.alpha)
+        if slower:
+            flagged.append(name)
+
+        p_ = f"{p:7.4f}" if p is not None else f"{'n/a':>7}"
+        mark = '  SLOWER' if slower else ''
+        print(f"{name:<48} {b:>10.1f}ns {c:>10.1f}ns {100 * change:>+7.1f}% {p_}{mark}")
+
+    for name in cont:
+        if name not in base:
+            print(f"{name:<48} {'missing in baseline':>42}")
+
+    if flagged:
+        print(f"\n{len(flagged)} benchmark(s) slower by > {100 * args.threshold:.1f}%")
+        sys.exit(1)
+
+
+def line(pts: list) -> tuple:
+    '''
+    Least squares fit of y = a + b * x, returning (a, b)
+    '''
+    xs, ys = [x for x, _ in pts], [y for _, y in pts]
+    mx, my = statistics.fmean(xs), statistics.fmean(ys)
+    b = sum((x - mx) * (y - my) for x, y in pts) / sum((x - mx) ** 2 for x in xs)
+    return my - b * mx, b
+
+
+def fit(args):
+    families = defaultdict(list)
+    for r in load(args.results):
+        parts = r['name'].split('/')
+        try:
+            nums = [int(x) for x in parts[1:]]
+        except ValueError:
+            continue
+
+        # first argument of IMIX benchmarks is associated data length
+        if '_imix' in parts[0]:
+            continue
+
+        # plain/ cipher text or message length, without associated data
+        if len(nums) == 1 or (len(nums) == 2 and nums[1] == 0):
+            cyc = r.get('cycles', r.get('tsc'))
+            families[parts[0]].append((nums[0], nanos(r, args.metric), cyc))
+
+    print(f"{'benchmark':<28} {'fixed (ns)':>11} {'ns/byte':>9} {'fixed (cyc)':>12} "
+          f"{'cyc/byte':>9} {'crossover (B)':>14}")
+
+    for name, pts in families.items():
+        pts = [p for p in pts if p[0] <= args.max_len]
+        if len({p[0] for p in pts}) < 2:
+            continue
+
+        fixed, slope = line([(x, y) for x, y, _ in pts])
+        cross = fixed / slope if slope > 0 else float('inf')
+
+        fixed_c, slope_c = float('nan'), float('nan')
+        if all(c is not None for _, _, c in pts):
+            fixed_c, slope_c = line([(x, c) for x, _, c in pts])
+
+        print(f"{name:<28} {fixed:>11.1f} {slope:>9.3f} {fixed_c:>12.1f} "
+              f"{slope_c:>9.2f} {cross:>14.0f}")
+
+    print("\ncrossover is length, beyond which per-byte cost exceeds per-call fixed cost")
+
+
+if __name__ == '__main__':
+    ap = argparse.ArgumentParser(description='Post-process google-benchmark JSON results')
+    ap.add_argument('--metric', default='cpu_time', choices=['cpu_time', 'real_time'])
+    sub = ap.add_subparsers(dest='cmd', required=True)
+
+    p = sub.add_parser('csv', help='print results as CSV')
+    p.add_argument('results')
+    p.set_defaults(fn=to_csv)
+
+    p = sub.add_parser('compare', help='flag significant slowdowns against baseline')
+    p.add_argument('baseline')
+    p.add_argument('contender')
+    p.add_argument('--threshold', type=float, default=.05, help='relative slowdown ( default 0.05 )')
+    p.add_argument('--alpha', type=float, default=.05, help='significance level ( default 0.05 )')
+    p.set_defaults(fn=compare)
+
+    p = sub.add_parser('fit', help='fit per-call & per-byte cost')
+    p.add_argument('results')
+    p.add_argument('--max-len', type=int, default=1 << 14, help='largest length used for fitting')
+    p.set_defaults(fn=fit)
+
+    args = ap.parse_args()
+    args.fn(args)
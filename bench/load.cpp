@@ -0,0 +1,132 @@
+#include "bench/load.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-threaded throughput scaling & tail latency benchmark, which runs an
+// Esch hash/ Schwaemm AEAD workload on 1, 2, 4 ... N threads, each with its own
+// buffers, reporting aggregate throughput, scaling efficiency ( w.r.t. single
+// thread ) & latency percentiles of each operation; see include/bench/load.hpp
+//
+// Build it with
+//
+// make bench/load.out
+//
+// Usage
+//
+// ./bench/load.out [options]
+//
+// Options
+//
+// -w <workload>   esch256 ( default ), esch384, schwaemm{256_128, 192_192,
+//                 128_128, 256_256}-{seal, open}, esch256-batch ( 16 messages
+//                 per operation, on shared thread pool ) or
+//                 schwaemm256_128-engine ( on shared crypto job engine )
+// -t <threads>    largest # -of threads ( default # -of hardware threads )
+// -l <bytes>      message/ text byte length ( default 64 )
+// -a <bytes>      associated data byte length ( default 0 )
+// -s <seconds>    duration of each run ( default 1 )
+// -r <ops/s>      open loop, issuing given # -of operations per second, spread
+//                 over all threads, instead of closed loop ( default )
+
+static int
+usage()
+{
+  std::cerr << "usage: load.out [-w <workload>] [-t <threads>] [-l <bytes>] "
+               "[-a <bytes>] [-s <seconds>] [-r <ops/s>]\n"
+            << "workloads:";
+  for (const auto& name : bench_load::NAMES) {
+    std::cerr << " " << name;
+  }
+  std::cerr << "\n";
+  return EXIT_FAILURE;
+}
+
+int
+main(int argc, char** argv)
+{
+  bench_load::config cfg;
+  size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_val = (i + 1) < argc;
+
+    if ((arg == "-w") && has_val) {
+      cfg.name = argv[++i];
+    } else if ((arg == "-t") && has_val) {
+      max_threads = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+    } else if ((arg == "-l") && has_val) {
+      cfg.len = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "-a") && has_val) {
+      cfg.d_len = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "-s") && has_val) {
+      cfg.seconds = std::strtod(argv[++i], nullptr);
+    } else if ((arg == "-r") && has_val) {
+      cfg.rate = std::strtod(argv[++i], nullptr);
+    } else {
+      return usage();
+    }
+  }
+
+  const auto& names = bench_load::NAMES;
+  if (std::find(names.begin(), names.end(), cfg.name) == names.end()) {
+    return usage();
+  }
+
+  std::vector<size_t> counts;
+  for (size_t n = 1; n < max_threads; n *= 2) {
+    counts.push_back(n);
+  }
+  counts.push_back(max_threads);
+
+  std::printf("%s, %zu -bytes", cfg.name.c_str(), cfg.len);
+  if (cfg.d_len > 0) {
+    std::printf(" + %zu -bytes associated data", cfg.d_len);
+  }
+  if (cfg.rate > 0) {
+    std::printf(", open loop at %.0f ops/s", cfg.rate);
+  }
+  std::printf("\n\n%7s %12s %10s %6s %10s %10s %10s %10s\n",
+              "threads",
+              "ops/s",
+              "MB/s",
+              "eff",
+              "p50 (us)",
+              "p99 (us)",
+              "p99.9 (us)",
+              "max (us)");
+
+  double base = 0.;
+  for (const size_t n : counts) {
+    cfg.threads = n;
+    const auto res = bench_load::run(cfg);
+    if (res.failed > 0) {
+      std::cerr << res.failed << " operations failed\n";
+      return EXIT_FAILURE;
+    }
+
+    const double ops = res.ops / res.seconds;
+    const double mbps = ops * res.bytes / (1 << 20);
+    if (n == 1) {
+      base = ops;
+    }
+
+    const auto& h = res.latency;
+    std::printf("%7zu %12.0f %10.2f %5.0f%% %10.2f %10.2f %10.2f %10.2f\n",
+                n,
+                ops,
+                mbps,
+                100. * ops / (n * base),
+                h.percentile(.5) / 1e3,
+                h.percentile(.99) / 1e3,
+                h.percentile(.999) / 1e3,
+                h.max() / 1e3);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -8,6 +8,46 @@ BENCHMARK(bench_sparkle::sparkle<6, 11>);
 BENCHMARK(bench_sparkle::sparkle<8, 8>);
 BENCHMARK(bench_sparkle::sparkle<8, 12>);
 
+// registering building blocks of Sparkle permutation, Esch hash & Schwaemm
+// AEAD, both as a dependent chain of calls ( latency ) & as independent
+// instances ( throughput ), where `op` & `cyc/op` counters report time & cycles
+// per call
+#define COMPONENT(name, fn, ...)                                               \
+  BENCHMARK(bench_sparkle::fn<bench_sparkle::LATENCY __VA_OPT__(, )            \
+                                __VA_ARGS__>)                                  \
+    ->Name(name "_latency");                                                   \
+  BENCHMARK(bench_sparkle::fn<bench_sparkle::THROUGHPUT __VA_OPT__(, )         \
+                                __VA_ARGS__>)                                  \
+    ->Name(name "_throughput")
+
+COMPONENT("alzette", alzette);
+COMPONENT("diffusion_layer_4", diffusion_layer, 4);
+COMPONENT("diffusion_layer_6", diffusion_layer, 6);
+COMPONENT("diffusion_layer_8", diffusion_layer, 8);
+COMPONENT("esch256_feistel", feistel, 384);
+COMPONENT("esch384_feistel", feistel, 512);
+COMPONENT("feistel_swap_16", feistel_swap, 16);
+COMPONENT("feistel_swap_24", feistel_swap, 24);
+COMPONENT("feistel_swap_32", feistel_swap, 32);
+COMPONENT("rho1_16", feedback, 16, bench_sparkle::rho::rho1);
+COMPONENT("rho1_24", feedback, 24, bench_sparkle::rho::rho1);
+COMPONENT("rho1_32", feedback, 32, bench_sparkle::rho::rho1);
+COMPONENT("rho2_16", feedback, 16, bench_sparkle::rho::rho2);
+COMPONENT("rho2_24", feedback, 24, bench_sparkle::rho::rho2);
+COMPONENT("rho2_32", feedback, 32, bench_sparkle::rho::rho2);
+COMPONENT("rhoprime1_16", feedback, 16, bench_sparkle::rho::rhoprime1);
+COMPONENT("rhoprime1_24", feedback, 24, bench_sparkle::rho::rhoprime1);
+COMPONENT("rhoprime1_32", feedback, 32, bench_sparkle::rho::rhoprime1);
+COMPONENT("schwaemm256_128_whiten_rate", whiten_rate, 32, 16);
+COMPONENT("schwaemm192_192_whiten_rate", whiten_rate, 24, 24);
+COMPONENT("schwaemm128_128_whiten_rate", whiten_rate, 16, 16);
+COMPONENT("schwaemm256_256_whiten_rate", whiten_rate, 32, 32);
+COMPONENT("copy_words_16", copy_words, 16);
+COMPONENT("copy_words_32", copy_words, 32);
+COMPONENT("copy_words_15", copy_words, 15);
+
+#undef COMPONENT
+
 // registering Esch{256,384} functions for benchmark
 BENCHMARK(esch256_hash)->Arg(64);
 BENCHMARK(esch256_hash)->Arg(128);
@@ -97,5 +137,218 @@ BENCHMARK(schwaemm256_256_decrypt)->Args({ 2048, 32 });
 BENCHMARK(schwaemm256_256_encrypt)->Args({ 4096, 32 });
 BENCHMARK(schwaemm256_256_decrypt)->Args({ 4096, 32 });
 
+// registering multi-threaded, segmented Schwaemm256-128 AEAD encrypt/ decrypt
+// routines for benchmark
+//
+// note, arguments are buffer length & segment length, in order
+BENCHMARK(schwaemm256_128_bulk_encrypt)
+  ->Args({ 1 << 20, 64 << 10 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_bulk_decrypt)
+  ->Args({ 1 << 20, 64 << 10 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_bulk_encrypt)
+  ->Args({ 16 << 20, 1 << 20 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_bulk_decrypt)
+  ->Args({ 16 << 20, 1 << 20 })
+  ->UseRealTime();
+
+// registering multi-threaded, segmented Schwaemm256-128 AEAD encryption on
+// NUMA aware thread pool, for comparing node-local & remote execution
+//
+// note, arguments are buffer length, segment length & whether segments are
+// executed on remote node, in order
+BENCHMARK(schwaemm256_128_numa_bulk_encrypt)
+  ->Args({ 16 << 20, 1 << 20, 0 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_numa_bulk_encrypt)
+  ->Args({ 16 << 20, 1 << 20, 1 })
+  ->UseRealTime();
+
+// registering in-place, batched Schwaemm256-128 page encrypt/ decrypt routines
+// for benchmark
+//
+// note, arguments are page length & # -of pages in batch, in order
+BENCHMARK(schwaemm256_128_page_seal_many)->Args({ 8192, 1 })->UseRealTime();
+BENCHMARK(schwaemm256_128_page_open_many)->Args({ 8192, 1 })->UseRealTime();
+BENCHMARK(schwaemm256_128_page_seal_many)->Args({ 8192, 256 })->UseRealTime();
+BENCHMARK(schwaemm256_128_page_open_many)->Args({ 8192, 256 })->UseRealTime();
+
+// registering random reads from Schwaemm256-128 encrypted container for
+// benchmark
+//
+// note, arguments are container's plain text length, chunk length & read
+// length, in order
+BENCHMARK(schwaemm256_128_container_read)->Args({ 64 << 20, 64 << 10, 4096 });
+BENCHMARK(schwaemm256_128_container_read)->Args({ 64 << 20, 4 << 10, 4096 });
+
+// registering Schwaemm256-128 AEAD & Esch256 hash, computed as two separate
+// passes and as a single fused pass, for benchmark
+//
+// note, argument is plain/ cipher text length; 64MB doesn't fit in LLC
+BENCHMARK(schwaemm256_128_encrypt_then_hash)->Arg(4096);
+BENCHMARK(schwaemm256_128_encrypt_and_hash)->Arg(4096);
+BENCHMARK(schwaemm256_128_decrypt_and_hash)->Arg(4096);
+BENCHMARK(schwaemm256_128_encrypt_then_hash)->Arg(64 << 20);
+BENCHMARK(schwaemm256_128_encrypt_and_hash)->Arg(64 << 20);
+BENCHMARK(schwaemm256_128_decrypt_and_hash)->Arg(64 << 20);
+
+// registering Schwaemm256-128 duplex session seal/ open routines for benchmark,
+// to be compared against one-shot encrypt/ decrypt of same sized messages
+//
+// note, arguments are plain/ cipher text length & associated data length
+BENCHMARK(schwaemm256_128_session_seal)->Args({ 32, 0 });
+BENCHMARK(schwaemm256_128_session_open)->Args({ 32, 0 });
+BENCHMARK(schwaemm256_128_encrypt)->Args({ 32, 0 });
+BENCHMARK(schwaemm256_128_decrypt)->Args({ 32, 0 });
+BENCHMARK(schwaemm256_128_session_seal)->Args({ 64, 32 });
+BENCHMARK(schwaemm256_128_session_open)->Args({ 64, 32 });
+
+// registering batched Schwaemm256-128 record seal/ open routines for benchmark
+//
+// note, arguments are plain text length of each record & # -of records in
+// batch, in order
+BENCHMARK(schwaemm256_128_record_seal_many)->Args({ 64, 1 });
+BENCHMARK(schwaemm256_128_record_open_many)->Args({ 64, 1 });
+BENCHMARK(schwaemm256_128_record_seal_many)->Args({ 64, 64 });
+BENCHMARK(schwaemm256_128_record_open_many)->Args({ 64, 64 });
+BENCHMARK(schwaemm256_128_record_seal_many)->Args({ 1024, 64 });
+BENCHMARK(schwaemm256_128_record_open_many)->Args({ 1024, 64 });
+
+// registering scatter-gather Schwaemm256-128 decryption for benchmark, to be
+// compared against linearizing fragments before decryption
+//
+// note, arguments are cipher text length & fragment length, in order
+BENCHMARK(schwaemm256_128_decryptv)->Args({ 64 << 10, 1460 });
+BENCHMARK(schwaemm256_128_decrypt_linearized)->Args({ 64 << 10, 1460 });
+BENCHMARK(schwaemm256_128_decryptv)->Args({ 64 << 10, 100 });
+BENCHMARK(schwaemm256_128_decrypt_linearized)->Args({ 64 << 10, 100 });
+
+// registering incremental Schwaemm256-128 encryption & checkpointing of its
+// context for benchmark
+//
+// note, arguments are plain text length & length of each piece, in order
+BENCHMARK(schwaemm256_128_context_update)->Args({ 64 << 10, 1 << 10 });
+BENCHMARK(schwaemm256_128_context_update)->Args({ 64 << 10, 61 });
+BENCHMARK(schwaemm256_128_context_checkpoint);
+
+// registering Schwaemm256-128 sealing of a batch of small messages, using
+// crypto job engine, to be compared against sealing them synchronously
+//
+// note, arguments are plain text length of each message, # -of messages in
+// batch & # -of worker threads, in order
+BENCHMARK(schwaemm256_128_engine_seal)->Args({ 64, 1024, 1 })->UseRealTime();
+BENCHMARK(schwaemm256_128_engine_seal)->Args({ 64, 1024, 2 })->UseRealTime();
+BENCHMARK(schwaemm256_128_engine_seal_sync)->Args({ 64, 1024 });
+
+// registering pipelined Schwaemm256-128 file sealing for benchmark, to compare
+// io_uring against blocking pread/ pwrite
+//
+// note, arguments are file byte length & whether io_uring is used, in order
+BENCHMARK(schwaemm256_128_pipeline_seal_file)
+  ->Args({ 64 << 20, 1 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_pipeline_seal_file)
+  ->Args({ 64 << 20, 0 })
+  ->UseRealTime();
+
+// registering streaming Schwaemm256-128 sealing of a large payload, on an
+// event loop thread, to compare worst case event loop latency, when crypto work
+// is offloaded to engine using async API, against doing it inline
+//
+// note, arguments are payload byte length, segment byte length & whether
+// crypto work is offloaded, in order
+BENCHMARK(schwaemm256_128_async_seal)
+  ->Args({ 16 << 20, 64 << 10, 1 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_async_seal)
+  ->Args({ 16 << 20, 1 << 20, 1 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_async_seal)
+  ->Args({ 16 << 20, 64 << 10, 0 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_async_seal)
+  ->Args({ 16 << 20, 1 << 20, 0 })
+  ->UseRealTime();
+
+// registering encrypted shared memory ring, using Schwaemm256-128, for
+// benchmark, where messages are sealed & opened in place, in ring slots
+//
+// note, argument is message byte length
+BENCHMARK(schwaemm256_128_shm_roundtrip)->Arg(64)->Arg(256);
+BENCHMARK(schwaemm256_128_shm_pair)->Arg(64)->UseRealTime();
+
+// registering sealing of small Schwaemm256-128 messages, from many clients, on
+// local crypto offload daemon, with & without lingering for fuller batches
+//
+// note, arguments are plain text byte length, # -of clients & linger time, in
+// microseconds, in order
+BENCHMARK(schwaemm256_128_offload_seal)
+  ->Args({ 64, 32, 0 })
+  ->UseRealTime();
+BENCHMARK(schwaemm256_128_offload_seal)
+  ->Args({ 64, 32, 50 })
+  ->UseRealTime();
+
+// registering batched Esch256 hashing & Schwaemm256-128 encryption of many
+// equal length messages, in a single call, to be compared against per-message
+// calls
+//
+// note, arguments are byte length of each message & # -of messages in batch,
+// in order
+BENCHMARK(esch256_batch_hash)->Args({ 64, 4096 })->UseRealTime();
+BENCHMARK(schwaemm256_128_batch_encrypt)->Args({ 64, 4096 })->UseRealTime();
+
+// registering Esch{256,384} hashing & Schwaemm256-128 AEAD over simple IMIX
+// i.e. 7:4:1 mix of 64, 576 & 1500 -bytes packets, to be compared against
+// fixed length messages
+//
+// note, argument is associated data byte length, of each packet
+BENCHMARK(bench_sparkle::esch_imix<esch256::DIGEST_LEN, esch256::hash>)
+  ->Name("esch256_imix");
+BENCHMARK(bench_sparkle::esch_imix<esch384::DIGEST_LEN, esch384::hash>)
+  ->Name("esch384_imix");
+BENCHMARK(bench_sparkle::schwaemm_imix<
+            SCHWAEMM_BENCH_VARIANT(schwaemm256_128),
+            false>)
+  ->Name("schwaemm256_128_imix_encrypt")
+  ->Arg(0);
+BENCHMARK(bench_sparkle::schwaemm_imix<
+            SCHWAEMM_BENCH_VARIANT(schwaemm256_128),
+            true>)
+  ->Name("schwaemm256_128_imix_decrypt")
+  ->Arg(0);
+
+// registering Esch256 hashing & Schwaemm256-128 encryption on cold buffers i.e.
+// on messages rotating through a working set much larger than last level cache,
+// backed by 4 KB or huge pages, after flushing caches & as first call in a
+// freshly forked process
+//
+// note, arguments are message byte length, working set size in MB & whether
+// huge pages are used, in order, for rotating working set, while it's only
+// message byte length for others
+#define COLD(name, op)                                                         \
+  BENCHMARK(bench_sparkle::rotating<op>)                                       \
+    ->Name(name "_rotating")                                                   \
+    ->ArgsProduct({ { 64, 4096 }, { 512 }, { 0, 1 } });                        \
+  BENCHMARK(bench_sparkle::flushed<op>)                                        \
+    ->Name(name "_flushed")                                                    \
+    ->Arg(64)                                                                  \
+    ->Arg(4096)                                                                \
+    ->UseManualTime();                                                         \
+  BENCHMARK(bench_sparkle::cold_start<op>)                                     \
+    ->Name(name "_cold_start")                                                 \
+    ->Arg(64)                                                                  \
+    ->Arg(4096)                                                                \
+    ->Iterations(64)                                                           \
+    ->UseManualTime()
+
+COLD("esch256_hash", bench_sparkle::cold_op::esch256_hash);
+COLD("schwaemm256_128_encrypt",
+     bench_sparkle::cold_op::schwaemm256_128_encrypt);
+
+#undef COLD
+
 // main function to drive execution of benchmark
 BENCHMARK_MAIN();
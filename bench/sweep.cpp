@@ -0,0 +1,179 @@
+#include "bench/bench_sparkle.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Parameter sweep of Esch{256, 384} hashing & Schwaemm AEAD, over message
+// lengths around rate boundaries ( i.e. empty, partial & full final blocks ),
+// powers of two & large inputs, crossed with associated data lengths, along
+// with simple IMIX packet mixes, for locating where per-call fixed cost stops
+// dominating
+//
+// Build it with
+//
+// make bench/sweep.out
+//
+// Usage
+//
+// ./bench/sweep.out [--sweep_max_len=<bytes>] [google-benchmark options]
+//
+// Large inputs go up to 1 GB ( default ), limited by --sweep_max_len. Use
+// --benchmark_out=<file> --benchmark_out_format=json for machine-readable
+// results & bench/compare.py for turning them into CSV, comparing them against
+// a baseline or fitting per-call & per-byte costs; `make sweep` does former.
+
+using lengths = std::vector<int64_t>;
+
+// Large input byte lengths, from 1 MB to 1 GB
+static const lengths LARGE{ 1l << 20, 4l << 20,   16l << 20,
+                            64l << 20, 256l << 20, 1l << 30 };
+
+// Sorted, unique union of given lengths
+static lengths
+merge(lengths a, const lengths& b)
+{
+  a.insert(a.end(), b.begin(), b.end());
+  std::sort(a.begin(), a.end());
+  a.erase(std::unique(a.begin(), a.end()), a.end());
+  return a;
+}
+
+// Lengths around first two multiples of rate r, so that final block is empty,
+// partial or full
+static lengths
+boundary(const int64_t r)
+{
+  return { 0, 1, r - 1, r, r + 1, 2 * r - 1, 2 * r, 2 * r + 1 };
+}
+
+// Registers Esch hashing, over message lengths, with a rate of 16 -bytes
+static void
+hash_sweep(const char* const name,
+           void (*fn)(benchmark::State&),
+           const int64_t max_len)
+{
+  const lengths lens =
+    merge(boundary(16), { 63, 64, 65, 255, 256, 1023, 1024, 4096, 16384 });
+
+  auto* b = benchmark::RegisterBenchmark(name, fn);
+  for (const auto len : lens) {
+    b->Arg(len);
+  }
+  for (const auto len : LARGE) {
+    if (len <= max_len) {
+      b->Arg(len);
+    }
+  }
+}
+
+// Registers Schwaemm encryption & decryption, with a rate of R -bytes, over
+// message length × associated data length, where latter is around first
+// multiple of rate. Large inputs are only encrypted,
+// without associated data.
+static void
+aead_sweep(const char* const enc_name,
+           void (*enc)(benchmark::State&),
+           const char* const dec_name,
+           void (*dec)(benchmark::State&),
+           const int64_t R,
+           const int64_t max_len)
+{
+  const lengths ct_lens =
+    merge(boundary(R), { 64, 255, 256, 1023, 1024, 4096, 16384 });
+  const lengths dt_lens{ 0, 1, R - 1, R, R + 1, 4 * R };
+
+  benchmark::RegisterBenchmark(enc_name, enc)
+    ->ArgsProduct({ ct_lens, dt_lens });
+  benchmark::RegisterBenchmark(dec_name, dec)
+    ->ArgsProduct({ ct_lens, dt_lens });
+
+  auto* b = benchmark::RegisterBenchmark(enc_name, enc);
+  for (const auto len : LARGE) {
+    if (len <= max_len) {
+      b->Args({ len, 0 });
+    }
+  }
+}
+
+// Registers Schwaemm sealing & opening of IMIX packets, without & with
+// associated data
+#define IMIX_SWEEP(ns)                                                         \
+  benchmark::RegisterBenchmark(                                                \
+    #ns "_imix_encrypt",                                                       \
+    bench_sparkle::schwaemm_imix<SCHWAEMM_BENCH_VARIANT(ns), false>)           \
+    ->Arg(0)                                                                   \
+    ->Arg(32);                                                                 \
+  benchmark::RegisterBenchmark(                                                \
+    #ns "_imix_decrypt",                                                       \
+    bench_sparkle::schwaemm_imix<SCHWAEMM_BENCH_VARIANT(ns), true>)            \
+    ->Arg(0)                                                                   \
+    ->Arg(32)
+
+int
+main(int argc, char** argv)
+{
+  int64_t max_len = LARGE.back();
+
+  // consume own options, before handing rest over to google-benchmark
+  constexpr char opt[] = "--sweep_max_len=";
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], opt, sizeof(opt) - 1) == 0) {
+      max_len = std::strtoll(argv[i] + sizeof(opt) - 1, nullptr, 10);
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+
+  hash_sweep("esch256_hash", esch256_hash, max_len);
+  hash_sweep("esch384_hash", esch384_hash, max_len);
+
+  aead_sweep("schwaemm256_128_encrypt",
+             schwaemm256_128_encrypt,
+             "schwaemm256_128_decrypt",
+             schwaemm256_128_decrypt,
+             schwaemm256_128::R,
+             max_len);
+  aead_sweep("schwaemm192_192_encrypt",
+             schwaemm192_192_encrypt,
+             "schwaemm192_192_decrypt",
+             schwaemm192_192_decrypt,
+             schwaemm192_192::R,
+             max_len);
+  aead_sweep("schwaemm128_128_encrypt",
+             schwaemm128_128_encrypt,
+             "schwaemm128_128_decrypt",
+             schwaemm128_128_decrypt,
+             schwaemm128_128::R,
+             max_len);
+  aead_sweep("schwaemm256_256_encrypt",
+             schwaemm256_256_encrypt,
+             "schwaemm256_256_decrypt",
+             schwaemm256_256_decrypt,
+             schwaemm256_256::R,
+             max_len);
+
+  benchmark::RegisterBenchmark(
+    "esch256_imix",
+    bench_sparkle::esch_imix<esch256::DIGEST_LEN, esch256::hash>);
+  benchmark::RegisterBenchmark(
+    "esch384_imix",
+    bench_sparkle::esch_imix<esch384::DIGEST_LEN, esch384::hash>);
+
+  IMIX_SWEEP(schwaemm256_128);
+  IMIX_SWEEP(schwaemm192_192);
+  IMIX_SWEEP(schwaemm128_128);
+  IMIX_SWEEP(schwaemm256_256);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return EXIT_FAILURE;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+#include "pipeline.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Command-line tool, which seals/ opens files using SchwaemmX-Y AEAD | X, Y ∈
+// {128, 192, 256} & hashes them using Esch{256, 384}, on pipelined file I/O (
+// see pipeline.hpp )
+//
+// Build it with
+//
+// make cli/a.out
+//
+// Usage
+//
+// ./cli/a.out seal [options] -k <hex key> <plain text file> <container file>
+// ./cli/a.out open [options] -k <hex key> <container file> <plain text file>
+// ./cli/a.out hash [options] <file>
+//
+// Options
+//
+// -a <algorithm>  schwaemm256-128 ( default ), schwaemm192-192,
+//                 schwaemm128-128, schwaemm256-256, esch256 ( default, when
+//                 hashing ) or esch384
+// -c <bytes>      segment byte length ( default 1 MB ), sealing only
+// -d <count>      # -of segments in flight ( default 8 )
+// -D              read plain text files using O_DIRECT
+// -P              use blocking pread/ pwrite, instead of io_uring
+// -v              print throughput to stderr
+
+// Parses hex string into bytes, returning false if it's malformed
+static bool
+from_hex(const std::string& str, std::vector<uint8_t>& out)
+{
+  if ((str.size() & 1) != 0) {
+    return false;
+  }
+
+  out.resize(str.size() >> 1);
+  for (size_t i = 0; i < out.size(); i++) {
+    unsigned v = 0;
+    if (std::sscanf(str.c_str() + 2 * i, "%2x", &v) != 1) {
+      return false;
+    }
+    out[i] = static_cast<uint8_t>(v);
+  }
+  return true;
+}
+
+static int
+usage()
+{
+  std::cerr << "usage: a.out seal [options] -k <hex key> <in> <out>\n"
+            << "       a.out open [options] -k <hex key> <in> <out>\n"
+            << "       a.out hash [options] <in>\n"
+            << "options: -a <algorithm> -c <segment bytes> -d <depth> -D -P "
+               "-v\n";
+  return EXIT_FAILURE;
+}
+
+// Seals/ opens a file, using one of Schwaemm variants, whose parameters live
+// in namespace of that variant
+#define SCHWAEMM_FILE(ns)                                                      \
+  [&]() {                                                                      \
+    using namespace ns;                                                        \
+    if (key.size() != C) {                                                     \
+      std::cerr << "key must be " << C << " -bytes\n";                         \
+      return false;                                                            \
+    }                                                                          \
+    if (seal) {                                                                \
+      uint8_t nonce[R - stream::NONCE_SUFFIX_LEN];                             \
+      sparkle_utils::random_data(nonce, sizeof(nonce));                        \
+      return pipeline_seal_file(in, out, key.data(), nonce, opt);              \
+    }                                                                          \
+    return pipeline_open_file(in, out, key.data(), opt);                       \
+  }()
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2) {
+    return usage();
+  }
+
+  const std::string cmd = argv[1];
+  if ((cmd != "seal") && (cmd != "open") && (cmd != "hash")) {
+    return usage();
+  }
+
+  std::string alg = (cmd == "hash") ? "esch256" : "schwaemm256-128";
+  std::vector<uint8_t> key;
+  std::vector<const char*> paths;
+  pipeline::options opt;
+  bool verbose = false;
+
+  for (int i = 2; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_val = (i + 1) < argc;
+
+    if ((arg == "-a") && has_val) {
+      alg = argv[++i];
+    } else if ((arg == "-k") && has_val) {
+      if (!from_hex(argv[++i], key)) {
+        std::cerr << "malformed key\n";
+        return EXIT_FAILURE;
+      }
+    } else if ((arg == "-c") && has_val) {
+      opt.chunk_len = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "-d") && has_val) {
+      opt.depth = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-D") {
+      opt.direct = true;
+    } else if (arg == "-P") {
+      opt.uring = false;
+    } else if (arg == "-v") {
+      verbose = true;
+    } else if (arg[0] == '-') {
+      return usage();
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+
+  if (paths.size() != ((cmd == "hash") ? 1ul : 2ul)) {
+    return usage();
+  }
+
+  const char* const in = paths[0];
+  const auto t0 = std::chrono::steady_clock::now();
+  bool f = false;
+
+  if (cmd == "hash") {
+    std::vector<uint8_t> digest;
+
+    if (alg == "esch256") {
+      digest.resize(esch256::DIGEST_LEN);
+      f = esch256::hash_file(in, digest.data(), opt);
+    } else if (alg == "esch384") {
+      digest.resize(esch384::DIGEST_LEN);
+      f = esch384::hash_file(in, digest.data(), opt);
+    } else {
+      return usage();
+    }
+
+    if (f) {
+      std::cout << sparkle_utils::to_hex(digest.data(), digest.size()) << "  "
+                << in << "\n";
+    }
+  } else {
+    const char* const out = paths[1];
+    const bool seal = cmd == "seal";
+
+    if (alg == "schwaemm256-128") {
+      f = SCHWAEMM_FILE(schwaemm256_128);
+    } else if (alg == "schwaemm192-192") {
+      f = SCHWAEMM_FILE(schwaemm192_192);
+    } else if (alg == "schwaemm128-128") {
+      f = SCHWAEMM_FILE(schwaemm128_128);
+    } else if (alg == "schwaemm256-256") {
+      f = SCHWAEMM_FILE(schwaemm256_256);
+    } else {
+      return usage();
+    }
+  }
+
+  if (!f) {
+    std::cerr << cmd << " failed: " << in << "\n";
+    return EXIT_FAILURE;
+  }
+
+  if (verbose) {
+    struct stat st;
+    const auto t1 = std::chrono::steady_clock::now();
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+
+    if (::stat(in, &st) == 0) {
+      const double mb = static_cast<double>(st.st_size) / (1 << 20);
+      std::cerr << cmd << ": " << mb << " MB in " << secs << " s ( "
+                << (mb / secs) << " MB/s )\n";
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
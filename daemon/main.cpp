@@ -0,0 +1,88 @@
+#include "offload.hpp"
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Local crypto offload daemon, serving Esch hash & Schwaemm seal/ open
+// requests of all processes on the host, on batched multi-lane crypto job
+// engines ( see offload.hpp )
+//
+// Build it with
+//
+// make daemon/a.out
+//
+// Usage
+//
+// ./daemon/a.out [-s <socket path>] [-w <workers per engine>] [-v]
+//
+// Socket path defaults to SPARKLE_OFFLOAD_SOCKET environment variable or
+// $XDG_RUNTIME_DIR/sparkle-offload.sock ( /tmp/sparkle-offload-<uid>/ is used,
+// when XDG_RUNTIME_DIR isn't set ). Only processes of same user are served,
+// which use it by loading wrapper/libsparkle_offload.so ( built with `make
+// offload` ) in place of wrapper/libsparkle.so. With -v, # -of executed jobs &
+// share of them executed on SIMD lanes are printed to stderr, on exit.
+
+static offload::server* srv = nullptr;
+
+static void
+on_signal(int)
+{
+  if (srv != nullptr) {
+    srv->stop();
+  }
+}
+
+static int
+usage()
+{
+  std::cerr << "usage: a.out [-s <socket path>] [-w <workers>] [-v]\n";
+  return EXIT_FAILURE;
+}
+
+int
+main(int argc, char** argv)
+{
+  std::string path = offload::socket_path();
+  size_t workers = std::thread::hardware_concurrency();
+  bool verbose = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_val = (i + 1) < argc;
+
+    if ((arg == "-s") && has_val) {
+      path = argv[++i];
+    } else if ((arg == "-w") && has_val) {
+      workers = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-v") {
+      verbose = true;
+    } else {
+      return usage();
+    }
+  }
+
+  offload::server s{ path.c_str(), workers };
+  if (!s.ok()) {
+    std::cerr << "failed to listen on " << path << ": " << std::strerror(errno)
+              << "\n";
+    return EXIT_FAILURE;
+  }
+
+  srv = &s;
+  std::signal(SIGINT, on_signal);
+  std::signal(SIGTERM, on_signal);
+
+  s.run();
+  srv = nullptr;
+
+  if (verbose) {
+    const uint64_t n = s.executed();
+    const uint64_t l = s.laned();
+    const double share = (n > 0) ? (100. * l) / n : 0.;
+
+    std::cerr << "executed " << n << " jobs, " << share << "% on SIMD lanes\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+#include "async.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -pthread -I ./include
+// example/async.cpp
+
+using namespace schwaemm256_128;
+
+// Seals whole payload, collecting sealed segments, while running on event loop
+static async::task
+seal_all(async_sealer& s,
+         async::memory_source& src,
+         const std::vector<uint8_t>& data,
+         std::vector<async::chunk>& out)
+{
+  auto g = s.seal(src, data.data(), data.size());
+  while (async::chunk* c = co_await g.next()) {
+    out.push_back(std::move(*c));
+  }
+}
+
+// Hands out previously sealed segments, as if they're being read off a socket
+static async::generator<async::chunk>
+replay(std::vector<async::chunk> segs)
+{
+  for (auto& c : segs) {
+    co_yield c;
+  }
+}
+
+// Opens sealed segments, appending plain text, while running on event loop
+static async::task
+open_all(async_opener& o,
+         std::vector<async::chunk> segs,
+         const std::vector<uint8_t>& data,
+         std::vector<uint8_t>& out)
+{
+  auto up = replay(std::move(segs));
+  auto g = o.open(up, data.data(), data.size());
+  while (async::chunk* c = co_await g.next()) {
+    out.insert(out.end(), c->data.begin(), c->data.end());
+  }
+}
+
+int
+main()
+{
+  constexpr size_t seg_len = 4096ul;             // segment byte length
+  constexpr size_t ct_len = 16 * seg_len + 1234; // plain text byte length
+  constexpr size_t d_len = 16ul;                 // associated data byte length
+  constexpr size_t n_segs = (ct_len + seg_len - 1) / seg_len;
+
+  uint8_t key[async_sealer::KEY_LEN];
+  uint8_t nonce[async_sealer::NONCE_LEN];
+  std::vector<uint8_t> data(d_len);
+  std::vector<uint8_t> txt(ct_len);
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(data.data(), data.size());
+  sparkle_utils::random_data(txt.data(), txt.size());
+
+  crypto_engine eng{ 2 };
+  async::loop ev;
+
+  // seal payload, with crypto work offloaded to engine & completions posted
+  // back to event loop
+  std::vector<async::chunk> segs;
+  {
+    async_sealer s{ eng, key, nonce, seg_len, 4, ev.poster() };
+    async::memory_source src{ txt.data(), txt.size() };
+
+    auto t = seal_all(s, src, data, segs);
+    ev.run(t);
+    assert(!s.error());
+  }
+
+  assert(segs.size() == n_segs);
+  assert(segs.back().last);
+
+  // sealed segments are STREAM segments, so they can be opened synchronously
+  {
+    stream_decryptor d{ key, nonce, seg_len };
+    std::vector<uint8_t> dec(seg_len);
+
+    size_t off = 0;
+    for (const auto& c : segs) {
+      assert(c.index == off / seg_len);
+
+      const bool f = d.open(data.data(),
+                            data.size(),
+                            c.data.data(),
+                            dec.data(),
+                            c.data.size(),
+                            c.tag.data(),
+                            c.last);
+      assert(f);
+      assert(std::equal(dec.begin(),
+                        dec.begin() + c.data.size(),
+                        txt.begin() + off));
+      off += c.data.size();
+    }
+
+    assert(d.finished());
+    assert(off == ct_len);
+  }
+
+  // open them asynchronously
+  {
+    async_opener o{ eng, key, nonce, seg_len, 4, ev.poster() };
+    std::vector<uint8_t> dec;
+
+    auto t = open_all(o, segs, data, dec);
+    ev.run(t);
+    assert(!o.error());
+    assert(dec == txt);
+  }
+
+  // tampered segment is not released, neither is anything after it
+  {
+    auto bad = segs;
+    bad[3].tag[0] ^= 0x01;
+
+    async_opener o{ eng, key, nonce, seg_len, 4, ev.poster() };
+    std::vector<uint8_t> dec;
+
+    auto t = open_all(o, std::move(bad), data, dec);
+    ev.run(t);
+    assert(o.error());
+    assert(dec.size() == 3 * seg_len);
+  }
+
+  // truncated stream is detected
+  {
+    auto bad = segs;
+    bad.pop_back();
+
+    async_opener o{ eng, key, nonce, seg_len, 4, ev.poster() };
+    std::vector<uint8_t> dec;
+
+    auto t = open_all(o, std::move(bad), data, dec);
+    ev.run(t);
+    assert(o.error());
+  }
+
+  // empty payload is sealed as single, empty last segment
+  {
+    std::vector<async::chunk> empty;
+    async_sealer s{ eng, key, nonce, seg_len, 1, ev.poster() };
+    async::memory_source src{ txt.data(), 0 };
+
+    auto t = seal_all(s, src, data, empty);
+    ev.run(t);
+    assert(empty.size() == 1);
+    assert(empty[0].last && empty[0].data.empty());
+  }
+
+  std::cout << "Async streaming Schwaemm256-128 seal/ open works !"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
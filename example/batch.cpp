@@ -0,0 +1,111 @@
+#include "batch.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -pthread -I ./include
+// example/batch.cpp
+int
+main()
+{
+  constexpr size_t n_msgs = 1000ul; // # -of messages in batch
+  constexpr size_t lens[]{ 0, 16, 64, 100, 1024 };
+
+  using namespace schwaemm256_128;
+
+  // messages of mixed length, packed back to back, so that some of them share
+  // SIMD lanes, while others are processed alone
+  std::vector<size_t> d_len(n_msgs), t_len(n_msgs);
+  size_t d_total = 0, t_total = 0;
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    t_len[i] = lens[(i * 7) % std::size(lens)];
+    d_len[i] = (i % 3) * 8;
+
+    t_total += t_len[i];
+    d_total += d_len[i];
+  }
+
+  std::vector<uint8_t> txt(t_total), data(d_total), enc(t_total), dec(t_total);
+  std::vector<uint8_t> keys(n_msgs * C), nonces(n_msgs * R), tags(n_msgs * C);
+
+  sparkle_utils::random_data(txt.data(), txt.size());
+  sparkle_utils::random_data(data.data(), data.size());
+  sparkle_utils::random_data(keys.data(), keys.size());
+  sparkle_utils::random_data(nonces.data(), nonces.size());
+
+  std::vector<const uint8_t*> key(n_msgs), nonce(n_msgs), ad(n_msgs);
+  std::vector<const uint8_t*> in(n_msgs);
+  std::vector<uint8_t*> out(n_msgs), plain(n_msgs);
+
+  for (size_t i = 0, d_off = 0, t_off = 0; i < n_msgs; i++) {
+    key[i] = keys.data() + i * C;
+    nonce[i] = nonces.data() + i * R;
+    ad[i] = data.data() + d_off;
+    in[i] = txt.data() + t_off;
+    out[i] = enc.data() + t_off;
+    plain[i] = dec.data() + t_off;
+
+    d_off += d_len[i];
+    t_off += t_len[i];
+  }
+
+  // hash whole batch in a single call, compare against hashing one by one
+  std::vector<uint8_t> digs(n_msgs * esch256::DIGEST_LEN);
+  esch256::batch_hash(in.data(), t_len.data(), n_msgs, digs.data());
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    uint8_t dig[esch256::DIGEST_LEN];
+    esch256::hash(in[i], t_len[i], dig);
+    assert(std::memcmp(dig, digs.data() + i * sizeof(dig), sizeof(dig)) == 0);
+  }
+
+  // encrypt whole batch in a single call, compare against encrypting one by one
+  batch_encrypt(key.data(),
+                nonce.data(),
+                ad.data(),
+                d_len.data(),
+                in.data(),
+                out.data(),
+                t_len.data(),
+                tags.data(),
+                n_msgs);
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    uint8_t enc_[lens[std::size(lens) - 1]], tag_[C];
+
+    encrypt(key[i], nonce[i], ad[i], d_len[i], in[i], enc_, t_len[i], tag_);
+    assert(std::memcmp(enc_, out[i], t_len[i]) == 0);
+    assert(std::memcmp(tag_, tags.data() + i * C, C) == 0);
+  }
+
+  // tamper with one tag, only that message fails verification
+  tags[5 * C] ^= 0x01;
+
+  bool flags[n_msgs];
+  bool f = batch_decrypt(key.data(),
+                         nonce.data(),
+                         tags.data(),
+                         ad.data(),
+                         d_len.data(),
+                         out.data(),
+                         plain.data(),
+                         t_len.data(),
+                         flags,
+                         n_msgs);
+  assert(!f);
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    assert(flags[i] == (i != 5));
+    if (i != 5) {
+      assert(std::memcmp(plain[i], in[i], t_len[i]) == 0);
+    }
+  }
+
+  std::cout << "Batched Esch256 & Schwaemm256-128 of " << n_msgs
+            << " messages, works !" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+#include "bulk.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -I ./include example/bulk.cpp
+int
+main()
+{
+  constexpr size_t ct_len = 1ul << 20;   // plain/ cipher text byte length
+  constexpr size_t seg_len = 64ul << 10; // segment byte length
+  constexpr size_t d_len = 32ul;         // associated data byte length
+
+  using namespace schwaemm256_128;
+
+  const size_t n_segs = bulk::segment_count(ct_len, seg_len);
+
+  std::vector<uint8_t> key(C);
+  std::vector<uint8_t> nonce(stream_encryptor::NONCE_LEN);
+  std::vector<uint8_t> data(d_len);
+  std::vector<uint8_t> txt(ct_len);
+  std::vector<uint8_t> enc(ct_len);
+  std::vector<uint8_t> dec(ct_len);
+  std::vector<uint8_t> tags(n_segs * C);
+
+  sparkle_utils::random_data(key.data(), key.size());
+  sparkle_utils::random_data(nonce.data(), nonce.size());
+  sparkle_utils::random_data(data.data(), data.size());
+  sparkle_utils::random_data(txt.data(), txt.size());
+
+  // independently authenticated segments, encrypted on all CPU cores
+  bool f = bulk_encrypt(key.data(),
+                        nonce.data(),
+                        data.data(),
+                        d_len,
+                        txt.data(),
+                        enc.data(),
+                        ct_len,
+                        seg_len,
+                        tags.data());
+  assert(f);
+
+  // ... and verified, decrypted on all CPU cores
+  f = bulk_decrypt(key.data(),
+                   nonce.data(),
+                   tags.data(),
+                   data.data(),
+                   d_len,
+                   enc.data(),
+                   dec.data(),
+                   ct_len,
+                   seg_len);
+  assert(f);
+  assert(txt == dec);
+
+  // same segments can also be opened, one after another, as a STREAM
+  {
+    stream_decryptor opener{ key.data(), nonce.data(), seg_len };
+
+    for (size_t i = 0; i < n_segs; i++) {
+      const size_t off = i * seg_len;
+      const size_t len = std::min(seg_len, ct_len - off);
+      const bool last = i == (n_segs - 1);
+
+      f = opener.open(data.data(),
+                      d_len,
+                      enc.data() + off,
+                      dec.data() + off,
+                      len,
+                      tags.data() + i * C,
+                      last);
+      assert(f);
+    }
+
+    assert(opener.finished());
+  }
+
+  // tampering with any segment makes whole buffer fail verification
+  enc[ct_len >> 1] ^= 1;
+  f = bulk_decrypt(key.data(),
+                   nonce.data(),
+                   tags.data(),
+                   data.data(),
+                   d_len,
+                   enc.data(),
+                   dec.data(),
+                   ct_len,
+                   seg_len);
+  assert(!f);
+
+  using namespace sparkle_utils;
+  std::cout << "segments      = " << n_segs << "\n";
+  std::cout << "first tag     = " << to_hex(tags.data(), C) << "\n";
+  std::cout << "last tag      = " << to_hex(tags.data() + (n_segs - 1) * C, C)
+            << "\n";
+
+  return EXIT_SUCCESS;
+}
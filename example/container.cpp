@@ -0,0 +1,95 @@
+#include "container.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -I ./include example/container.cpp
+int
+main()
+{
+  constexpr size_t len = (4ul << 20) + 123ul; // plain text byte length
+  constexpr size_t chunk_len = 64ul << 10;    // chunk byte length
+  constexpr char path[] = "container.sparkle";
+
+  using namespace schwaemm256_128;
+
+  const size_t size = container::sealed_size<R, C>(len, chunk_len);
+
+  std::vector<uint8_t> key(C);
+  std::vector<uint8_t> nonce(container_reader::NONCE_LEN);
+  std::vector<uint8_t> txt(len);
+
+  sparkle_utils::random_data(key.data(), key.size());
+  sparkle_utils::random_data(nonce.data(), nonce.size());
+  sparkle_utils::random_data(txt.data(), txt.size());
+
+  // seal plain text into a container file, on all CPU cores
+  bool f = container_seal_file(
+    path, key.data(), nonce.data(), txt.data(), len, chunk_len);
+  assert(f);
+
+  container_reader rd{ key.data() };
+  f = rd.open(path);
+  assert(f);
+  assert(rd.size() == len);
+
+  // small random read decrypts only one ( or two ) chunks
+  {
+    constexpr size_t off = 1234567ul;
+    std::vector<uint8_t> out(4096);
+
+    f = rd.read(off, out.size(), out.data());
+    assert(f);
+    assert(std::equal(out.begin(), out.end(), txt.begin() + off));
+  }
+
+  // large range is decrypted on all CPU cores
+  {
+    constexpr size_t off = 100ul;
+    std::vector<uint8_t> out(len - off);
+
+    f = rd.read(off, out.size(), out.data());
+    assert(f);
+    assert(std::equal(out.begin(), out.end(), txt.begin() + off));
+  }
+
+  // range beyond end of plain text is rejected
+  {
+    std::vector<uint8_t> out(16);
+
+    f = rd.read(len - 8, out.size(), out.data());
+    assert(!f);
+  }
+
+  // tampering with a chunk is detected, only when that chunk is read
+  {
+    std::vector<uint8_t> blob(size);
+    f = container_seal(
+      key.data(), nonce.data(), txt.data(), len, chunk_len, blob.data());
+    assert(f);
+
+    blob[blob.size() - 1] ^= 1;
+
+    container_reader mem{ key.data() };
+    f = mem.attach(blob.data(), blob.size());
+    assert(f);
+
+    std::vector<uint8_t> out(chunk_len);
+
+    f = mem.read(0, out.size(), out.data());
+    assert(f);
+    f = mem.read(len - out.size(), out.size(), out.data());
+    assert(!f);
+  }
+
+  rd.close();
+  std::remove(path);
+
+  std::cout << "plain text    = " << len << " bytes\n";
+  std::cout << "chunk size    = " << chunk_len << " bytes\n";
+  std::cout << "container     = " << size << " bytes\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+#include "context.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I ./include example/context.cpp
+int
+main()
+{
+  constexpr size_t file_len = 1ul << 20;   // to be uploaded file byte length
+  constexpr size_t chunk_len = 64ul << 10; // upload chunk byte length
+  constexpr size_t crash_at = 5ul;         // process crashes after this chunk
+  constexpr uint64_t key_id = 0xc0ffee;    // identifies secret key in keystore
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t wrap_key[aead_encryptor::WRAP_KEY_LEN];
+  uint8_t wrap_nonce[aead_encryptor::WRAP_NONCE_LEN]{};
+  uint8_t hdr[16];
+
+  std::vector<uint8_t> file(file_len);
+  std::vector<uint8_t> sent(file_len); // cipher text, received by server
+  std::vector<uint8_t> ckpt(aead_encryptor::EXPORT_LEN); // last checkpoint
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(wrap_key, sizeof(wrap_key));
+  sparkle_utils::random_data(hdr, sizeof(hdr));
+  sparkle_utils::random_data(file.data(), file.size());
+
+  // first attempt: upload chunks, checkpointing context after each of them
+  {
+    aead_encryptor enc{ key, nonce };
+    enc.absorb(hdr, sizeof(hdr));
+
+    for (size_t i = 0; i <= crash_at; i++) {
+      const size_t off = i * chunk_len;
+      enc.update(file.data() + off, sent.data() + off, chunk_len);
+
+      // wrapping nonce must never repeat, so use checkpoint index
+      wrap_nonce[0] = static_cast<uint8_t>(i);
+      enc.export_to(wrap_key, wrap_nonce, key_id, ckpt.data());
+    }
+
+    // ... crash, context is lost
+  }
+
+  // second attempt: restore context from last checkpoint & continue
+  aead_encryptor enc;
+
+  assert(aead_encryptor::key_handle(ckpt.data()) == key_id);
+  bool f = enc.import(wrap_key, key, ckpt.data());
+  assert(f);
+
+  const size_t resume_at = enc.text_bytes();
+  assert(resume_at == (crash_at + 1) * chunk_len);
+
+  for (size_t off = resume_at; off < file_len; off += chunk_len) {
+    enc.update(file.data() + off, sent.data() + off, chunk_len);
+  }
+
+  uint8_t tag[C];
+  enc.finalize(tag);
+
+  // resumed upload is same as uninterrupted one
+  std::vector<uint8_t> expected(file_len);
+  uint8_t expected_tag[C];
+
+  encrypt(key,
+          nonce,
+          hdr,
+          sizeof(hdr),
+          file.data(),
+          expected.data(),
+          file_len,
+          expected_tag);
+
+  assert(sent == expected);
+  assert(std::equal(tag, tag + C, expected_tag));
+
+  std::cout << "checkpoint size  = " << ckpt.size() << " bytes\n";
+  std::cout << "resumed at       = " << resume_at << " bytes\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include "engine.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -pthread -I ./include
+// example/engine.cpp
+int
+main()
+{
+  constexpr size_t n_msgs = 256ul; // # -of messages, sealed as a batch
+  constexpr size_t msg_len = 64ul; // plain text byte length, of each message
+  constexpr size_t dt_len = 16ul;  // associated data byte length
+
+  using namespace schwaemm256_128;
+
+  crypto_engine eng{ 2 };
+
+  std::vector<uint8_t> keys(n_msgs * C);
+  std::vector<uint8_t> nonces(n_msgs * R);
+  std::vector<uint8_t> data(n_msgs * dt_len);
+  std::vector<uint8_t> txts(n_msgs * msg_len);
+  std::vector<uint8_t> encs(n_msgs * msg_len);
+  std::vector<uint8_t> decs(n_msgs * msg_len);
+  std::vector<uint8_t> tags(n_msgs * C);
+
+  sparkle_utils::random_data(keys.data(), keys.size());
+  sparkle_utils::random_data(nonces.data(), nonces.size());
+  sparkle_utils::random_data(data.data(), data.size());
+  sparkle_utils::random_data(txts.data(), txts.size());
+
+  // seal all messages, submitted as one batch, waiting on a future
+  std::vector<engine::job> jobs(n_msgs);
+  for (size_t i = 0; i < n_msgs; i++) {
+    jobs[i] = engine::seal_job(keys.data() + i * C,
+                               nonces.data() + i * R,
+                               data.data() + i * dt_len,
+                               dt_len,
+                               txts.data() + i * msg_len,
+                               encs.data() + i * msg_len,
+                               msg_len,
+                               tags.data() + i * C);
+  }
+
+  bool f = eng.submit(jobs.data(), n_msgs).get();
+  assert(f);
+
+  // sealed by engine is same as sealed synchronously
+  for (size_t i = 0; i < n_msgs; i += 37) {
+    uint8_t enc[msg_len];
+    uint8_t tag[C];
+
+    encrypt(keys.data() + i * C,
+            nonces.data() + i * R,
+            data.data() + i * dt_len,
+            dt_len,
+            txts.data() + i * msg_len,
+            enc,
+            msg_len,
+            tag);
+
+    assert(std::equal(enc, enc + msg_len, encs.data() + i * msg_len));
+    assert(std::equal(tag, tag + C, tags.data() + i * C));
+  }
+
+  // tamper with one tag & open each message separately, getting notified
+  // using a callback
+  tags[C * 7] ^= 1;
+
+  std::atomic<size_t> done{ 0 };
+  std::atomic<size_t> failed{ 0 };
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    const auto j = engine::open_job(keys.data() + i * C,
+                                    nonces.data() + i * R,
+                                    tags.data() + i * C,
+                                    data.data() + i * dt_len,
+                                    dt_len,
+                                    encs.data() + i * msg_len,
+                                    decs.data() + i * msg_len,
+                                    msg_len);
+
+    eng.submit(j, [&](const bool ok) {
+      failed += !ok;
+      done++;
+    });
+  }
+
+  while (done.load() < n_msgs) {
+    std::this_thread::yield();
+  }
+
+  assert(failed == 1);
+  for (size_t i = 0; i < n_msgs; i++) {
+    if (i == 7) {
+      continue;
+    }
+
+    const size_t off = i * msg_len;
+    assert(std::equal(txts.begin() + off,
+                      txts.begin() + off + msg_len,
+                      decs.begin() + off));
+  }
+
+  // hash a single message, waiting on a future
+  uint8_t digest[esch256::DIGEST_LEN];
+  uint8_t expected[esch256::DIGEST_LEN];
+
+  f = eng.submit(engine::hash_job(engine::op::esch256,
+                                  txts.data(),
+                                  txts.size(),
+                                  digest))
+        .get();
+  assert(f);
+
+  esch256::hash(txts.data(), txts.size(), expected);
+  assert(std::equal(digest, digest + sizeof(digest), expected));
+
+  std::cout << "worker threads   = " << eng.concurrency() << "\n";
+  std::cout << "sealed messages  = " << n_msgs << "\n";
+  std::cout << "failed to open   = " << failed << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include "fused.hpp"
+#include <cassert>
+#include <iostream>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -I ./include example/fused.cpp
+int
+main()
+{
+  constexpr size_t d_len = 32ul;   // associated data byte length
+  constexpr size_t ct_len = 100ul; // plain/ cipher text byte length
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+  uint8_t data[d_len];
+  uint8_t txt[ct_len];
+  uint8_t enc[ct_len];
+  uint8_t dec[ct_len];
+  uint8_t digest0[esch256::DIGEST_LEN];
+  uint8_t digest1[esch256::DIGEST_LEN];
+  uint8_t digest2[esch256::DIGEST_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(data, sizeof(data));
+  sparkle_utils::random_data(txt, sizeof(txt));
+
+  // single pass over plain text, producing cipher text, tag & Esch256 digest
+  encrypt_and_hash(key, nonce, data, d_len, txt, enc, ct_len, tag, digest0);
+
+  // single pass over cipher text, producing decrypted text & its digest
+  const bool f =
+    decrypt_and_hash(key, nonce, tag, data, d_len, enc, dec, ct_len, digest1);
+  assert(f);
+
+  // same digest as computed by standalone Esch256
+  esch256::hash(txt, ct_len, digest2);
+
+  bool cmp = false;
+  for (size_t i = 0; i < ct_len; i++) {
+    cmp |= dec[i] ^ txt[i];
+  }
+  for (size_t i = 0; i < esch256::DIGEST_LEN; i++) {
+    cmp |= (digest0[i] ^ digest1[i]) | (digest0[i] ^ digest2[i]);
+  }
+
+  assert(!cmp);
+
+  using namespace sparkle_utils;
+  std::cout << "cipher        = " << to_hex(enc, sizeof(enc)) << "\n";
+  std::cout << "tag           = " << to_hex(tag, sizeof(tag)) << "\n";
+  std::cout << "digest        = " << to_hex(digest0, sizeof(digest0)) << "\n";
+
+  return EXIT_SUCCESS;
+}
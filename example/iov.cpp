@@ -0,0 +1,66 @@
+#include "iov.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I ./include example/iov.cpp
+int
+main()
+{
+  constexpr size_t hdr_len = 13ul;    // packet header, authenticated only
+  constexpr size_t pld_len = 3000ul;  // packet payload, encrypted
+  constexpr size_t frag_len = 1460ul; // payload is received in such fragments
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+
+  std::vector<uint8_t> hdr(hdr_len);
+  std::vector<uint8_t> msg(pld_len);
+  std::vector<uint8_t> enc(pld_len);
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(hdr.data(), hdr.size());
+  sparkle_utils::random_data(msg.data(), msg.size());
+
+  // sender has contiguous buffers
+  encrypt(
+    key, nonce, hdr.data(), hdr_len, msg.data(), enc.data(), pld_len, tag);
+
+  // receiver gets payload as a chain of fragments ...
+  std::vector<struct iovec> frags;
+  for (size_t off = 0; off < pld_len; off += frag_len) {
+    const size_t len = std::min(frag_len, pld_len - off);
+    frags.push_back({ enc.data() + off, len });
+  }
+
+  // ... which are decrypted straight into two application buffers
+  std::vector<uint8_t> app0(1000);
+  std::vector<uint8_t> app1(pld_len - app0.size());
+
+  const struct iovec ad[]{ { hdr.data(), hdr_len } };
+  const struct iovec dec[]{ { app0.data(), app0.size() },
+                            { app1.data(), app1.size() } };
+
+  bool f = decryptv(key, nonce, tag, ad, 1, frags.data(), frags.size(), dec, 2);
+  assert(f);
+  assert(std::equal(app0.begin(), app0.end(), msg.begin()));
+  assert(std::equal(app1.begin(), app1.end(), msg.begin() + app0.size()));
+
+  // tampered fragment fails verification, while all output buffers are zeroed
+  enc[frag_len] ^= 1;
+  f = decryptv(key, nonce, tag, ad, 1, frags.data(), frags.size(), dec, 2);
+  assert(!f);
+  assert(std::all_of(app0.begin(), app0.end(), [](auto v) { return v == 0; }));
+  assert(std::all_of(app1.begin(), app1.end(), [](auto v) { return v == 0; }));
+
+  std::cout << "payload fragments  = " << frags.size() << "\n";
+  std::cout << "output buffers     = " << 2 << "\n";
+
+  return EXIT_SUCCESS;
+}
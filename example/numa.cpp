@@ -0,0 +1,86 @@
+#include "bulk.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -pthread -I ./include example/numa.cpp
+int
+main()
+{
+  constexpr size_t ct_len = 4ul << 20;   // plain/ cipher text byte length
+  constexpr size_t seg_len = 64ul << 10; // segment byte length, page multiple
+  constexpr size_t d_len = 32ul;         // associated data byte length
+
+  using namespace schwaemm256_128;
+
+  const size_t n_segs = bulk::segment_count(ct_len, seg_len);
+  const auto& nodes = numa::nodes();
+
+  // plain text, bound to NUMA node, calling thread is running on
+  numa::buffer txt(ct_len, numa::current_node());
+  sparkle_utils::random_data(txt.data(), ct_len);
+
+  // cipher text, whose each segment lives on same node as plain text segment
+  numa::buffer enc(ct_len, txt.data(), seg_len);
+  numa::buffer dec(ct_len, txt.data(), seg_len);
+
+  std::vector<uint8_t> key(C);
+  std::vector<uint8_t> nonce(stream_encryptor::NONCE_LEN);
+  std::vector<uint8_t> data(d_len);
+  std::vector<uint8_t> tags(n_segs * C);
+
+  sparkle_utils::random_data(key.data(), key.size());
+  sparkle_utils::random_data(nonce.data(), nonce.size());
+  sparkle_utils::random_data(data.data(), data.size());
+
+  // each segment is encrypted on a core of the node, owning its pages
+  bool f = bulk_encrypt_numa(key.data(),
+                             nonce.data(),
+                             data.data(),
+                             d_len,
+                             txt.data(),
+                             enc.data(),
+                             ct_len,
+                             seg_len,
+                             tags.data());
+  assert(f);
+
+  f = bulk_decrypt_numa(key.data(),
+                        nonce.data(),
+                        tags.data(),
+                        data.data(),
+                        d_len,
+                        enc.data(),
+                        dec.data(),
+                        ct_len,
+                        seg_len);
+  assert(f);
+  assert(std::equal(txt.data(), txt.data() + ct_len, dec.data()));
+
+  // NUMA placement doesn't change cipher text, which is same as produced on
+  // plain thread pool
+  std::vector<uint8_t> enc_(ct_len);
+  std::vector<uint8_t> tags_(n_segs * C);
+
+  f = bulk_encrypt(key.data(),
+                   nonce.data(),
+                   data.data(),
+                   d_len,
+                   txt.data(),
+                   enc_.data(),
+                   ct_len,
+                   seg_len,
+                   tags_.data());
+  assert(f);
+  assert(std::equal(enc_.begin(), enc_.end(), enc.data()));
+  assert(tags_ == tags);
+
+  std::cout << "NUMA nodes      = " << nodes.size() << "\n";
+  std::cout << "worker threads  = " << numa::default_pool().concurrency()
+            << "\n";
+  std::cout << "first segment @ node " << numa::node_of(enc.data()) << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+#include "offload.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -pthread -I ./include
+// example/offload.cpp
+int
+main()
+{
+  constexpr size_t n_clients = 32ul; // # -of clients, each on its own thread
+  constexpr size_t n_rounds = 256ul; // # -of requests, from each client
+  constexpr size_t msg_len = 64ul;   // plain text byte length
+  constexpr size_t dt_len = 16ul;    // associated data byte length
+
+  const std::string path =
+    "/tmp/sparkle-offload-example-" + std::to_string(getpid()) + ".sock";
+
+  // daemon would usually be a separate process; see daemon/main.cpp
+  offload::server srv{ path.c_str(), 2 };
+  assert(srv.ok());
+  std::thread loop([&] { srv.run(); });
+
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < n_clients; i++) {
+    clients.emplace_back([&] {
+      using namespace schwaemm256_128;
+      constexpr auto var = offload::variant::schwaemm256_128;
+
+      // generous reply timeout, so that a loaded machine doesn't make
+      // requests fall back to local crypto, failing assertions below
+      offload::client cl{ path.c_str(), offload::DEFAULT_ARENA, 60'000 };
+      assert(cl.ok());
+
+      uint8_t key[C], nonce[R], data[dt_len], txt[msg_len];
+      uint8_t enc[msg_len], dec[msg_len], tag[C];
+      uint8_t enc_[msg_len], tag_[C];
+
+      for (size_t r = 0; r < n_rounds; r++) {
+        sparkle_utils::random_data(key, sizeof(key));
+        sparkle_utils::random_data(nonce, sizeof(nonce));
+        sparkle_utils::random_data(data, sizeof(data));
+        sparkle_utils::random_data(txt, sizeof(txt));
+
+        // seal on daemon, compare against sealing locally
+        bool f0 =
+          cl.seal(var, key, nonce, data, dt_len, txt, enc, msg_len, tag);
+        assert(f0);
+
+        encrypt(key, nonce, data, dt_len, txt, enc_, msg_len, tag_);
+        assert(std::memcmp(enc, enc_, msg_len) == 0);
+        assert(std::memcmp(tag, tag_, C) == 0);
+
+        // open on daemon
+        bool flag = false;
+        bool f1 = cl.open(
+          var, key, nonce, tag, data, dt_len, enc, dec, msg_len, flag);
+        assert(f1 && flag);
+        assert(std::memcmp(txt, dec, msg_len) == 0);
+
+        // tampered tag fails verification
+        tag[0] ^= 0x01;
+        bool f2 = cl.open(
+          var, key, nonce, tag, data, dt_len, enc, dec, msg_len, flag);
+        assert(f2 && !flag);
+
+        // hash on daemon, compare against hashing locally
+        uint8_t dig[esch256::DIGEST_LEN], dig_[esch256::DIGEST_LEN];
+        bool f3 = cl.hash(engine::op::esch256, txt, msg_len, dig);
+        assert(f3);
+
+        esch256::hash(txt, msg_len, dig_);
+        assert(std::memcmp(dig, dig_, sizeof(dig)) == 0);
+      }
+
+      // request larger than arena is refused, to be served locally
+      std::vector<uint8_t> big(offload::DEFAULT_ARENA);
+      uint8_t dig[esch256::DIGEST_LEN];
+      bool f4 = cl.hash(engine::op::esch256, big.data(), big.size(), dig);
+      assert(!f4);
+    });
+  }
+
+  for (auto& c : clients) {
+    c.join();
+  }
+
+  srv.stop();
+  loop.join();
+
+  // 4 requests per round, of each client
+  assert(srv.executed() == n_clients * n_rounds * 4);
+
+  std::cout << "Offloaded " << srv.executed() << " jobs, "
+            << (100. * srv.laned()) / srv.executed() << "% on SIMD lanes"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include "page.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I ./include example/page.cpp
+int
+main()
+{
+  constexpr size_t page_len = 8192ul; // database page byte length
+  constexpr size_t n_pages = 37ul;    // # -of dirty pages, flushed together
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[page_cipher::KEY_LEN];
+  uint8_t salt[page_cipher::SALT_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(salt, sizeof(salt));
+
+  const page_cipher cipher{ key, salt, page_len };
+
+  std::vector<uint8_t> pool(n_pages * page_len);
+  std::vector<uint8_t> orig(n_pages * page_len);
+  std::vector<uint8_t*> pages(n_pages);
+  std::vector<uint64_t> page_nos(n_pages);
+  std::vector<uint64_t> lsns(n_pages);
+  bool flags[n_pages];
+
+  sparkle_utils::random_data(pool.data(), pool.size());
+
+  for (size_t i = 0; i < n_pages; i++) {
+    pages[i] = pool.data() + i * page_len;
+    page_nos[i] = 1000ul + 3ul * i;
+    lsns[i] = 0xdeadbeeful + i;
+  }
+
+  orig = pool;
+
+  // checkpoint: encrypt all dirty pages in place, across SIMD lanes & threads
+  bool f =
+    cipher.seal_many(pages.data(), page_nos.data(), lsns.data(), n_pages);
+  assert(f);
+
+  for (size_t i = 0; i < n_pages; i++) {
+    assert(cipher.lsn(pages[i]) == lsns[i]);
+  }
+
+  // a page, sealed in batch, can be opened on its own ...
+  {
+    std::vector<uint8_t> tmp(pages[5], pages[5] + page_len);
+    f = cipher.open(tmp.data(), page_nos[5]);
+    assert(f);
+    assert(std::equal(tmp.begin(),
+                      tmp.begin() + cipher.payload_size(),
+                      orig.begin() + 5 * page_len));
+  }
+
+  // ... but not when it's read back from another location
+  {
+    std::vector<uint8_t> tmp(pages[5], pages[5] + page_len);
+    f = cipher.open(tmp.data(), page_nos[6]);
+    assert(!f);
+  }
+
+  // batch read-verify of all pages, in place
+  f = cipher.open_many(pages.data(), page_nos.data(), flags, n_pages);
+  assert(f);
+
+  for (size_t i = 0; i < n_pages; i++) {
+    const size_t off = i * page_len;
+
+    assert(flags[i]);
+    assert(std::equal(pool.begin() + off,
+                      pool.begin() + off + cipher.payload_size(),
+                      orig.begin() + off));
+  }
+
+  // tampered page fails verification, without affecting others
+  cipher.seal_many(pages.data(), page_nos.data(), lsns.data(), n_pages);
+  pages[1][7] ^= 1;
+
+  f = cipher.open_many(pages.data(), page_nos.data(), flags, n_pages);
+  assert(!f);
+
+  for (size_t i = 0; i < n_pages; i++) {
+    assert(flags[i] == (i != 1));
+  }
+
+  std::cout << "pages         = " << n_pages << "\n";
+  std::cout << "page size     = " << cipher.page_size() << "\n";
+  std::cout << "payload size  = " << cipher.payload_size() << "\n";
+
+  return EXIT_SUCCESS;
+}
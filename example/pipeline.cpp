@@ -0,0 +1,158 @@
+#include "pipeline.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+// Stand-in for uring::ring, which carries out queued requests synchronously,
+// with pread/ pwrite, at submission, but completes each write only partially &
+// hands out completions in reverse order, so that pipeline has to cope with
+// short writes & writes finishing out of order
+class shuffled_ring
+{
+public:
+  explicit shuffled_ring(const unsigned) {}
+
+  bool ok() const { return true; }
+  bool register_buffers(const iovec*, const unsigned) { return false; }
+
+  bool read(const int file,
+            void* const buf,
+            const uint32_t len,
+            const uint64_t off,
+            const int,
+            const uint64_t user)
+  {
+    queued.push_back({ false, file, buf, len, off, user });
+    return true;
+  }
+
+  bool write(const int file,
+             const void* const buf,
+             const uint32_t len,
+             const uint64_t off,
+             const int,
+             const uint64_t user)
+  {
+    void* const ptr = const_cast<void*>(buf);
+    queued.push_back({ true, file, ptr, std::max(len / 2, 1u), off, user });
+    return true;
+  }
+
+  bool submit(const unsigned)
+  {
+    for (const auto& r : queued) {
+      const ssize_t n = r.wr ? ::pwrite(r.file, r.buf, r.len, r.off)
+                             : ::pread(r.file, r.buf, r.len, r.off);
+      done.push_back({ r.user, static_cast<int32_t>(n < 0 ? -errno : n) });
+    }
+    queued.clear();
+    return true;
+  }
+
+  bool reap(uring::completion& c)
+  {
+    if (done.empty()) {
+      return false;
+    }
+    c = done.back();
+    done.pop_back();
+    return true;
+  }
+
+private:
+  struct request
+  {
+    bool wr;
+    int file;
+    void* buf;
+    uint32_t len;
+    uint64_t off;
+    uint64_t user;
+  };
+
+  std::vector<request> queued;
+  std::vector<uring::completion> done;
+};
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I ./include example/pipeline.cpp
+int
+main()
+{
+  constexpr size_t len = (4ul << 20) + 123ul; // plain text byte length
+  constexpr char txt_path[] = "pipeline.bin";
+  constexpr char ctr_path[] = "pipeline.ctr";
+  constexpr char out_path[] = "pipeline.out";
+
+  using namespace schwaemm256_128;
+
+  std::vector<uint8_t> key(C);
+  std::vector<uint8_t> nonce(R - 5);
+  std::vector<uint8_t> txt(len);
+  std::vector<uint8_t> out(len);
+
+  sparkle_utils::random_data(key.data(), key.size());
+  sparkle_utils::random_data(nonce.data(), nonce.size());
+  sparkle_utils::random_data(txt.data(), txt.size());
+
+  FILE* fp = std::fopen(txt_path, "wb");
+  assert(fp != nullptr);
+  size_t n = std::fwrite(txt.data(), 1, len, fp);
+  std::fclose(fp);
+  assert(n == len);
+
+  // seal plain text file into a container & open it back, 256 KB at a time
+  pipeline::options opt;
+  opt.chunk_len = 256ul << 10;
+
+  bool f =
+    pipeline_seal_file(txt_path, ctr_path, key.data(), nonce.data(), opt);
+  assert(f);
+  f = pipeline_open_file(ctr_path, out_path, key.data(), opt);
+  assert(f);
+
+  fp = std::fopen(out_path, "rb");
+  assert(fp != nullptr);
+  n = std::fread(out.data(), 1, len, fp);
+  std::fclose(fp);
+  assert(n == len);
+  assert(out == txt);
+
+  // copy plain text file, while writes complete short & out of order
+  const int in_fd = ::open(txt_path, O_RDONLY);
+  const int out_fd = ::open(out_path, O_WRONLY | O_TRUNC);
+  assert((in_fd >= 0) && (out_fd >= 0));
+
+  pipeline::plan p;
+  p.in_fd = in_fd;
+  p.out_fd = out_fd;
+  p.total = len;
+  p.work = [](size_t, const uint8_t* src, uint8_t* dst, size_t n) {
+    std::memcpy(dst, src, n);
+    return true;
+  };
+
+  opt.depth = 3;
+  const int r = pipeline::run_uring<shuffled_ring>(p, opt);
+  assert(r == 1);
+
+  ::close(in_fd);
+  ::close(out_fd);
+
+  std::fill(out.begin(), out.end(), 0);
+  fp = std::fopen(out_path, "rb");
+  assert(fp != nullptr);
+  n = std::fread(out.data(), 1, len, fp);
+  std::fclose(fp);
+  assert(n == len);
+  assert(out == txt);
+
+  std::remove(txt_path);
+  std::remove(ctr_path);
+  std::remove(out_path);
+
+  std::cout << "Pipelined seal/ open and out of order completion : passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+#include "record.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I ./include example/record.cpp
+int
+main()
+{
+  constexpr size_t n_recs = 20ul;   // # -of records, sealed as one packet
+  constexpr size_t rec_len = 100ul; // plain text byte length, of each record
+  constexpr uint8_t type = 23;      // content type, of each record
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[record_sealer::KEY_LEN];
+  uint8_t iv[record_sealer::IV_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(iv, sizeof(iv));
+
+  record_sealer tx{ key, iv };
+  record_opener rx{ key, iv };
+
+  // single record, sealed in place, with header headroom & tag tailroom
+  std::vector<uint8_t> pkt(record::HEADER_LEN + rec_len + C);
+  std::vector<uint8_t> msg(rec_len);
+  sparkle_utils::random_data(msg.data(), msg.size());
+
+  uint8_t* const payload = pkt.data() + record::HEADER_LEN;
+  std::copy(msg.begin(), msg.end(), payload);
+
+  size_t len = tx.seal(type, payload, rec_len, pkt.data());
+  assert(len == pkt.size());
+
+  const std::vector<uint8_t> sealed = pkt;
+
+  record::view v;
+  bool f = rx.open(pkt.data(), len, v);
+  assert(f);
+  assert((v.type == type) && (v.len == rec_len));
+  assert(std::equal(msg.begin(), msg.end(), v.data));
+
+  // many small records, coalesced into one packet
+  std::vector<uint8_t> txts(n_recs * rec_len);
+  std::vector<const uint8_t*> ptrs(n_recs);
+  std::vector<size_t> lens(n_recs, rec_len);
+  std::vector<uint8_t> types(n_recs, type);
+
+  sparkle_utils::random_data(txts.data(), txts.size());
+  for (size_t i = 0; i < n_recs; i++) {
+    ptrs[i] = txts.data() + i * rec_len;
+  }
+  lens[n_recs - 1] = 7; // last record is shorter
+
+  std::vector<uint8_t> wire(n_recs * (rec_len + record_sealer::OVERHEAD));
+  len =
+    tx.seal_many(types.data(), ptrs.data(), lens.data(), n_recs, wire.data());
+
+  // receive buffer holds all records, but last one arrives only partially
+  std::vector<record::view> recs(n_recs);
+  size_t consumed = 0;
+
+  size_t n = rx.open_many(wire.data(), len - 3, recs.data(), n_recs, consumed);
+  assert(n == n_recs - 1);
+
+  for (size_t i = 0; i < n; i++) {
+    assert(recs[i].len == lens[i]);
+    assert(std::equal(ptrs[i], ptrs[i] + lens[i], recs[i].data));
+  }
+
+  // rest of the last record arrives
+  n = rx.open_many(
+    wire.data() + consumed, len - consumed, recs.data(), n_recs, consumed);
+  assert(n == 1);
+  assert(recs[0].len == 7);
+  assert(!rx.error());
+
+  // replayed record fails verification
+  pkt = sealed;
+  f = rx.open(pkt.data(), pkt.size(), v);
+  assert(!f);
+  assert(rx.error());
+
+  // tampered record, in a run opened on SIMD lanes, fails verification; it &
+  // all records decrypted along with it, on following lanes, are zeroed
+  record_sealer tx_{ key, iv };
+  record_opener rx_{ key, iv };
+
+  std::fill(lens.begin(), lens.end(), rec_len);
+  len =
+    tx_.seal_many(types.data(), ptrs.data(), lens.data(), n_recs, wire.data());
+
+  constexpr size_t stride = rec_len + record_sealer::OVERHEAD;
+  wire[stride + record::HEADER_LEN + rec_len] ^= 0x01; // tag of 2nd record
+
+  n = rx_.open_many(wire.data(), len, recs.data(), n_recs, consumed);
+  assert(n == 1);
+  assert(rx_.error());
+
+  for (size_t i = 1; i < std::min(multilane::LANES, n_recs); i++) {
+    const uint8_t* const dec = wire.data() + i * stride + record::HEADER_LEN;
+    assert(std::all_of(dec, dec + rec_len, [](uint8_t b) { return b == 0; }));
+  }
+
+  std::cout << "records sealed  = " << tx.sequence() << "\n";
+  std::cout << "records opened  = " << rx.sequence() << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include "session.hpp"
+#include <cassert>
+#include <iostream>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -I ./include example/session.cpp
+int
+main()
+{
+  constexpr size_t n_msgs = 8ul;  // # -of messages exchanged in session
+  constexpr size_t d_len = 8ul;   // associated data byte length, per message
+  constexpr size_t ct_len = 32ul; // plain/ cipher text byte length, per message
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[session_cipher::KEY_LEN];
+  uint8_t nonce[session_cipher::NONCE_LEN];
+  uint8_t data[n_msgs][d_len];
+  uint8_t txt[n_msgs][ct_len];
+  uint8_t enc[n_msgs][ct_len];
+  uint8_t dec[n_msgs][ct_len];
+  uint8_t tags[n_msgs][session_cipher::TAG_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(&data[0][0], sizeof(data));
+  sparkle_utils::random_data(&txt[0][0], sizeof(txt));
+
+  // both sides initialize their session once, from same key & nonce
+  session_cipher alice{ key, nonce };
+  session_cipher bob{ key, nonce };
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    // odd messages carry no associated data
+    const size_t dlen = (i & 1) ? 0 : d_len;
+
+    bool f = alice.seal(data[i], dlen, txt[i], enc[i], ct_len, tags[i]);
+    assert(f);
+
+    f = bob.open(data[i], dlen, enc[i], dec[i], ct_len, tags[i]);
+    assert(f);
+  }
+
+  // empty message still advances session, so it can't be dropped silently
+  {
+    uint8_t tag[session_cipher::TAG_LEN];
+
+    bool f = alice.seal(nullptr, 0, nullptr, nullptr, 0, tag);
+    assert(f);
+
+    f = bob.open(nullptr, 0, nullptr, nullptr, 0, tag);
+    assert(f);
+  }
+
+  assert(alice.messages() == bob.messages());
+
+  bool cmp = false;
+  for (size_t i = 0; i < n_msgs; i++) {
+    for (size_t j = 0; j < ct_len; j++) {
+      cmp |= dec[i][j] ^ txt[i][j];
+    }
+  }
+
+  assert(!cmp);
+
+  // replaying an earlier message is detected & fails the session
+  {
+    uint8_t tmp[ct_len];
+
+    bool f = bob.open(data[0], d_len, enc[0], tmp, ct_len, tags[0]);
+    assert(!f);
+    assert(bob.error());
+  }
+
+  using namespace sparkle_utils;
+  std::cout << "messages      = " << alice.messages() << "\n";
+  std::cout << "first tag     = " << to_hex(tags[0], sizeof(tags[0])) << "\n";
+  std::cout << "last tag      = " << to_hex(tags[n_msgs - 1], C) << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+#include "shm.hpp"
+#include <cassert>
+#include <iostream>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -march=native -pthread -I ./include
+// example/shm.cpp
+int
+main()
+{
+  constexpr uint32_t slots = 256u;      // # -of slots in ring
+  constexpr uint32_t cap = 128u;        // maximum message byte length
+  constexpr size_t n_producers = 2ul;   // # -of producer threads
+  constexpr size_t n_msgs = 1ul << 16;  // # -of messages, from each producer
+  constexpr size_t msg_len = 8ul + 40ul; // message byte length
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[shm_channel::KEY_LEN];
+  sparkle_utils::random_data(key, sizeof(key));
+
+  const size_t len = shm::region_size(slots, cap, shm_channel::TAG_LEN);
+  shm::region reg = shm::region::create(len);
+  assert(reg.ok());
+
+  const bool f = shm_channel::format(reg.data(), reg.size(), slots, cap);
+  assert(f);
+
+  // consumer runs in a child process, sharing mapping of memfd
+  const pid_t pid = fork();
+  assert(pid >= 0);
+
+  if (pid == 0) {
+    shm_channel ch{ reg.data(), reg.size(), key };
+    assert(ch.ok());
+
+    std::vector<uint64_t> next(n_producers, 0);
+    size_t seen = 0;
+
+    while (seen < n_producers * n_msgs) {
+      size_t mlen = 0;
+      const uint8_t* const msg = ch.peek(mlen);
+      if (msg == nullptr) {
+        if (ch.error()) {
+          _exit(1);
+        }
+        std::this_thread::yield();
+        continue;
+      }
+
+      // each message carries producer id & per-producer counter, which must
+      // arrive in order
+      const uint64_t word = sparkle_utils::from_le_bytes(msg);
+      const size_t id = word >> 32;
+      const uint64_t ctr = word & 0xfffffffful;
+
+      if ((mlen != msg_len) || (id >= n_producers) || (ctr != next[id])) {
+        _exit(2);
+      }
+      for (size_t i = 8; i < mlen; i++) {
+        if (msg[i] != static_cast<uint8_t>(ctr + i)) {
+          _exit(3);
+        }
+      }
+
+      next[id]++;
+      seen++;
+      ch.release();
+    }
+
+    _exit(0);
+  }
+
+  // producers write plain text straight into reserved slots, which is sealed
+  // in place
+  std::vector<std::thread> producers;
+  for (size_t id = 0; id < n_producers; id++) {
+    producers.emplace_back([&, id] {
+      shm_channel ch{ reg.data(), reg.size(), key };
+      assert(ch.ok());
+
+      for (uint64_t ctr = 0; ctr < n_msgs; ctr++) {
+        shm::ticket t;
+        while (!ch.reserve(msg_len, t)) {
+          std::this_thread::yield();
+        }
+
+        sparkle_utils::to_le_bytes((static_cast<uint64_t>(id) << 32) | ctr,
+                                   t.buf);
+        for (size_t i = 8; i < msg_len; i++) {
+          t.buf[i] = static_cast<uint8_t>(ctr + i);
+        }
+        ch.commit(t);
+      }
+    });
+  }
+
+  for (auto& p : producers) {
+    p.join();
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  assert(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+  // message tampered with, while in shared memory, is never handed out
+  {
+    shm_channel ch{ reg.data(), reg.size(), key };
+
+    uint8_t msg[32]{};
+    bool f0 = ch.push(msg, sizeof(msg));
+    assert(f0);
+
+    // flip a bit of cipher text, in the only published slot
+    const size_t pos = (n_producers * n_msgs) % slots;
+    const size_t slot_len = shm::slot_size(cap, shm_channel::TAG_LEN);
+    reg.data()[sizeof(shm::header) + pos * slot_len + shm::PAYLOAD_OFF] ^= 1;
+
+    uint8_t out[cap];
+    size_t olen = 0;
+    bool f1 = ch.pop(out, sizeof(out), olen);
+    assert(!f1);
+    assert(ch.error());
+  }
+
+  std::cout << "Encrypted shared memory ring, using Schwaemm256-128, works !"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+#include "stream.hpp"
+#include <cassert>
+#include <iostream>
+
+// Compile it with
+//
+// g++ -std=c++20 -Wall -O3 -I ./include example/stream.cpp
+int
+main()
+{
+  constexpr size_t seg_len = 64ul; // segment byte length
+  constexpr size_t ct_len = 200ul; // plain/ cipher text byte length
+  constexpr size_t d_len = 16ul;   // associated data byte length, per segment
+  constexpr size_t n_segs = (ct_len + seg_len - 1) / seg_len;
+
+  using namespace schwaemm256_128;
+
+  uint8_t key[stream_encryptor::KEY_LEN];
+  uint8_t nonce[stream_encryptor::NONCE_LEN];
+  uint8_t data[d_len];
+  uint8_t txt[ct_len];
+  uint8_t enc[ct_len];
+  uint8_t dec[ct_len];
+  uint8_t tags[n_segs][stream_encryptor::TAG_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(data, sizeof(data));
+  sparkle_utils::random_data(txt, sizeof(txt));
+
+  std::memset(enc, 0, sizeof(enc));
+  std::memset(dec, 0, sizeof(dec));
+
+  // segment-by-segment authenticated encryption with Schwaemm256-128 AEAD
+  {
+    stream_encryptor sealer{ key, nonce, seg_len };
+
+    for (size_t i = 0; i < n_segs; i++) {
+      const size_t off = i * seg_len;
+      const size_t len = std::min(seg_len, ct_len - off);
+      const bool last = i == (n_segs - 1);
+
+      const bool f =
+        sealer.seal(data, d_len, txt + off, enc + off, len, tags[i], last);
+      assert(f);
+    }
+
+    assert(sealer.finished());
+  }
+
+  // segment-by-segment verified decryption, where each segment's plain text is
+  // released as soon as its tag is verified
+  {
+    stream_decryptor opener{ key, nonce, seg_len };
+
+    for (size_t i = 0; i < n_segs; i++) {
+      const size_t off = i * seg_len;
+      const size_t len = std::min(seg_len, ct_len - off);
+      const bool last = i == (n_segs - 1);
+
+      const bool f =
+        opener.open(data, d_len, enc + off, dec + off, len, tags[i], last);
+      assert(f);
+    }
+
+    assert(opener.finished());
+  }
+
+  bool cmp = false;
+  for (size_t i = 0; i < ct_len; i++) {
+    cmp |= dec[i] ^ txt[i];
+  }
+
+  assert(!cmp);
+
+  // segments can't be reordered, without being detected
+  {
+    stream_decryptor opener{ key, nonce, seg_len };
+    uint8_t tmp[seg_len];
+
+    const bool f =
+      opener.open(data, d_len, enc + seg_len, tmp, seg_len, tags[1], false);
+    assert(!f);
+    assert(opener.error());
+  }
+
+  using namespace sparkle_utils;
+  std::cout << "key           = " << to_hex(key, sizeof(key)) << "\n";
+  std::cout << "nonce         = " << to_hex(nonce, sizeof(nonce)) << "\n";
+  std::cout << "cipher        = " << to_hex(enc, sizeof(enc)) << "\n";
+  std::cout << "decrypted     = " << to_hex(dec, sizeof(dec)) << "\n";
+
+  return EXIT_SUCCESS;
+}
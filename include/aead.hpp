@@ -441,6 +441,9 @@ process_data(
 // state, while producing equal many cipher text bytes, using algorithm 2.{13,
 // 15, 17, 19} of Sparkle specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/sparkle-spec-final.pdf
+//
+// Note, `txt` & `enc` are allowed to point to same memory, because each block
+// is read before its encrypted form is written back.
 template<const size_t RATE,
          const size_t CAPACITY,
          const uint32_t CONST_M0,
@@ -449,10 +452,10 @@ template<const size_t RATE,
          const size_t ns_slim,
          const size_t ns_big>
 static inline void
-process_text(uint32_t* const __restrict state,    // permutation state
-             const uint8_t* const __restrict txt, // N (>0) -bytes plain text
-             uint8_t* const __restrict enc, // N (>0) -bytes encrypted text
-             const size_t ct_len            // len(txt) = len(enc) = N | N > 0
+process_text(uint32_t* const __restrict state, // permutation state
+             const uint8_t* const txt,         // N (>0) -bytes plain text
+             uint8_t* const enc,               // N (>0) -bytes encrypted text
+             const size_t ct_len // len(txt) = len(enc) = N | N > 0
 )
 {
   constexpr size_t RATE_W = RATE >> 2; // # -of 32 -bit words
@@ -513,6 +516,9 @@ process_text(uint32_t* const __restrict state,    // permutation state
 // into permutation state, while producing equal many decrypted text bytes,
 // using algorithm 2.{14, 16, 18, 20} of Sparkle specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/sparkle-spec-final.pdf
+//
+// Note, `enc` & `dec` are allowed to point to same memory, because each block
+// is read before its decrypted form is written back.
 template<const size_t RATE,
          const size_t CAPACITY,
          const uint32_t CONST_M0,
@@ -522,10 +528,10 @@ template<const size_t RATE,
          const size_t ns_big>
 static inline void
 process_cipher(
-  uint32_t* const __restrict state,    // permutation state
-  const uint8_t* const __restrict enc, // N (>0) -bytes encrypted text
-  uint8_t* const __restrict dec,       // N (>0) -bytes decrypted text
-  const size_t ct_len                  // len(enc) = len(dec) = N | N > 0
+  uint32_t* const __restrict state, // permutation state
+  const uint8_t* const enc,         // N (>0) -bytes encrypted text
+  uint8_t* const dec,               // N (>0) -bytes decrypted text
+  const size_t ct_len               // len(enc) = len(dec) = N | N > 0
 )
 {
   constexpr size_t RATE_W = RATE >> 2; // # -of 32 -bit words
@@ -643,6 +649,8 @@ finalize(const uint32_t* const __restrict state, // permutation state
 // v)   BR = # -of branches in permutation state | = ((R + C) >> 2) >> 1
 // vi)  S = # -of steps in slim variant of Sparkle permutation
 // vii) B = # -of steps in big variant of Sparkle permutation
+//
+// Note, `txt` & `enc` can point to same memory, for in-place encryption.
 template<const size_t R,
          const size_t C,
          const uint32_t A0,
@@ -657,8 +665,8 @@ encrypt(const uint8_t* const __restrict key,   // C -bytes secret key
         const uint8_t* const __restrict nonce, // R -bytes nonce
         const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
         const size_t d_len,                    // len(data) = N | N >= 0
-        const uint8_t* const __restrict txt,   // N (>=0) -bytes plain text
-        uint8_t* const __restrict enc,         // N (>=0) -bytes cipher text
+        const uint8_t* const txt,              // N (>=0) -bytes plain text
+        uint8_t* const enc,                    // N (>=0) -bytes cipher text
         const size_t ct_len,                   // len(txt) = len(enc) = N | >= 0
         uint8_t* const __restrict tag          // C -bytes authentication tag
 )
@@ -687,6 +695,8 @@ encrypt(const uint8_t* const __restrict key,   // C -bytes secret key
 // v)   BR = # -of branches in permutation state | = ((R + C) >> 2) >> 1
 // vi)  S = # -of steps in slim variant of Sparkle permutation
 // vii) B = # -of steps in big variant of Sparkle permutation
+//
+// Note, `enc` & `dec` can point to same memory, for in-place decryption.
 template<const size_t R,
          const size_t C,
          const uint32_t A0,
@@ -702,8 +712,8 @@ decrypt(const uint8_t* const __restrict key,   // C -bytes secret key
         const uint8_t* const __restrict tag,   // C -bytes authentication tag
         const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
         const size_t d_len,                    // len(data) = N | N >= 0
-        const uint8_t* const __restrict enc,   // N (>=0) -bytes encrypted text
-        uint8_t* const __restrict dec,         // N (>=0) -bytes decrypted text
+        const uint8_t* const enc,              // N (>=0) -bytes encrypted text
+        uint8_t* const dec,                    // N (>=0) -bytes decrypted text
         const size_t ct_len                    // len(enc) = len(dec) = N | >= 0
 )
 {
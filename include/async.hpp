@@ -0,0 +1,704 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "engine.hpp"
+#include "stream.hpp"
+
+// C++20 coroutine based, asynchronous streaming encryption/ decryption, on top
+// of SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}
+//
+// Payload is pulled from an asynchronous source, split into segments, which
+// are sealed same way as STREAM construction does ( see stream.hpp ), so that
+// they can also be opened using stream::decryptor. Crypto work of each segment
+// is offloaded to a crypto job engine ( see engine.hpp ), while calling
+// coroutine is suspended, so that event loop thread only copies bytes around.
+// Sealed/ opened segments are handed out, in order, by an asynchronous
+// generator, which only reads ahead a bounded window of segments, so that a
+// slow consumer applies backpressure all the way to the source.
+namespace async {
+
+// Schedules resumption of a suspended coroutine, say by posting it to event
+// loop, which it belongs to. It's invoked on a worker thread of crypto engine.
+using resumer = std::function<void(std::coroutine_handle<>)>;
+
+// Resumes coroutine inline, on whichever thread completes awaited operation
+static inline void
+resume_inline(const std::coroutine_handle<> h)
+{
+  h.resume();
+}
+
+// Awaitable, which is already complete, holding result of type T
+template<typename T>
+struct ready
+{
+  T value;
+
+  bool await_ready() const noexcept { return true; }
+  void await_suspend(std::coroutine_handle<>) const noexcept {}
+  T await_resume() { return std::move(value); }
+};
+
+// Eagerly started coroutine, producing no result, whose completion can be
+// polled using `done`; frame is destroyed along with this object
+class task
+{
+public:
+  struct promise_type
+  {
+    task get_return_object()
+    {
+      return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+  task(task&& other) noexcept
+    : h(std::exchange(other.h, nullptr))
+  {
+  }
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+
+  ~task()
+  {
+    if (h) {
+      h.destroy();
+    }
+  }
+
+  // Returns truth value, if coroutine has run to completion
+  bool done() const { return !h || h.done(); }
+
+private:
+  explicit task(const std::coroutine_handle<promise_type> h)
+    : h(h)
+  {
+  }
+
+  std::coroutine_handle<promise_type> h;
+};
+
+// Lazily started, asynchronous generator of values of type T, which can
+// co_await other operations between yielding values
+//
+// Consumer awaits `next()`, which resolves to pointer to next yielded value (
+// valid until `next()` is awaited again ) or nullptr, once generator has
+// finished. Generator must not be destroyed while `next()` is being awaited.
+template<typename T>
+class generator
+{
+public:
+  struct promise_type
+  {
+    T* value = nullptr;
+    std::coroutine_handle<> consumer = nullptr;
+
+    // Transfers control back to consumer, awaiting next value
+    struct to_consumer
+    {
+      bool await_ready() const noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<promise_type> h) const noexcept
+      {
+        return h.promise().consumer;
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    generator get_return_object()
+    {
+      return generator{
+        std::coroutine_handle<promise_type>::from_promise(*this)
+      };
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    to_consumer final_suspend() noexcept { return {}; }
+
+    to_consumer yield_value(T& v) noexcept
+    {
+      value = std::addressof(v);
+      return {};
+    }
+
+    to_consumer yield_value(T&& v) noexcept
+    {
+      value = std::addressof(v);
+      return {};
+    }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+  generator(generator&& other) noexcept
+    : h(std::exchange(other.h, nullptr))
+  {
+  }
+
+  generator(const generator&) = delete;
+  generator& operator=(const generator&) = delete;
+
+  ~generator()
+  {
+    if (h) {
+      h.destroy();
+    }
+  }
+
+  // Returns awaitable, resolving to pointer to next value or nullptr
+  auto next()
+  {
+    struct awaiter
+    {
+      std::coroutine_handle<promise_type> h;
+
+      bool await_ready() const noexcept { return !h || h.done(); }
+
+      std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<> consumer) noexcept
+      {
+        h.promise().consumer = consumer;
+        h.promise().value = nullptr;
+        return h;
+      }
+
+      T* await_resume() const noexcept
+      {
+        return (!h || h.done()) ? nullptr : h.promise().value;
+      }
+    };
+
+    return awaiter{ h };
+  }
+
+private:
+  explicit generator(const std::coroutine_handle<promise_type> h)
+    : h(h)
+  {
+  }
+
+  std::coroutine_handle<promise_type> h;
+};
+
+// Minimal single threaded event loop, which resumes posted coroutines, in
+// order; useful for driving streaming APIs, when application has no event loop
+// of its own
+class loop
+{
+public:
+  // Posts a coroutine for resumption on loop thread; can be called from any
+  // thread
+  void post(const std::coroutine_handle<> h)
+  {
+    // notify under lock, so that loop can't be destroyed in between
+    std::lock_guard<std::mutex> lk{ mtx };
+    ready_q.push_back(h);
+    cv.notify_one();
+  }
+
+  // Returns a resumer, posting coroutines to this loop
+  resumer poster()
+  {
+    return [this](const std::coroutine_handle<> h) { post(h); };
+  }
+
+  // Returns awaitable, which suspends calling coroutine & posts it back to
+  // this loop, letting other posted coroutines run first
+  auto schedule()
+  {
+    struct awaiter
+    {
+      loop& l;
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(const std::coroutine_handle<> h) { l.post(h); }
+      void await_resume() const noexcept {}
+    };
+
+    return awaiter{ *this };
+  }
+
+  // Resumes posted coroutines, on calling thread, until `t` completes
+  void run(const task& t)
+  {
+    while (!t.done()) {
+      std::coroutine_handle<> h;
+      {
+        std::unique_lock<std::mutex> lk{ mtx };
+        cv.wait(lk, [this] { return !ready_q.empty(); });
+
+        h = ready_q.front();
+        ready_q.pop_front();
+      }
+      h.resume();
+    }
+  }
+
+private:
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::coroutine_handle<>> ready_q;
+};
+
+// Asynchronous source, handing out bytes of an in-memory payload, each read
+// completing immediately
+//
+// Any type, with `read(buf, len)` returning an awaitable, which resolves to #
+// -of bytes read ( zero only at end of payload ), can be used as source.
+class memory_source
+{
+public:
+  memory_source(const uint8_t* const data, const size_t len)
+    : data(data)
+    , len(len)
+  {
+  }
+
+  ready<size_t> read(uint8_t* const buf, const size_t blen)
+  {
+    const size_t n = std::min(blen, len - off);
+    std::memcpy(buf, data + off, n);
+    off += n;
+    return ready<size_t>{ n };
+  }
+
+private:
+  const uint8_t* data;
+  size_t len;
+  size_t off = 0;
+};
+
+// A segment of the stream, handed out by generators
+struct chunk
+{
+  uint64_t index = 0;        // segment index, in stream
+  std::vector<uint8_t> data; // cipher text ( or decrypted text ) of segment
+  std::vector<uint8_t> tag;  // C -bytes authentication tag of segment
+  bool last = false;         // is it last segment ?
+};
+
+// Shared state of a segment, whose crypto work is offloaded to engine. Owns
+// everything engine touches, so that it stays alive until job completes, even
+// if generator is destroyed in between.
+template<const size_t R, const size_t C>
+struct slot
+{
+  std::atomic<int> st{ 0 }; // 0 = pending, 1 = done, 2 = awaited
+  bool ok = false;
+  std::coroutine_handle<> waiter = nullptr;
+  resumer post;
+
+  uint8_t key[C];
+  uint8_t nonce[R];
+  std::shared_ptr<const std::vector<uint8_t>> ad;
+  std::vector<uint8_t> in;
+  chunk c;
+
+  ~slot() { std::memset(key, 0, C); }
+
+  // Completion callback of crypto job
+  static void complete(const std::shared_ptr<slot>& s, const bool ok)
+  {
+    s->ok = ok;
+    if (s->st.exchange(1, std::memory_order_acq_rel) == 2) {
+      s->post(s->waiter);
+    }
+  }
+
+  // Awaitable, resolving to status of crypto job; slot is kept alive by
+  // awaiting coroutine
+  struct awaiter
+  {
+    slot* s;
+
+    bool await_ready() const noexcept
+    {
+      return s->st.load(std::memory_order_acquire) == 1;
+    }
+
+    bool await_suspend(const std::coroutine_handle<> h) noexcept
+    {
+      s->waiter = h;
+      return s->st.exchange(2, std::memory_order_acq_rel) != 1;
+    }
+
+    bool await_resume() const noexcept { return s->ok; }
+  };
+};
+
+// Asynchronous, streaming sealer, which can be used with SchwaemmX-Y AEAD | X,
+// Y ∈ {128, 192, 256}; see aead::encrypt for meaning of template parameters.
+//
+// At most `window` segments are being sealed ( on engine ) at any time, while
+// next segments are only read from source, once consumer takes sealed ones.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class sealer
+{
+public:
+  using executor = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of base nonce, from which per-segment nonces are derived
+  static constexpr size_t NONCE_LEN = R - stream::NONCE_SUFFIX_LEN;
+
+  // Byte length of authentication tag, of each segment
+  static constexpr size_t TAG_LEN = C;
+
+  sealer(executor& eng,                         // crypto job engine
+         const uint8_t* const __restrict key,   // C -bytes secret key
+         const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+         const size_t seg_len,                  // segment byte length | > 0
+         const size_t window = 4,               // # -of in-flight segments
+         resumer post = resume_inline           // resumes awaiting coroutine
+         )
+    : eng(eng)
+    , seg_len(std::max<size_t>(seg_len, 1ul))
+    , window(std::max<size_t>(window, 1ul))
+    , post(std::move(post))
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->nonce, nonce, NONCE_LEN);
+  }
+
+  sealer(const sealer&) = delete;
+  sealer& operator=(const sealer&) = delete;
+
+  ~sealer() { std::memset(key, 0, KEY_LEN); }
+
+  // Returns generator of sealed segments of payload, pulled from `src`, where
+  // N (>=0) -bytes associated data is authenticated along with each segment.
+  // Generator stops early, if payload needs more segments than can be sealed
+  // under one base nonce; see `error`.
+  //
+  // Note, sealer & source must outlive returned generator.
+  template<typename Source>
+  generator<chunk> seal(Source& src,
+                        const uint8_t* const data = nullptr,
+                        const size_t d_len = 0)
+  {
+    auto ad = std::make_shared<const std::vector<uint8_t>>(data, data + d_len);
+
+    std::deque<std::shared_ptr<slot<R, C>>> q;
+    std::shared_ptr<slot<R, C>> held; // read, but not known whether last
+    uint64_t idx = 0;
+    bool eof = false;
+
+    while (true) {
+      // keep window of in-flight segments full
+      while (!eof && (q.size() < window)) {
+        auto s = std::make_shared<slot<R, C>>();
+        s->in.resize(seg_len);
+
+        size_t got = 0;
+        while (got < seg_len) {
+          const size_t n = co_await src.read(s->in.data() + got, seg_len - got);
+          if (n == 0) {
+            break;
+          }
+          got += n;
+        }
+        s->in.resize(got);
+
+        eof = got < seg_len;
+        const bool had = held != nullptr;
+
+        if (had) {
+          if (!submit(held, ad, idx++, eof && (got == 0))) {
+            failed = eof = true;
+            break;
+          }
+          q.push_back(std::move(held));
+        }
+
+        if (got == seg_len) {
+          held = std::move(s);
+        } else if ((got > 0) || !had) {
+          if (!submit(s, ad, idx++, true)) {
+            failed = eof = true;
+            break;
+          }
+          q.push_back(std::move(s));
+        }
+      }
+
+      if (q.empty()) {
+        break;
+      }
+
+      auto s = std::move(q.front());
+      q.pop_front();
+
+      co_await typename slot<R, C>::awaiter{ s.get() };
+      co_yield std::move(s->c);
+    }
+  }
+
+  // Returns truth value, if a generator stopped early
+  bool error() const { return failed; }
+
+private:
+  // Offloads sealing of i -th segment to engine
+  bool submit(const std::shared_ptr<slot<R, C>>& s,
+              const std::shared_ptr<const std::vector<uint8_t>>& ad,
+              const uint64_t i,
+              const bool last)
+  {
+    if (i >= stream::MAX_SEGMENTS) {
+      return false;
+    }
+
+    s->post = post;
+    s->ad = ad;
+    std::memcpy(s->key, key, KEY_LEN);
+    stream::derive_nonce<R>(nonce, static_cast<uint32_t>(i), last, s->nonce);
+
+    s->c.index = i;
+    s->c.last = last;
+    s->c.data.resize(s->in.size());
+    s->c.tag.resize(TAG_LEN);
+
+    const auto j = engine::seal_job(s->key,
+                                    s->nonce,
+                                    ad->data(),
+                                    ad->size(),
+                                    s->in.data(),
+                                    s->c.data.data(),
+                                    s->in.size(),
+                                    s->c.tag.data());
+
+    eng.submit(j, [s](const bool ok) { slot<R, C>::complete(s, ok); });
+    return true;
+  }
+
+  executor& eng;
+  uint8_t key[KEY_LEN];
+  uint8_t nonce[NONCE_LEN];
+  size_t seg_len;
+  size_t window;
+  resumer post;
+  bool failed = false;
+};
+
+// Asynchronous, streaming opener, which can be used with SchwaemmX-Y AEAD | X,
+// Y ∈ {128, 192, 256}; see aead::decrypt for meaning of template parameters.
+//
+// At most `window` segments are being opened ( on engine ) at any time, while
+// next sealed segments are only pulled from upstream generator, once consumer
+// takes opened ones.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class opener
+{
+public:
+  using executor = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of base nonce, from which per-segment nonces are derived
+  static constexpr size_t NONCE_LEN = R - stream::NONCE_SUFFIX_LEN;
+
+  // Byte length of authentication tag, of each segment
+  static constexpr size_t TAG_LEN = C;
+
+  opener(executor& eng,                         // crypto job engine
+         const uint8_t* const __restrict key,   // C -bytes secret key
+         const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+         const size_t seg_len,                  // segment byte length | > 0
+         const size_t window = 4,               // # -of in-flight segments
+         resumer post = resume_inline           // resumes awaiting coroutine
+         )
+    : eng(eng)
+    , seg_len(std::max<size_t>(seg_len, 1ul))
+    , window(std::max<size_t>(window, 1ul))
+    , post(std::move(post))
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->nonce, nonce, NONCE_LEN);
+  }
+
+  opener(const opener&) = delete;
+  opener& operator=(const opener&) = delete;
+
+  ~opener() { std::memset(key, 0, KEY_LEN); }
+
+  // Returns generator of opened segments, pulling sealed ones from `in` ( say
+  // a generator, returned by sealer::seal, or one reading segments off a
+  // socket ), where N (>=0) -bytes associated data is authenticated along
+  // with each segment. Only verified segments are handed out, in order; on
+  // first malformed/ out of order segment, verification failure or if stream
+  // ends before its last segment, generator stops & `error` holds truth value.
+  //
+  // Note, opener & upstream generator must outlive returned generator.
+  template<typename Upstream>
+  generator<chunk> open(Upstream& in,
+                        const uint8_t* const data = nullptr,
+                        const size_t d_len = 0)
+  {
+    auto ad = std::make_shared<const std::vector<uint8_t>>(data, data + d_len);
+
+    std::deque<std::shared_ptr<slot<R, C>>> q;
+    uint64_t idx = 0;
+    bool eof = false;
+    bool seen_last = false;
+
+    while (true) {
+      // keep window of in-flight segments full
+      while (!eof && (q.size() < window)) {
+        chunk* const c = co_await in.next();
+        if (c == nullptr) {
+          eof = true;
+          break;
+        }
+
+        const bool bad_len =
+          c->last ? (c->data.size() > seg_len) : (c->data.size() != seg_len);
+        if (bad_len || (c->index != idx) || (c->tag.size() != TAG_LEN) ||
+            (idx >= stream::MAX_SEGMENTS)) {
+          failed = true;
+          eof = true;
+          break;
+        }
+
+        auto s = std::make_shared<slot<R, C>>();
+        s->in = std::move(c->data);
+        s->c.tag = std::move(c->tag);
+        s->c.index = idx++;
+        s->c.last = c->last;
+
+        submit(s, ad);
+        q.push_back(std::move(s));
+
+        if (c->last) {
+          seen_last = true;
+          eof = true;
+        }
+      }
+
+      if (q.empty()) {
+        // truncated stream
+        failed |= !seen_last;
+        break;
+      }
+
+      auto s = std::move(q.front());
+      q.pop_front();
+
+      const bool ok = co_await typename slot<R, C>::awaiter{ s.get() };
+      if (!ok || failed) {
+        // don't release unverified ( or out of order ) segments
+        failed = true;
+        break;
+      }
+
+      co_yield std::move(s->c);
+    }
+  }
+
+  // Returns truth value, if a generator stopped because of bad input
+  bool error() const { return failed; }
+
+private:
+  // Offloads opening of a segment to engine
+  void submit(const std::shared_ptr<slot<R, C>>& s,
+              const std::shared_ptr<const std::vector<uint8_t>>& ad)
+  {
+    s->post = post;
+    s->ad = ad;
+    std::memcpy(s->key, key, KEY_LEN);
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(s->c.index), s->c.last, s->nonce);
+
+    s->c.data.resize(s->in.size());
+
+    const auto j = engine::open_job(s->key,
+                                    s->nonce,
+                                    s->c.tag.data(),
+                                    ad->data(),
+                                    ad->size(),
+                                    s->in.data(),
+                                    s->c.data.data(),
+                                    s->in.size());
+
+    eng.submit(j, [s](const bool ok) { slot<R, C>::complete(s, ok); });
+  }
+
+  executor& eng;
+  uint8_t key[KEY_LEN];
+  uint8_t nonce[NONCE_LEN];
+  size_t seg_len;
+  size_t window;
+  resumer post;
+  bool failed = false;
+};
+
+} // namespace async
+
+// Asynchronous streaming encryption/ decryption using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using async_sealer = async::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using async_opener = async::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Asynchronous streaming encryption/ decryption using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using async_sealer = async::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using async_opener = async::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Asynchronous streaming encryption/ decryption using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using async_sealer = async::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using async_opener = async::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Asynchronous streaming encryption/ decryption using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using async_sealer = async::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using async_opener = async::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
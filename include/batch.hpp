@@ -0,0 +1,555 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "esch256.hpp"
+#include "esch384.hpp"
+#include "multilane.hpp"
+#include "parallel.hpp"
+#include "schwaemm128_128.hpp"
+#include "schwaemm192_192.hpp"
+#include "schwaemm256_128.hpp"
+#include "schwaemm256_256.hpp"
+
+// Batched Esch{256,384} hashing & SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256} of
+// many independent messages, in a single call
+//
+// Messages are ordered by their shape ( i.e. byte lengths ), so that runs of
+// equal shape messages are processed L at a time, on multi-lane kernels ( see
+// multilane.hpp ), while leftovers are processed one at a time. Resulting
+// pieces of work are spread over a thread pool, when batch carries enough bytes
+// to pay for waking up workers.
+namespace batch {
+
+// Minimum # -of message bytes in a batch, for it to be spread over thread pool
+constexpr size_t PAR_MIN = 1ul << 16;
+
+// A piece of work, covering `cnt` -many consecutive entries of message ordering
+struct task
+{
+  size_t beg;
+  size_t cnt;
+};
+
+// Orders n messages by their shape & splits ordering into tasks, where each
+// task is either L -many equal shape messages or a single message
+template<const size_t L, typename Shape>
+static inline void
+plan(const size_t n,
+     const Shape& shape, // shape(i) -> ( comparable ) shape of i -th message
+     std::vector<size_t>& order,
+     std::vector<task>& tasks)
+{
+  const auto less = [&](const size_t a, const size_t b) {
+    return shape(a) < shape(b);
+  };
+
+  order.resize(n);
+  std::iota(order.begin(), order.end(), 0ul);
+  if (!std::is_sorted(order.begin(), order.end(), less)) {
+    std::stable_sort(order.begin(), order.end(), less);
+  }
+
+  tasks.clear();
+  tasks.reserve(n / L + L);
+
+  size_t i = 0;
+  while (i < n) {
+    size_t j = i + 1;
+    while ((j < n) && (shape(order[j]) == shape(order[i]))) {
+      j++;
+    }
+
+    for (; (j - i) >= L; i += L) {
+      tasks.push_back({ i, L });
+    }
+    for (; i < j; i++) {
+      tasks.push_back({ i, 1 });
+    }
+  }
+}
+
+// Invokes `fn(t)` for each task t, on thread pool, if batch carries at least
+// PAR_MIN -bytes, otherwise on calling thread
+template<typename Fn>
+static inline void
+execute(parallel::thread_pool& pool,
+        const std::vector<task>& tasks,
+        const size_t bytes, // total byte length of all messages
+        const Fn& fn)
+{
+  if ((bytes < PAR_MIN) || (tasks.size() < 2)) {
+    for (const auto& t : tasks) {
+      fn(t);
+    }
+    return;
+  }
+
+  pool.for_each(tasks.size(), [&](const size_t i) { fn(tasks[i]); });
+}
+
+// Esch256 ( nb = 6 ) or Esch384 ( nb = 8 ) hash of n messages, writing dlen
+// -bytes digest of i -th message at offset i * dlen of `out`
+template<const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t dlen,
+         const size_t L = multilane::LANES>
+static inline void
+hash(parallel::thread_pool& pool,
+     const uint8_t* const* const in, // n -many messages
+     const size_t* const ilen,       // n -many message byte lengths
+     const size_t n,                 // # -of messages
+     uint8_t* const __restrict out   // n * dlen -bytes digests
+)
+{
+  std::vector<size_t> order;
+  std::vector<task> tasks;
+  plan<L>(n, [&](const size_t i) { return ilen[i]; }, order, tasks);
+
+  const size_t bytes = std::accumulate(ilen, ilen + n, 0ul);
+
+  execute(pool, tasks, bytes, [&](const task& t) {
+    const size_t* const idx = order.data() + t.beg;
+
+    if (t.cnt == 1) {
+      const size_t i = idx[0];
+      if constexpr (nb == 6) {
+        esch256::hash(in[i], ilen[i], out + i * dlen);
+      } else {
+        esch384::hash(in[i], ilen[i], out + i * dlen);
+      }
+      return;
+    }
+
+    const uint8_t* ins[L];
+    uint8_t* outs[L];
+    for (size_t l = 0; l < L; l++) {
+      ins[l] = in[idx[l]];
+      outs[l] = out + idx[l] * dlen;
+    }
+
+    multilane::hash<nb, ns_slim, ns_big, dlen, L>(ins, ilen[idx[0]], outs);
+  });
+}
+
+// Authenticated encryption of n messages, using SchwaemmX-Y AEAD, writing C
+// -bytes authentication tag of i -th message at offset i * C of `tag`; see
+// aead::encrypt for meaning of template parameters
+//
+// Each message has its own key, nonce, associated data, plain text & cipher
+// text, where plain text & cipher text of a message may point to same memory.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+static inline void
+encrypt(parallel::thread_pool& pool,
+        const uint8_t* const* const key,   // n -many C -bytes secret keys
+        const uint8_t* const* const nonce, // n -many R -bytes nonces
+        const uint8_t* const* const data,  // n -many associated data
+        const size_t* const d_len,         // n -many AD byte lengths
+        const uint8_t* const* const txt,   // n -many plain texts
+        uint8_t* const* const enc,         // n -many cipher texts
+        const size_t* const ct_len,        // n -many plain text byte lengths
+        uint8_t* const __restrict tag,     // n * C -bytes tags
+        const size_t n                     // # -of messages
+)
+{
+  std::vector<size_t> order;
+  std::vector<task> tasks;
+  plan<L>(
+    n,
+    [&](const size_t i) { return std::make_pair(ct_len[i], d_len[i]); },
+    order,
+    tasks);
+
+  const size_t bytes = std::accumulate(ct_len, ct_len + n, 0ul);
+
+  execute(pool, tasks, bytes, [&](const task& t) {
+    const size_t* const idx = order.data() + t.beg;
+
+    if (t.cnt == 1) {
+      const size_t i = idx[0];
+      aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(key[i],
+                                                    nonce[i],
+                                                    data[i],
+                                                    d_len[i],
+                                                    txt[i],
+                                                    enc[i],
+                                                    ct_len[i],
+                                                    tag + i * C);
+      return;
+    }
+
+    const uint8_t *keys[L], *nonces[L], *datas[L], *txts[L];
+    uint8_t *encs[L], *tags[L];
+    for (size_t l = 0; l < L; l++) {
+      const size_t i = idx[l];
+
+      keys[l] = key[i];
+      nonces[l] = nonce[i];
+      datas[l] = data[i];
+      txts[l] = txt[i];
+      encs[l] = enc[i];
+      tags[l] = tag + i * C;
+    }
+
+    const size_t i = idx[0];
+    multilane::encrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+      keys, nonces, datas, d_len[i], txts, encs, ct_len[i], tags);
+  });
+}
+
+// Verified decryption of n messages, using SchwaemmX-Y AEAD, writing
+// verification status of i -th message to `flag[i]`; see aead::decrypt for
+// meaning of template parameters
+//
+// Decrypted text of each message, which failed verification, is zeroed. Returns
+// truth value only if all messages are verified. Cipher text & decrypted text
+// of a message may point to same memory.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+static inline bool
+decrypt(parallel::thread_pool& pool,
+        const uint8_t* const* const key,     // n -many C -bytes secret keys
+        const uint8_t* const* const nonce,   // n -many R -bytes nonces
+        const uint8_t* const __restrict tag, // n * C -bytes tags
+        const uint8_t* const* const data,    // n -many associated data
+        const size_t* const d_len,           // n -many AD byte lengths
+        const uint8_t* const* const enc,     // n -many cipher texts
+        uint8_t* const* const dec,           // n -many decrypted texts
+        const size_t* const ct_len,          // n -many cipher text byte lengths
+        bool* const flag,                    // n -many verification flags
+        const size_t n                       // # -of messages
+)
+{
+  std::vector<size_t> order;
+  std::vector<task> tasks;
+  plan<L>(
+    n,
+    [&](const size_t i) { return std::make_pair(ct_len[i], d_len[i]); },
+    order,
+    tasks);
+
+  const size_t bytes = std::accumulate(ct_len, ct_len + n, 0ul);
+
+  execute(pool, tasks, bytes, [&](const task& t) {
+    const size_t* const idx = order.data() + t.beg;
+
+    if (t.cnt == 1) {
+      const size_t i = idx[0];
+      flag[i] = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(key[i],
+                                                              nonce[i],
+                                                              tag + i * C,
+                                                              data[i],
+                                                              d_len[i],
+                                                              enc[i],
+                                                              dec[i],
+                                                              ct_len[i]);
+      return;
+    }
+
+    const uint8_t *keys[L], *nonces[L], *tags[L], *datas[L], *encs[L];
+    uint8_t* decs[L];
+    bool flags[L];
+    for (size_t l = 0; l < L; l++) {
+      const size_t i = idx[l];
+
+      keys[l] = key[i];
+      nonces[l] = nonce[i];
+      tags[l] = tag + i * C;
+      datas[l] = data[i];
+      encs[l] = enc[i];
+      decs[l] = dec[i];
+    }
+
+    const size_t i = idx[0];
+    multilane::decrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+      keys, nonces, tags, datas, d_len[i], encs, decs, ct_len[i], flags);
+
+    for (size_t l = 0; l < L; l++) {
+      flag[idx[l]] = flags[l];
+    }
+  });
+
+  return std::all_of(flag, flag + n, [](const bool f) { return f; });
+}
+
+} // namespace batch
+
+namespace esch256 {
+
+// Hashes n messages, on process wide thread pool; see batch::hash
+static inline void
+batch_hash(const uint8_t* const* const in, // n -many messages
+           const size_t* const ilen,       // n -many message byte lengths
+           const size_t n,                 // # -of messages
+           uint8_t* const __restrict out   // n * 32 -bytes digests
+)
+{
+  batch::hash<6ul, 7ul, 11ul, DIGEST_LEN>(
+    parallel::default_pool(), in, ilen, n, out);
+}
+
+}
+
+namespace esch384 {
+
+// Hashes n messages, on process wide thread pool; see batch::hash
+static inline void
+batch_hash(const uint8_t* const* const in, // n -many messages
+           const size_t* const ilen,       // n -many message byte lengths
+           const size_t n,                 // # -of messages
+           uint8_t* const __restrict out   // n * 48 -bytes digests
+)
+{
+  batch::hash<8ul, 8ul, 12ul, DIGEST_LEN>(
+    parallel::default_pool(), in, ilen, n, out);
+}
+
+}
+
+namespace schwaemm256_128 {
+
+// Encrypts n messages, on process wide thread pool; see batch::encrypt
+static inline void
+batch_encrypt(const uint8_t* const* const key,   // n -many 16 -bytes keys
+              const uint8_t* const* const nonce, // n -many nonces
+              const uint8_t* const* const data,  // n -many associated data
+              const size_t* const d_len,         // n -many AD byte lengths
+              const uint8_t* const* const txt,   // n -many plain texts
+              uint8_t* const* const enc,         // n -many cipher texts
+              const size_t* const ct_len,        // n -many text byte lengths
+              uint8_t* const __restrict tag,     // n * 16 -bytes tags
+              const size_t n                     // # -of messages
+)
+{
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 key,
+                                                 nonce,
+                                                 data,
+                                                 d_len,
+                                                 txt,
+                                                 enc,
+                                                 ct_len,
+                                                 tag,
+                                                 n);
+}
+
+// Decrypts n messages, on process wide thread pool; see batch::decrypt
+static inline bool
+batch_decrypt(const uint8_t* const* const key,     // n -many 16 -bytes keys
+              const uint8_t* const* const nonce,   // n -many nonces
+              const uint8_t* const __restrict tag, // n * 16 -bytes tags
+              const uint8_t* const* const data,    // n -many associated data
+              const size_t* const d_len,           // n -many AD byte lengths
+              const uint8_t* const* const enc,     // n -many cipher texts
+              uint8_t* const* const dec,           // n -many decrypted texts
+              const size_t* const ct_len,          // n -many text byte lengths
+              bool* const flag,                    // n -many verification flags
+              const size_t n                       // # -of messages
+)
+{
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    key,
+    nonce,
+    tag,
+    data,
+    d_len,
+    enc,
+    dec,
+    ct_len,
+    flag,
+    n);
+}
+
+}
+
+namespace schwaemm192_192 {
+
+// Encrypts n messages, on process wide thread pool; see batch::encrypt
+static inline void
+batch_encrypt(const uint8_t* const* const key,   // n -many 24 -bytes keys
+              const uint8_t* const* const nonce, // n -many nonces
+              const uint8_t* const* const data,  // n -many associated data
+              const size_t* const d_len,         // n -many AD byte lengths
+              const uint8_t* const* const txt,   // n -many plain texts
+              uint8_t* const* const enc,         // n -many cipher texts
+              const size_t* const ct_len,        // n -many text byte lengths
+              uint8_t* const __restrict tag,     // n * 24 -bytes tags
+              const size_t n                     // # -of messages
+)
+{
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 key,
+                                                 nonce,
+                                                 data,
+                                                 d_len,
+                                                 txt,
+                                                 enc,
+                                                 ct_len,
+                                                 tag,
+                                                 n);
+}
+
+// Decrypts n messages, on process wide thread pool; see batch::decrypt
+static inline bool
+batch_decrypt(const uint8_t* const* const key,     // n -many 24 -bytes keys
+              const uint8_t* const* const nonce,   // n -many nonces
+              const uint8_t* const __restrict tag, // n * 24 -bytes tags
+              const uint8_t* const* const data,    // n -many associated data
+              const size_t* const d_len,           // n -many AD byte lengths
+              const uint8_t* const* const enc,     // n -many cipher texts
+              uint8_t* const* const dec,           // n -many decrypted texts
+              const size_t* const ct_len,          // n -many text byte lengths
+              bool* const flag,                    // n -many verification flags
+              const size_t n                       // # -of messages
+)
+{
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    key,
+    nonce,
+    tag,
+    data,
+    d_len,
+    enc,
+    dec,
+    ct_len,
+    flag,
+    n);
+}
+
+}
+
+namespace schwaemm128_128 {
+
+// Encrypts n messages, on process wide thread pool; see batch::encrypt
+static inline void
+batch_encrypt(const uint8_t* const* const key,   // n -many 16 -bytes keys
+              const uint8_t* const* const nonce, // n -many nonces
+              const uint8_t* const* const data,  // n -many associated data
+              const size_t* const d_len,         // n -many AD byte lengths
+              const uint8_t* const* const txt,   // n -many plain texts
+              uint8_t* const* const enc,         // n -many cipher texts
+              const size_t* const ct_len,        // n -many text byte lengths
+              uint8_t* const __restrict tag,     // n * 16 -bytes tags
+              const size_t n                     // # -of messages
+)
+{
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 key,
+                                                 nonce,
+                                                 data,
+                                                 d_len,
+                                                 txt,
+                                                 enc,
+                                                 ct_len,
+                                                 tag,
+                                                 n);
+}
+
+// Decrypts n messages, on process wide thread pool; see batch::decrypt
+static inline bool
+batch_decrypt(const uint8_t* const* const key,     // n -many 16 -bytes keys
+              const uint8_t* const* const nonce,   // n -many nonces
+              const uint8_t* const __restrict tag, // n * 16 -bytes tags
+              const uint8_t* const* const data,    // n -many associated data
+              const size_t* const d_len,           // n -many AD byte lengths
+              const uint8_t* const* const enc,     // n -many cipher texts
+              uint8_t* const* const dec,           // n -many decrypted texts
+              const size_t* const ct_len,          // n -many text byte lengths
+              bool* const flag,                    // n -many verification flags
+              const size_t n                       // # -of messages
+)
+{
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    key,
+    nonce,
+    tag,
+    data,
+    d_len,
+    enc,
+    dec,
+    ct_len,
+    flag,
+    n);
+}
+
+}
+
+namespace schwaemm256_256 {
+
+// Encrypts n messages, on process wide thread pool; see batch::encrypt
+static inline void
+batch_encrypt(const uint8_t* const* const key,   // n -many 32 -bytes keys
+              const uint8_t* const* const nonce, // n -many nonces
+              const uint8_t* const* const data,  // n -many associated data
+              const size_t* const d_len,         // n -many AD byte lengths
+              const uint8_t* const* const txt,   // n -many plain texts
+              uint8_t* const* const enc,         // n -many cipher texts
+              const size_t* const ct_len,        // n -many text byte lengths
+              uint8_t* const __restrict tag,     // n * 32 -bytes tags
+              const size_t n                     // # -of messages
+)
+{
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 key,
+                                                 nonce,
+                                                 data,
+                                                 d_len,
+                                                 txt,
+                                                 enc,
+                                                 ct_len,
+                                                 tag,
+                                                 n);
+}
+
+// Decrypts n messages, on process wide thread pool; see batch::decrypt
+static inline bool
+batch_decrypt(const uint8_t* const* const key,     // n -many 32 -bytes keys
+              const uint8_t* const* const nonce,   // n -many nonces
+              const uint8_t* const __restrict tag, // n * 32 -bytes tags
+              const uint8_t* const* const data,    // n -many associated data
+              const size_t* const d_len,           // n -many AD byte lengths
+              const uint8_t* const* const enc,     // n -many cipher texts
+              uint8_t* const* const dec,           // n -many decrypted texts
+              const size_t* const ct_len,          // n -many text byte lengths
+              bool* const flag,                    // n -many verification flags
+              const size_t n                       // # -of messages
+)
+{
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    key,
+    nonce,
+    tag,
+    data,
+    d_len,
+    enc,
+    dec,
+    ct_len,
+    flag,
+    n);
+}
+
+}
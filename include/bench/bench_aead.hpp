@@ -1,4 +1,5 @@
 #pragma once
+#include "bench_counters.hpp"
 #include "schwaemm.hpp"
 #include "utils.hpp"
 #include <benchmark/benchmark.h>
@@ -31,6 +32,7 @@ schwaemm256_128_encrypt(benchmark::State& state)
   memset(enc, 0, ct_len);
   memset(tag, 0, schwaemm256_128::C);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     schwaemm256_128::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
@@ -43,6 +45,7 @@ schwaemm256_128_encrypt(benchmark::State& state)
     benchmark::DoNotOptimize(ct_len);
     benchmark::DoNotOptimize(tag);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -89,6 +92,7 @@ schwaemm256_128_decrypt(benchmark::State& state)
 
   schwaemm256_128::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     using namespace schwaemm256_128;
     using namespace benchmark;
@@ -106,6 +110,7 @@ schwaemm256_128_decrypt(benchmark::State& state)
     DoNotOptimize(dec);
     DoNotOptimize(ct_len);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -151,6 +156,7 @@ schwaemm192_192_encrypt(benchmark::State& state)
   memset(enc, 0, ct_len);
   memset(tag, 0, KNT_LEN);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     schwaemm192_192::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
@@ -163,6 +169,7 @@ schwaemm192_192_encrypt(benchmark::State& state)
     benchmark::DoNotOptimize(ct_len);
     benchmark::DoNotOptimize(tag);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -211,6 +218,7 @@ schwaemm192_192_decrypt(benchmark::State& state)
 
   schwaemm192_192::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     using namespace schwaemm192_192;
     using namespace benchmark;
@@ -228,6 +236,7 @@ schwaemm192_192_decrypt(benchmark::State& state)
     DoNotOptimize(dec);
     DoNotOptimize(ct_len);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -273,6 +282,7 @@ schwaemm128_128_encrypt(benchmark::State& state)
   memset(enc, 0, ct_len);
   memset(tag, 0, KNT_LEN);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     schwaemm128_128::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
@@ -285,6 +295,7 @@ schwaemm128_128_encrypt(benchmark::State& state)
     benchmark::DoNotOptimize(ct_len);
     benchmark::DoNotOptimize(tag);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -333,6 +344,7 @@ schwaemm128_128_decrypt(benchmark::State& state)
 
   schwaemm128_128::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     using namespace schwaemm128_128;
     using namespace benchmark;
@@ -350,6 +362,7 @@ schwaemm128_128_decrypt(benchmark::State& state)
     DoNotOptimize(dec);
     DoNotOptimize(ct_len);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -395,6 +408,7 @@ schwaemm256_256_encrypt(benchmark::State& state)
   memset(enc, 0, ct_len);
   memset(tag, 0, KNT_LEN);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     schwaemm256_256::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
@@ -407,6 +421,7 @@ schwaemm256_256_encrypt(benchmark::State& state)
     benchmark::DoNotOptimize(ct_len);
     benchmark::DoNotOptimize(tag);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -455,6 +470,7 @@ schwaemm256_256_decrypt(benchmark::State& state)
 
   schwaemm256_256::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     using namespace schwaemm256_256;
     using namespace benchmark;
@@ -472,6 +488,7 @@ schwaemm256_256_decrypt(benchmark::State& state)
     DoNotOptimize(dec);
     DoNotOptimize(ct_len);
   }
+  ctr.report(state, dt_len + ct_len);
 
   const size_t per_itr_data = dt_len + ct_len;
   const size_t total_data = per_itr_data * state.iterations();
@@ -0,0 +1,141 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "async.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <vector>
+
+// Helpers for benchmarking asynchronous streaming API
+namespace bench_sparkle {
+
+using clk = std::chrono::steady_clock;
+
+// Keeps rescheduling itself on event loop, until asked to stop, while
+// recording longest gap ( in microseconds ) between two of its turns i.e. worst
+// case latency, any other event handler would see
+static async::task
+ticker(async::loop& ev, const bool& stop, double& max_gap)
+{
+  auto prev = clk::now();
+  while (!stop) {
+    co_await ev.schedule();
+
+    const auto now = clk::now();
+    const std::chrono::duration<double, std::micro> gap = now - prev;
+    max_gap = std::max(max_gap, gap.count());
+    prev = now;
+  }
+}
+
+// Seals payload segment by segment, on event loop thread, yielding to loop
+// after each segment
+static async::task
+seal_inline(async::loop& ev,
+            schwaemm256_128::stream_encryptor& e,
+            const std::vector<uint8_t>& txt,
+            std::vector<uint8_t>& enc,
+            std::vector<uint8_t>& tags,
+            const size_t seg_len)
+{
+  using namespace schwaemm256_128;
+
+  const size_t len = txt.size();
+  for (size_t off = 0, i = 0; off < len; off += seg_len, i++) {
+    const size_t n = std::min(seg_len, len - off);
+    const bool last = (off + n) == len;
+
+    e.seal(nullptr,
+           0,
+           txt.data() + off,
+           enc.data() + off,
+           n,
+           tags.data() + i * C,
+           last);
+    co_await ev.schedule();
+  }
+}
+
+// Seals payload, with crypto work offloaded to engine, on event loop thread
+static async::task
+seal_async(schwaemm256_128::async_sealer& s,
+           async::memory_source& src,
+           std::vector<uint8_t>& enc,
+           std::vector<uint8_t>& tags)
+{
+  using namespace schwaemm256_128;
+
+  auto g = s.seal(src);
+  size_t off = 0;
+  while (async::chunk* c = co_await g.next()) {
+    std::copy(c->data.begin(), c->data.end(), enc.begin() + off);
+    std::copy(c->tag.begin(), c->tag.end(), tags.begin() + c->index * C);
+    off += c->data.size();
+  }
+}
+
+} // namespace bench_sparkle
+
+// Benchmark streaming sealing of a large payload, using Schwaemm256-128, on an
+// event loop thread, which also runs a ticker, where payload byte length,
+// segment byte length & whether crypto work is offloaded to engine using async
+// API ( = 1 ) or done inline on loop thread ( = 0 ) are provided when setting
+// up benchmark. Worst case gap between ticks is reported as `max_gap_us`, which
+// should stay flat with segment length, when crypto work is offloaded.
+void
+schwaemm256_128_async_seal(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t len = state.range(0);
+  const size_t seg_len = state.range(1);
+  const bool offload = state.range(2) != 0;
+  const size_t n_segs = (len + seg_len - 1) / seg_len;
+
+  // acquire memory resources
+  std::vector<uint8_t> text(len);
+  std::vector<uint8_t> enc(len);
+  std::vector<uint8_t> tags(n_segs * C);
+  uint8_t key[C];
+  uint8_t nonce[R - stream::NONCE_SUFFIX_LEN];
+
+  sparkle_utils::random_data(text.data(), text.size());
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  crypto_engine eng{};
+  async::loop ev;
+  double max_gap = 0.;
+
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    bool stop = false;
+    auto tick = bench_sparkle::ticker(ev, stop, max_gap);
+
+    if (offload) {
+      async_sealer s{ eng, key, nonce, seg_len, 4, ev.poster() };
+      async::memory_source src{ text.data(), text.size() };
+
+      auto t = bench_sparkle::seal_async(s, src, enc, tags);
+      ev.run(t);
+    } else {
+      stream_encryptor e{ key, nonce, seg_len };
+
+      auto t = bench_sparkle::seal_inline(ev, e, text, enc, tags, seg_len);
+      ev.run(t);
+    }
+
+    stop = true;
+    ev.run(tick);
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(len * state.iterations()));
+  state.counters["max_gap_us"] = max_gap;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "batch.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark Esch256 hashing of a batch of equal length messages, in a single
+// call, where message byte length & # -of messages in batch are provided when
+// setting up benchmark
+void
+esch256_batch_hash(benchmark::State& state)
+{
+  const size_t m_len = state.range(0);
+  const size_t n_msgs = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> msgs(n_msgs * m_len);
+  std::vector<uint8_t> digs(n_msgs * esch256::DIGEST_LEN);
+  std::vector<const uint8_t*> ins(n_msgs);
+  std::vector<size_t> lens(n_msgs, m_len);
+
+  sparkle_utils::random_data(msgs.data(), msgs.size());
+  for (size_t i = 0; i < n_msgs; i++) {
+    ins[i] = msgs.data() + i * m_len;
+  }
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    esch256::batch_hash(ins.data(), lens.data(), n_msgs, digs.data());
+
+    benchmark::DoNotOptimize(digs.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, msgs.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(msgs.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_msgs * state.iterations()));
+}
+
+// Benchmark Schwaemm256-128 encryption of a batch of equal length messages,
+// each under its own key & nonce, in a single call, where plain text byte
+// length & # -of messages in batch are provided when setting up benchmark
+void
+schwaemm256_128_batch_encrypt(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t n_msgs = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> keys(n_msgs * C), nonces(n_msgs * R);
+  std::vector<uint8_t> text(n_msgs * ct_len), enc(n_msgs * ct_len);
+  std::vector<uint8_t> tags(n_msgs * C);
+
+  std::vector<const uint8_t*> key(n_msgs), nonce(n_msgs), data(n_msgs);
+  std::vector<const uint8_t*> txt(n_msgs);
+  std::vector<uint8_t*> out(n_msgs);
+  std::vector<size_t> d_len(n_msgs, 0), t_len(n_msgs, ct_len);
+
+  sparkle_utils::random_data(keys.data(), keys.size());
+  sparkle_utils::random_data(nonces.data(), nonces.size());
+  sparkle_utils::random_data(text.data(), text.size());
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    key[i] = keys.data() + i * C;
+    nonce[i] = nonces.data() + i * R;
+    data[i] = nullptr;
+    txt[i] = text.data() + i * ct_len;
+    out[i] = enc.data() + i * ct_len;
+  }
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    batch_encrypt(key.data(),
+                  nonce.data(),
+                  data.data(),
+                  d_len.data(),
+                  txt.data(),
+                  out.data(),
+                  t_len.data(),
+                  tags.data(),
+                  n_msgs);
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tags.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, text.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(text.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_msgs * state.iterations()));
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "bulk.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark multi-threaded, segmented Schwaemm256-128 Authenticated Encryption
+// on CPU, where buffer length and segment length are provided when setting up
+// benchmark
+void
+schwaemm256_128_bulk_encrypt(benchmark::State& state)
+{
+  const size_t ct_len = state.range(0);
+  const size_t seg_len = state.range(1);
+  const size_t dt_len = 32ul;
+  const size_t n_segs = bulk::segment_count(ct_len, seg_len);
+
+  constexpr size_t nonce_len = schwaemm256_128::stream_encryptor::NONCE_LEN;
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* data = static_cast<uint8_t*>(malloc(dt_len));
+  uint8_t* key = static_cast<uint8_t*>(malloc(schwaemm256_128::C));
+  uint8_t* nonce = static_cast<uint8_t*>(malloc(nonce_len));
+  uint8_t* tags = static_cast<uint8_t*>(malloc(n_segs * schwaemm256_128::C));
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(data, dt_len);
+  sparkle_utils::random_data(key, schwaemm256_128::C);
+  sparkle_utils::random_data(nonce, nonce_len);
+
+  memset(enc, 0, ct_len);
+  memset(tags, 0, n_segs * schwaemm256_128::C);
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    using namespace schwaemm256_128;
+    bulk_encrypt(key, nonce, data, dt_len, text, enc, ct_len, seg_len, tags);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tags);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+  state.counters["threads"] = parallel::default_pool().concurrency();
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+  free(data);
+  free(key);
+  free(nonce);
+  free(tags);
+}
+
+// Benchmark multi-threaded, segmented Schwaemm256-128 Verified Decryption on
+// CPU, where buffer length and segment length are provided when setting up
+// benchmark
+void
+schwaemm256_128_bulk_decrypt(benchmark::State& state)
+{
+  const size_t ct_len = state.range(0);
+  const size_t seg_len = state.range(1);
+  const size_t dt_len = 32ul;
+  const size_t n_segs = bulk::segment_count(ct_len, seg_len);
+
+  constexpr size_t nonce_len = schwaemm256_128::stream_encryptor::NONCE_LEN;
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* data = static_cast<uint8_t*>(malloc(dt_len));
+  uint8_t* key = static_cast<uint8_t*>(malloc(schwaemm256_128::C));
+  uint8_t* nonce = static_cast<uint8_t*>(malloc(nonce_len));
+  uint8_t* tags = static_cast<uint8_t*>(malloc(n_segs * schwaemm256_128::C));
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(data, dt_len);
+  sparkle_utils::random_data(key, schwaemm256_128::C);
+  sparkle_utils::random_data(nonce, nonce_len);
+
+  using namespace schwaemm256_128;
+  bulk_encrypt(key, nonce, data, dt_len, text, enc, ct_len, seg_len, tags);
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    bool f =
+      bulk_decrypt(key, nonce, tags, data, dt_len, enc, dec, ct_len, seg_len);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+  state.counters["threads"] = parallel::default_pool().concurrency();
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+  free(dec);
+  free(data);
+  free(key);
+  free(nonce);
+  free(tags);
+}
@@ -0,0 +1,317 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "esch.hpp"
+#include "schwaemm.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#endif
+
+// Benchmarks on cold buffers i.e. ones not resident in CPU caches/ TLB, as
+// seen when processing data just received from NIC or read from disk
+namespace bench_sparkle {
+
+// Anonymous memory mapping, backed by transparent huge pages ( when asked for
+// & enabled in /sys/kernel/mm/transparent_hugepage ) or by 4 KB pages, which is
+// pre-faulted, so that page faults aren't measured
+class region
+{
+public:
+  static constexpr size_t HUGE_PAGE = 2ul << 20;
+
+  region(const size_t len, const bool huge)
+    : n(len)
+  {
+    // over-allocate, so that region can start at huge page boundary
+    map_len = n + HUGE_PAGE;
+    map = ::mmap(nullptr,
+                 map_len,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS,
+                 -1,
+                 0);
+    if (map == MAP_FAILED) {
+      map = nullptr;
+      return;
+    }
+
+    const auto addr = reinterpret_cast<uintptr_t>(map);
+    ptr = reinterpret_cast<uint8_t*>((addr + HUGE_PAGE - 1) &
+                                     ~(HUGE_PAGE - 1));
+    advised = ::madvise(ptr, n, huge ? MADV_HUGEPAGE : MADV_NOHUGEPAGE) == 0;
+
+    // content doesn't matter, as all operations are constant-time
+    std::memset(ptr, 0xa5, n);
+  }
+
+  region(const region&) = delete;
+  region& operator=(const region&) = delete;
+
+  ~region()
+  {
+    if (map != nullptr) {
+      ::munmap(map, map_len);
+    }
+  }
+
+  bool ok() const { return map != nullptr; }
+  bool thp_advised() const { return advised; }
+  uint8_t* data() const { return ptr; }
+  size_t size() const { return n; }
+
+private:
+  void* map = nullptr;
+  size_t map_len = 0;
+  uint8_t* ptr = nullptr;
+  size_t n = 0;
+  bool advised = false;
+};
+
+// Whether cache lines can be evicted using clflush instruction
+#if defined __x86_64__ || defined __i386__
+constexpr bool HAS_CLFLUSH = true;
+#else
+constexpr bool HAS_CLFLUSH = false;
+#endif
+
+// Byte length of last level cache, or 32 MB, when it can't be determined
+static inline size_t
+llc_size()
+{
+#if defined _SC_LEVEL3_CACHE_SIZE
+  const long n = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (n > 0) {
+    return static_cast<size_t>(n);
+  }
+#endif
+  return 32ul << 20;
+}
+
+// Evicts `len` -bytes, starting at `ptr`, from all levels of CPU caches, using
+// clflush on x86, otherwise by reading through an eviction buffer, which must
+// be larger than last level cache ( unused on x86 )
+static inline void
+evict(const uint8_t* const ptr, const size_t len, const region& buf)
+{
+#if defined __x86_64__ || defined __i386__
+  (void)buf;
+  for (size_t off = 0; off < len; off += 64) {
+    _mm_clflush(ptr + off);
+  }
+  if (len > 0) {
+    _mm_clflush(ptr + len - 1);
+  }
+  _mm_mfence();
+#else
+  (void)ptr;
+  (void)len;
+
+  uint64_t acc = 0;
+  for (size_t off = 0; off < buf.size(); off += 64) {
+    acc += buf.data()[off];
+  }
+  benchmark::DoNotOptimize(acc);
+#endif
+}
+
+// Kind of operation, benchmarked on cold buffers
+enum class cold_op
+{
+  esch256_hash,
+  schwaemm256_128_encrypt
+};
+
+// Executes operation on `len` -bytes input, writing to output of same length
+// ( encryption only ) & digest/ tag, using fixed key & nonce
+template<const cold_op op>
+static inline void
+cold_call(const uint8_t* const in,
+          uint8_t* const out,
+          const size_t len,
+          uint8_t* const tag)
+{
+  if constexpr (op == cold_op::esch256_hash) {
+    (void)out;
+    esch256::hash(in, len, tag);
+  } else {
+    using namespace schwaemm256_128;
+
+    constexpr uint8_t key[C]{};
+    constexpr uint8_t nonce[R]{};
+    encrypt(key, nonce, key, 0, in, out, len, tag);
+  }
+}
+
+// Benchmark Esch256 hashing/ Schwaemm256-128 encryption of N -bytes messages,
+// taking next message from a working set of M MB, in each iteration, so that
+// none of them is cache resident, when M is ( much ) larger than last level
+// cache, where working set is backed by huge or 4 KB pages. Messages are
+// visited in a shuffled order, so that hardware prefetcher can't stream next
+// message in, while current one is being processed | N, M & whether huge pages
+// are used, are provided when setting up benchmark
+template<const cold_op op>
+void
+rotating(benchmark::State& state)
+{
+  const size_t len = state.range(0);
+  const size_t ws = static_cast<size_t>(state.range(1)) << 20;
+  const bool huge = state.range(2) != 0;
+
+  // for encryption, cipher text is written next to plain text
+  const size_t slot =
+    std::max<size_t>((op == cold_op::esch256_hash) ? len : 2 * len, 1);
+  const size_t n_slots = std::max<size_t>(ws / slot, 1);
+
+  region mem{ n_slots * slot, huge };
+  if (!mem.ok()) {
+    state.SkipWithError("failed to map working set");
+    return;
+  }
+
+  // fixed seed, so that each run visits slots in same order
+  std::vector<size_t> order(n_slots);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937_64{ n_slots });
+
+  uint8_t tag[32];
+  size_t i = 0;
+
+  counters ctr;
+  for (auto _ : state) {
+    uint8_t* const msg = mem.data() + order[i] * slot;
+    cold_call<op>(msg, msg + len, len, tag);
+
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+
+    i = (i + 1 == n_slots) ? 0 : i + 1;
+  }
+  ctr.report(state, len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(len * state.iterations()));
+  state.SetLabel(huge ? (mem.thp_advised() ? "thp" : "thp unavailable")
+                      : "4k pages");
+}
+
+// Benchmark Esch256 hashing/ Schwaemm256-128 encryption of a N -bytes message,
+// after evicting message & output buffers from CPU caches, timing only the
+// call itself | N is provided when setting up benchmark
+template<const cold_op op>
+void
+flushed(benchmark::State& state)
+{
+  using clk = std::chrono::steady_clock;
+
+  const size_t len = state.range(0);
+
+  region mem{ 2 * len + 64, false };
+  region evict_buf{ HAS_CLFLUSH ? 0 : 2 * llc_size(), false };
+  if (!mem.ok() || !evict_buf.ok()) {
+    state.SkipWithError("failed to map buffers");
+    return;
+  }
+
+  uint8_t* const msg = mem.data();
+  uint8_t* const out = msg + len;
+  uint8_t* const tag = out + len;
+
+  for (auto _ : state) {
+    evict(mem.data(), mem.size(), evict_buf);
+
+    const auto t0 = clk::now();
+    cold_call<op>(msg, out, len, tag);
+    benchmark::ClobberMemory();
+    const auto t1 = clk::now();
+
+    state.SetIterationTime(std::chrono::duration<double>(t1 - t0).count());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(len * state.iterations()));
+}
+
+// Benchmark first call of Esch256 hashing/ Schwaemm256-128 encryption, in a
+// freshly forked process, after evicting caches, so that instructions, data &
+// TLB are all cold, timing only the call itself, on N -bytes message | N is
+// provided when setting up benchmark
+template<const cold_op op>
+void
+cold_start(benchmark::State& state)
+{
+  using clk = std::chrono::steady_clock;
+
+  const size_t len = state.range(0);
+
+  // allocated before forking, as child must not allocate
+  region mem{ 2 * len + 64, false };
+  region evict_buf{ 2 * llc_size(), false };
+  if (!mem.ok() || !evict_buf.ok()) {
+    state.SkipWithError("failed to map buffers");
+    return;
+  }
+
+  for (auto _ : state) {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+      state.SkipWithError("failed to create pipe");
+      break;
+    }
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+      ::close(fds[0]);
+
+      // break copy-on-write sharing of output pages, before they're evicted,
+      // so that timed call doesn't take page faults
+      uint8_t* const msg = mem.data();
+      for (size_t off = len; off < mem.size(); off += 64) {
+        msg[off] = 0;
+      }
+
+      // reads don't break copy-on-write sharing, so nothing gets allocated
+      uint64_t acc = 0;
+      for (size_t off = 0; off < evict_buf.size(); off += 64) {
+        acc += evict_buf.data()[off];
+      }
+      benchmark::DoNotOptimize(acc);
+
+      const auto t0 = clk::now();
+      cold_call<op>(msg, msg + len, len, msg + 2 * len);
+      const auto t1 = clk::now();
+
+      const double secs = std::chrono::duration<double>(t1 - t0).count();
+      const bool ok = ::write(fds[1], &secs, sizeof(secs)) == sizeof(secs);
+      ::_exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    ::close(fds[1]);
+
+    double secs = 0.;
+    const bool ok = (pid > 0) && (::read(fds[0], &secs, sizeof(secs)) ==
+                                  static_cast<ssize_t>(sizeof(secs)));
+    ::close(fds[0]);
+    if (pid > 0) {
+      ::waitpid(pid, nullptr, 0);
+    }
+
+    if (!ok) {
+      state.SkipWithError("failed to run forked child");
+      break;
+    }
+    state.SetIterationTime(secs);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(len * state.iterations()));
+}
+
+} // namespace bench_sparkle
@@ -0,0 +1,178 @@
+#pragma once
+#include "aead.hpp"
+#include "bench_counters.hpp"
+#include "hash.hpp"
+#include "sparkle.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark building blocks of Sparkle permutation, Esch hash & Schwaemm AEAD,
+// each as a dependent chain of calls ( latency, K = 1 ) & as K independent
+// instances, interleaved ( throughput, K > 1 )
+namespace bench_sparkle {
+
+// # -of independent instances, when measuring latency & throughput
+constexpr size_t LATENCY = 1;
+constexpr size_t THROUGHPUT = 8;
+
+// # -of times each instance is stepped, per benchmark iteration
+constexpr size_t UNROLL = 16;
+
+// Makes W words of state opaque to compiler, without forcing them to memory,
+// so that consecutive steps ( say, XORing same words twice ) can't be folded
+template<const size_t W>
+static inline void
+opaque(uint32_t* const st)
+{
+  for (size_t i = 0; i < W; i++) {
+    asm volatile("" : "+r"(st[i]));
+  }
+}
+
+// Steps K independent W -words states, using `step`, which transforms state in
+// place, UNROLL times per iteration, reporting time & cycles per step
+template<const size_t W, const size_t K, typename F>
+static inline void
+component(benchmark::State& state, F&& step)
+{
+  uint32_t st[K * W];
+  sparkle_utils::random_data(st, K * W);
+
+  counters ctr;
+  for (auto _ : state) {
+    for (size_t r = 0; r < UNROLL; r++) {
+      for (size_t k = 0; k < K; k++) {
+        step(st + k * W);
+        opaque<W>(st + k * W);
+      }
+    }
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+  ctr.report(state, 0);
+
+  using benchmark::Counter;
+  const double ops = static_cast<double>(UNROLL * K);
+  const double steps = ops * state.iterations();
+
+  state.counters["op"] = Counter(ops, Counter::kIsIterationInvariantRate |
+                                        Counter::kInvert);
+  for (const char* const c : { "cycles", "tsc" }) {
+    if (state.counters.contains(c)) {
+      state.counters["cyc/op"] = state.counters[c].value / steps;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(steps));
+}
+
+// Benchmark ARX-box Alzette, on a pair of words
+template<const size_t K>
+void
+alzette(benchmark::State& state)
+{
+  component<2, K>(state, [](uint32_t* const st) {
+    const auto p = sparkle::alzette(st[0], st[1], sparkle::CONST[0]);
+    st[0] = p.first;
+    st[1] = p.second;
+  });
+}
+
+// Benchmark linear diffusion layer ℒ4, ℒ6 or ℒ8, of Sparkle{256, 384, 512}
+template<const size_t K, const size_t nb>
+void
+diffusion_layer(benchmark::State& state)
+{
+  component<2 * nb, K>(state, [](uint32_t* const st) {
+    if constexpr (nb == 4) {
+      sparkle::diffusion_layer_4(st);
+    } else if constexpr (nb == 6) {
+      sparkle::diffusion_layer_6(st);
+    } else {
+      sparkle::diffusion_layer_8(st);
+    }
+  });
+}
+
+// Benchmark message injection ℳ3/ ℳ4 of Esch256/ Esch384, where message words
+// ( next four words, after permutation state ) are also part of the chain
+template<const size_t K, const size_t state_w>
+void
+feistel(benchmark::State& state)
+{
+  constexpr size_t W = state_w / 32;
+
+  component<W + 4, K>(state, [](uint32_t* const st) {
+    hash::feistel<state_w>(st, st + W);
+  });
+}
+
+// Benchmark Feistel swap of Schwaemm rate, of RATE -bytes
+template<const size_t K, const size_t RATE>
+void
+feistel_swap(benchmark::State& state)
+{
+  component<RATE / 4, K>(
+    state, [](uint32_t* const st) { aead::feistel_swap<RATE>(st); });
+}
+
+// Kind of Schwaemm feedback function
+enum class rho
+{
+  rho1,
+  rho2,
+  rhoprime1
+};
+
+// Benchmark Schwaemm feedback function 𝜌1, 𝜌2 or 𝜌'1, on RATE -bytes rate &
+// data block ( latter following former, in state )
+template<const size_t K, const size_t RATE, const rho fn>
+void
+feedback(benchmark::State& state)
+{
+  constexpr size_t W = RATE / 4;
+
+  component<2 * W, K>(state, [](uint32_t* const st) {
+    if constexpr (fn == rho::rho1) {
+      aead::rho1<RATE>(st, st + W);
+    } else if constexpr (fn == rho::rho2) {
+      aead::rho2<RATE>(st, st + W);
+    } else {
+      aead::rhoprime1<RATE>(st, st + W);
+    }
+  });
+}
+
+// Benchmark rate whitening of Schwaemm, with RATE & CAPACITY in bytes
+template<const size_t K, const size_t RATE, const size_t CAPACITY>
+void
+whiten_rate(benchmark::State& state)
+{
+  component<(RATE + CAPACITY) / 4, K>(state, [](uint32_t* const st) {
+    aead::whiten_rate<RATE, CAPACITY>(st);
+  });
+}
+
+// Benchmark round trip of `blen` -bytes, from words to little-endian bytes &
+// back, using compile-time ( when blen is a multiple of 4 ) or run-time length
+// copy routines of sparkle_utils
+template<const size_t K, const size_t blen>
+void
+copy_words(benchmark::State& state)
+{
+  constexpr size_t W = (blen + 3) / 4;
+
+  component<2 * W, K>(state, [](uint32_t* const st) {
+    uint8_t* const bytes = reinterpret_cast<uint8_t*>(st + W);
+
+    if constexpr (blen % 4 == 0) {
+      sparkle_utils::copy_words_to_le_bytes<blen>(st, bytes);
+      sparkle_utils::copy_le_bytes_to_words<blen>(bytes, st);
+    } else {
+      sparkle_utils::copy_words_to_le_bytes(st, bytes, blen);
+      sparkle_utils::copy_le_bytes_to_words(bytes, st, blen);
+    }
+  });
+}
+
+} // namespace bench_sparkle
@@ -0,0 +1,58 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "container.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// Benchmark random reads of small plain text ranges from a Schwaemm256-128
+// encrypted container, living in memory, where container's plain text length,
+// chunk length & read length are provided when setting up benchmark
+void
+schwaemm256_128_container_read(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t len = state.range(0);
+  const size_t chunk_len = state.range(1);
+  const size_t r_len = state.range(2);
+  const size_t size = container::sealed_size<R, C>(len, chunk_len);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(len));
+  uint8_t* blob = static_cast<uint8_t*>(malloc(size));
+  uint8_t* out = static_cast<uint8_t*>(malloc(r_len));
+  uint8_t key[C];
+  uint8_t nonce[container_reader::NONCE_LEN];
+
+  sparkle_utils::random_data(text, len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  container_seal(key, nonce, text, len, chunk_len, blob);
+
+  container_reader rd{ key };
+  rd.attach(blob, size);
+
+  std::mt19937_64 gen{ 0x5eed };
+  std::uniform_int_distribution<size_t> dis{ 0, len - r_len };
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    bool f = rd.read(dis(gen), r_len, out);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, r_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(r_len * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(blob);
+  free(out);
+}
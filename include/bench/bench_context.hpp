@@ -0,0 +1,82 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "context.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark incremental Schwaemm256-128 encryption on CPU, where plain text is
+// fed in equal sized pieces; plain text length & piece length are provided
+// when setting up benchmark
+void
+schwaemm256_128_context_update(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t piece_len = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> text(ct_len);
+  std::vector<uint8_t> enc(ct_len);
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+
+  sparkle_utils::random_data(text.data(), ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    aead_encryptor ctx{ key, nonce };
+
+    for (size_t off = 0; off < ct_len; off += piece_len) {
+      const size_t len = std::min(piece_len, ct_len - off);
+      ctx.update(text.data() + off, enc.data() + off, len);
+    }
+    ctx.finalize(tag);
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+}
+
+// Benchmark checkpointing of an in-flight Schwaemm256-128 encryption context
+// i.e. exporting it, sealed under a wrapping key & importing it back, on CPU
+void
+schwaemm256_128_context_checkpoint(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t wrap_key[aead_encryptor::WRAP_KEY_LEN];
+  uint8_t wrap_nonce[aead_encryptor::WRAP_NONCE_LEN];
+  uint8_t text[100];
+  uint8_t blob[aead_encryptor::EXPORT_LEN];
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  sparkle_utils::random_data(wrap_key, sizeof(wrap_key));
+  sparkle_utils::random_data(wrap_nonce, sizeof(wrap_nonce));
+  sparkle_utils::random_data(text, sizeof(text));
+
+  aead_encryptor ctx{ key, nonce };
+  ctx.update(text, text, sizeof(text));
+
+  for (auto _ : state) {
+    ctx.export_to(wrap_key, wrap_nonce, 0, blob);
+    bool f = ctx.import(wrap_key, key, blob);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(blob);
+    benchmark::ClobberMemory();
+  }
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#if defined __linux__
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#endif
+
+// Hardware counters reported along with each benchmark
+namespace bench_sparkle {
+
+// Reads time stamp counter, when available, otherwise returns 0
+static inline uint64_t
+tsc()
+{
+#if defined __x86_64__ || defined __i386__
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Counts CPU cycles, retired instructions, branch & last level cache misses of
+// calling thread ( user space only ), from construction to `report`, which
+// attaches them to benchmark state as user counters, averaged per iteration,
+// along with cycles/ byte.
+//
+// Benchmarks, which spread work over other threads ( say thread pools, engine
+// workers or event loops ), ask for all threads of the process instead, which
+// must already exist at construction time; threads spawned afterwards by them
+// are counted once they exit. Counts are then summed across threads, so
+// cycles/ byte is total CPU cost, not elapsed time ( unless it falls back to
+// time stamp counter, see below ). Untimed work inside benchmark loop is left
+// out, by wrapping it in `pause` and `resume`.
+//
+// Each event, which can't be opened ( say, non-Linux host, perf_event_paranoid
+// too strict or virtualised PMU ), is silently skipped; when CPU cycles aren't
+// countable, cycles/ byte is computed from time stamp counter ( x86 only ),
+// which ticks at reference frequency, instead.
+class counters
+{
+private:
+  // Hardware events, counted using perf_event_open(2), in order
+  enum event : size_t
+  {
+    cycles = 0,
+    instructions,
+    branch_misses,
+    cache_misses,
+    n_events
+  };
+
+  // one descriptor per counted thread, for each event
+  std::vector<int> fd[n_events];
+  uint64_t tsc0 = 0;
+  uint64_t tsc_paused = 0;
+
+#if defined __linux__
+  static inline int open(const uint64_t config, const int tid, const bool inh)
+  {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = inh;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+  }
+
+  // Returns ids of all threads of this process
+  static inline std::vector<int> threads()
+  {
+    std::vector<int> tids;
+
+    DIR* const dir = opendir("/proc/self/task");
+    if (dir == nullptr) {
+      return tids;
+    }
+    while (const dirent* const ent = readdir(dir)) {
+      if (ent->d_name[0] != '.') {
+        tids.push_back(std::atoi(ent->d_name));
+      }
+    }
+    closedir(dir);
+    return tids;
+  }
+
+  // Reads counter value, summed across threads, each scaled up when event was
+  // multiplexed with others, or returns -1, when it wasn't opened/ never
+  // scheduled on PMU
+  inline double read(const size_t e) const
+  {
+    double sum = -1.;
+    for (const int f : fd[e]) {
+      uint64_t v[3]; // value, time enabled, time running
+      if ((::read(f, v, sizeof(v)) != sizeof(v)) || (v[2] == 0)) {
+        continue;
+      }
+      sum = std::max(sum, 0.) +
+            static_cast<double>(v[0]) * (static_cast<double>(v[1]) / v[2]);
+    }
+    return sum;
+  }
+
+  // Issues same ioctl(2) request on all opened descriptors
+  inline void control(const unsigned long req) const
+  {
+    for (size_t e = 0; e < n_events; e++) {
+      for (const int f : fd[e]) {
+        ioctl(f, req, 0);
+      }
+    }
+  }
+#else
+  inline double read(const size_t) const { return -1.; }
+#endif
+
+public:
+  // Opens & starts counting all available hardware events, of calling thread
+  // or of all threads of the process
+  explicit counters(const bool all_threads = false)
+  {
+#if defined __linux__
+    constexpr uint64_t config[n_events]{ PERF_COUNT_HW_CPU_CYCLES,
+                                         PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_BRANCH_MISSES,
+                                         PERF_COUNT_HW_CACHE_MISSES };
+
+    const std::vector<int> tids =
+      all_threads ? threads() : std::vector<int>{ 0 };
+
+    for (size_t e = 0; e < n_events; e++) {
+      for (const int tid : tids) {
+        const int f = open(config[e], tid, all_threads);
+        if (f >= 0) {
+          fd[e].push_back(f);
+        }
+      }
+    }
+    control(PERF_EVENT_IOC_RESET);
+    control(PERF_EVENT_IOC_ENABLE);
+#else
+    (void)all_threads;
+#endif
+    tsc0 = tsc();
+  }
+
+  counters(const counters&) = delete;
+  counters& operator=(const counters&) = delete;
+
+  ~counters()
+  {
+#if defined __linux__
+    for (size_t e = 0; e < n_events; e++) {
+      for (const int f : fd[e]) {
+        close(f);
+      }
+    }
+#endif
+  }
+
+  // Stops counting, for untimed work, in between `state.PauseTiming()` and
+  // `state.ResumeTiming()`
+  void pause()
+  {
+#if defined __linux__
+    control(PERF_EVENT_IOC_DISABLE);
+#endif
+    tsc_paused = tsc();
+  }
+
+  // Resumes counting, stopped by `pause`
+  void resume()
+  {
+    tsc0 += tsc() - tsc_paused;
+#if defined __linux__
+    control(PERF_EVENT_IOC_ENABLE);
+#endif
+  }
+
+  // Stops counting & reports counters, where each benchmark iteration
+  // processes `bytes` -bytes, to benchmark state
+  void report(benchmark::State& state, const size_t bytes)
+  {
+    const uint64_t tsc1 = tsc();
+
+#if defined __linux__
+    control(PERF_EVENT_IOC_DISABLE);
+#endif
+
+    const double itr = static_cast<double>(state.iterations());
+    if (itr == 0) {
+      return;
+    }
+
+    double val[n_events];
+    for (size_t e = 0; e < n_events; e++) {
+      val[e] = read(e);
+    }
+
+    using benchmark::Counter;
+    constexpr auto avg = Counter::kAvgIterations;
+
+    double cyc = val[cycles];
+    if (cyc < 0 && tsc0 != tsc1) {
+      cyc = static_cast<double>(tsc1 - tsc0);
+      state.counters["tsc"] = Counter(cyc, avg);
+    } else if (cyc >= 0) {
+      state.counters["cycles"] = Counter(cyc, avg);
+    }
+
+    if (cyc >= 0 && bytes > 0) {
+      state.counters["cpb"] = cyc / (itr * static_cast<double>(bytes));
+    }
+    if (val[instructions] >= 0) {
+      state.counters["insns"] = Counter(val[instructions], avg);
+      if (val[cycles] > 0) {
+        state.counters["IPC"] = val[instructions] / val[cycles];
+      }
+    }
+    if (val[branch_misses] >= 0) {
+      state.counters["br_miss"] = Counter(val[branch_misses], avg);
+    }
+    if (val[cache_misses] >= 0) {
+      state.counters["llc_miss"] = Counter(val[cache_misses], avg);
+    }
+  }
+};
+
+} // namespace bench_sparkle
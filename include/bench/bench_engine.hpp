@@ -0,0 +1,109 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "engine.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark sealing of a batch of equal length Schwaemm256-128 messages, each
+// under its own key & nonce, submitted to crypto job engine, on CPU, where
+// plain text length of each message, # -of messages in batch & # -of worker
+// threads are provided when setting up benchmark
+void
+schwaemm256_128_engine_seal(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t n_msgs = state.range(1);
+  const size_t n_workers = state.range(2);
+
+  // acquire memory resources
+  std::vector<uint8_t> keys(n_msgs * C);
+  std::vector<uint8_t> nonces(n_msgs * R);
+  std::vector<uint8_t> text(n_msgs * ct_len);
+  std::vector<uint8_t> enc(n_msgs * ct_len);
+  std::vector<uint8_t> tags(n_msgs * C);
+  std::vector<engine::job> jobs(n_msgs);
+
+  sparkle_utils::random_data(keys.data(), keys.size());
+  sparkle_utils::random_data(nonces.data(), nonces.size());
+  sparkle_utils::random_data(text.data(), text.size());
+
+  for (size_t i = 0; i < n_msgs; i++) {
+    jobs[i] = engine::seal_job(keys.data() + i * C,
+                               nonces.data() + i * R,
+                               nullptr,
+                               0,
+                               text.data() + i * ct_len,
+                               enc.data() + i * ct_len,
+                               ct_len,
+                               tags.data() + i * C);
+  }
+
+  crypto_engine eng{ n_workers };
+
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    bool f = eng.submit(jobs.data(), n_msgs).get();
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, text.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(text.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_msgs * state.iterations()));
+}
+
+// Benchmark sealing of a batch of equal length Schwaemm256-128 messages, each
+// under its own key & nonce, one after another, on calling thread, where
+// plain text length of each message & # -of messages in batch are provided
+// when setting up benchmark; baseline for crypto job engine
+void
+schwaemm256_128_engine_seal_sync(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t n_msgs = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> keys(n_msgs * C);
+  std::vector<uint8_t> nonces(n_msgs * R);
+  std::vector<uint8_t> text(n_msgs * ct_len);
+  std::vector<uint8_t> enc(n_msgs * ct_len);
+  std::vector<uint8_t> tags(n_msgs * C);
+
+  sparkle_utils::random_data(keys.data(), keys.size());
+  sparkle_utils::random_data(nonces.data(), nonces.size());
+  sparkle_utils::random_data(text.data(), text.size());
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < n_msgs; i++) {
+      encrypt(keys.data() + i * C,
+              nonces.data() + i * R,
+              nullptr,
+              0,
+              text.data() + i * ct_len,
+              enc.data() + i * ct_len,
+              ct_len,
+              tags.data() + i * C);
+    }
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, text.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(text.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_msgs * state.iterations()));
+}
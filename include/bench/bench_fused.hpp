@@ -0,0 +1,137 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "fused.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark Schwaemm256-128 Authenticated Encryption, followed by Esch256 hash
+// of plain text, as two separate passes over the data, where plain text length
+// is provided when setting up benchmark
+void
+schwaemm256_128_encrypt_then_hash(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+  uint8_t digest[esch256::DIGEST_LEN];
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    encrypt(key, nonce, nullptr, 0, text, enc, ct_len, tag);
+    esch256::hash(text, ct_len, digest);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::DoNotOptimize(digest);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+}
+
+// Benchmark fused Schwaemm256-128 Authenticated Encryption & Esch256 hash of
+// plain text, as a single pass over the data, where plain text length is
+// provided when setting up benchmark
+void
+schwaemm256_128_encrypt_and_hash(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+  uint8_t digest[esch256::DIGEST_LEN];
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    encrypt_and_hash(key, nonce, nullptr, 0, text, enc, ct_len, tag, digest);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::DoNotOptimize(digest);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+}
+
+// Benchmark fused Schwaemm256-128 Verified Decryption & Esch256 hash of
+// decrypted text, as a single pass over the data, where cipher text length is
+// provided when setting up benchmark
+void
+schwaemm256_128_decrypt_and_hash(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+  uint8_t digest[esch256::DIGEST_LEN];
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  encrypt(key, nonce, nullptr, 0, text, enc, ct_len, tag);
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    bool f =
+      decrypt_and_hash(key, nonce, tag, nullptr, 0, enc, dec, ct_len, digest);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec);
+    benchmark::DoNotOptimize(digest);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+  free(dec);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "bench_counters.hpp"
 #include "esch.hpp"
 #include "utils.hpp"
 #include <benchmark/benchmark.h>
@@ -17,6 +18,7 @@ esch256_hash(benchmark::State& state)
   sparkle_utils::random_data(msg, mlen);
   std::memset(out, 0, dlen);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     esch256::hash(msg, mlen, out);
 
@@ -25,6 +27,7 @@ esch256_hash(benchmark::State& state)
     benchmark::DoNotOptimize(out);
     benchmark::ClobberMemory();
   }
+  ctr.report(state, mlen);
 
   state.SetBytesProcessed(static_cast<int64_t>(mlen * state.iterations()));
 
@@ -46,6 +49,7 @@ esch384_hash(benchmark::State& state)
   sparkle_utils::random_data(msg, mlen);
   std::memset(out, 0, dlen);
 
+  bench_sparkle::counters ctr;
   for (auto _ : state) {
     esch384::hash(msg, mlen, out);
 
@@ -54,6 +58,7 @@ esch384_hash(benchmark::State& state)
     benchmark::DoNotOptimize(out);
     benchmark::ClobberMemory();
   }
+  ctr.report(state, mlen);
 
   state.SetBytesProcessed(static_cast<int64_t>(mlen * state.iterations()));
 
@@ -0,0 +1,110 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "iov.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark scatter-gather Schwaemm256-128 verified decryption on CPU, where
+// cipher text, received as a chain of fragments, is decrypted into a single
+// application buffer; cipher text length & fragment length are provided when
+// setting up benchmark
+void
+schwaemm256_128_decryptv(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t frag_len = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> text(ct_len);
+  std::vector<uint8_t> enc(ct_len);
+  std::vector<uint8_t> dec(ct_len);
+  std::vector<struct iovec> encv;
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+
+  sparkle_utils::random_data(text.data(), ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  encrypt(key, nonce, nullptr, 0, text.data(), enc.data(), ct_len, tag);
+
+  for (size_t off = 0; off < ct_len; off += frag_len) {
+    const size_t len = std::min(frag_len, ct_len - off);
+    encv.push_back({ enc.data() + off, len });
+  }
+
+  const struct iovec decv[]{ { dec.data(), ct_len } };
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    bool f =
+      decryptv(key, nonce, tag, nullptr, 0, encv.data(), encv.size(), decv, 1);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+}
+
+// Benchmark Schwaemm256-128 verified decryption on CPU, where cipher text,
+// received as a chain of fragments, is first linearized into a contiguous
+// buffer; to be compared against scatter-gather decryption
+void
+schwaemm256_128_decrypt_linearized(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t frag_len = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> text(ct_len);
+  std::vector<uint8_t> enc(ct_len);
+  std::vector<uint8_t> lin(ct_len);
+  std::vector<uint8_t> dec(ct_len);
+  std::vector<struct iovec> encv;
+  uint8_t key[C];
+  uint8_t nonce[R];
+  uint8_t tag[C];
+
+  sparkle_utils::random_data(text.data(), ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  encrypt(key, nonce, nullptr, 0, text.data(), enc.data(), ct_len, tag);
+
+  for (size_t off = 0; off < ct_len; off += frag_len) {
+    const size_t len = std::min(frag_len, ct_len - off);
+    encv.push_back({ enc.data() + off, len });
+  }
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    size_t off = 0;
+    for (const auto& frag : encv) {
+      std::memcpy(lin.data() + off, frag.iov_base, frag.iov_len);
+      off += frag.iov_len;
+    }
+
+    bool f =
+      decrypt(key, nonce, tag, nullptr, 0, lin.data(), dec.data(), ct_len);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "bulk.hpp"
+#include "numa.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark multi-threaded, segmented Schwaemm256-128 Authenticated Encryption
+// on CPU, using NUMA aware thread pool, where input & output buffers are bound
+// to first NUMA node; buffer length, segment length & whether segments are
+// executed on workers of the node owning their pages ( = 0 ) or on workers of
+// next node ( = 1 ), are provided when setting up benchmark. Placement is
+// strict, so that idle workers of one node don't pick up segments of another.
+//
+// Note, on a single node machine, local & remote placements are same.
+void
+schwaemm256_128_numa_bulk_encrypt(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t seg_len = state.range(1);
+  const bool remote = state.range(2) != 0;
+  const size_t n_segs = bulk::segment_count(ct_len, seg_len);
+
+  numa::pool& pool = numa::default_pool();
+
+  const auto& ids = numa::nodes();
+  const int local = ids.front();
+  const int exec = remote ? ids[1 % ids.size()] : local;
+
+  // acquire memory resources, bound to first node
+  numa::buffer text(ct_len, local);
+  numa::buffer enc(ct_len, local);
+  std::vector<uint8_t> tags(n_segs * C);
+  std::vector<int> homes(n_segs, exec);
+  uint8_t key[C];
+  uint8_t nonce[R];
+
+  sparkle_utils::random_data(text.data(), ct_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+  std::memset(enc.data(), 0, ct_len);
+
+  const std::function<void(size_t)> seal = [&](const size_t i) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ct_len - off);
+
+    encrypt(key,
+            nonce,
+            nullptr,
+            0,
+            text.data() + off,
+            enc.data() + off,
+            len,
+            tags.data() + i * C);
+  };
+
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    pool.for_each(n_segs, homes.data(), seal, true);
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tags.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, ct_len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(ct_len * state.iterations()));
+  state.counters["threads"] = pool.concurrency();
+  state.counters["nodes"] = pool.node_count();
+}
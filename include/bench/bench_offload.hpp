@@ -0,0 +1,86 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "offload.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Benchmark sealing small Schwaemm256-128 messages, from many clients ( each
+// on its own thread, issuing one request at a time, as a worker process would
+// ), on local crypto offload daemon, where plain text byte length, # -of
+// clients & linger time ( in microseconds ) of daemon are provided when
+// setting up benchmark. Share of jobs executed on SIMD lanes is reported as
+// `laned`.
+void
+schwaemm256_128_offload_seal(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+  constexpr auto var = offload::variant::schwaemm256_128;
+  constexpr size_t per_round = 64ul; // # -of requests, per client, per round
+
+  const size_t ct_len = state.range(0);
+  const size_t n_clients = state.range(1);
+  const size_t linger_us = state.range(2);
+
+  const std::string path =
+    "/tmp/sparkle-offload-bench-" + std::to_string(getpid()) + ".sock";
+
+  offload::server srv{ path.c_str(), 1, linger_us };
+  std::thread loop([&] { srv.run(); });
+
+  std::vector<std::unique_ptr<offload::client>> clients;
+  for (size_t i = 0; i < n_clients; i++) {
+    clients.emplace_back(std::make_unique<offload::client>(path.c_str()));
+  }
+
+  // acquire memory resources
+  std::vector<uint8_t> key(C), nonce(R), text(ct_len);
+  std::vector<uint8_t> enc(n_clients * ct_len), tags(n_clients * C);
+
+  sparkle_utils::random_data(key.data(), key.size());
+  sparkle_utils::random_data(nonce.data(), nonce.size());
+  sparkle_utils::random_data(text.data(), text.size());
+
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    std::vector<std::thread> ts;
+    for (size_t i = 0; i < n_clients; i++) {
+      ts.emplace_back([&, i] {
+        for (size_t r = 0; r < per_round; r++) {
+          clients[i]->seal(var,
+                           key.data(),
+                           nonce.data(),
+                           nullptr,
+                           0,
+                           text.data(),
+                           enc.data() + i * ct_len,
+                           ct_len,
+                           tags.data() + i * C);
+        }
+      });
+    }
+
+    for (auto& t : ts) {
+      t.join();
+    }
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, n_clients * per_round * ct_len);
+
+  srv.stop();
+  loop.join();
+
+  const size_t n_msgs = n_clients * per_round;
+  state.SetBytesProcessed(
+    static_cast<int64_t>(n_msgs * ct_len * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_msgs * state.iterations()));
+
+  const uint64_t n = srv.executed();
+  state.counters["laned"] = (n > 0) ? static_cast<double>(srv.laned()) / n : 0.;
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "page.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark in-place Schwaemm256-128 page encryption on CPU, where a batch of
+// pages is sealed at once ( across SIMD lanes & threads ); page length & # -of
+// pages are provided when setting up benchmark
+void
+schwaemm256_128_page_seal_many(benchmark::State& state)
+{
+  using page_cipher = schwaemm256_128::page_cipher;
+
+  const size_t page_len = state.range(0);
+  const size_t n_pages = state.range(1);
+
+  // acquire memory resources
+  uint8_t* frames = static_cast<uint8_t*>(malloc(n_pages * page_len));
+  uint8_t** pages = static_cast<uint8_t**>(malloc(n_pages * sizeof(uint8_t*)));
+  uint64_t* page_nos = static_cast<uint64_t*>(malloc(n_pages * 8));
+  uint64_t* lsns = static_cast<uint64_t*>(malloc(n_pages * 8));
+
+  uint8_t key[page_cipher::KEY_LEN];
+  uint8_t salt[page_cipher::SALT_LEN];
+
+  sparkle_utils::random_data(frames, n_pages * page_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(salt, sizeof(salt));
+
+  for (size_t i = 0; i < n_pages; i++) {
+    pages[i] = frames + i * page_len;
+    page_nos[i] = i;
+    lsns[i] = i;
+  }
+
+  const page_cipher cipher{ key, salt, page_len };
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    cipher.seal_many(pages, page_nos, lsns, n_pages);
+
+    benchmark::DoNotOptimize(frames);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, n_pages * cipher.payload_size());
+
+  const size_t p_len = cipher.payload_size();
+  state.SetBytesProcessed(
+    static_cast<int64_t>(n_pages * p_len * state.iterations()));
+  state.counters["lanes"] = multilane::LANES;
+  state.counters["threads"] = parallel::default_pool().concurrency();
+
+  // deallocate all resources
+  free(frames);
+  free(pages);
+  free(page_nos);
+  free(lsns);
+}
+
+// Benchmark in-place Schwaemm256-128 page decryption on CPU, where a batch of
+// pages is verified & decrypted at once ( across SIMD lanes & threads ); page
+// length & # -of pages are provided when setting up benchmark
+void
+schwaemm256_128_page_open_many(benchmark::State& state)
+{
+  using page_cipher = schwaemm256_128::page_cipher;
+
+  const size_t page_len = state.range(0);
+  const size_t n_pages = state.range(1);
+
+  // acquire memory resources
+  uint8_t* frames = static_cast<uint8_t*>(malloc(n_pages * page_len));
+  uint8_t* sealed = static_cast<uint8_t*>(malloc(n_pages * page_len));
+  uint8_t** pages = static_cast<uint8_t**>(malloc(n_pages * sizeof(uint8_t*)));
+  uint64_t* page_nos = static_cast<uint64_t*>(malloc(n_pages * 8));
+  uint64_t* lsns = static_cast<uint64_t*>(malloc(n_pages * 8));
+  bool* flags = static_cast<bool*>(malloc(n_pages * sizeof(bool)));
+
+  uint8_t key[page_cipher::KEY_LEN];
+  uint8_t salt[page_cipher::SALT_LEN];
+
+  sparkle_utils::random_data(frames, n_pages * page_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(salt, sizeof(salt));
+
+  for (size_t i = 0; i < n_pages; i++) {
+    pages[i] = frames + i * page_len;
+    page_nos[i] = i;
+    lsns[i] = i;
+  }
+
+  const page_cipher cipher{ key, salt, page_len };
+  cipher.seal_many(pages, page_nos, lsns, n_pages);
+  memcpy(sealed, frames, n_pages * page_len);
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    // pages are decrypted in place, so restore sealed pages ( untimed )
+    state.PauseTiming();
+    ctr.pause();
+    memcpy(frames, sealed, n_pages * page_len);
+    ctr.resume();
+    state.ResumeTiming();
+
+    bool f = cipher.open_many(pages, page_nos, flags, n_pages);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(frames);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, n_pages * cipher.payload_size());
+
+  const size_t p_len = cipher.payload_size();
+  state.SetBytesProcessed(
+    static_cast<int64_t>(n_pages * p_len * state.iterations()));
+  state.counters["lanes"] = multilane::LANES;
+  state.counters["threads"] = parallel::default_pool().concurrency();
+
+  // deallocate all resources
+  free(frames);
+  free(sealed);
+  free(pages);
+  free(page_nos);
+  free(lsns);
+  free(flags);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "bench_counters.hpp"
 #include "sparkle.hpp"
 #include "utils.hpp"
 #include <benchmark/benchmark.h>
@@ -14,10 +15,12 @@ sparkle(benchmark::State& state)
   uint32_t st[2 * nb];
   sparkle_utils::random_data(st, 2 * nb);
 
+  counters ctr;
   for (auto _ : state) {
     sparkle::sparkle<nb, ns>(st);
     benchmark::DoNotOptimize(st);
   }
+  ctr.report(state, sizeof(st));
 
   const size_t total_bytes = sizeof(st) * state.iterations();
   state.SetBytesProcessed(total_bytes);
@@ -0,0 +1,59 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "pipeline.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <vector>
+
+// Benchmark pipelined sealing of a file, using Schwaemm256-128, where file
+// byte length & whether io_uring ( = 1 ) or blocking pread/ pwrite ( = 0 ) is
+// used, are provided when setting up benchmark
+//
+// Note, files live in /tmp & are mostly served from page cache, so this
+// measures how well file I/O overlaps with crypto work, rather than disk
+// bandwidth.
+void
+schwaemm256_128_pipeline_seal_file(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t len = state.range(0);
+  const bool uring = state.range(1) != 0;
+
+  const char* const in = "/tmp/sparkle_bench_pipeline.in";
+  const char* const out = "/tmp/sparkle_bench_pipeline.out";
+
+  std::vector<uint8_t> text(len);
+  uint8_t key[C];
+  uint8_t nonce[R - stream::NONCE_SUFFIX_LEN];
+
+  sparkle_utils::random_data(text.data(), len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  FILE* const fp = std::fopen(in, "wb");
+  std::fwrite(text.data(), 1, len, fp);
+  std::fclose(fp);
+
+  pipeline::options opt;
+  opt.uring = uring;
+
+  // workers of thread pool must exist, before their counters are opened
+  parallel::default_pool();
+  bench_sparkle::counters ctr{ true };
+
+  for (auto _ : state) {
+    bool f = pipeline_seal_file(in, out, key, nonce, opt);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, len);
+
+  state.SetBytesProcessed(static_cast<int64_t>(len * state.iterations()));
+
+  std::remove(in);
+  std::remove(out);
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "record.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Benchmark sealing of a batch of equal length Schwaemm256-128 records, into a
+// single packet, on CPU, where plain text length of each record & # -of
+// records in batch are provided when setting up benchmark
+void
+schwaemm256_128_record_seal_many(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t rec_len = state.range(0);
+  const size_t n_recs = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> text(n_recs * rec_len);
+  std::vector<uint8_t> out(n_recs * (rec_len + record_sealer::OVERHEAD));
+  std::vector<const uint8_t*> txts(n_recs);
+  std::vector<size_t> lens(n_recs, rec_len);
+  std::vector<uint8_t> types(n_recs, 23);
+  uint8_t key[record_sealer::KEY_LEN];
+  uint8_t iv[record_sealer::IV_LEN];
+
+  sparkle_utils::random_data(text.data(), text.size());
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(iv, sizeof(iv));
+
+  for (size_t i = 0; i < n_recs; i++) {
+    txts[i] = text.data() + i * rec_len;
+  }
+
+  record_sealer tx{ key, iv };
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    size_t len = tx.seal_many(
+      types.data(), txts.data(), lens.data(), n_recs, out.data());
+
+    benchmark::DoNotOptimize(len);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, text.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(text.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_recs * state.iterations()));
+}
+
+// Benchmark opening of a packet, holding a batch of equal length
+// Schwaemm256-128 records, on CPU, where plain text length of each record & #
+// -of records in batch are provided when setting up benchmark
+//
+// Note, same packet is sealed ( with increasing sequence numbers ) & then
+// opened, in each iteration, though only opening is timed.
+void
+schwaemm256_128_record_open_many(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t rec_len = state.range(0);
+  const size_t n_recs = state.range(1);
+
+  // acquire memory resources
+  std::vector<uint8_t> text(n_recs * rec_len);
+  std::vector<uint8_t> out(n_recs * (rec_len + record_sealer::OVERHEAD));
+  std::vector<const uint8_t*> txts(n_recs);
+  std::vector<size_t> lens(n_recs, rec_len);
+  std::vector<uint8_t> types(n_recs, 23);
+  std::vector<record::view> recs(n_recs);
+  uint8_t key[record_sealer::KEY_LEN];
+  uint8_t iv[record_sealer::IV_LEN];
+
+  sparkle_utils::random_data(text.data(), text.size());
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(iv, sizeof(iv));
+
+  for (size_t i = 0; i < n_recs; i++) {
+    txts[i] = text.data() + i * rec_len;
+  }
+
+  record_sealer tx{ key, iv };
+  record_opener rx{ key, iv };
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    ctr.pause();
+    const size_t len = tx.seal_many(
+      types.data(), txts.data(), lens.data(), n_recs, out.data());
+    ctr.resume();
+    state.ResumeTiming();
+
+    size_t consumed = 0;
+    size_t n = rx.open_many(out.data(), len, recs.data(), n_recs, consumed);
+
+    benchmark::DoNotOptimize(n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, text.size());
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(text.size() * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_recs * state.iterations()));
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "session.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// Benchmark sealing of next message in a Schwaemm256-128 duplex session on
+// CPU, where plain text length & associated data length are provided when
+// setting up benchmark
+void
+schwaemm256_128_session_seal(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  const size_t ct_len = state.range(0);
+  const size_t dt_len = state.range(1);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* data = static_cast<uint8_t*>(malloc(dt_len));
+  uint8_t key[session_cipher::KEY_LEN];
+  uint8_t nonce[session_cipher::NONCE_LEN];
+  uint8_t tag[session_cipher::TAG_LEN];
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(data, dt_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  session_cipher sess{ key, nonce };
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    bool f = sess.seal(data, dt_len, text, enc, ct_len, tag);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, dt_len + ct_len);
+
+  const size_t per_itr_data = dt_len + ct_len;
+  state.SetBytesProcessed(
+    static_cast<int64_t>(per_itr_data * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+  free(data);
+}
+
+// Benchmark opening of next message in a Schwaemm256-128 duplex session on
+// CPU, where cipher text length & associated data length are provided when
+// setting up benchmark
+//
+// Note, a fixed sequence of messages is sealed upfront, which is opened over
+// and over again, in a fresh session, each time it's exhausted.
+void
+schwaemm256_128_session_open(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  constexpr size_t n_msgs = 1024ul;
+
+  const size_t ct_len = state.range(0);
+  const size_t dt_len = state.range(1);
+
+  // acquire memory resources
+  uint8_t* text = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(malloc(n_msgs * ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(malloc(ct_len));
+  uint8_t* data = static_cast<uint8_t*>(malloc(dt_len));
+  uint8_t* tags = static_cast<uint8_t*>(malloc(n_msgs * C));
+  uint8_t key[session_cipher::KEY_LEN];
+  uint8_t nonce[session_cipher::NONCE_LEN];
+
+  sparkle_utils::random_data(text, ct_len);
+  sparkle_utils::random_data(data, dt_len);
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  {
+    session_cipher sealer{ key, nonce };
+    for (size_t i = 0; i < n_msgs; i++) {
+      sealer.seal(data, dt_len, text, enc + i * ct_len, ct_len, tags + i * C);
+    }
+  }
+
+  auto opener = std::make_unique<session_cipher>(key, nonce);
+  size_t idx = 0;
+
+  bench_sparkle::counters ctr;
+
+  for (auto _ : state) {
+    if (idx == n_msgs) {
+      state.PauseTiming();
+      ctr.pause();
+      opener = std::make_unique<session_cipher>(key, nonce);
+      idx = 0;
+      ctr.resume();
+      state.ResumeTiming();
+    }
+
+    const uint8_t* msg = enc + idx * ct_len;
+    const uint8_t* tag = tags + idx * C;
+
+    bool f = opener->open(data, dt_len, msg, dec, ct_len, tag);
+    idx++;
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec);
+    benchmark::ClobberMemory();
+  }
+
+  ctr.report(state, dt_len + ct_len);
+
+  const size_t per_itr_data = dt_len + ct_len;
+  state.SetBytesProcessed(
+    static_cast<int64_t>(per_itr_data * state.iterations()));
+
+  // deallocate all resources
+  free(text);
+  free(enc);
+  free(dec);
+  free(data);
+  free(tags);
+}
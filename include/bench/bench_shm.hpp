@@ -0,0 +1,100 @@
+#pragma once
+#include "shm.hpp"
+#include "utils.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+
+// Benchmark sealing a message in place, in a slot of encrypted shared memory
+// ring, followed by opening it in place, on same thread, using Schwaemm256-128,
+// where message byte length is provided when setting up benchmark
+void
+schwaemm256_128_shm_roundtrip(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  constexpr uint32_t slots = 1024u;
+  const size_t msg_len = state.range(0);
+  const uint32_t cap = static_cast<uint32_t>(msg_len);
+
+  uint8_t key[C];
+  std::vector<uint8_t> msg(msg_len);
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(msg.data(), msg.size());
+
+  shm::region reg = shm::region::create(shm::region_size(slots, cap, C));
+  shm_channel::format(reg.data(), reg.size(), slots, cap);
+  shm_channel ch{ reg.data(), reg.size(), key };
+
+  for (auto _ : state) {
+    shm::ticket t;
+    bool f0 = ch.reserve(msg_len, t);
+    std::memcpy(t.buf, msg.data(), msg_len);
+    ch.commit(t);
+
+    size_t len = 0;
+    const uint8_t* m = ch.peek(len);
+    benchmark::DoNotOptimize(f0);
+    benchmark::DoNotOptimize(m);
+    ch.release();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(msg_len * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Benchmark streaming messages through encrypted shared memory ring, using
+// Schwaemm256-128, from a producer thread to consumer ( i.e. benchmark )
+// thread, where message byte length is provided when setting up benchmark
+//
+// Note, both ends of ring would usually live in different processes, which
+// doesn't change how they share memory.
+void
+schwaemm256_128_shm_pair(benchmark::State& state)
+{
+  using namespace schwaemm256_128;
+
+  constexpr uint32_t slots = 1024u;
+  const size_t msg_len = state.range(0);
+  const uint32_t cap = static_cast<uint32_t>(msg_len);
+
+  uint8_t key[C];
+  std::vector<uint8_t> msg(msg_len);
+
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(msg.data(), msg.size());
+
+  shm::region reg = shm::region::create(shm::region_size(slots, cap, C));
+  shm_channel::format(reg.data(), reg.size(), slots, cap);
+
+  std::atomic<bool> stop{ false };
+  std::thread producer([&] {
+    shm_channel ch{ reg.data(), reg.size(), key };
+    while (!stop.load(std::memory_order_relaxed)) {
+      if (!ch.push(msg.data(), msg_len)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  shm_channel ch{ reg.data(), reg.size(), key };
+
+  for (auto _ : state) {
+    size_t len = 0;
+    const uint8_t* m = nullptr;
+    while ((m = ch.peek(len)) == nullptr) {
+      std::this_thread::yield();
+    }
+
+    benchmark::DoNotOptimize(m);
+    ch.release();
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  producer.join();
+
+  state.SetBytesProcessed(static_cast<int64_t>(msg_len * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
@@ -1,5 +1,24 @@
 #pragma once
 
 #include "bench_aead.hpp"
+#include "bench_async.hpp"
+#include "bench_batch.hpp"
+#include "bench_bulk.hpp"
+#include "bench_cold.hpp"
+#include "bench_component.hpp"
+#include "bench_container.hpp"
+#include "bench_context.hpp"
+#include "bench_counters.hpp"
+#include "bench_engine.hpp"
+#include "bench_fused.hpp"
 #include "bench_hash.hpp"
+#include "bench_iov.hpp"
+#include "bench_numa.hpp"
+#include "bench_offload.hpp"
+#include "bench_page.hpp"
 #include "bench_permutation.hpp"
+#include "bench_pipeline.hpp"
+#include "bench_record.hpp"
+#include "bench_session.hpp"
+#include "bench_shm.hpp"
+#include "bench_sweep.hpp"
@@ -0,0 +1,138 @@
+#pragma once
+#include "bench_counters.hpp"
+#include "esch.hpp"
+#include "schwaemm.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <vector>
+
+// Benchmarks over realistic mixes of message lengths
+namespace bench_sparkle {
+
+// Simple IMIX i.e. 7:4:1 mix of 64, 576 & 1500 -bytes packets, interleaved
+// so that consecutive packets don't always have same length
+constexpr size_t IMIX[]{ 64, 576, 64, 64, 576, 64, 1500, 64, 576, 64, 64, 576 };
+constexpr size_t IMIX_COUNT = sizeof(IMIX) / sizeof(IMIX[0]);
+constexpr size_t IMIX_BYTES = 7 * 64 + 4 * 576 + 1500;
+
+// Benchmark Esch{256, 384} hashing of one round of IMIX packets, per iteration
+template<const size_t dlen,
+         void (*hash)(const uint8_t* const __restrict,
+                      const size_t,
+                      uint8_t* const __restrict)>
+void
+esch_imix(benchmark::State& state)
+{
+  std::vector<uint8_t> pkts(IMIX_BYTES);
+  uint8_t dig[dlen];
+
+  sparkle_utils::random_data(pkts.data(), pkts.size());
+
+  counters ctr;
+  for (auto _ : state) {
+    size_t off = 0;
+    for (size_t i = 0; i < IMIX_COUNT; i++) {
+      hash(pkts.data() + off, IMIX[i], dig);
+      off += IMIX[i];
+
+      benchmark::DoNotOptimize(dig);
+      benchmark::ClobberMemory();
+    }
+  }
+  ctr.report(state, IMIX_BYTES);
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(IMIX_BYTES * state.iterations()));
+  state.SetItemsProcessed(
+    static_cast<int64_t>(IMIX_COUNT * state.iterations()));
+}
+
+// Benchmark Schwaemm sealing/ opening of one round of IMIX packets, each with
+// N (>=0) -bytes associated data, per iteration | N is provided when setting
+// up benchmark; see aead::encrypt for template parameters
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const bool open>
+void
+schwaemm_imix(benchmark::State& state)
+{
+  const size_t dt_len = state.range(0);
+
+  std::vector<uint8_t> text(IMIX_BYTES), enc(IMIX_BYTES), dec(IMIX_BYTES);
+  std::vector<uint8_t> data(dt_len), tags(IMIX_COUNT * C);
+  uint8_t key[C], nonce[R];
+
+  sparkle_utils::random_data(text.data(), text.size());
+  sparkle_utils::random_data(data.data(), data.size());
+  sparkle_utils::random_data(key, sizeof(key));
+  sparkle_utils::random_data(nonce, sizeof(nonce));
+
+  size_t off = 0;
+  for (size_t i = 0; i < IMIX_COUNT; i++) {
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(key,
+                                                  nonce,
+                                                  data.data(),
+                                                  dt_len,
+                                                  text.data() + off,
+                                                  enc.data() + off,
+                                                  IMIX[i],
+                                                  tags.data() + i * C);
+    off += IMIX[i];
+  }
+
+  counters ctr;
+  for (auto _ : state) {
+    off = 0;
+    for (size_t i = 0; i < IMIX_COUNT; i++) {
+      if constexpr (open) {
+        bool flg =
+          aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(key,
+                                                        nonce,
+                                                        tags.data() + i * C,
+                                                        data.data(),
+                                                        dt_len,
+                                                        enc.data() + off,
+                                                        dec.data() + off,
+                                                        IMIX[i]);
+
+        benchmark::DoNotOptimize(flg);
+        assert(flg);
+      } else {
+        aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(key,
+                                                      nonce,
+                                                      data.data(),
+                                                      dt_len,
+                                                      text.data() + off,
+                                                      enc.data() + off,
+                                                      IMIX[i],
+                                                      tags.data() + i * C);
+      }
+      off += IMIX[i];
+
+      benchmark::ClobberMemory();
+    }
+  }
+
+  const size_t per_itr_data = IMIX_BYTES + IMIX_COUNT * dt_len;
+  ctr.report(state, per_itr_data);
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(per_itr_data * state.iterations()));
+  state.SetItemsProcessed(
+    static_cast<int64_t>(IMIX_COUNT * state.iterations()));
+}
+
+} // namespace bench_sparkle
+
+// Template arguments of Schwaemm variant, living in namespace `ns`, for
+// registering templated benchmarks
+#define SCHWAEMM_BENCH_VARIANT(ns)                                             \
+  ns::R, ns::C, ns::A0, ns::A1, ns::M0, ns::M1, ns::BR, ns::S, ns::B
@@ -0,0 +1,467 @@
+#pragma once
+#include "batch.hpp"
+#include "engine.hpp"
+#include "esch.hpp"
+#include "schwaemm.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-threaded load generator, which runs Esch hash & Schwaemm AEAD
+// workloads on N threads, each with its own buffers, either back-to-back (
+// closed loop ) or at a target request rate ( open loop ), recording latency
+// of each operation; see bench/load.cpp
+namespace bench_load {
+
+using clk = std::chrono::steady_clock;
+
+// Log-linear histogram of latencies ( in nanoseconds ), with 32 sub-buckets
+// per power of two, so that any recorded value is off by at most ~3%, from
+// its bucket's upper bound, which is what percentiles report
+class histogram
+{
+public:
+  static constexpr size_t SUB_BITS = 5;
+  static constexpr size_t SUB = 1ul << SUB_BITS;
+  static constexpr size_t N_BUCKETS = (64 - SUB_BITS + 1) * SUB;
+
+  void record(const uint64_t ns)
+  {
+    cnt[index(ns)]++;
+    n++;
+    sum += ns;
+    hi = std::max(hi, ns);
+  }
+
+  void merge(const histogram& h)
+  {
+    for (size_t i = 0; i < N_BUCKETS; i++) {
+      cnt[i] += h.cnt[i];
+    }
+    n += h.n;
+    sum += h.sum;
+    hi = std::max(hi, h.hi);
+  }
+
+  uint64_t count() const { return n; }
+  uint64_t max() const { return hi; }
+  double mean() const { return n > 0 ? static_cast<double>(sum) / n : 0.; }
+
+  // Smallest latency, such that at least p ∈ [0, 1] fraction of recorded ones
+  // are not larger than it
+  uint64_t percentile(const double p) const
+  {
+    if (n == 0) {
+      return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::max(p * n, 1.));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < N_BUCKETS; i++) {
+      seen += cnt[i];
+      if (seen >= rank) {
+        return std::min(upper(i), hi);
+      }
+    }
+    return hi;
+  }
+
+private:
+  std::array<uint64_t, N_BUCKETS> cnt{};
+  uint64_t n = 0;
+  uint64_t sum = 0;
+  uint64_t hi = 0;
+
+  static size_t index(const uint64_t v)
+  {
+    if (v < SUB) {
+      return v;
+    }
+
+    const size_t shift = std::bit_width(v) - 1 - SUB_BITS;
+    return (shift + 1) * SUB + static_cast<size_t>((v >> shift) - SUB);
+  }
+
+  static uint64_t upper(const size_t i)
+  {
+    if (i < SUB) {
+      return i;
+    }
+
+    const size_t shift = i / SUB - 1;
+    const uint64_t m = i % SUB + SUB;
+    return ((m + 1) << shift) - 1;
+  }
+};
+
+// One operation of a workload, bound to buffers owned by a single thread,
+// returning false, when it fails ( say, verification of decrypted text )
+struct workload
+{
+  std::function<bool()> op;
+  size_t bytes = 0; // # -of bytes processed by one operation
+};
+
+// Buffers of a thread, running a workload
+struct buffers
+{
+  std::vector<uint8_t> key, nonce, data, txt, enc, dec, tag;
+
+  buffers(const size_t c, const size_t r, const size_t d_len, const size_t len)
+    : key(c)
+    , nonce(r)
+    , data(d_len)
+    , txt(len)
+    , enc(len)
+    , dec(len)
+    , tag(c)
+  {
+    sparkle_utils::random_data(key.data(), key.size());
+    sparkle_utils::random_data(nonce.data(), nonce.size());
+    sparkle_utils::random_data(data.data(), data.size());
+    sparkle_utils::random_data(txt.data(), txt.size());
+  }
+};
+
+// Seals `len` -bytes plain text, with `d_len` -bytes associated data, using
+// Schwaemm AEAD; see aead::encrypt for template parameters
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline workload
+seal(const size_t len, const size_t d_len)
+{
+  auto b = std::make_shared<buffers>(C, R, d_len, len);
+
+  auto op = [b, len, d_len] {
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(b->key.data(),
+                                                  b->nonce.data(),
+                                                  b->data.data(),
+                                                  d_len,
+                                                  b->txt.data(),
+                                                  b->enc.data(),
+                                                  len,
+                                                  b->tag.data());
+    return true;
+  };
+  return { op, len + d_len };
+}
+
+// Opens `len` -bytes cipher text, with `d_len` -bytes associated data, using
+// Schwaemm AEAD; see aead::decrypt for template parameters
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline workload
+open(const size_t len, const size_t d_len)
+{
+  auto b = std::make_shared<buffers>(C, R, d_len, len);
+  aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(b->key.data(),
+                                                b->nonce.data(),
+                                                b->data.data(),
+                                                d_len,
+                                                b->txt.data(),
+                                                b->enc.data(),
+                                                len,
+                                                b->tag.data());
+
+  auto op = [b, len, d_len] {
+    return aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(b->key.data(),
+                                                         b->nonce.data(),
+                                                         b->tag.data(),
+                                                         b->data.data(),
+                                                         d_len,
+                                                         b->enc.data(),
+                                                         b->dec.data(),
+                                                         len);
+  };
+  return { op, len + d_len };
+}
+
+// Computes Esch{256, 384} digest of `len` -bytes message
+template<const size_t dlen,
+         void (*hash)(const uint8_t* const __restrict,
+                      const size_t,
+                      uint8_t* const __restrict)>
+static inline workload
+digest(const size_t len)
+{
+  auto b = std::make_shared<buffers>(dlen, 0, 0, len);
+
+  auto op = [b, len] {
+    hash(b->txt.data(), len, b->tag.data());
+    return true;
+  };
+  return { op, len };
+}
+
+// # -of messages, hashed in a single call, by batched workload
+constexpr size_t BATCH = 16;
+
+// Computes Esch256 digests of BATCH -many `len` -bytes messages, in a single
+// call, sharing default thread pool with all other threads; see batch.hpp
+static inline workload
+batch_digest(const size_t len)
+{
+  struct state
+  {
+    std::vector<uint8_t> msgs, digs;
+    std::vector<const uint8_t*> ins;
+    std::vector<size_t> lens;
+  };
+
+  auto b = std::make_shared<state>();
+  b->msgs.resize(BATCH * len);
+  b->digs.resize(BATCH * esch256::DIGEST_LEN);
+  b->lens.assign(BATCH, len);
+  for (size_t i = 0; i < BATCH; i++) {
+    b->ins.push_back(b->msgs.data() + i * len);
+  }
+  sparkle_utils::random_data(b->msgs.data(), b->msgs.size());
+
+  auto op = [b] {
+    esch256::batch_hash(b->ins.data(), b->lens.data(), BATCH, b->digs.data());
+    return true;
+  };
+  return { op, BATCH * len };
+}
+
+// Seals `len` -bytes plain text, with `d_len` -bytes associated data, using
+// Schwaemm256-128 AEAD, on crypto job engine, shared with all other threads,
+// waiting for completion; see engine.hpp
+static inline workload
+engine_seal(schwaemm256_128::crypto_engine& eng,
+            const size_t len,
+            const size_t d_len)
+{
+  using namespace schwaemm256_128;
+
+  auto b = std::make_shared<buffers>(C, R, d_len, len);
+  const engine::job j = engine::seal_job(b->key.data(),
+                                         b->nonce.data(),
+                                         b->data.data(),
+                                         d_len,
+                                         b->txt.data(),
+                                         b->enc.data(),
+                                         len,
+                                         b->tag.data());
+
+  auto op = [b, j, &eng] { return eng.submit(j).get(); };
+  return { op, len + d_len };
+}
+
+// Template arguments of Schwaemm variant, living in namespace `ns`
+#define SCHWAEMM_VARIANT(ns)                                                   \
+  ns::R, ns::C, ns::A0, ns::A1, ns::M0, ns::M1, ns::BR, ns::S, ns::B
+
+// Names of all workloads
+static const std::vector<std::string> NAMES{
+  "esch256",
+  "esch384",
+  "schwaemm256_128-seal",
+  "schwaemm256_128-open",
+  "schwaemm192_192-seal",
+  "schwaemm192_192-open",
+  "schwaemm128_128-seal",
+  "schwaemm128_128-open",
+  "schwaemm256_256-seal",
+  "schwaemm256_256-open",
+  "esch256-batch",
+  "schwaemm256_128-engine"
+};
+
+// Makes named workload, processing `len` -bytes message/ text, along with
+// `d_len` -bytes associated data ( AEAD only ), where crypto job engine is only
+// used by engine workload. Returns workload without operation, when name is
+// unknown.
+static inline workload
+make(const std::string& name,
+     const size_t len,
+     const size_t d_len,
+     schwaemm256_128::crypto_engine* const eng)
+{
+  if (name == "esch256") {
+    return digest<esch256::DIGEST_LEN, esch256::hash>(len);
+  } else if (name == "esch384") {
+    return digest<esch384::DIGEST_LEN, esch384::hash>(len);
+  } else if (name == "schwaemm256_128-seal") {
+    return seal<SCHWAEMM_VARIANT(schwaemm256_128)>(len, d_len);
+  } else if (name == "schwaemm256_128-open") {
+    return open<SCHWAEMM_VARIANT(schwaemm256_128)>(len, d_len);
+  } else if (name == "schwaemm192_192-seal") {
+    return seal<SCHWAEMM_VARIANT(schwaemm192_192)>(len, d_len);
+  } else if (name == "schwaemm192_192-open") {
+    return open<SCHWAEMM_VARIANT(schwaemm192_192)>(len, d_len);
+  } else if (name == "schwaemm128_128-seal") {
+    return seal<SCHWAEMM_VARIANT(schwaemm128_128)>(len, d_len);
+  } else if (name == "schwaemm128_128-open") {
+    return open<SCHWAEMM_VARIANT(schwaemm128_128)>(len, d_len);
+  } else if (name == "schwaemm256_256-seal") {
+    return seal<SCHWAEMM_VARIANT(schwaemm256_256)>(len, d_len);
+  } else if (name == "schwaemm256_256-open") {
+    return open<SCHWAEMM_VARIANT(schwaemm256_256)>(len, d_len);
+  } else if (name == "esch256-batch") {
+    return batch_digest(len);
+  } else if ((name == "schwaemm256_128-engine") && (eng != nullptr)) {
+    return engine_seal(*eng, len, d_len);
+  }
+  return {};
+}
+
+#undef SCHWAEMM_VARIANT
+
+// Load generation parameters
+struct config
+{
+  std::string name = "esch256"; // workload
+  size_t threads = 1;           // # -of threads, generating load
+  size_t len = 64;              // message/ text byte length
+  size_t d_len = 0;             // associated data byte length
+  double seconds = 1.;          // duration of run
+  double rate = 0.;             // total ops/ second, 0 for closed loop
+};
+
+// Outcome of a run
+struct result
+{
+  uint64_t ops = 0;      // # -of completed operations
+  uint64_t failed = 0;   // # -of operations, which returned false
+  size_t bytes = 0;      // # -of bytes processed by one operation
+  double seconds = 0.;   // wall clock time, load was generated for
+  histogram latency;     // of all operations, on all threads
+};
+
+// Runs workload on `cfg.threads` threads, each with its own buffers, for
+// `cfg.seconds`, where each thread either issues operations back-to-back (
+// closed loop ) or, when `cfg.rate` is positive, at fixed intervals, such that
+// all threads together issue `cfg.rate` operations per second ( open loop ).
+//
+// In open loop, latency of an operation is measured from when it was scheduled
+// to be issued, not from when it actually got issued, so that time spent
+// waiting behind earlier, slower operations is accounted for ( i.e. no
+// coordinated omission ).
+static inline result
+run(const config& cfg)
+{
+  const size_t n = std::max<size_t>(cfg.threads, 1);
+
+  std::unique_ptr<schwaemm256_128::crypto_engine> eng;
+  if (cfg.name == "schwaemm256_128-engine") {
+    eng = std::make_unique<schwaemm256_128::crypto_engine>();
+  }
+
+  std::vector<workload> ws;
+  for (size_t i = 0; i < n; i++) {
+    ws.push_back(make(cfg.name, cfg.len, cfg.d_len, eng.get()));
+    if (!ws.back().op) {
+      return {};
+    }
+  }
+
+  std::vector<histogram> hs(n);
+  std::vector<uint64_t> fails(n, 0);
+  std::vector<clk::time_point> ends(n);
+  std::atomic<size_t> ready{ 0 };
+  std::atomic<bool> go{ false };
+  clk::time_point beg;
+
+  const auto dur = std::chrono::duration_cast<clk::duration>(
+    std::chrono::duration<double>(cfg.seconds));
+  const auto gap = std::chrono::duration_cast<clk::duration>(
+    std::chrono::duration<double>(cfg.rate > 0 ? n / cfg.rate : 0.));
+
+  auto body = [&](const size_t t) {
+    auto& op = ws[t].op;
+    histogram h;
+    uint64_t failed = 0;
+
+    ready.fetch_add(1, std::memory_order_release);
+    while (!go.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+
+    const auto end = beg + dur;
+
+    if (cfg.rate <= 0) {
+      auto t0 = clk::now();
+      while (t0 < end) {
+        failed += !op();
+        const auto t1 = clk::now();
+        h.record(static_cast<uint64_t>((t1 - t0).count()));
+        t0 = t1;
+      }
+      hs[t] = h;
+      fails[t] = failed;
+      ends[t] = t0;
+      return;
+    }
+
+    // stagger threads, so that they don't issue operations in lock step
+    auto next = beg + gap * t / n;
+    while (next < end) {
+      auto now = clk::now();
+      if (next - now > std::chrono::microseconds(100)) {
+        std::this_thread::sleep_until(next - std::chrono::microseconds(50));
+      }
+      while ((now = clk::now()) < next) {
+      }
+
+      failed += !op();
+      h.record(static_cast<uint64_t>((clk::now() - next).count()));
+      next += gap;
+    }
+    hs[t] = h;
+    fails[t] = failed;
+    ends[t] = std::max(clk::now(), end);
+  };
+
+  std::vector<std::thread> ths;
+  for (size_t t = 1; t < n; t++) {
+    ths.emplace_back(body, t);
+  }
+
+  while (ready.load(std::memory_order_acquire) < n - 1) {
+    std::this_thread::yield();
+  }
+  beg = clk::now();
+  go.store(true, std::memory_order_release);
+
+  body(0);
+  for (auto& th : ths) {
+    th.join();
+  }
+
+  result res;
+  res.bytes = ws[0].bytes;
+  const auto last = *std::max_element(ends.begin(), ends.end());
+  res.seconds = std::chrono::duration<double>(last - beg).count();
+  for (size_t t = 0; t < n; t++) {
+    res.latency.merge(hs[t]);
+    res.failed += fails[t];
+  }
+  res.ops = res.latency.count();
+  return res;
+}
+
+} // namespace bench_load
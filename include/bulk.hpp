@@ -0,0 +1,631 @@
+#pragma once
+#include <cstring>
+
+#include "numa.hpp"
+#include "parallel.hpp"
+#include "stream.hpp"
+
+// Multi-threaded authenticated encryption/ verified decryption of large
+// buffers, on top of SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}
+//
+// Buffer is split into fixed size segments ( last one can be shorter ), each of
+// them being independently encrypted & authenticated, so that segments can be
+// processed on all available CPU cores. Per-segment nonces are derived same way
+// as it's done in STREAM construction ( see stream.hpp ), meaning cipher text
+// segments along with their tags, produced here, can be opened using
+// stream::decryptor too ( and vice versa ). Authentication tags of all segments
+// are collected in a compact table, where i -th tag lives at offset i * C.
+//
+// Segments can be spread over either a plain thread pool or a NUMA aware one (
+// see numa.hpp ), which executes each segment on a core of the node owning its
+// input pages. Output is written in place, wherever caller put it; for output
+// to be node-local too, allocate it as numa::buffer(M, txt, seg_len), which
+// binds each output segment to node owning corresponding input segment.
+namespace bulk {
+
+// # -of segments, a buffer of `ct_len` -bytes is split into, when segment byte
+// length is `seg_len`. Note, empty buffer still produces one ( empty ) segment,
+// so that associated data is authenticated & truncation can be detected.
+static inline size_t
+segment_count(const size_t ct_len, const size_t seg_len)
+{
+  return (ct_len == 0) ? 1ul : (ct_len + seg_len - 1) / seg_len;
+}
+
+// Invokes `fn(i)` for each of n segments of a buffer, on a plain thread pool
+static inline void
+for_each_segment(parallel::thread_pool& pool,
+                 const uint8_t* const,
+                 const size_t,
+                 const size_t n,
+                 const std::function<void(size_t)>& fn)
+{
+  pool.for_each(n, fn);
+}
+
+// Invokes `fn(i)` for each of n segments of a buffer, starting at `buf`, on a
+// NUMA aware thread pool, which executes i -th segment on a core of the node
+// owning its first page
+static inline void
+for_each_segment(numa::pool& pool,
+                 const uint8_t* const buf,
+                 const size_t seg_len,
+                 const size_t n,
+                 const std::function<void(size_t)>& fn)
+{
+  pool.for_each(buf, seg_len, n, fn);
+}
+
+// Generic multi-threaded authenticated encryption routine, which can be used
+// with SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning
+// of first nine template parameters, while P is type of thread pool (
+// parallel::thread_pool or numa::pool ).
+//
+// Given C -bytes secret key, (R - 5) -bytes base nonce, N (>=0) -bytes
+// associated data ( authenticated along with each segment ) & M (>=0) -bytes
+// plain text, this routine computes M -bytes cipher text & segment_count(M,
+// seg_len) -many C -bytes authentication tags.
+//
+// Returns false ( without touching output buffers ) if segment length is zero
+// or buffer needs more segments than can be sealed under one base nonce.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         typename P>
+static inline bool
+encrypt(P& pool,                               // pool of worker threads
+        const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+        const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
+        const size_t d_len,                    // len(data) = N | N >= 0
+        const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+        uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+        const size_t ct_len,                   // len(txt) = len(enc) = M
+        const size_t seg_len,                  // segment byte length | > 0
+        uint8_t* const __restrict tags         // C * segment_count(M) -bytes
+)
+{
+  if (seg_len == 0) {
+    return false;
+  }
+
+  const size_t n_segs = segment_count(ct_len, seg_len);
+  if (n_segs > stream::MAX_SEGMENTS) {
+    return false;
+  }
+
+  for_each_segment(pool, txt, seg_len, n_segs, [&](const size_t i) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ct_len - off);
+
+    uint8_t seg_nonce[R];
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(i), i == (n_segs - 1), seg_nonce);
+
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, data, d_len, txt + off, enc + off, len, tags + i * C);
+  });
+
+  return true;
+}
+
+// Generic multi-threaded verified decryption routine, which can be used with
+// SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}; see aead::decrypt for meaning of
+// first nine template parameters, while P is type of thread pool (
+// parallel::thread_pool or numa::pool ).
+//
+// Given C -bytes secret key, (R - 5) -bytes base nonce, table of
+// segment_count(M, seg_len) -many C -bytes authentication tags, N (>=0) -bytes
+// associated data & M (>=0) -bytes cipher text, this routine computes M -bytes
+// decrypted text & returns boolean verification flag, which holds truth value
+// only if all segments are verified. If any segment fails verification, whole
+// decrypted text is zeroed i.e. no unverified plain text is released.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         typename P>
+static inline bool
+decrypt(P& pool,                               // pool of worker threads
+        const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+        const uint8_t* const __restrict tags,  // C * segment_count(M) -bytes
+        const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
+        const size_t d_len,                    // len(data) = N | N >= 0
+        const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+        uint8_t* const __restrict dec,         // M (>=0) -bytes decrypted text
+        const size_t ct_len,                   // len(enc) = len(dec) = M
+        const size_t seg_len                   // segment byte length | > 0
+)
+{
+  if (seg_len == 0) {
+    std::memset(dec, 0, ct_len);
+    return false;
+  }
+
+  const size_t n_segs = segment_count(ct_len, seg_len);
+  if (n_segs > stream::MAX_SEGMENTS) {
+    std::memset(dec, 0, ct_len);
+    return false;
+  }
+
+  std::atomic<bool> flag{ true };
+
+  for_each_segment(pool, enc, seg_len, n_segs, [&](const size_t i) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ct_len - off);
+
+    uint8_t seg_nonce[R];
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(i), i == (n_segs - 1), seg_nonce);
+
+    const bool f = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, tags + i * C, data, d_len, enc + off, dec + off, len);
+
+    if (!f) {
+      flag.store(false, std::memory_order_relaxed);
+    }
+  });
+
+  // don't release unverified plain text
+  const bool f = flag.load(std::memory_order_relaxed);
+  std::memset(dec, 0, !f * ct_len);
+  return f;
+}
+
+} // namespace bulk
+
+// Multi-threaded bulk encryption/ decryption using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+// Segmented authenticated encryption of a large buffer, on process wide thread
+// pool; see bulk::encrypt
+static inline bool
+bulk_encrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
+             const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+             uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+             const size_t ct_len,                   // len(txt) = len(enc) = M
+             const size_t seg_len,                  // segment byte length
+             uint8_t* const __restrict tags         // 16 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide thread
+// pool; see bulk::decrypt
+static inline bool
+bulk_decrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
+             const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+             const uint8_t* const __restrict tags,  // 16 * #-of segments bytes
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+             uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+             const size_t ct_len,                   // len(enc) = len(dec) = M
+             const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+// Segmented authenticated encryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::encrypt
+static inline bool
+bulk_encrypt_numa(
+  const uint8_t* const __restrict key,   // 16 -bytes secret key
+  const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+  uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+  const size_t ct_len,                   // len(txt) = len(enc) = M
+  const size_t seg_len,                  // segment byte length
+  uint8_t* const __restrict tags         // 16 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::decrypt
+static inline bool
+bulk_decrypt_numa(
+  const uint8_t* const __restrict key,   // 16 -bytes secret key
+  const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+  const uint8_t* const __restrict tags,  // 16 * #-of segments bytes
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+  uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+  const size_t ct_len,                   // len(enc) = len(dec) = M
+  const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+}
+
+// Multi-threaded bulk encryption/ decryption using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+// Segmented authenticated encryption of a large buffer, on process wide thread
+// pool; see bulk::encrypt
+static inline bool
+bulk_encrypt(const uint8_t* const __restrict key,   // 24 -bytes secret key
+             const uint8_t* const __restrict nonce, // 19 -bytes base nonce
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+             uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+             const size_t ct_len,                   // len(txt) = len(enc) = M
+             const size_t seg_len,                  // segment byte length
+             uint8_t* const __restrict tags         // 24 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide thread
+// pool; see bulk::decrypt
+static inline bool
+bulk_decrypt(const uint8_t* const __restrict key,   // 24 -bytes secret key
+             const uint8_t* const __restrict nonce, // 19 -bytes base nonce
+             const uint8_t* const __restrict tags,  // 24 * #-of segments bytes
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+             uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+             const size_t ct_len,                   // len(enc) = len(dec) = M
+             const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+// Segmented authenticated encryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::encrypt
+static inline bool
+bulk_encrypt_numa(
+  const uint8_t* const __restrict key,   // 24 -bytes secret key
+  const uint8_t* const __restrict nonce, // 19 -bytes base nonce
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+  uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+  const size_t ct_len,                   // len(txt) = len(enc) = M
+  const size_t seg_len,                  // segment byte length
+  uint8_t* const __restrict tags         // 24 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::decrypt
+static inline bool
+bulk_decrypt_numa(
+  const uint8_t* const __restrict key,   // 24 -bytes secret key
+  const uint8_t* const __restrict nonce, // 19 -bytes base nonce
+  const uint8_t* const __restrict tags,  // 24 * #-of segments bytes
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+  uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+  const size_t ct_len,                   // len(enc) = len(dec) = M
+  const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+}
+
+// Multi-threaded bulk encryption/ decryption using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+// Segmented authenticated encryption of a large buffer, on process wide thread
+// pool; see bulk::encrypt
+static inline bool
+bulk_encrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
+             const uint8_t* const __restrict nonce, // 11 -bytes base nonce
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+             uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+             const size_t ct_len,                   // len(txt) = len(enc) = M
+             const size_t seg_len,                  // segment byte length
+             uint8_t* const __restrict tags         // 16 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide thread
+// pool; see bulk::decrypt
+static inline bool
+bulk_decrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
+             const uint8_t* const __restrict nonce, // 11 -bytes base nonce
+             const uint8_t* const __restrict tags,  // 16 * #-of segments bytes
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+             uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+             const size_t ct_len,                   // len(enc) = len(dec) = M
+             const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+// Segmented authenticated encryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::encrypt
+static inline bool
+bulk_encrypt_numa(
+  const uint8_t* const __restrict key,   // 16 -bytes secret key
+  const uint8_t* const __restrict nonce, // 11 -bytes base nonce
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+  uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+  const size_t ct_len,                   // len(txt) = len(enc) = M
+  const size_t seg_len,                  // segment byte length
+  uint8_t* const __restrict tags         // 16 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::decrypt
+static inline bool
+bulk_decrypt_numa(
+  const uint8_t* const __restrict key,   // 16 -bytes secret key
+  const uint8_t* const __restrict nonce, // 11 -bytes base nonce
+  const uint8_t* const __restrict tags,  // 16 * #-of segments bytes
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+  uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+  const size_t ct_len,                   // len(enc) = len(dec) = M
+  const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+}
+
+// Multi-threaded bulk encryption/ decryption using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+// Segmented authenticated encryption of a large buffer, on process wide thread
+// pool; see bulk::encrypt
+static inline bool
+bulk_encrypt(const uint8_t* const __restrict key,   // 32 -bytes secret key
+             const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+             uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+             const size_t ct_len,                   // len(txt) = len(enc) = M
+             const size_t seg_len,                  // segment byte length
+             uint8_t* const __restrict tags         // 32 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide thread
+// pool; see bulk::decrypt
+static inline bool
+bulk_decrypt(const uint8_t* const __restrict key,   // 32 -bytes secret key
+             const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+             const uint8_t* const __restrict tags,  // 32 * #-of segments bytes
+             const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+             const size_t d_len,                    // len(data) = N | N >= 0
+             const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+             uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+             const size_t ct_len,                   // len(enc) = len(dec) = M
+             const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+// Segmented authenticated encryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::encrypt
+static inline bool
+bulk_encrypt_numa(
+  const uint8_t* const __restrict key,   // 32 -bytes secret key
+  const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+  uint8_t* const __restrict enc,         // M (>=0) -bytes encrypted
+  const size_t ct_len,                   // len(txt) = len(enc) = M
+  const size_t seg_len,                  // segment byte length
+  uint8_t* const __restrict tags         // 32 * #-of segments bytes
+)
+{
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       data,
+                                                       d_len,
+                                                       txt,
+                                                       enc,
+                                                       ct_len,
+                                                       seg_len,
+                                                       tags);
+}
+
+// Segmented verified decryption of a large buffer, on process wide NUMA
+// aware thread pool; see bulk::decrypt
+static inline bool
+bulk_decrypt_numa(
+  const uint8_t* const __restrict key,   // 32 -bytes secret key
+  const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+  const uint8_t* const __restrict tags,  // 32 * #-of segments bytes
+  const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+  const size_t d_len,                    // len(data) = N | N >= 0
+  const uint8_t* const __restrict enc,   // M (>=0) -bytes encrypted
+  uint8_t* const __restrict dec,         // M (>=0) -bytes plain text
+  const size_t ct_len,                   // len(enc) = len(dec) = M
+  const size_t seg_len                   // segment byte length
+)
+{
+  return bulk::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(numa::default_pool(),
+                                                       key,
+                                                       nonce,
+                                                       tags,
+                                                       data,
+                                                       d_len,
+                                                       enc,
+                                                       dec,
+                                                       ct_len,
+                                                       seg_len);
+}
+
+}
@@ -0,0 +1,526 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bulk.hpp"
+
+// Random-access encrypted container, on top of SchwaemmX-Y AEAD | X, Y ∈
+// {128, 192, 256}
+//
+// Plain text is split into fixed size chunks ( last one can be shorter ), each
+// of them being independently encrypted & authenticated, same way as it's done
+// in bulk.hpp, so that any byte range can be read back by decrypting &
+// verifying only those chunks which cover it. Sealed container is laid out as
+//
+// container = header || tags || cipher text
+//
+// header = magic || le64(chunk_len) || le64(len) || nonce
+//
+// where magic is 8 -bytes, nonce is (R - 5) -bytes base nonce, tags is a table
+// of C -bytes authentication tags ( i -th tag belonging to i -th chunk ) &
+// cipher text is of `len` -bytes. Header is authenticated, as associated data,
+// along with each chunk, so that tampering with it makes every read fail.
+namespace container {
+
+// Magic bytes, identifying a sealed container
+constexpr uint8_t MAGIC[8] = { 'S', 'P', 'K', 'L', 'C', 'T', 'R', 1 };
+
+// Byte length of header, for Schwaemm variant with R -bytes rate
+template<const size_t R>
+constexpr size_t HEADER_LEN =
+  sizeof(MAGIC) + 16ul + (R - stream::NONCE_SUFFIX_LEN);
+
+// Byte length of container, sealing `len` -bytes plain text, split into
+// chunks of `chunk_len` -bytes, using Schwaemm variant with R -bytes rate &
+// C -bytes tag
+template<const size_t R, const size_t C>
+static inline size_t
+sealed_size(const size_t len, const size_t chunk_len)
+{
+  return HEADER_LEN<R> + bulk::segment_count(len, chunk_len) * C + len;
+}
+
+// Generic multi-threaded container sealing routine, which can be used with
+// SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of
+// template parameters.
+//
+// Given C -bytes secret key, (R - 5) -bytes base nonce & M (>=0) -bytes plain
+// text, this routine writes sealed_size<R, C>(M, chunk_len) -bytes container
+// to `out`, which can as well be a writable memory mapping of destination
+// file. Returns false ( without touching output buffer ) if chunk length is
+// zero or plain text needs more chunks than can be sealed under one base nonce.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+seal(parallel::thread_pool& pool,           // pool of worker threads
+     const uint8_t* const __restrict key,   // C -bytes secret key
+     const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+     const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+     const size_t len,                      // len(txt) = M | M >= 0
+     const size_t chunk_len,                // chunk byte length | > 0
+     uint8_t* const __restrict out          // container bytes
+)
+{
+  constexpr size_t hlen = HEADER_LEN<R>;
+
+  if (chunk_len == 0) {
+    return false;
+  }
+
+  const size_t n_chunks = bulk::segment_count(len, chunk_len);
+  if (n_chunks > stream::MAX_SEGMENTS) {
+    return false;
+  }
+
+  std::memcpy(out, MAGIC, sizeof(MAGIC));
+  sparkle_utils::to_le_bytes(chunk_len, out + sizeof(MAGIC));
+  sparkle_utils::to_le_bytes(len, out + sizeof(MAGIC) + 8);
+  std::memcpy(out + sizeof(MAGIC) + 16, nonce, R - stream::NONCE_SUFFIX_LEN);
+
+  uint8_t* const tags = out + hlen;
+  uint8_t* const enc = tags + n_chunks * C;
+
+  return bulk::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    pool, key, nonce, out, hlen, txt, enc, len, chunk_len, tags);
+}
+
+// Seals plain text into a container & writes it to file at `path` ( which is
+// created or truncated ), through a writable memory mapping; see `seal` above.
+// Returns false if sealing or any file operation fails.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+seal_file(parallel::thread_pool& pool,           // pool of worker threads
+          const char* const path,                // destination file path
+          const uint8_t* const __restrict key,   // C -bytes secret key
+          const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+          const uint8_t* const __restrict txt,   // M (>=0) -bytes plain text
+          const size_t len,                      // len(txt) = M | M >= 0
+          const size_t chunk_len                 // chunk byte length | > 0
+)
+{
+  if (chunk_len == 0) {
+    return false;
+  }
+
+  const size_t size = sealed_size<R, C>(len, chunk_len);
+
+  const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  constexpr int prot = PROT_READ | PROT_WRITE;
+  void* const map = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+
+  uint8_t* const out = static_cast<uint8_t*>(map);
+  bool f = seal<R, C, A0, A1, M0, M1, BR, S, B>(
+    pool, key, nonce, txt, len, chunk_len, out);
+
+  f &= ::msync(map, size, MS_SYNC) == 0;
+  ::munmap(map, size);
+  ::close(fd);
+
+  return f;
+}
+
+// Random-access reader of sealed container, which can be used with SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}; see aead::decrypt for meaning of template
+// parameters.
+//
+// Container is either memory mapped from a file ( see `open` ) or attached
+// from memory ( see `attach` ), after which any byte range of plain text can
+// be read, by decrypting & verifying only those chunks which cover it.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class reader
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of base nonce, from which per-chunk nonces are derived
+  static constexpr size_t NONCE_LEN = R - stream::NONCE_SUFFIX_LEN;
+
+  explicit reader(const uint8_t* const key /* C -bytes secret key */)
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+  }
+
+  reader(const reader&) = delete;
+  reader& operator=(const reader&) = delete;
+
+  ~reader()
+  {
+    close();
+    std::memset(key, 0, KEY_LEN);
+  }
+
+  // Memory maps container file at `path` ( read-only ) & parses its header.
+  // Returns false if file can't be mapped or it's not a well-formed container.
+  bool open(const char* const path)
+  {
+    close();
+
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat st;
+    if ((::fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+      ::close(fd);
+      return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* const map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (map == MAP_FAILED) {
+      return false;
+    }
+
+    // small ranges are read from anywhere in the file, so don't read ahead
+    ::madvise(map, size, MADV_RANDOM);
+
+    map_ptr = map;
+    map_len = size;
+
+    if (!attach(static_cast<const uint8_t*>(map), size)) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  // Attaches container, living in memory, & parses its header. Memory must
+  // stay valid until this reader is closed. Returns false if it's not a
+  // well-formed container.
+  bool attach(const uint8_t* const buf, const size_t buf_len)
+  {
+    constexpr size_t hlen = HEADER_LEN<R>;
+
+    if (buf_len < hlen) {
+      return false;
+    }
+    if (std::memcmp(buf, MAGIC, sizeof(MAGIC)) != 0) {
+      return false;
+    }
+
+    const size_t cl = sparkle_utils::from_le_bytes(buf + sizeof(MAGIC));
+    const size_t ln = sparkle_utils::from_le_bytes(buf + sizeof(MAGIC) + 8);
+    if ((cl == 0) || (ln > buf_len)) {
+      return false;
+    }
+
+    const size_t n = bulk::segment_count(ln, cl);
+    if ((n > stream::MAX_SEGMENTS) || (buf_len != hlen + n * C + ln)) {
+      return false;
+    }
+
+    header = buf;
+    chunk_len = cl;
+    len = ln;
+    n_chunks = n;
+    return true;
+  }
+
+  // Unmaps container file, if any, & detaches from container
+  void close()
+  {
+    if (map_ptr != nullptr) {
+      ::munmap(map_ptr, map_len);
+    }
+
+    map_ptr = nullptr;
+    map_len = 0;
+    header = nullptr;
+    chunk_len = len = n_chunks = 0;
+  }
+
+  // Returns byte length of plain text, sealed in container
+  size_t size() const { return len; }
+
+  // Returns byte length of chunks, sealed in container
+  size_t chunk_size() const { return chunk_len; }
+
+  // Returns # -of chunks, sealed in container
+  size_t chunks() const { return n_chunks; }
+
+  // Decrypts & verifies only those chunks which cover plain text byte range
+  // [off, off + r_len), writing requested range to `out`, while spreading
+  // chunks over worker threads. Returns boolean verification flag; on failure (
+  // or if range is out of bounds ) `out` is zeroed i.e. no unverified plain
+  // text is released.
+  bool read(parallel::thread_pool& pool, // pool of worker threads
+            const size_t off,            // plain text byte offset
+            const size_t r_len,          // # -of bytes to read
+            uint8_t* const out           // r_len -bytes plain text
+  ) const
+  {
+    if ((header == nullptr) || (off > len) || (r_len > len - off)) {
+      std::memset(out, 0, r_len);
+      return false;
+    }
+    if (r_len == 0) {
+      return true;
+    }
+
+    const size_t first = off / chunk_len;
+    const size_t last = (off + r_len - 1) / chunk_len;
+
+    std::atomic<bool> flag{ true };
+
+    pool.for_each(last - first + 1, [&](const size_t i) {
+      const size_t k = first + i;
+      const size_t c_off = k * chunk_len;
+      const size_t c_len = std::min(chunk_len, len - c_off);
+
+      const bool full = (c_off >= off) && (c_off + c_len <= off + r_len);
+      bool f = false;
+
+      if (full) {
+        f = open_chunk(k, out + (c_off - off));
+      } else {
+        // partially requested chunk is decrypted into scratch buffer
+        auto tmp = std::make_unique<uint8_t[]>(c_len);
+        f = open_chunk(k, tmp.get());
+
+        const size_t beg = std::max(off, c_off);
+        const size_t end = std::min(off + r_len, c_off + c_len);
+        std::memcpy(out + (beg - off), tmp.get() + (beg - c_off), end - beg);
+      }
+
+      if (!f) {
+        flag.store(false, std::memory_order_relaxed);
+      }
+    });
+
+    // don't release unverified plain text
+    const bool f = flag.load(std::memory_order_relaxed);
+    std::memset(out, 0, !f * r_len);
+    return f;
+  }
+
+  // Reads plain text byte range, on process wide thread pool; see above
+  bool read(const size_t off, const size_t r_len, uint8_t* const out) const
+  {
+    return read(parallel::default_pool(), off, r_len, out);
+  }
+
+private:
+  // Decrypts & verifies k -th chunk, writing its plain text to `dec`
+  bool open_chunk(const size_t k, uint8_t* const dec) const
+  {
+    constexpr size_t hlen = HEADER_LEN<R>;
+
+    const uint8_t* const nonce = header + sizeof(MAGIC) + 16;
+    const uint8_t* const tags = header + hlen;
+    const uint8_t* const enc = tags + n_chunks * C;
+
+    const size_t c_off = k * chunk_len;
+    const size_t c_len = std::min(chunk_len, len - c_off);
+
+    uint8_t seg_nonce[R];
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(k), k == (n_chunks - 1), seg_nonce);
+
+    return aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, tags + k * C, header, hlen, enc + c_off, dec, c_len);
+  }
+
+  uint8_t key[KEY_LEN];
+
+  void* map_ptr = nullptr;
+  size_t map_len = 0;
+
+  const uint8_t* header = nullptr;
+  size_t chunk_len = 0;
+  size_t len = 0;
+  size_t n_chunks = 0;
+};
+
+} // namespace container
+
+// Random-access encrypted container using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using container_reader = container::reader<R, C, A0, A1, M0, M1, BR, S, B>;
+
+// Seals plain text into a container, on process wide thread pool; see
+// container::seal
+static inline bool
+container_seal(const uint8_t* const __restrict key,   // 16 -bytes secret key
+               const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+               const uint8_t* const __restrict txt,   // M (>=0) -bytes text
+               const size_t len,                      // len(txt) = M | M >= 0
+               const size_t chunk_len,                // chunk byte length
+               uint8_t* const __restrict out          // container bytes
+)
+{
+  return container::seal<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), key, nonce, txt, len, chunk_len, out);
+}
+
+// Seals plain text into a container file, on process wide thread pool; see
+// container::seal_file
+static inline bool
+container_seal_file(const char* const path, // destination file path
+                    const uint8_t* const __restrict key,   // 16 -bytes key
+                    const uint8_t* const __restrict nonce, // 27 -bytes nonce
+                    const uint8_t* const __restrict txt,   // M (>=0) -bytes
+                    const size_t len,                      // len(txt) = M
+                    const size_t chunk_len                 // chunk byte length
+)
+{
+  return container::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), path, key, nonce, txt, len, chunk_len);
+}
+
+}
+
+// Random-access encrypted container using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using container_reader = container::reader<R, C, A0, A1, M0, M1, BR, S, B>;
+
+// Seals plain text into a container, on process wide thread pool; see
+// container::seal
+static inline bool
+container_seal(const uint8_t* const __restrict key,   // 24 -bytes secret key
+               const uint8_t* const __restrict nonce, // 19 -bytes base nonce
+               const uint8_t* const __restrict txt,   // M (>=0) -bytes text
+               const size_t len,                      // len(txt) = M | M >= 0
+               const size_t chunk_len,                // chunk byte length
+               uint8_t* const __restrict out          // container bytes
+)
+{
+  return container::seal<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), key, nonce, txt, len, chunk_len, out);
+}
+
+// Seals plain text into a container file, on process wide thread pool; see
+// container::seal_file
+static inline bool
+container_seal_file(const char* const path, // destination file path
+                    const uint8_t* const __restrict key,   // 24 -bytes key
+                    const uint8_t* const __restrict nonce, // 19 -bytes nonce
+                    const uint8_t* const __restrict txt,   // M (>=0) -bytes
+                    const size_t len,                      // len(txt) = M
+                    const size_t chunk_len                 // chunk byte length
+)
+{
+  return container::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), path, key, nonce, txt, len, chunk_len);
+}
+
+}
+
+// Random-access encrypted container using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using container_reader = container::reader<R, C, A0, A1, M0, M1, BR, S, B>;
+
+// Seals plain text into a container, on process wide thread pool; see
+// container::seal
+static inline bool
+container_seal(const uint8_t* const __restrict key,   // 16 -bytes secret key
+               const uint8_t* const __restrict nonce, // 11 -bytes base nonce
+               const uint8_t* const __restrict txt,   // M (>=0) -bytes text
+               const size_t len,                      // len(txt) = M | M >= 0
+               const size_t chunk_len,                // chunk byte length
+               uint8_t* const __restrict out          // container bytes
+)
+{
+  return container::seal<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), key, nonce, txt, len, chunk_len, out);
+}
+
+// Seals plain text into a container file, on process wide thread pool; see
+// container::seal_file
+static inline bool
+container_seal_file(const char* const path, // destination file path
+                    const uint8_t* const __restrict key,   // 16 -bytes key
+                    const uint8_t* const __restrict nonce, // 11 -bytes nonce
+                    const uint8_t* const __restrict txt,   // M (>=0) -bytes
+                    const size_t len,                      // len(txt) = M
+                    const size_t chunk_len                 // chunk byte length
+)
+{
+  return container::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), path, key, nonce, txt, len, chunk_len);
+}
+
+}
+
+// Random-access encrypted container using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using container_reader = container::reader<R, C, A0, A1, M0, M1, BR, S, B>;
+
+// Seals plain text into a container, on process wide thread pool; see
+// container::seal
+static inline bool
+container_seal(const uint8_t* const __restrict key,   // 32 -bytes secret key
+               const uint8_t* const __restrict nonce, // 27 -bytes base nonce
+               const uint8_t* const __restrict txt,   // M (>=0) -bytes text
+               const size_t len,                      // len(txt) = M | M >= 0
+               const size_t chunk_len,                // chunk byte length
+               uint8_t* const __restrict out          // container bytes
+)
+{
+  return container::seal<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), key, nonce, txt, len, chunk_len, out);
+}
+
+// Seals plain text into a container file, on process wide thread pool; see
+// container::seal_file
+static inline bool
+container_seal_file(const char* const path, // destination file path
+                    const uint8_t* const __restrict key,   // 32 -bytes key
+                    const uint8_t* const __restrict nonce, // 27 -bytes nonce
+                    const uint8_t* const __restrict txt,   // M (>=0) -bytes
+                    const size_t len,                      // len(txt) = M
+                    const size_t chunk_len                 // chunk byte length
+)
+{
+  return container::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(), path, key, nonce, txt, len, chunk_len);
+}
+
+}
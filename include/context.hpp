@@ -0,0 +1,512 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+
+#include "esch256.hpp"
+#include "schwaemm.hpp"
+
+// Incremental ( streaming ) SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}, where
+// associated data & plain/ cipher text can be supplied in arbitrary sized
+// pieces, while produced cipher text & authentication tag are same as what
+// aead::encrypt computes over concatenation of those pieces.
+//
+// In-flight context ( i.e. permutation state, pending partial block, phase &
+// byte counters ) can be exported as a fixed size blob, sealed under a wrapping
+// key, and later imported into a fresh context, possibly by another process,
+// so that a long encryption can be resumed after a crash, from the last saved
+// point, instead of starting over from byte zero. Secret key itself is never
+// part of exported blob; it's referred to by a caller chosen 64 -bit key
+// handle ( stored in clear, but authenticated ), while a key check value is
+// kept in sealed part of blob, so that importing with wrong key fails.
+namespace context {
+
+// Phases of an incremental AEAD context
+enum class phase : uint8_t
+{
+  data = 0, // absorbing associated data
+  text = 1, // encrypting/ decrypting text
+  done = 2, // tag is already produced/ verified
+  none = 3  // context isn't yet initialized/ imported
+};
+
+// Magic bytes, at the start of each exported context
+constexpr uint8_t MAGIC[]{ 'S', 'P', 'K', 'L', 'C', 'T', 'X', 1 };
+
+// Byte length of key check value, kept inside exported context
+constexpr size_t KCV_LEN = 8ul;
+
+// Computes key check value of a secret key, as truncated Esch256 digest of a
+// domain separated encoding of the key
+template<const size_t C>
+static inline void
+key_check_value(const uint8_t* const __restrict key, // C -bytes secret key
+                uint8_t* const __restrict kcv        // KCV_LEN -bytes
+)
+{
+  uint8_t msg[sizeof(MAGIC) + C];
+  uint8_t digest[esch256::DIGEST_LEN];
+
+  std::memcpy(msg, MAGIC, sizeof(MAGIC));
+  std::memcpy(msg + sizeof(MAGIC), key, C);
+
+  esch256::hash(msg, sizeof(msg), digest);
+  std::memcpy(kcv, digest, KCV_LEN);
+
+  std::memset(msg, 0, sizeof(msg));
+}
+
+// Incremental SchwaemmX-Y authenticated encryption ( when DEC = false ) or
+// decryption ( when DEC = true ) context | X, Y ∈ {128, 192, 256}; see
+// aead::encrypt for meaning of first nine template parameters.
+//
+// Associated data ( if any ) must be supplied completely, before first piece
+// of text. Cipher text ( or decrypted text ) bytes are produced right away,
+// while permutation is applied only when next block of input is seen, because
+// last block of text is processed differently. Note, when decrypting, produced
+// bytes aren't verified until `finalize` returns truth value.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const bool DEC>
+class cipher
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of nonce
+  static constexpr size_t NONCE_LEN = R;
+
+  // Byte length of authentication tag
+  static constexpr size_t TAG_LEN = C;
+
+  // Byte length of wrapping key, under which context is exported
+  static constexpr size_t WRAP_KEY_LEN = C;
+
+  // Byte length of nonce, used for sealing exported context
+  static constexpr size_t WRAP_NONCE_LEN = R;
+
+  // Byte length of exported context's header i.e. magic bytes, rate &
+  // capacity, direction, key handle & wrapping nonce, which is authenticated
+  // but not encrypted
+  static constexpr size_t HEADER_LEN = sizeof(MAGIC) + 3 + 8 + R;
+
+  // Byte length of exported context's sealed body i.e. state words, pending
+  // block, its fill level, phase, # -of consumed associated data & text bytes
+  // and key check value
+  static constexpr size_t BODY_LEN = (BR << 3) + R + 2 + 16 + KCV_LEN;
+
+  // Byte length of exported context
+  static constexpr size_t EXPORT_LEN = HEADER_LEN + BODY_LEN + C;
+
+  // Creates a context, which must be populated using `import`, before use
+  cipher() = default;
+
+  cipher(const uint8_t* const __restrict key,  // C -bytes secret key
+         const uint8_t* const __restrict nonce // R -bytes nonce
+  )
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    aead::initialize<R, C, BR, B>(state, key, nonce);
+    ph = phase::data;
+  }
+
+  // Copying a context ( say, to fork a stream after a common prefix ) must be
+  // asked for explicitly, as the copy carries secret key too
+  explicit cipher(const cipher&) = default;
+  cipher& operator=(const cipher&) = delete;
+
+  ~cipher()
+  {
+    std::memset(key, 0, KEY_LEN);
+    std::memset(state, 0, sizeof(state));
+    std::memset(buf, 0, sizeof(buf));
+    std::memset(ks, 0, sizeof(ks));
+  }
+
+  // Absorbs next piece of associated data. Returns false, if text processing
+  // has already begun.
+  bool absorb(const uint8_t* const data, const size_t d_len)
+  {
+    if (ph != phase::data) {
+      return false;
+    }
+
+    size_t off = 0;
+    while (off < d_len) {
+      // a full block is known to be non-last, only when more input follows
+      if (pos == R) {
+        absorb_data_block(buf);
+        pos = 0;
+      }
+
+      if ((pos == 0) && ((d_len - off) > R)) {
+        absorb_data_block(data + off);
+        off += R;
+        continue;
+      }
+
+      const size_t m = std::min(R - pos, d_len - off);
+      std::memcpy(buf + pos, data + off, m);
+
+      pos += m;
+      off += m;
+    }
+
+    d_total += d_len;
+    return true;
+  }
+
+  // Encrypts ( or decrypts, when DEC = true ) next piece of text, producing
+  // equal many output bytes. Returns false, if tag is already produced/
+  // verified.
+  //
+  // Note, `in` & `out` can point to same memory, for in-place processing.
+  bool update(const uint8_t* const in, uint8_t* const out, const size_t len)
+  {
+    if ((ph == phase::done) || (ph == phase::none)) {
+      return false;
+    }
+    if (ph == phase::data) {
+      begin_text();
+    }
+
+    size_t off = 0;
+    while (off < len) {
+      if (pos == R) {
+        absorb_text_block(buf, nullptr);
+        pos = 0;
+      }
+
+      if ((pos == 0) && ((len - off) > R)) {
+        absorb_text_block(in + off, out + off);
+        off += R;
+        continue;
+      }
+
+      const size_t m = std::min(R - pos, len - off);
+      for (size_t i = 0; i < m; i++) {
+        const uint8_t b = in[off + i];
+
+        buf[pos + i] = b;
+        out[off + i] = b ^ ks[pos + i];
+      }
+
+      pos += m;
+      off += m;
+    }
+
+    t_total += len;
+    return true;
+  }
+
+  // Finishes encryption, producing C -bytes authentication tag. Returns false,
+  // if tag is already produced.
+  bool finalize(uint8_t* const __restrict tag)
+    requires(!DEC)
+  {
+    if ((ph == phase::done) || (ph == phase::none)) {
+      return false;
+    }
+
+    finish();
+    aead::finalize<R, C>(state, key, tag);
+    return true;
+  }
+
+  // Finishes decryption, verifying C -bytes authentication tag. Returns
+  // boolean verification flag; all decrypted bytes must be discarded, when
+  // it's false.
+  bool finalize(const uint8_t* const __restrict tag)
+    requires(DEC)
+  {
+    if ((ph == phase::done) || (ph == phase::none)) {
+      return false;
+    }
+
+    finish();
+
+    uint8_t tag_[C];
+    aead::finalize<R, C>(state, key, tag_);
+
+    bool flag = false;
+    for (size_t i = 0; i < C; i++) {
+      flag |= (tag[i] ^ tag_[i]);
+    }
+    return !flag;
+  }
+
+  // Exports in-flight context as EXPORT_LEN -bytes blob, sealed under wrapping
+  // key, using given nonce ( which must never repeat for same wrapping key ).
+  // Key handle is stored in clear, so that the key can be looked up, before
+  // importing. Returns false, if context isn't in use.
+  bool export_to(const uint8_t* const __restrict wrap_key,   // C -bytes
+                 const uint8_t* const __restrict wrap_nonce, // R -bytes
+                 const uint64_t key_handle,    // identifies secret key
+                 uint8_t* const __restrict out // EXPORT_LEN -bytes
+  ) const
+  {
+    if (ph == phase::none) {
+      return false;
+    }
+
+    write_header(out, key_handle, wrap_nonce);
+
+    uint8_t body[BODY_LEN];
+    uint8_t* ptr = body;
+
+    sparkle_utils::copy_words_to_le_bytes<(BR << 3)>(state, ptr);
+    ptr += BR << 3;
+    std::memcpy(ptr, buf, R);
+    ptr += R;
+    *ptr++ = static_cast<uint8_t>(pos);
+    *ptr++ = static_cast<uint8_t>(ph);
+    sparkle_utils::to_le_bytes(d_total, ptr);
+    ptr += 8;
+    sparkle_utils::to_le_bytes(t_total, ptr);
+    ptr += 8;
+    key_check_value<C>(key, ptr);
+
+    uint8_t* const enc = out + HEADER_LEN;
+    uint8_t* const tag = enc + BODY_LEN;
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      wrap_key, wrap_nonce, out, HEADER_LEN, body, enc, BODY_LEN, tag);
+
+    std::memset(body, 0, sizeof(body));
+    return true;
+  }
+
+  // Imports a context, which was exported by `export_to` ( of a context with
+  // same Schwaemm variant & direction ), replacing current one. Returns false,
+  // without touching current context, if blob is malformed, fails
+  // verification under wrapping key or was exported with another secret key.
+  bool import(const uint8_t* const __restrict wrap_key, // C -bytes
+              const uint8_t* const __restrict key,      // C -bytes secret key
+              const uint8_t* const __restrict blob      // EXPORT_LEN -bytes
+  )
+  {
+    const uint8_t* const wrap_nonce = blob + HEADER_LEN - R;
+
+    uint8_t hdr[HEADER_LEN];
+    write_header(hdr, key_handle(blob), wrap_nonce);
+
+    if (std::memcmp(hdr, blob, HEADER_LEN) != 0) {
+      return false;
+    }
+
+    uint8_t body[BODY_LEN];
+    const uint8_t* const enc = blob + HEADER_LEN;
+    const uint8_t* const tag = enc + BODY_LEN;
+
+    bool f = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      wrap_key, wrap_nonce, tag, blob, HEADER_LEN, enc, body, BODY_LEN);
+
+    uint8_t kcv[KCV_LEN];
+    key_check_value<C>(key, kcv);
+
+    const uint8_t* ptr = body + (BR << 3) + R;
+    const size_t pos_ = ptr[0];
+    const uint8_t ph_ = ptr[1];
+    const uint64_t d_total_ = sparkle_utils::from_le_bytes(ptr + 2);
+    const uint64_t t_total_ = sparkle_utils::from_le_bytes(ptr + 10);
+
+    f &= std::memcmp(kcv, ptr + 18, KCV_LEN) == 0;
+    f &= pos_ <= R;
+    f &= ph_ <= static_cast<uint8_t>(phase::done);
+
+    if (f) {
+      sparkle_utils::copy_le_bytes_to_words<(BR << 3)>(body, state);
+      std::memcpy(buf, body + (BR << 3), R);
+      std::memcpy(this->key, key, KEY_LEN);
+
+      pos = pos_;
+      ph = static_cast<phase>(ph_);
+      d_total = d_total_;
+      t_total = t_total_;
+
+      load_keystream();
+    }
+
+    std::memset(body, 0, sizeof(body));
+    return f;
+  }
+
+  // Reads key handle, from an exported context, so that secret key, required
+  // for importing it, can be looked up
+  static uint64_t key_handle(const uint8_t* const blob)
+  {
+    return sparkle_utils::from_le_bytes(blob + sizeof(MAGIC) + 3);
+  }
+
+  // Returns # -of associated data bytes, consumed so far
+  uint64_t data_bytes() const { return d_total; }
+
+  // Returns # -of text bytes, consumed so far
+  uint64_t text_bytes() const { return t_total; }
+
+private:
+  // Writes header of exported context, which is authenticated as associated
+  // data, while sealing context's body
+  static void write_header(uint8_t* const __restrict hdr,
+                           const uint64_t key_handle,
+                           const uint8_t* const __restrict wrap_nonce)
+  {
+    std::memcpy(hdr, MAGIC, sizeof(MAGIC));
+
+    uint8_t* const ptr = hdr + sizeof(MAGIC);
+    ptr[0] = static_cast<uint8_t>(R);
+    ptr[1] = static_cast<uint8_t>(C);
+    ptr[2] = static_cast<uint8_t>(DEC);
+
+    sparkle_utils::to_le_bytes(key_handle, ptr + 3);
+    std::memcpy(ptr + 11, wrap_nonce, R);
+  }
+
+  // Absorbs a full, non-last block of associated data
+  void absorb_data_block(const uint8_t* const blk)
+  {
+    uint32_t words[R >> 2];
+    sparkle_utils::copy_le_bytes_to_words<R>(blk, words);
+
+    aead::rho1<R>(state, words);
+    aead::whiten_rate<R, C>(state);
+    sparkle::sparkle<BR, S>(state);
+  }
+
+  // Absorbs a full, non-last block of input text, while writing output text
+  // of that block to `out`, unless it's nullptr ( i.e. when output bytes are
+  // already produced )
+  void absorb_text_block(const uint8_t* const in, uint8_t* const out)
+  {
+    uint32_t words[R >> 2];
+    sparkle_utils::copy_le_bytes_to_words<R>(in, words);
+
+    if (out != nullptr) {
+      uint32_t buffer[R >> 2];
+      std::memcpy(buffer, state, R);
+      aead::rho2<R>(buffer, words);
+      sparkle_utils::copy_words_to_le_bytes<R>(buffer, out);
+    }
+
+    if constexpr (DEC) {
+      aead::rhoprime1<R>(state, words);
+    } else {
+      aead::rho1<R>(state, words);
+    }
+    aead::whiten_rate<R, C>(state);
+    sparkle::sparkle<BR, S>(state);
+
+    load_keystream();
+  }
+
+  // Absorbs last block of associated data ( if any ) & moves to text phase
+  void begin_text()
+  {
+    if (d_total > 0) {
+      aead::process_data<R, C, A0, A1, BR, S, B>(state, buf, pos);
+    }
+
+    pos = 0;
+    ph = phase::text;
+    load_keystream();
+  }
+
+  // Absorbs last block of text ( if any ) & moves to done phase
+  void finish()
+  {
+    if (ph == phase::data) {
+      begin_text();
+    }
+
+    if (t_total > 0) {
+      uint8_t tmp[R];
+
+      if constexpr (DEC) {
+        aead::process_cipher<R, C, M0, M1, BR, S, B>(state, buf, tmp, pos);
+      } else {
+        aead::process_text<R, C, M0, M1, BR, S, B>(state, buf, tmp, pos);
+      }
+    }
+
+    ph = phase::done;
+  }
+
+  // Keystream of current text block is outer part of permutation state
+  void load_keystream()
+  {
+    sparkle_utils::copy_words_to_le_bytes<R>(state, ks);
+  }
+
+  uint32_t state[BR << 1]{};
+  uint8_t key[KEY_LEN]{};
+  uint8_t buf[R]{}; // pending block of associated data/ input text
+  uint8_t ks[R]{};  // keystream of current text block
+  size_t pos = 0;   // # -of bytes in pending block
+  phase ph = phase::none;
+  uint64_t d_total = 0;
+  uint64_t t_total = 0;
+};
+
+// Incremental SchwaemmX-Y authenticated encryption context
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+using encryptor = cipher<R, C, A0, A1, M0, M1, BR, S, B, false>;
+
+// Incremental SchwaemmX-Y verified decryption context
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+using decryptor = cipher<R, C, A0, A1, M0, M1, BR, S, B, true>;
+
+} // namespace context
+
+// Incremental, resumable Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using aead_encryptor = context::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using aead_decryptor = context::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Incremental, resumable Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using aead_encryptor = context::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using aead_decryptor = context::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Incremental, resumable Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using aead_encryptor = context::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using aead_decryptor = context::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Incremental, resumable Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using aead_encryptor = context::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using aead_decryptor = context::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
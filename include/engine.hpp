@@ -0,0 +1,552 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esch.hpp"
+#include "multilane.hpp"
+#include "schwaemm.hpp"
+
+// Asynchronous crypto job engine, which executes Esch{256, 384} hash &
+// SchwaemmX-Y seal/ open jobs | X, Y ∈ {128, 192, 256}, submitted by any
+// number of application threads, on a fixed set of worker threads
+//
+// Each worker owns a deque of pending jobs. A worker takes jobs from front of
+// its own deque, while an idle worker steals them from back of some other
+// worker's deque, so load stays balanced across cores. Whenever a worker takes
+// a job, it also gathers ( from a small window of the same deque ) other
+// pending jobs of same kind & same input lengths, and when it finds L of them,
+// they're executed together, on L lanes of multi-lane Sparkle permutation (
+// see multilane.hpp ). Completion is reported using a future or a callback.
+namespace engine {
+
+// Kind of a job
+enum class op : uint8_t
+{
+  esch256 = 0, // Esch256 hash
+  esch384 = 1, // Esch384 hash
+  seal = 2,    // Schwaemm authenticated encryption
+  open = 3     // Schwaemm verified decryption
+};
+
+// Job descriptor, referring to caller owned buffers, which must stay alive
+// until job is completed. Aligned to cache line, so that descriptors of
+// adjacent jobs, being filled/ consumed by different threads, don't share one.
+struct alignas(64) job
+{
+  op kind = op::esch256;
+  const uint8_t* key = nullptr;   // secret key
+  const uint8_t* nonce = nullptr; // nonce
+  const uint8_t* data = nullptr;  // associated data
+  size_t d_len = 0;               // len(data)
+  const uint8_t* in = nullptr;    // message/ plain text/ cipher text
+  uint8_t* out = nullptr;         // digest/ cipher text/ decrypted text
+  size_t len = 0;                 // len(in)
+  uint8_t* tag = nullptr;         // produced tag, of seal job
+  const uint8_t* vtag = nullptr;  // to be verified tag, of open job
+};
+
+// Describes a job, computing Esch256 ( 32 -bytes ) or Esch384 ( 48 -bytes )
+// digest of N (>=0) -bytes message
+static inline job
+hash_job(const op kind,           // op::esch256 or op::esch384
+         const uint8_t* const in, // N (>=0) -bytes message
+         const size_t ilen,       // len(in) = N
+         uint8_t* const out       // digest
+)
+{
+  job j;
+  j.kind = kind;
+  j.in = in;
+  j.len = ilen;
+  j.out = out;
+  return j;
+}
+
+// Describes a job, sealing plain text using Schwaemm AEAD; see aead::encrypt
+static inline job
+seal_job(const uint8_t* const key,   // C -bytes secret key
+         const uint8_t* const nonce, // R -bytes nonce
+         const uint8_t* const data,  // N (>=0) -bytes associated data
+         const size_t d_len,         // len(data) = N
+         const uint8_t* const txt,   // M (>=0) -bytes plain text
+         uint8_t* const enc,         // M (>=0) -bytes cipher text
+         const size_t ct_len,        // len(txt) = len(enc) = M
+         uint8_t* const tag          // C -bytes authentication tag
+)
+{
+  job j;
+  j.kind = op::seal;
+  j.key = key;
+  j.nonce = nonce;
+  j.data = data;
+  j.d_len = d_len;
+  j.in = txt;
+  j.out = enc;
+  j.len = ct_len;
+  j.tag = tag;
+  return j;
+}
+
+// Describes a job, opening cipher text using Schwaemm AEAD; see aead::decrypt
+static inline job
+open_job(const uint8_t* const key,   // C -bytes secret key
+         const uint8_t* const nonce, // R -bytes nonce
+         const uint8_t* const tag,   // C -bytes authentication tag
+         const uint8_t* const data,  // N (>=0) -bytes associated data
+         const size_t d_len,         // len(data) = N
+         const uint8_t* const enc,   // M (>=0) -bytes cipher text
+         uint8_t* const dec,         // M (>=0) -bytes decrypted text
+         const size_t ct_len         // len(enc) = len(dec) = M
+)
+{
+  job j;
+  j.kind = op::open;
+  j.key = key;
+  j.nonce = nonce;
+  j.vtag = tag;
+  j.data = data;
+  j.d_len = d_len;
+  j.in = enc;
+  j.out = dec;
+  j.len = ct_len;
+  return j;
+}
+
+// Completion callback, invoked on a worker thread, with job's status i.e.
+// verification flag for open jobs & truth value for all other jobs
+using callback = std::function<void(bool)>;
+
+// Work-stealing job engine, which executes Schwaemm jobs using SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of first nine
+// template parameters, while L denotes # -of jobs executed together, on
+// multi-lane Sparkle permutation.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+class executor
+{
+public:
+  // # -of pending jobs, from front/ back of a deque, which are looked at, when
+  // gathering jobs of same kind & same input lengths into a batch
+  static constexpr size_t WINDOW = 4 * L;
+
+  // Creates an engine with given # -of worker threads ( at least one ), which
+  // defaults to # -of hardware threads
+  explicit executor(
+    const size_t n_workers = std::thread::hardware_concurrency())
+  {
+    const size_t n = std::max<size_t>(n_workers, 1ul);
+
+    queues.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      queues.emplace_back(std::make_unique<queue>());
+    }
+
+    workers.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      workers.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  executor(const executor&) = delete;
+  executor& operator=(const executor&) = delete;
+
+  // Waits for all submitted jobs to complete, before stopping workers
+  ~executor()
+  {
+    {
+      std::lock_guard<std::mutex> lk{ sleep_mtx };
+      stop = true;
+    }
+    cv.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of worker threads
+  size_t concurrency() const { return workers.size(); }
+
+  // Submits a job, whose completion is reported by invoking `done`
+  void submit(const job& j, callback done)
+  {
+    pending.fetch_add(1, std::memory_order_relaxed);
+
+    queue& q = *queues[target()];
+    {
+      std::lock_guard<std::mutex> lk{ q.mtx };
+      q.tasks.push_back(task{ j, std::move(done) });
+    }
+
+    wake(false);
+  }
+
+  // Submits a job, returning a future, which resolves to job's status
+  std::future<bool> submit(const job& j)
+  {
+    auto p = std::make_shared<std::promise<bool>>();
+    auto f = p->get_future();
+
+    submit(j, [p](const bool ok) { p->set_value(ok); });
+    return f;
+  }
+
+  // Submits n jobs, whose completion is reported by invoking `done` once, with
+  // truth value only if all of them succeeded. Consecutive jobs are spread, in
+  // chunks of L, over all worker deques.
+  void submit(const job* const jobs, const size_t n, callback done)
+  {
+    if (n == 0) {
+      done(true);
+      return;
+    }
+
+    struct batch
+    {
+      std::atomic<size_t> left;
+      std::atomic<bool> all{ true };
+      callback done;
+    };
+
+    auto b = std::make_shared<batch>();
+    b->left.store(n, std::memory_order_relaxed);
+    b->done = std::move(done);
+
+    const callback each = [b](const bool ok) {
+      if (!ok) {
+        b->all.store(false, std::memory_order_relaxed);
+      }
+      if (b->left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b->done(b->all.load(std::memory_order_relaxed));
+      }
+    };
+
+    pending.fetch_add(n, std::memory_order_relaxed);
+
+    for (size_t off = 0; off < n; off += L) {
+      const size_t cnt = std::min(L, n - off);
+
+      queue& q = *queues[target()];
+      std::lock_guard<std::mutex> lk{ q.mtx };
+
+      for (size_t i = 0; i < cnt; i++) {
+        q.tasks.push_back(task{ jobs[off + i], each });
+      }
+    }
+
+    wake(true);
+  }
+
+  // Submits n jobs, returning a future, which resolves to truth value only if
+  // all of them succeeded
+  std::future<bool> submit(const job* const jobs, const size_t n)
+  {
+    auto p = std::make_shared<std::promise<bool>>();
+    auto f = p->get_future();
+
+    submit(jobs, n, [p](const bool ok) { p->set_value(ok); });
+    return f;
+  }
+
+  // Submits n independent jobs, whose completion is reported by invoking
+  // corresponding callback, from `dones`. All jobs are queued before any worker
+  // is woken up, so that jobs of same shape, gathered from many requesters,
+  // get executed together.
+  void submit(const job* const jobs, callback* const dones, const size_t n)
+  {
+    if (n == 0) {
+      return;
+    }
+
+    pending.fetch_add(n, std::memory_order_relaxed);
+
+    for (size_t off = 0; off < n; off += L) {
+      const size_t cnt = std::min(L, n - off);
+
+      queue& q = *queues[target()];
+      std::lock_guard<std::mutex> lk{ q.mtx };
+
+      for (size_t i = 0; i < cnt; i++) {
+        q.tasks.push_back(task{ jobs[off + i], std::move(dones[off + i]) });
+      }
+    }
+
+    wake(true);
+  }
+
+  // # -of jobs executed so far
+  uint64_t executed() const { return n_jobs.load(std::memory_order_relaxed); }
+
+  // # -of jobs executed so far, on lanes of multi-lane permutation; ratio of it
+  // to `executed` tells how well SIMD lanes are utilized
+  uint64_t laned() const { return n_laned.load(std::memory_order_relaxed); }
+
+private:
+  // A submitted job, along with its completion callback
+  struct task
+  {
+    job j;
+    callback done;
+  };
+
+  // Deque of pending jobs, owned by a worker; aligned to cache line, so that
+  // lock of one deque doesn't share a cache line with another one
+  struct alignas(64) queue
+  {
+    std::mutex mtx;
+    std::deque<task> tasks;
+  };
+
+  // Returns index of deque, to which next job should be pushed; a worker
+  // pushes to its own deque, while other threads go round robin
+  size_t target()
+  {
+    if (self_owner == this) {
+      return self_idx;
+    }
+    return next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+  }
+
+  // Wakes up one ( or all ) sleeping workers, after pushing new jobs
+  void wake(const bool all)
+  {
+    {
+      std::lock_guard<std::mutex> lk{ sleep_mtx };
+    }
+
+    if (all) {
+      cv.notify_all();
+    } else {
+      cv.notify_one();
+    }
+  }
+
+  // Checks whether two jobs can be executed together, on multi-lane
+  // permutation
+  static bool same_shape(const job& a, const job& b)
+  {
+    return (a.kind == b.kind) && (a.len == b.len) && (a.d_len == b.d_len);
+  }
+
+  // Takes a job from front ( or back, when stealing ) of deque, along with up
+  // to L - 1 other jobs of same shape, found within a window of it. Returns #
+  // -of taken jobs.
+  size_t take(queue& q, const bool back, task* const out)
+  {
+    std::lock_guard<std::mutex> lk{ q.mtx };
+
+    auto& d = q.tasks;
+    if (d.empty()) {
+      return 0;
+    }
+
+    size_t n = 0;
+
+    if (back) {
+      out[n++] = std::move(d.back());
+      d.pop_back();
+
+      size_t idx = d.size();
+      for (size_t seen = 0; (idx > 0) && (seen < WINDOW) && (n < L); seen++) {
+        idx--;
+        if (same_shape(d[idx].j, out[0].j)) {
+          out[n++] = std::move(d[idx]);
+          d.erase(d.begin() + static_cast<ptrdiff_t>(idx));
+        }
+      }
+    } else {
+      out[n++] = std::move(d.front());
+      d.pop_front();
+
+      size_t idx = 0;
+      for (size_t seen = 0; (idx < d.size()) && (seen < WINDOW) && (n < L);
+           seen++) {
+        if (same_shape(d[idx].j, out[0].j)) {
+          out[n++] = std::move(d[idx]);
+          d.erase(d.begin() + static_cast<ptrdiff_t>(idx));
+        } else {
+          idx++;
+        }
+      }
+    }
+
+    pending.fetch_sub(n, std::memory_order_relaxed);
+    return n;
+  }
+
+  // Executes a single job
+  static bool run_one(const job& j)
+  {
+    switch (j.kind) {
+      case op::esch256:
+        esch256::hash(j.in, j.len, j.out);
+        return true;
+      case op::esch384:
+        esch384::hash(j.in, j.len, j.out);
+        return true;
+      case op::seal:
+        aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+          j.key, j.nonce, j.data, j.d_len, j.in, j.out, j.len, j.tag);
+        return true;
+      default:
+        return aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+          j.key, j.nonce, j.vtag, j.data, j.d_len, j.in, j.out, j.len);
+    }
+  }
+
+  // Executes L jobs of same shape together, on multi-lane permutation, writing
+  // status of each of them to `flags`
+  static void run_lanes(const task* const ts, bool* const flags)
+  {
+    const uint8_t* keys[L];
+    const uint8_t* nonces[L];
+    const uint8_t* data[L];
+    const uint8_t* ins[L];
+    const uint8_t* vtags[L];
+    uint8_t* outs[L];
+    uint8_t* tags[L];
+
+    for (size_t l = 0; l < L; l++) {
+      const job& j = ts[l].j;
+
+      keys[l] = j.key;
+      nonces[l] = j.nonce;
+      data[l] = j.data;
+      ins[l] = j.in;
+      outs[l] = j.out;
+      tags[l] = j.tag;
+      vtags[l] = j.vtag;
+      flags[l] = true;
+    }
+
+    const job& j = ts[0].j;
+
+    switch (j.kind) {
+      case op::esch256:
+        multilane::hash<6, 7, 11, esch256::DIGEST_LEN, L>(ins, j.len, outs);
+        break;
+      case op::esch384:
+        multilane::hash<8, 8, 12, esch384::DIGEST_LEN, L>(ins, j.len, outs);
+        break;
+      case op::seal:
+        multilane::encrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+          keys, nonces, data, j.d_len, ins, outs, j.len, tags);
+        break;
+      default:
+        multilane::decrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+          keys, nonces, vtags, data, j.d_len, ins, outs, j.len, flags);
+        break;
+    }
+  }
+
+  // Worker thread's event loop
+  void work(const size_t idx)
+  {
+    self_owner = this;
+    self_idx = idx;
+
+    std::vector<task> ts(L);
+    bool flags[L];
+
+    while (true) {
+      size_t n = take(*queues[idx], false, ts.data());
+
+      // steal from other workers, when own deque is empty
+      for (size_t i = 1; (n == 0) && (i < queues.size()); i++) {
+        n = take(*queues[(idx + i) % queues.size()], true, ts.data());
+      }
+
+      if (n == 0) {
+        std::unique_lock<std::mutex> lk{ sleep_mtx };
+        cv.wait(lk, [this] {
+          return stop || (pending.load(std::memory_order_relaxed) > 0);
+        });
+
+        if (stop && (pending.load(std::memory_order_relaxed) == 0)) {
+          return;
+        }
+        continue;
+      }
+
+      n_jobs.fetch_add(n, std::memory_order_relaxed);
+
+      if (n == L) {
+        run_lanes(ts.data(), flags);
+        n_laned.fetch_add(n, std::memory_order_relaxed);
+      } else {
+        for (size_t i = 0; i < n; i++) {
+          flags[i] = run_one(ts[i].j);
+        }
+      }
+
+      for (size_t i = 0; i < n; i++) {
+        if (ts[i].done) {
+          ts[i].done(flags[i]);
+        }
+        ts[i].done = nullptr;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<queue>> queues;
+  std::vector<std::thread> workers;
+
+  alignas(64) std::atomic<size_t> pending{ 0 };
+  alignas(64) std::atomic<size_t> next{ 0 };
+  alignas(64) std::atomic<uint64_t> n_jobs{ 0 };
+  std::atomic<uint64_t> n_laned{ 0 };
+
+  std::mutex sleep_mtx;
+  std::condition_variable cv;
+  bool stop = false;
+
+  // engine & deque index of calling thread, when it's a worker
+  static inline thread_local const executor* self_owner = nullptr;
+  static inline thread_local size_t self_idx = 0;
+};
+
+} // namespace engine
+
+// Crypto job engine using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using crypto_engine = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Crypto job engine using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using crypto_engine = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Crypto job engine using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using crypto_engine = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Crypto job engine using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using crypto_engine = engine::executor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
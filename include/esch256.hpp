@@ -71,4 +71,8 @@ hash(const uint8_t* const __restrict in, // input message
   sparkle_utils::copy_words_to_le_bytes<hash::RATE>(state, out + hash::RATE);
 }
 
+// Incremental Esch256 hasher, absorbing message in arbitrary sized pieces; see
+// hash::hasher
+using hasher = hash::hasher<6ul, 7ul, 11ul, DIGEST_LEN>;
+
 } // namespace esch256
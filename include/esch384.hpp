@@ -76,4 +76,8 @@ hash(const uint8_t* const __restrict in, // input message
   sparkle_utils::copy_words_to_le_bytes<hash::RATE>(state, out + off1);
 }
 
+// Incremental Esch384 hasher, absorbing message in arbitrary sized pieces; see
+// hash::hasher
+using hasher = hash::hasher<8ul, 8ul, 12ul, DIGEST_LEN>;
+
 } // namespace esch384
@@ -0,0 +1,504 @@
+#pragma once
+#include <cstring>
+
+#include "esch.hpp"
+#include "schwaemm.hpp"
+
+// Fused SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256} & Esch{256, 384} hash,
+// where each plain text block is read from memory only once, while it's
+// consumed by both AEAD and hash permutation states
+//
+// Encrypt-and-hash produces cipher text, authentication tag & digest of plain
+// text ( say for content based deduplication ), while decrypt-and-hash
+// produces decrypted text & its digest, in a single pass over the data.
+// Computed cipher text/ tag and digest are exactly same as what separate
+// aead::{encrypt, decrypt} and esch{256, 384}::hash calls produce.
+namespace fused {
+
+// Generic routine for consuming non-empty plain text into permutation state of
+// SchwaemmX-Y AEAD, while producing equal many cipher text bytes, which also
+// absorbs same plain text into permutation state of Esch{256, 384} hash &
+// squeezes digest out; see aead::process_text for meaning of first seven
+// template parameters, while next four are # -of branches, # -of steps in slim
+// & big variant of Sparkle permutation & byte length of digest, of the hash.
+template<const size_t RATE,
+         const size_t CAPACITY,
+         const uint32_t CONST_M0,
+         const uint32_t CONST_M1,
+         const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t h_nb,
+         const size_t h_slim,
+         const size_t h_big,
+         const size_t dlen>
+static inline void
+process_text(uint32_t* const __restrict state,  // AEAD permutation state
+             uint32_t* const __restrict hstate, // hash permutation state
+             const uint8_t* const txt,          // N (>0) -bytes plain text
+             uint8_t* const enc,                // N (>0) -bytes encrypted text
+             const size_t ct_len,               // len(txt) = len(enc) = N
+             uint8_t* const __restrict digest   // dlen -bytes digest
+)
+{
+  constexpr size_t RATE_W = RATE >> 2;       // # -of 32 -bit words
+  constexpr size_t HRATE_W = hash::RATE >> 2; // # -of 32 -bit words
+
+  uint32_t buffer0[RATE_W];
+  uint32_t buffer1[RATE_W];
+
+  // words of plain text, not yet absorbed into hash state, because they don't
+  // fill a full hash block ( only when RATE isn't multiple of 16 -bytes )
+  uint32_t pending[RATE_W + HRATE_W];
+  size_t p_cnt = 0;
+
+  // process full message blocks, except last one ( even if that's full )
+  size_t r_bytes = ct_len;
+  while (r_bytes > RATE) {
+    const size_t b_off = ct_len - r_bytes;
+
+    sparkle_utils::copy_le_bytes_to_words<RATE>(txt + b_off, buffer0);
+
+    // more plain text follows, so all full hash blocks can be absorbed
+    if constexpr ((RATE % hash::RATE) == 0) {
+      for (size_t i = 0; i < RATE_W; i += HRATE_W) {
+        hash::absorb<h_nb, h_slim>(hstate, buffer0 + i);
+      }
+    } else {
+      std::memcpy(pending + p_cnt, buffer0, RATE);
+      p_cnt += RATE_W;
+
+      size_t i = 0;
+      for (; (p_cnt - i) >= HRATE_W; i += HRATE_W) {
+        hash::absorb<h_nb, h_slim>(hstate, pending + i);
+      }
+
+      std::memmove(pending, pending + i, (p_cnt - i) << 2);
+      p_cnt -= i;
+    }
+
+    std::memcpy(buffer1, state, RATE);
+    aead::rho2<RATE>(buffer1, buffer0);
+    sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, enc + b_off);
+
+    aead::rho1<RATE>(state, buffer0);
+    aead::whiten_rate<RATE, CAPACITY>(state);
+    sparkle::sparkle<nb, ns_slim>(state);
+
+    r_bytes -= RATE;
+  }
+
+  const size_t b_off = ct_len - r_bytes;
+
+  // collect plain text bytes, still to be hashed, before ( possibly in-place )
+  // encryption of last block overwrites them
+  uint8_t tail[hash::RATE + RATE];
+  const size_t p_len = p_cnt << 2;
+
+  sparkle_utils::copy_words_to_le_bytes(pending, tail, p_len);
+  std::memcpy(tail + p_len, txt + b_off, r_bytes);
+
+  // process last message block, it can be full/ partially filled
+  aead::process_text<RATE, CAPACITY, CONST_M0, CONST_M1, nb, ns_slim, ns_big>(
+    state, txt + b_off, enc + b_off, r_bytes);
+
+  const size_t t_len = p_len + r_bytes;
+  size_t t_off = 0;
+
+  for (; (t_len - t_off) > hash::RATE; t_off += hash::RATE) {
+    sparkle_utils::copy_le_bytes_to_words<hash::RATE>(tail + t_off, buffer1);
+    hash::absorb<h_nb, h_slim>(hstate, buffer1);
+  }
+
+  hash::finalize<h_nb, h_slim, h_big, dlen>(
+    hstate, tail + t_off, t_len - t_off, digest);
+}
+
+// Generic routine for consuming non-empty encrypted text into permutation
+// state of SchwaemmX-Y AEAD, while producing equal many decrypted text bytes,
+// which also absorbs decrypted text into permutation state of Esch{256, 384}
+// hash & squeezes digest out; see fused::process_text for meaning of template
+// parameters.
+template<const size_t RATE,
+         const size_t CAPACITY,
+         const uint32_t CONST_M0,
+         const uint32_t CONST_M1,
+         const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t h_nb,
+         const size_t h_slim,
+         const size_t h_big,
+         const size_t dlen>
+static inline void
+process_cipher(uint32_t* const __restrict state,  // AEAD permutation state
+               uint32_t* const __restrict hstate, // hash permutation state
+               const uint8_t* const enc,          // N (>0) -bytes encrypted
+               uint8_t* const dec,                // N (>0) -bytes decrypted
+               const size_t ct_len,               // len(enc) = len(dec) = N
+               uint8_t* const __restrict digest   // dlen -bytes digest
+)
+{
+  constexpr size_t RATE_W = RATE >> 2;       // # -of 32 -bit words
+  constexpr size_t HRATE_W = hash::RATE >> 2; // # -of 32 -bit words
+
+  uint32_t buffer0[RATE_W];
+  uint32_t buffer1[RATE_W];
+
+  // words of decrypted text, not yet absorbed into hash state, because they
+  // don't fill a full hash block ( only when RATE isn't multiple of 16 -bytes )
+  uint32_t pending[RATE_W + HRATE_W];
+  size_t p_cnt = 0;
+
+  // process full message blocks, except last one ( even if that's full )
+  size_t r_bytes = ct_len;
+  while (r_bytes > RATE) {
+    const size_t b_off = ct_len - r_bytes;
+
+    sparkle_utils::copy_le_bytes_to_words<RATE>(enc + b_off, buffer0);
+    std::memcpy(buffer1, state, RATE);
+    aead::rhoprime2<RATE>(buffer1, buffer0);
+    sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, dec + b_off);
+
+    // more decrypted text follows, so all full hash blocks can be absorbed
+    if constexpr ((RATE % hash::RATE) == 0) {
+      for (size_t i = 0; i < RATE_W; i += HRATE_W) {
+        hash::absorb<h_nb, h_slim>(hstate, buffer1 + i);
+      }
+    } else {
+      std::memcpy(pending + p_cnt, buffer1, RATE);
+      p_cnt += RATE_W;
+
+      size_t i = 0;
+      for (; (p_cnt - i) >= HRATE_W; i += HRATE_W) {
+        hash::absorb<h_nb, h_slim>(hstate, pending + i);
+      }
+
+      std::memmove(pending, pending + i, (p_cnt - i) << 2);
+      p_cnt -= i;
+    }
+
+    aead::rhoprime1<RATE>(state, buffer0);
+    aead::whiten_rate<RATE, CAPACITY>(state);
+    sparkle::sparkle<nb, ns_slim>(state);
+
+    r_bytes -= RATE;
+  }
+
+  const size_t b_off = ct_len - r_bytes;
+
+  // process last message block, it can be full/ partially filled
+  aead::process_cipher<RATE, CAPACITY, CONST_M0, CONST_M1, nb, ns_slim, ns_big>(
+    state, enc + b_off, dec + b_off, r_bytes);
+
+  // collect decrypted text bytes, still to be hashed
+  uint8_t tail[hash::RATE + RATE];
+  const size_t p_len = p_cnt << 2;
+
+  sparkle_utils::copy_words_to_le_bytes(pending, tail, p_len);
+  std::memcpy(tail + p_len, dec + b_off, r_bytes);
+
+  const size_t t_len = p_len + r_bytes;
+  size_t t_off = 0;
+
+  for (; (t_len - t_off) > hash::RATE; t_off += hash::RATE) {
+    sparkle_utils::copy_le_bytes_to_words<hash::RATE>(tail + t_off, buffer1);
+    hash::absorb<h_nb, h_slim>(hstate, buffer1);
+  }
+
+  hash::finalize<h_nb, h_slim, h_big, dlen>(
+    hstate, tail + t_off, t_len - t_off, digest);
+}
+
+// Generic encrypt-and-hash routine, which can be used with SchwaemmX-Y AEAD |
+// X, Y ∈ {128, 192, 256} & Esch{256, 384} hash; see aead::encrypt for meaning
+// of first nine template parameters, while next four are # -of branches, # -of
+// steps in slim & big variant of Sparkle permutation & byte length of digest,
+// of the hash.
+//
+// Given C -bytes secret key, R -bytes nonce, N (>=0) -bytes associated data &
+// M (>=0) -bytes plain text, this routine computes M -bytes cipher text, C
+// -bytes authentication tag & dlen -bytes digest of plain text. Note, `txt` &
+// `enc` can point to same memory, for in-place encryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t HBR,
+         const size_t HS,
+         const size_t HB,
+         const size_t D>
+static inline void
+encrypt(const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // R -bytes nonce
+        const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
+        const size_t d_len,                    // len(data) = N | N >= 0
+        const uint8_t* const txt,              // M (>=0) -bytes plain text
+        uint8_t* const enc,                    // M (>=0) -bytes cipher text
+        const size_t ct_len,                   // len(txt) = len(enc) = M
+        uint8_t* const __restrict tag,         // C -bytes authentication tag
+        uint8_t* const __restrict digest       // D -bytes digest of plain text
+)
+{
+  uint32_t state[BR << 1];
+  uint32_t hstate[HBR << 1]{};
+
+  aead::initialize<R, C, BR, B>(state, key, nonce);
+
+  if (d_len > 0) {
+    aead::process_data<R, C, A0, A1, BR, S, B>(state, data, d_len);
+  }
+  if (ct_len > 0) {
+    process_text<R, C, M0, M1, BR, S, B, HBR, HS, HB, D>(
+      state, hstate, txt, enc, ct_len, digest);
+  } else {
+    const uint8_t empty[1]{};
+    hash::finalize<HBR, HS, HB, D>(hstate, empty, 0, digest);
+  }
+
+  aead::finalize<R, C>(state, key, tag);
+}
+
+// Generic decrypt-and-hash routine, which can be used with SchwaemmX-Y AEAD |
+// X, Y ∈ {128, 192, 256} & Esch{256, 384} hash; see fused::encrypt for
+// meaning of template parameters.
+//
+// Given C -bytes secret key, R -bytes nonce, C -bytes authentication tag, N
+// (>=0) -bytes associated data & M (>=0) -bytes cipher text, this routine
+// computes M -bytes decrypted text & dlen -bytes digest of it, returning
+// boolean verification flag. On verification failure, both decrypted text &
+// digest are zeroed. Note, `enc` & `dec` can point to same memory, for
+// in-place decryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t HBR,
+         const size_t HS,
+         const size_t HB,
+         const size_t D>
+static inline bool
+decrypt(const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // R -bytes nonce
+        const uint8_t* const __restrict tag,   // C -bytes authentication tag
+        const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
+        const size_t d_len,                    // len(data) = N | N >= 0
+        const uint8_t* const enc,              // M (>=0) -bytes encrypted text
+        uint8_t* const dec,                    // M (>=0) -bytes decrypted text
+        const size_t ct_len,                   // len(enc) = len(dec) = M
+        uint8_t* const __restrict digest       // D -bytes digest of plain text
+)
+{
+  uint32_t state[BR << 1];
+  uint32_t hstate[HBR << 1]{};
+  uint8_t tag_[C];
+
+  aead::initialize<R, C, BR, B>(state, key, nonce);
+
+  if (d_len > 0) {
+    aead::process_data<R, C, A0, A1, BR, S, B>(state, data, d_len);
+  }
+  if (ct_len > 0) {
+    process_cipher<R, C, M0, M1, BR, S, B, HBR, HS, HB, D>(
+      state, hstate, enc, dec, ct_len, digest);
+  } else {
+    const uint8_t empty[1]{};
+    hash::finalize<HBR, HS, HB, D>(hstate, empty, 0, digest);
+  }
+
+  aead::finalize<R, C>(state, key, tag_);
+
+  bool flag = false;
+  for (size_t i = 0; i < C; i++) {
+    flag |= (tag[i] ^ tag_[i]);
+  }
+
+  // don't release unverified plain text, neither its digest
+  std::memset(dec, 0, flag * ct_len);
+  std::memset(digest, 0, flag * D);
+  return !flag;
+}
+
+} // namespace fused
+
+// Fused Schwaemm256-128 AEAD & Esch256 hash
+namespace schwaemm256_128 {
+
+// Schwaemm256-128 authenticated encryption, which also computes Esch256
+// digest of plain text, in a single pass; see fused::encrypt
+static inline void
+encrypt_and_hash(const uint8_t* const __restrict key,   // 16 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 32 -bytes nonce
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const txt,              // M (>=0) -bytes text
+                 uint8_t* const enc,                    // M (>=0) -bytes cipher
+                 const size_t ct_len,                   // len(txt) = M
+                 uint8_t* const __restrict tag,         // 16 -bytes tag
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  fused::encrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, data, d_len, txt, enc, ct_len, tag, digest);
+}
+
+// Schwaemm256-128 verified decryption, which also computes Esch256 digest of
+// decrypted text, in a single pass; see fused::decrypt
+static inline bool
+decrypt_and_hash(const uint8_t* const __restrict key,   // 16 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 32 -bytes nonce
+                 const uint8_t* const __restrict tag,   // 16 -bytes tag
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const enc,              // M (>=0) -bytes cipher
+                 uint8_t* const dec,                    // M (>=0) -bytes text
+                 const size_t ct_len,                   // len(enc) = M
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  return fused::decrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, tag, data, d_len, enc, dec, ct_len, digest);
+}
+
+}
+
+// Fused Schwaemm192-192 AEAD & Esch256 hash
+namespace schwaemm192_192 {
+
+// Schwaemm192-192 authenticated encryption, which also computes Esch256
+// digest of plain text, in a single pass; see fused::encrypt
+static inline void
+encrypt_and_hash(const uint8_t* const __restrict key,   // 24 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 24 -bytes nonce
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const txt,              // M (>=0) -bytes text
+                 uint8_t* const enc,                    // M (>=0) -bytes cipher
+                 const size_t ct_len,                   // len(txt) = M
+                 uint8_t* const __restrict tag,         // 24 -bytes tag
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  fused::encrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, data, d_len, txt, enc, ct_len, tag, digest);
+}
+
+// Schwaemm192-192 verified decryption, which also computes Esch256 digest of
+// decrypted text, in a single pass; see fused::decrypt
+static inline bool
+decrypt_and_hash(const uint8_t* const __restrict key,   // 24 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 24 -bytes nonce
+                 const uint8_t* const __restrict tag,   // 24 -bytes tag
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const enc,              // M (>=0) -bytes cipher
+                 uint8_t* const dec,                    // M (>=0) -bytes text
+                 const size_t ct_len,                   // len(enc) = M
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  return fused::decrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, tag, data, d_len, enc, dec, ct_len, digest);
+}
+
+}
+
+// Fused Schwaemm128-128 AEAD & Esch256 hash
+namespace schwaemm128_128 {
+
+// Schwaemm128-128 authenticated encryption, which also computes Esch256
+// digest of plain text, in a single pass; see fused::encrypt
+static inline void
+encrypt_and_hash(const uint8_t* const __restrict key,   // 16 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 16 -bytes nonce
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const txt,              // M (>=0) -bytes text
+                 uint8_t* const enc,                    // M (>=0) -bytes cipher
+                 const size_t ct_len,                   // len(txt) = M
+                 uint8_t* const __restrict tag,         // 16 -bytes tag
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  fused::encrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, data, d_len, txt, enc, ct_len, tag, digest);
+}
+
+// Schwaemm128-128 verified decryption, which also computes Esch256 digest of
+// decrypted text, in a single pass; see fused::decrypt
+static inline bool
+decrypt_and_hash(const uint8_t* const __restrict key,   // 16 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 16 -bytes nonce
+                 const uint8_t* const __restrict tag,   // 16 -bytes tag
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const enc,              // M (>=0) -bytes cipher
+                 uint8_t* const dec,                    // M (>=0) -bytes text
+                 const size_t ct_len,                   // len(enc) = M
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  return fused::decrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, tag, data, d_len, enc, dec, ct_len, digest);
+}
+
+}
+
+// Fused Schwaemm256-256 AEAD & Esch256 hash
+namespace schwaemm256_256 {
+
+// Schwaemm256-256 authenticated encryption, which also computes Esch256
+// digest of plain text, in a single pass; see fused::encrypt
+static inline void
+encrypt_and_hash(const uint8_t* const __restrict key,   // 32 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 32 -bytes nonce
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const txt,              // M (>=0) -bytes text
+                 uint8_t* const enc,                    // M (>=0) -bytes cipher
+                 const size_t ct_len,                   // len(txt) = M
+                 uint8_t* const __restrict tag,         // 32 -bytes tag
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  fused::encrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, data, d_len, txt, enc, ct_len, tag, digest);
+}
+
+// Schwaemm256-256 verified decryption, which also computes Esch256 digest of
+// decrypted text, in a single pass; see fused::decrypt
+static inline bool
+decrypt_and_hash(const uint8_t* const __restrict key,   // 32 -bytes secret key
+                 const uint8_t* const __restrict nonce, // 32 -bytes nonce
+                 const uint8_t* const __restrict tag,   // 32 -bytes tag
+                 const uint8_t* const __restrict data,  // N (>=0) -bytes AD
+                 const size_t d_len,                    // len(data) = N
+                 const uint8_t* const enc,              // M (>=0) -bytes cipher
+                 uint8_t* const dec,                    // M (>=0) -bytes text
+                 const size_t ct_len,                   // len(enc) = M
+                 uint8_t* const __restrict digest       // 32 -bytes digest
+)
+{
+  // Esch256 uses Sparkle384 i.e. 6 branches, with 7/ 11 steps
+  return fused::decrypt<R, C, A0, A1, M0, M1, BR, S, B, 6, 7, 11, 32>(
+    key, nonce, tag, data, d_len, enc, dec, ct_len, digest);
+}
+
+}
@@ -1,5 +1,8 @@
 #pragma once
+#include <cstring>
+
 #include "sparkle.hpp"
+#include "utils.hpp"
 
 // Common routines used from hash functions Esch256 & Esch384, which are based
 // on Sparkle permutation
@@ -81,4 +84,137 @@ feistel(uint32_t* const __restrict state, const uint32_t* const __restrict msg)
   }
 }
 
+// Absorbs one 128 -bit message block ( which must not be the last one ) into
+// permutation state of Esch256 ( nb = 6 ) or Esch384 ( nb = 8 ), by mixing it
+// in using ℳ3/ ℳ4 & applying slim variant of Sparkle permutation
+template<const size_t nb, const size_t ns_slim>
+static inline void
+absorb(uint32_t* const __restrict state,    // (nb << 1) -many words
+       const uint32_t* const __restrict msg // 4 -many words
+)
+{
+  feistel<nb << 6>(state, msg);
+  sparkle::sparkle<nb, ns_slim>(state);
+}
+
+// Absorbs last message block of [0, 16] -bytes ( padding it, if it's not full )
+// into permutation state of Esch256 ( nb = 6 ) or Esch384 ( nb = 8 ), using big
+// variant of Sparkle permutation, before squeezing dlen -bytes digest out
+//
+// See algorithm 2.{9, 10} of Sparkle specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/sparkle-spec-final.pdf
+template<const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t dlen>
+static inline void
+finalize(uint32_t* const __restrict state,   // (nb << 1) -many words
+         const uint8_t* const __restrict in, // last message block
+         const size_t ilen,                  // len(in) | <= 16
+         uint8_t* const __restrict out       // dlen -bytes digest
+)
+{
+  static_assert(dlen % RATE == 0, "Digest must be multiple of 16 -bytes");
+
+  uint8_t blk[RATE]{};
+  std::memcpy(blk, in, ilen);
+  if (ilen < RATE) {
+    blk[ilen] = 0x80;
+  }
+
+  uint32_t buffer[RATE >> 2];
+  sparkle_utils::copy_le_bytes_to_words<RATE>(blk, buffer);
+
+  constexpr uint32_t consts[]{ CONST_M1, CONST_M0 };
+  state[nb - 1] ^= consts[ilen < RATE];
+
+  feistel<nb << 6>(state, buffer);
+  sparkle::sparkle<nb, ns_big>(state);
+
+  sparkle_utils::copy_words_to_le_bytes<RATE>(state, out);
+  for (size_t off = RATE; off < dlen; off += RATE) {
+    sparkle::sparkle<nb, ns_slim>(state);
+    sparkle_utils::copy_words_to_le_bytes<RATE>(state, out + off);
+  }
+}
+
+// Incremental Esch256 ( nb = 6 ) or Esch384 ( nb = 8 ) hasher, which absorbs
+// message in arbitrary sized pieces & produces same digest, as hashing whole
+// message at once does
+//
+// Last message block is processed differently ( see `finalize` above ), so up
+// to 16 -bytes of message are kept buffered, until either more message bytes
+// arrive or digest is requested.
+template<const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t dlen>
+class hasher
+{
+public:
+  // Byte length of digest
+  static constexpr size_t DIGEST_LEN = dlen;
+
+  hasher() = default;
+
+  // Absorbs next N (>=0) -bytes of message; must not be called after digest
+  // is computed
+  void absorb(const uint8_t* const __restrict in, // N (>=0) -bytes message
+              const size_t ilen                   // len(in) = N | N >= 0
+  )
+  {
+    if (ilen == 0) {
+      return;
+    }
+
+    size_t off = 0;
+
+    // complete buffered block, but only absorb it when more bytes follow
+    if (buf_len > 0) {
+      const size_t take = std::min(RATE - buf_len, ilen);
+      std::memcpy(buf + buf_len, in, take);
+      buf_len += take;
+      off += take;
+
+      if ((buf_len < RATE) || (off == ilen)) {
+        return;
+      }
+
+      uint32_t words[RATE >> 2];
+      sparkle_utils::copy_le_bytes_to_words<RATE>(buf, words);
+      hash::absorb<nb, ns_slim>(state, words);
+      buf_len = 0;
+    }
+
+    // absorb full blocks, as long as at least one more byte follows them
+    while ((ilen - off) > RATE) {
+      uint32_t words[RATE >> 2];
+      sparkle_utils::copy_le_bytes_to_words<RATE>(in + off, words);
+      hash::absorb<nb, ns_slim>(state, words);
+      off += RATE;
+    }
+
+    std::memcpy(buf, in + off, ilen - off);
+    buf_len = ilen - off;
+  }
+
+  // Computes dlen -bytes digest of all absorbed message bytes
+  void finalize(uint8_t* const __restrict out /* dlen -bytes digest */)
+  {
+    hash::finalize<nb, ns_slim, ns_big, dlen>(state, buf, buf_len, out);
+  }
+
+  // Resets hasher, so that a new message can be absorbed
+  void reset()
+  {
+    std::memset(state, 0, sizeof(state));
+    buf_len = 0;
+  }
+
+private:
+  uint32_t state[nb << 1]{};
+  uint8_t buf[RATE]{};
+  size_t buf_len = 0;
+};
+
 } // namespace hash
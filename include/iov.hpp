@@ -0,0 +1,561 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <sys/uio.h>
+
+#include "schwaemm.hpp"
+
+// Scatter-gather variant of SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}, where
+// associated data, input & output texts are given as POSIX I/O vectors ( i.e.
+// chained buffers, as produced by readv(2)/ recvmsg(2) ), instead of
+// contiguous byte arrays
+//
+// Rate blocks, which are fully contained in a single fragment, are read from &
+// written to that fragment directly, while only those blocks, which straddle a
+// fragment boundary, are gathered into ( or scattered from ) a small stack
+// buffer. So a packet, received as a chain of buffers, can be decrypted into
+// application buffers without first linearizing it. Produced cipher text &
+// authentication tag are same as what aead::encrypt computes over
+// concatenation of fragments.
+namespace iov {
+
+// Returns total byte length of `cnt` -many fragments
+static inline size_t
+length(const struct iovec* const vec, const size_t cnt)
+{
+  size_t len = 0;
+  for (size_t i = 0; i < cnt; i++) {
+    len += vec[i].iov_len;
+  }
+  return len;
+}
+
+// Position inside a sequence of fragments, from where next byte is to be read/
+// written
+struct cursor
+{
+  const struct iovec* vec; // fragments
+  size_t cnt;              // # -of fragments
+  size_t idx = 0;          // index of current fragment
+  size_t off = 0;          // byte offset inside current fragment
+
+  cursor(const struct iovec* const vec, const size_t cnt)
+    : vec(vec)
+    , cnt(cnt)
+  {
+    skip_empty();
+  }
+
+  // Returns pointer to next n -bytes, if they're contiguous in current
+  // fragment, otherwise returns nullptr
+  uint8_t* contiguous(const size_t n) const
+  {
+    if ((idx < cnt) && ((vec[idx].iov_len - off) >= n)) {
+      return static_cast<uint8_t*>(vec[idx].iov_base) + off;
+    }
+    return nullptr;
+  }
+
+  // Moves cursor forward by n -bytes, which must be available
+  void advance(size_t n)
+  {
+    while (n > 0) {
+      const size_t m = std::min(n, vec[idx].iov_len - off);
+
+      off += m;
+      n -= m;
+      skip_empty();
+    }
+  }
+
+  // Copies next n -bytes to `dst`, while moving cursor forward
+  void read(uint8_t* const dst, const size_t n)
+  {
+    size_t done = 0;
+    while (done < n) {
+      const size_t m = std::min(n - done, vec[idx].iov_len - off);
+      const uint8_t* const src = static_cast<const uint8_t*>(vec[idx].iov_base);
+
+      std::memcpy(dst + done, src + off, m);
+      done += m;
+      advance(m);
+    }
+  }
+
+  // Copies n -bytes from `src` to next n -bytes, while moving cursor forward
+  void write(const uint8_t* const src, const size_t n)
+  {
+    size_t done = 0;
+    while (done < n) {
+      const size_t m = std::min(n - done, vec[idx].iov_len - off);
+      uint8_t* const dst = static_cast<uint8_t*>(vec[idx].iov_base);
+
+      std::memcpy(dst + off, src + done, m);
+      done += m;
+      advance(m);
+    }
+  }
+
+  // Zeros next n -bytes, while moving cursor forward
+  void zero(const size_t n)
+  {
+    size_t done = 0;
+    while (done < n) {
+      const size_t m = std::min(n - done, vec[idx].iov_len - off);
+      uint8_t* const dst = static_cast<uint8_t*>(vec[idx].iov_base);
+
+      std::memset(dst + off, 0, m);
+      done += m;
+      advance(m);
+    }
+  }
+
+private:
+  // Moves to next fragment, if current one is exhausted
+  void skip_empty()
+  {
+    while ((idx < cnt) && (off == vec[idx].iov_len)) {
+      idx++;
+      off = 0;
+    }
+  }
+};
+
+// Returns pointer to next n -bytes of input, which points into current
+// fragment when those bytes are contiguous there, otherwise they're gathered
+// into `buf` ( of n -bytes ), while moving cursor forward
+static inline const uint8_t*
+gather(cursor& in, uint8_t* const buf, const size_t n)
+{
+  const uint8_t* ptr = in.contiguous(n);
+  if (ptr != nullptr) {
+    in.advance(n);
+    return ptr;
+  }
+
+  in.read(buf, n);
+  return buf;
+}
+
+// Consumes non-empty, fragmented associated data into permutation state; see
+// aead::process_data for meaning of template parameters
+template<const size_t RATE,
+         const size_t CAPACITY,
+         const uint32_t CONST_A0,
+         const uint32_t CONST_A1,
+         const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big>
+static inline void
+process_data(uint32_t* const __restrict state, // permutation state
+             cursor& data,                     // N (>0) -bytes associated data
+             const size_t d_len                // len(data) = N | N > 0
+)
+{
+  constexpr size_t RATE_W = RATE >> 2; // # -of 32 -bit words
+
+  uint32_t buffer0[RATE_W];
+  uint8_t blk[RATE];
+
+  // process full blocks, except last one ( even if that's full )
+  size_t r_bytes = d_len;
+  while (r_bytes > RATE) {
+    const uint8_t* const in = gather(data, blk, RATE);
+
+    sparkle_utils::copy_le_bytes_to_words<RATE>(in, buffer0);
+    aead::rho1<RATE>(state, buffer0);
+    aead::whiten_rate<RATE, CAPACITY>(state);
+    sparkle::sparkle<nb, ns_slim>(state);
+
+    r_bytes -= RATE;
+  }
+
+  // last block, it can be full/ partially filled
+  data.read(blk, r_bytes);
+  aead::process_data<RATE, CAPACITY, CONST_A0, CONST_A1, nb, ns_slim, ns_big>(
+    state, blk, r_bytes);
+}
+
+// Consumes non-empty, fragmented plain text into permutation state, while
+// scattering equal many cipher text bytes; see aead::process_text for meaning
+// of template parameters
+template<const size_t RATE,
+         const size_t CAPACITY,
+         const uint32_t CONST_M0,
+         const uint32_t CONST_M1,
+         const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big>
+static inline void
+process_text(uint32_t* const __restrict state, // permutation state
+             cursor& txt,                      // N (>0) -bytes plain text
+             cursor& enc,                      // N (>0) -bytes encrypted text
+             const size_t ct_len // len(txt) = len(enc) = N | N > 0
+)
+{
+  constexpr size_t RATE_W = RATE >> 2; // # -of 32 -bit words
+
+  uint32_t buffer0[RATE_W];
+  uint32_t buffer1[RATE_W];
+  uint8_t iblk[RATE];
+  uint8_t oblk[RATE];
+
+  // process full blocks, except last one ( even if that's full )
+  size_t r_bytes = ct_len;
+  while (r_bytes > RATE) {
+    const uint8_t* const in = gather(txt, iblk, RATE);
+    sparkle_utils::copy_le_bytes_to_words<RATE>(in, buffer0);
+
+    std::memcpy(buffer1, state, RATE);
+    aead::rho2<RATE>(buffer1, buffer0);
+
+    uint8_t* const out = enc.contiguous(RATE);
+    if (out != nullptr) {
+      sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, out);
+      enc.advance(RATE);
+    } else {
+      sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, oblk);
+      enc.write(oblk, RATE);
+    }
+
+    aead::rho1<RATE>(state, buffer0);
+    aead::whiten_rate<RATE, CAPACITY>(state);
+    sparkle::sparkle<nb, ns_slim>(state);
+
+    r_bytes -= RATE;
+  }
+
+  // last block, it can be full/ partially filled
+  txt.read(iblk, r_bytes);
+  aead::process_text<RATE, CAPACITY, CONST_M0, CONST_M1, nb, ns_slim, ns_big>(
+    state, iblk, oblk, r_bytes);
+  enc.write(oblk, r_bytes);
+}
+
+// Consumes non-empty, fragmented cipher text into permutation state, while
+// scattering equal many decrypted text bytes; see aead::process_cipher for
+// meaning of template parameters
+template<const size_t RATE,
+         const size_t CAPACITY,
+         const uint32_t CONST_M0,
+         const uint32_t CONST_M1,
+         const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big>
+static inline void
+process_cipher(uint32_t* const __restrict state, // permutation state
+               cursor& enc,                      // N (>0) -bytes encrypted text
+               cursor& dec,                      // N (>0) -bytes decrypted text
+               const size_t ct_len // len(enc) = len(dec) = N | N > 0
+)
+{
+  constexpr size_t RATE_W = RATE >> 2; // # -of 32 -bit words
+
+  uint32_t buffer0[RATE_W];
+  uint32_t buffer1[RATE_W];
+  uint8_t iblk[RATE];
+  uint8_t oblk[RATE];
+
+  // process full blocks, except last one ( even if that's full )
+  size_t r_bytes = ct_len;
+  while (r_bytes > RATE) {
+    const uint8_t* const in = gather(enc, iblk, RATE);
+    sparkle_utils::copy_le_bytes_to_words<RATE>(in, buffer0);
+
+    std::memcpy(buffer1, state, RATE);
+    aead::rhoprime2<RATE>(buffer1, buffer0);
+
+    uint8_t* const out = dec.contiguous(RATE);
+    if (out != nullptr) {
+      sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, out);
+      dec.advance(RATE);
+    } else {
+      sparkle_utils::copy_words_to_le_bytes<RATE>(buffer1, oblk);
+      dec.write(oblk, RATE);
+    }
+
+    aead::rhoprime1<RATE>(state, buffer0);
+    aead::whiten_rate<RATE, CAPACITY>(state);
+    sparkle::sparkle<nb, ns_slim>(state);
+
+    r_bytes -= RATE;
+  }
+
+  // last block, it can be full/ partially filled
+  enc.read(iblk, r_bytes);
+  aead::process_cipher<RATE, CAPACITY, CONST_M0, CONST_M1, nb, ns_slim, ns_big>(
+    state, iblk, oblk, r_bytes);
+  dec.write(oblk, r_bytes);
+}
+
+// Scatter-gather authenticated encryption routine, which can be used with
+// SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of
+// template parameters.
+//
+// Plain text & cipher text can be fragmented differently, but their total
+// byte lengths must match, otherwise this routine returns false, without
+// touching output buffers. Plain text & cipher text fragments can point to same
+// memory ( as long as they're fragmented same way ), for in-place encryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+encrypt(const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // R -bytes nonce
+        const struct iovec* const data,        // associated data fragments
+        const size_t d_cnt,                    // # -of AD fragments
+        const struct iovec* const txt,         // plain text fragments
+        const size_t t_cnt,                    // # -of plain text fragments
+        const struct iovec* const enc,         // cipher text fragments
+        const size_t e_cnt,                    // # -of cipher text fragments
+        uint8_t* const __restrict tag          // C -bytes authentication tag
+)
+{
+  const size_t d_len = length(data, d_cnt);
+  const size_t ct_len = length(txt, t_cnt);
+
+  if (length(enc, e_cnt) != ct_len) {
+    return false;
+  }
+
+  uint32_t state[BR << 1];
+
+  aead::initialize<R, C, BR, B>(state, key, nonce);
+
+  if (d_len > 0) {
+    cursor d{ data, d_cnt };
+    process_data<R, C, A0, A1, BR, S, B>(state, d, d_len);
+  }
+  if (ct_len > 0) {
+    cursor t{ txt, t_cnt };
+    cursor e{ enc, e_cnt };
+    process_text<R, C, M0, M1, BR, S, B>(state, t, e, ct_len);
+  }
+
+  aead::finalize<R, C>(state, key, tag);
+  return true;
+}
+
+// Scatter-gather verified decryption routine, which can be used with
+// SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of
+// template parameters.
+//
+// Cipher text & decrypted text can be fragmented differently, but their total
+// byte lengths must match, otherwise this routine returns false, without
+// touching output buffers. On verification failure, all decrypted text
+// fragments are zeroed. Cipher text & decrypted text fragments can point to
+// same memory ( as long as they're fragmented same way ), for in-place
+// decryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+decrypt(const uint8_t* const __restrict key,   // C -bytes secret key
+        const uint8_t* const __restrict nonce, // R -bytes nonce
+        const uint8_t* const __restrict tag,   // C -bytes authentication tag
+        const struct iovec* const data,        // associated data fragments
+        const size_t d_cnt,                    // # -of AD fragments
+        const struct iovec* const enc,         // cipher text fragments
+        const size_t e_cnt,                    // # -of cipher text fragments
+        const struct iovec* const dec,         // decrypted text fragments
+        const size_t t_cnt                     // # -of decrypted text fragments
+)
+{
+  const size_t d_len = length(data, d_cnt);
+  const size_t ct_len = length(enc, e_cnt);
+
+  if (length(dec, t_cnt) != ct_len) {
+    return false;
+  }
+
+  uint32_t state[BR << 1];
+  uint8_t tag_[C];
+
+  aead::initialize<R, C, BR, B>(state, key, nonce);
+
+  if (d_len > 0) {
+    cursor d{ data, d_cnt };
+    process_data<R, C, A0, A1, BR, S, B>(state, d, d_len);
+  }
+  if (ct_len > 0) {
+    cursor e{ enc, e_cnt };
+    cursor t{ dec, t_cnt };
+    process_cipher<R, C, M0, M1, BR, S, B>(state, e, t, ct_len);
+  }
+
+  aead::finalize<R, C>(state, key, tag_);
+
+  bool flag = false;
+  for (size_t i = 0; i < C; i++) {
+    flag |= (tag[i] ^ tag_[i]);
+  }
+
+  // don't release unverified plain text
+  if (flag) {
+    cursor t{ dec, t_cnt };
+    t.zero(ct_len);
+  }
+  return !flag;
+}
+
+} // namespace iov
+
+// Scatter-gather Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+static inline bool
+encryptv(const uint8_t* const __restrict key,   // 16 -bytes secret key
+         const uint8_t* const __restrict nonce, // 32 -bytes nonce
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const txt,         // plain text fragments
+         const size_t t_cnt,                    // # -of plain text fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         uint8_t* const __restrict tag          // 16 -bytes authentication tag
+)
+{
+  return iov::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+}
+
+static inline bool
+decryptv(const uint8_t* const __restrict key,   // 16 -bytes secret key
+         const uint8_t* const __restrict nonce, // 32 -bytes nonce
+         const uint8_t* const __restrict tag,   // 16 -bytes authentication tag
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         const struct iovec* const dec,         // decrypted text fragments
+         const size_t t_cnt                     // # -of decrypted fragments
+)
+{
+  return iov::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+}
+
+}
+
+// Scatter-gather Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+static inline bool
+encryptv(const uint8_t* const __restrict key,   // 24 -bytes secret key
+         const uint8_t* const __restrict nonce, // 24 -bytes nonce
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const txt,         // plain text fragments
+         const size_t t_cnt,                    // # -of plain text fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         uint8_t* const __restrict tag          // 24 -bytes authentication tag
+)
+{
+  return iov::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+}
+
+static inline bool
+decryptv(const uint8_t* const __restrict key,   // 24 -bytes secret key
+         const uint8_t* const __restrict nonce, // 24 -bytes nonce
+         const uint8_t* const __restrict tag,   // 24 -bytes authentication tag
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         const struct iovec* const dec,         // decrypted text fragments
+         const size_t t_cnt                     // # -of decrypted fragments
+)
+{
+  return iov::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+}
+
+}
+
+// Scatter-gather Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+static inline bool
+encryptv(const uint8_t* const __restrict key,   // 16 -bytes secret key
+         const uint8_t* const __restrict nonce, // 16 -bytes nonce
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const txt,         // plain text fragments
+         const size_t t_cnt,                    // # -of plain text fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         uint8_t* const __restrict tag          // 16 -bytes authentication tag
+)
+{
+  return iov::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+}
+
+static inline bool
+decryptv(const uint8_t* const __restrict key,   // 16 -bytes secret key
+         const uint8_t* const __restrict nonce, // 16 -bytes nonce
+         const uint8_t* const __restrict tag,   // 16 -bytes authentication tag
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         const struct iovec* const dec,         // decrypted text fragments
+         const size_t t_cnt                     // # -of decrypted fragments
+)
+{
+  return iov::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+}
+
+}
+
+// Scatter-gather Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+static inline bool
+encryptv(const uint8_t* const __restrict key,   // 32 -bytes secret key
+         const uint8_t* const __restrict nonce, // 32 -bytes nonce
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const txt,         // plain text fragments
+         const size_t t_cnt,                    // # -of plain text fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         uint8_t* const __restrict tag          // 32 -bytes authentication tag
+)
+{
+  return iov::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+}
+
+static inline bool
+decryptv(const uint8_t* const __restrict key,   // 32 -bytes secret key
+         const uint8_t* const __restrict nonce, // 32 -bytes nonce
+         const uint8_t* const __restrict tag,   // 32 -bytes authentication tag
+         const struct iovec* const data,        // associated data fragments
+         const size_t d_cnt,                    // # -of AD fragments
+         const struct iovec* const enc,         // cipher text fragments
+         const size_t e_cnt,                    // # -of cipher text fragments
+         const struct iovec* const dec,         // decrypted text fragments
+         const size_t t_cnt                     // # -of decrypted fragments
+)
+{
+  return iov::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+}
+
+}
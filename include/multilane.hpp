@@ -0,0 +1,637 @@
+#pragma once
+#include <cstring>
+
+#include "hash.hpp"
+#include "sparkle.hpp"
+#include "utils.hpp"
+
+// Multi-lane ( i.e. L -many independent instances, processed together )
+// Sparkle permutation, SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256} & Esch{256,
+// 384} hash
+//
+// Permutation state of all lanes is kept in word-sliced layout s.t. j -th
+// 32 -bit word of l -th lane lives at index j * L + l. This way each operation
+// of Sparkle permutation is applied on L consecutive words, which compiler
+// vectorizes using SIMD instructions available on target CPU.
+namespace multilane {
+
+// Default # -of lanes, which fills a 512 -bit ( when AVX512 is available ) or
+// 256 -bit SIMD register with 32 -bit words
+#if defined __AVX512F__
+constexpr size_t LANES = 16ul;
+#else
+constexpr size_t LANES = 8ul;
+#endif
+
+// ARX-box Alzette, applied on L -many lanes; see sparkle::alzette
+template<const size_t L>
+static inline void
+alzette(uint32_t* const __restrict x, // L -many left words
+        uint32_t* const __restrict y, // L -many right words
+        const uint32_t c              // round constant
+)
+{
+#if defined __clang__
+  // Following
+  // https://clang.llvm.org/docs/LanguageExtensions.html#extensions-for-loop-hint-optimizations
+
+#pragma clang loop vectorize(enable)
+#elif defined __GNUG__
+  // Following
+  // https://gcc.gnu.org/onlinedocs/gcc/Loop-Specific-Pragmas.html#Loop-Specific-Pragmas
+
+#pragma GCC ivdep
+#endif
+  for (size_t l = 0; l < L; l++) {
+    uint32_t lw = x[l] + std::rotr(y[l], 31);
+    uint32_t rw = y[l] ^ std::rotr(lw, 24);
+    lw ^= c;
+
+    lw = lw + std::rotr(rw, 17);
+    rw = rw ^ std::rotr(lw, 17);
+    lw ^= c;
+
+    lw = lw + rw;
+    rw = rw ^ std::rotr(lw, 31);
+    lw ^= c;
+
+    lw = lw + std::rotr(rw, 24);
+    rw = rw ^ std::rotr(lw, 16);
+    lw ^= c;
+
+    x[l] = lw;
+    y[l] = rw;
+  }
+}
+
+// Diffusion Layer `ℒ4`, `ℒ6` or `ℒ8` ( based on # -of branches ), applied on
+// L -many lanes; see sparkle::diffusion_layer_{4, 6, 8}
+template<const size_t nb, const size_t L>
+static inline void
+diffusion_layer(uint32_t* const state)
+{
+  constexpr size_t h = nb >> 1; // # -of branches in each half
+
+  uint32_t tx[L]{};
+  uint32_t ty[L]{};
+
+  for (size_t j = 0; j < h; j++) {
+    const uint32_t* const x = state + (2 * j + 0) * L;
+    const uint32_t* const y = state + (2 * j + 1) * L;
+
+    for (size_t l = 0; l < L; l++) {
+      tx[l] ^= x[l];
+      ty[l] ^= y[l];
+    }
+  }
+
+  for (size_t l = 0; l < L; l++) {
+    tx[l] = std::rotl(tx[l] ^ (tx[l] << 16), 16);
+    ty[l] = std::rotl(ty[l] ^ (ty[l] << 16), 16);
+  }
+
+  // feistel round
+
+  for (size_t j = 0; j < h; j++) {
+    const uint32_t* const lx = state + (2 * j + 0) * L;
+    const uint32_t* const ly = state + (2 * j + 1) * L;
+    uint32_t* const rx = state + (2 * (h + j) + 0) * L;
+    uint32_t* const ry = state + (2 * (h + j) + 1) * L;
+
+    for (size_t l = 0; l < L; l++) {
+      rx[l] ^= lx[l] ^ ty[l];
+      ry[l] ^= ly[l] ^ tx[l];
+    }
+  }
+
+  // branch permutation
+
+  uint32_t left[2 * h * L];
+  std::memcpy(left, state, sizeof(left));
+
+  for (size_t j = 0; j < h; j++) {
+    const size_t k = (j + 1) % h;
+
+    std::memcpy(state + 2 * j * L, state + 2 * (h + k) * L, 2 * L * 4);
+  }
+  std::memcpy(state + 2 * h * L, left, sizeof(left));
+}
+
+// Sparkle permutation, applied on L -many lanes, each of 32 * (nb * 2) -bit
+// state; see sparkle::sparkle
+template<const size_t nb, const size_t ns, const size_t L>
+static inline void
+sparkle(uint32_t* const state // 32 * (nb * 2) * L -bit wide word-sliced state
+        )
+  requires(sparkle::check_nb_ns(nb, ns))
+{
+  for (size_t i = 0; i < ns; i++) {
+    for (size_t l = 0; l < L; l++) {
+      state[1 * L + l] ^= sparkle::CONST[i & 7ul];
+      state[3 * L + l] ^= static_cast<uint32_t>(i);
+    }
+
+    for (size_t j = 0; j < nb; j++) {
+      uint32_t* const x = state + (2 * j + 0) * L;
+      uint32_t* const y = state + (2 * j + 1) * L;
+
+      alzette<L>(x, y, sparkle::CONST[j]);
+    }
+
+    diffusion_layer<nb, L>(state);
+  }
+}
+
+// Loads R -bytes ( or less, in case of last block, which is padded ) from each
+// lane's input into word-sliced block
+template<const size_t R, const size_t L>
+static inline void
+load_block(const uint8_t* const* const in, // L -many inputs
+           const size_t off,               // byte offset in each input
+           const size_t len,               // bytes to be loaded | <= R
+           uint32_t* const __restrict blk  // (R >> 2) * L -many words
+)
+{
+  constexpr size_t RW = R >> 2;
+
+  for (size_t l = 0; l < L; l++) {
+    uint8_t bytes[R]{};
+    uint32_t words[RW];
+
+    std::memcpy(bytes, in[l] + off, len);
+    if (len < R) {
+      bytes[len] = 0x80;
+    }
+    sparkle_utils::copy_le_bytes_to_words<R>(bytes, words);
+
+    for (size_t i = 0; i < RW; i++) {
+      blk[i * L + l] = words[i];
+    }
+  }
+}
+
+// Stores first `len` -bytes of word-sliced block into each lane's output
+template<const size_t R, const size_t L>
+static inline void
+store_block(const uint32_t* const __restrict blk, // (R >> 2) * L -many words
+            uint8_t* const* const out,            // L -many outputs
+            const size_t off,                     // byte offset in each output
+            const size_t len                      // bytes to be stored | <= R
+)
+{
+  constexpr size_t RW = R >> 2;
+
+  for (size_t l = 0; l < L; l++) {
+    uint32_t words[RW];
+    uint8_t bytes[R];
+
+    for (size_t i = 0; i < RW; i++) {
+      words[i] = blk[i * L + l];
+    }
+    sparkle_utils::copy_words_to_le_bytes<R>(words, bytes);
+
+    std::memcpy(out[l] + off, bytes, len);
+  }
+}
+
+// Feedback function `𝜌1` ( i.e. FeistelSwap on outer part of state, followed
+// by XOR-ing block ), applied on L -many lanes; see aead::rho1
+template<const size_t R, const size_t L>
+static inline void
+rho1(uint32_t* const __restrict state,    // word-sliced permutation state
+     const uint32_t* const __restrict blk // (R >> 2) * L -many words
+)
+{
+  constexpr size_t h = R >> 3; // # -of words in each half of outer part
+
+  for (size_t i = 0; i < h; i++) {
+    uint32_t* const s0 = state + i * L;
+    uint32_t* const s1 = state + (h + i) * L;
+    const uint32_t* const d0 = blk + i * L;
+    const uint32_t* const d1 = blk + (h + i) * L;
+
+    for (size_t l = 0; l < L; l++) {
+      const uint32_t a = s0[l];
+      const uint32_t b = s1[l];
+
+      s0[l] = b ^ d0[l];
+      s1[l] = a ^ b ^ d1[l];
+    }
+  }
+}
+
+// Rate whitening layer, applied on L -many lanes; see aead::whiten_rate
+template<const size_t R, const size_t C, const size_t L>
+static inline void
+whiten_rate(uint32_t* const state)
+{
+  constexpr size_t RW = R >> 2;
+  constexpr size_t CW = C >> 2;
+
+  for (size_t i = 0; i < RW; i++) {
+    const uint32_t* const src = state + (RW + (i % CW)) * L;
+    uint32_t* const dst = state + i * L;
+
+    for (size_t l = 0; l < L; l++) {
+      dst[l] ^= src[l];
+    }
+  }
+}
+
+// Initializes word-sliced permutation state of L -many lanes, consuming each
+// lane's C -bytes secret key & R -bytes nonce; see aead::initialize
+template<const size_t R,
+         const size_t C,
+         const size_t BR,
+         const size_t B,
+         const size_t L>
+static inline void
+initialize(uint32_t* const __restrict state, // word-sliced permutation state
+           const uint8_t* const* const key,  // L -many C -bytes keys
+           const uint8_t* const* const nonce // L -many R -bytes nonces
+)
+{
+  constexpr size_t RW = R >> 2;
+  constexpr size_t CW = C >> 2;
+
+  for (size_t l = 0; l < L; l++) {
+    uint32_t words[RW + CW];
+
+    sparkle_utils::copy_le_bytes_to_words<R>(nonce[l], words);
+    sparkle_utils::copy_le_bytes_to_words<C>(key[l], words + RW);
+
+    for (size_t i = 0; i < RW + CW; i++) {
+      state[i * L + l] = words[i];
+    }
+  }
+
+  sparkle<BR, B, L>(state);
+}
+
+// Consumes N (>0) -bytes associated data of each lane into word-sliced
+// permutation state; see aead::process_data
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L>
+static inline void
+process_data(uint32_t* const __restrict state, // word-sliced permutation state
+             const uint8_t* const* const data, // L -many N -bytes AD
+             const size_t d_len                // len(data[l]) = N | N > 0
+)
+{
+  uint32_t blk[(R >> 2) * L];
+
+  size_t off = 0;
+  while ((d_len - off) > R) {
+    load_block<R, L>(data, off, R, blk);
+    rho1<R, L>(state, blk);
+    whiten_rate<R, C, L>(state);
+    sparkle<BR, S, L>(state);
+
+    off += R;
+  }
+
+  const size_t len = d_len - off;
+  load_block<R, L>(data, off, len, blk);
+  rho1<R, L>(state, blk);
+
+  const uint32_t cnst = (len < R) ? A0 : A1;
+  for (size_t l = 0; l < L; l++) {
+    state[((BR << 1) - 1) * L + l] ^= cnst;
+  }
+
+  whiten_rate<R, C, L>(state);
+  sparkle<BR, B, L>(state);
+}
+
+// Consumes N (>0) -bytes plain text of each lane into word-sliced permutation
+// state, while producing equal many cipher text bytes; see aead::process_text
+//
+// Note, `txt[l]` & `enc[l]` are allowed to point to same memory.
+template<const size_t R,
+         const size_t C,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L>
+static inline void
+process_text(uint32_t* const __restrict state, // word-sliced permutation state
+             const uint8_t* const* const txt,  // L -many N -bytes plain text
+             uint8_t* const* const enc,        // L -many N -bytes cipher text
+             const size_t ct_len               // len(txt[l]) = N | N > 0
+)
+{
+  constexpr size_t RW = R >> 2;
+
+  uint32_t blk[RW * L];
+  uint32_t ct[RW * L];
+
+  size_t off = 0;
+  while (true) {
+    const size_t len = std::min(ct_len - off, R);
+    const bool last = (ct_len - off) <= R;
+
+    load_block<R, L>(txt, off, len, blk);
+
+    for (size_t i = 0; i < RW * L; i++) {
+      ct[i] = state[i] ^ blk[i];
+    }
+    store_block<R, L>(ct, enc, off, len);
+
+    rho1<R, L>(state, blk);
+
+    if (last) {
+      const uint32_t cnst = (len < R) ? M0 : M1;
+      for (size_t l = 0; l < L; l++) {
+        state[((BR << 1) - 1) * L + l] ^= cnst;
+      }
+
+      whiten_rate<R, C, L>(state);
+      sparkle<BR, B, L>(state);
+      break;
+    }
+
+    whiten_rate<R, C, L>(state);
+    sparkle<BR, S, L>(state);
+
+    off += R;
+  }
+}
+
+// Consumes N (>0) -bytes cipher text of each lane into word-sliced permutation
+// state, while producing equal many decrypted bytes; see aead::process_cipher
+//
+// Note, `enc[l]` & `dec[l]` are allowed to point to same memory.
+template<const size_t R,
+         const size_t C,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L>
+static inline void
+process_cipher(uint32_t* const __restrict state, // word-sliced state
+               const uint8_t* const* const enc,  // L -many N -bytes cipher text
+               uint8_t* const* const dec,        // L -many N -bytes plain text
+               const size_t ct_len               // len(enc[l]) = N | N > 0
+)
+{
+  constexpr size_t RW = R >> 2;
+
+  uint32_t blk[RW * L];
+  uint32_t pt[RW * L];
+
+  size_t off = 0;
+  while (true) {
+    const size_t len = std::min(ct_len - off, R);
+    const bool last = (ct_len - off) <= R;
+
+    load_block<R, L>(enc, off, len, blk);
+
+    for (size_t i = 0; i < RW * L; i++) {
+      pt[i] = state[i] ^ blk[i];
+    }
+    store_block<R, L>(pt, dec, off, len);
+
+    // padding of decrypted block must be recomputed, when it's not full
+    if (len < R) {
+      load_block<R, L>(dec, off, len, pt);
+    }
+
+    rho1<R, L>(state, pt);
+
+    if (last) {
+      const uint32_t cnst = (len < R) ? M0 : M1;
+      for (size_t l = 0; l < L; l++) {
+        state[((BR << 1) - 1) * L + l] ^= cnst;
+      }
+
+      whiten_rate<R, C, L>(state);
+      sparkle<BR, B, L>(state);
+      break;
+    }
+
+    whiten_rate<R, C, L>(state);
+    sparkle<BR, S, L>(state);
+
+    off += R;
+  }
+}
+
+// Computes C -bytes authentication tag of each lane; see aead::finalize
+template<const size_t R, const size_t C, const size_t L>
+static inline void
+finalize(const uint32_t* const __restrict state, // word-sliced state
+         const uint8_t* const* const key,        // L -many C -bytes keys
+         uint8_t* const* const tag               // L -many C -bytes tags
+)
+{
+  constexpr size_t RW = R >> 2;
+  constexpr size_t CW = C >> 2;
+
+  for (size_t l = 0; l < L; l++) {
+    uint32_t words[CW];
+    sparkle_utils::copy_le_bytes_to_words<C>(key[l], words);
+
+    for (size_t i = 0; i < CW; i++) {
+      words[i] ^= state[(RW + i) * L + l];
+    }
+
+    sparkle_utils::copy_words_to_le_bytes<C>(words, tag[l]);
+  }
+}
+
+// Authenticated encryption of L -many equal length messages, using SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}, where all lanes are processed together; see
+// aead::encrypt for meaning of template parameters.
+//
+// Each lane has its own key, nonce, associated data, plain text, cipher text &
+// tag, though all lanes must have same associated data length & same plain
+// text length. Plain text & cipher text of a lane may point to same memory,
+// for in-place encryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L>
+static inline void
+encrypt(const uint8_t* const* const key,   // L -many C -bytes secret keys
+        const uint8_t* const* const nonce, // L -many R -bytes nonces
+        const uint8_t* const* const data,  // L -many N (>=0) -bytes AD
+        const size_t d_len,                // len(data[l]) = N | N >= 0
+        const uint8_t* const* const txt,   // L -many M (>=0) -bytes plain text
+        uint8_t* const* const enc,         // L -many M (>=0) -bytes cipher text
+        const size_t ct_len,               // len(txt[l]) = len(enc[l]) = M
+        uint8_t* const* const tag          // L -many C -bytes tags
+)
+{
+  alignas(64) uint32_t state[(BR << 1) * L];
+
+  initialize<R, C, BR, B, L>(state, key, nonce);
+
+  if (d_len > 0) {
+    process_data<R, C, A0, A1, BR, S, B, L>(state, data, d_len);
+  }
+  if (ct_len > 0) {
+    process_text<R, C, M0, M1, BR, S, B, L>(state, txt, enc, ct_len);
+  }
+
+  finalize<R, C, L>(state, key, tag);
+}
+
+// Verified decryption of L -many equal length messages, using SchwaemmX-Y AEAD
+// | X, Y ∈ {128, 192, 256}, where all lanes are processed together; see
+// aead::decrypt for meaning of template parameters.
+//
+// Verification status of each lane is written to `flag[l]`, while decrypted
+// text of each lane, which failed verification, is zeroed. Returns truth value
+// only if all lanes are verified. Cipher text & decrypted text of a lane may
+// point to same memory, for in-place decryption.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L>
+static inline bool
+decrypt(const uint8_t* const* const key,   // L -many C -bytes secret keys
+        const uint8_t* const* const nonce, // L -many R -bytes nonces
+        const uint8_t* const* const tag,   // L -many C -bytes tags
+        const uint8_t* const* const data,  // L -many N (>=0) -bytes AD
+        const size_t d_len,                // len(data[l]) = N | N >= 0
+        const uint8_t* const* const enc,   // L -many M (>=0) -bytes cipher text
+        uint8_t* const* const dec,         // L -many M (>=0) -bytes plain text
+        const size_t ct_len,               // len(enc[l]) = len(dec[l]) = M
+        bool* const flag                   // L -many verification flags
+)
+{
+  alignas(64) uint32_t state[(BR << 1) * L];
+  uint8_t tags_[L][C];
+  uint8_t* tag_[L];
+
+  for (size_t l = 0; l < L; l++) {
+    tag_[l] = tags_[l];
+  }
+
+  initialize<R, C, BR, B, L>(state, key, nonce);
+
+  if (d_len > 0) {
+    process_data<R, C, A0, A1, BR, S, B, L>(state, data, d_len);
+  }
+  if (ct_len > 0) {
+    process_cipher<R, C, M0, M1, BR, S, B, L>(state, enc, dec, ct_len);
+  }
+
+  finalize<R, C, L>(state, key, tag_);
+
+  bool all = true;
+  for (size_t l = 0; l < L; l++) {
+    bool f = false;
+    for (size_t i = 0; i < C; i++) {
+      f |= (tag[l][i] ^ tags_[l][i]);
+    }
+
+    // don't release unverified plain text
+    std::memset(dec[l], 0, f * ct_len);
+
+    flag[l] = !f;
+    all &= !f;
+  }
+
+  return all;
+}
+
+// Transformation function ℳ3 ( nb = 6 ) or ℳ4 ( nb = 8 ), mixing 128 -bit
+// message block of each lane into word-sliced permutation state; see
+// hash::feistel
+template<const size_t nb, const size_t L>
+static inline void
+feistel(uint32_t* const __restrict state,    // word-sliced permutation state
+        const uint32_t* const __restrict msg // 4 * L -many words
+)
+{
+  for (size_t l = 0; l < L; l++) {
+    uint32_t tx = msg[0 * L + l] ^ msg[2 * L + l];
+    uint32_t ty = msg[1 * L + l] ^ msg[3 * L + l];
+
+    tx = std::rotl(tx ^ (tx << 16), 16);
+    ty = std::rotl(ty ^ (ty << 16), 16);
+
+    state[0 * L + l] ^= msg[0 * L + l] ^ ty;
+    state[2 * L + l] ^= msg[2 * L + l] ^ ty;
+    state[1 * L + l] ^= msg[1 * L + l] ^ tx;
+    state[3 * L + l] ^= msg[3 * L + l] ^ tx;
+
+    for (size_t j = 2; j < (nb >> 1); j++) {
+      state[(2 * j + 0) * L + l] ^= ty;
+      state[(2 * j + 1) * L + l] ^= tx;
+    }
+  }
+}
+
+// Esch256 ( nb = 6 ) or Esch384 ( nb = 8 ) hash of L -many equal length
+// messages, where all lanes are processed together; see esch{256, 384}::hash
+template<const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t dlen,
+         const size_t L>
+static inline void
+hash(const uint8_t* const* const in, // L -many N (>=0) -bytes messages
+     const size_t ilen,              // len(in[l]) = N | N >= 0
+     uint8_t* const* const out       // L -many dlen -bytes digests
+)
+{
+  constexpr size_t RATE = hash::RATE;
+  static_assert(dlen % RATE == 0, "Digest must be multiple of 16 -bytes");
+
+  alignas(64) uint32_t state[(nb << 1) * L]{};
+  alignas(64) uint32_t blk[(RATE >> 2) * L];
+
+  // process full message blocks, except last one ( even if that's full )
+  size_t off = 0;
+  while ((ilen - off) > RATE) {
+    load_block<RATE, L>(in, off, RATE, blk);
+    feistel<nb, L>(state, blk);
+    sparkle<nb, ns_slim, L>(state);
+
+    off += RATE;
+  }
+
+  // process last message block, it can be full/ partially filled/ empty
+  const size_t r_bytes = ilen - off;
+  load_block<RATE, L>(in, off, r_bytes, blk);
+
+  const uint32_t cnst = (r_bytes < RATE) ? hash::CONST_M0 : hash::CONST_M1;
+  for (size_t l = 0; l < L; l++) {
+    state[(nb - 1) * L + l] ^= cnst;
+  }
+
+  feistel<nb, L>(state, blk);
+  sparkle<nb, ns_big, L>(state);
+
+  store_block<RATE, L>(state, out, 0, RATE);
+  for (size_t o = RATE; o < dlen; o += RATE) {
+    sparkle<nb, ns_slim, L>(state);
+    store_block<RATE, L>(state, out, o, RATE);
+  }
+}
+
+} // namespace multilane
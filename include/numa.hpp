@@ -0,0 +1,519 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <linux/mempolicy.h>
+#include <memory>
+#include <mutex>
+#include <sched.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// NUMA topology queries, node-local memory allocation & a thread pool, whose
+// workers are pinned per NUMA node, so that bulk crypto routines ( see
+// bulk.hpp ) can process each segment of a buffer on a core of the node which
+// owns its pages
+//
+// Memory policy & page placement are queried/ set using raw `get_mempolicy`,
+// `move_pages` & `mbind` system calls, so that libnuma is not required. When
+// those system calls are unavailable ( say kernel built without NUMA support
+// or blocked by seccomp ), whole machine is treated as a single node.
+namespace numa {
+
+// Page placement of a buffer, not yet known, because its pages are not yet
+// faulted in ( or query failed )
+constexpr int UNKNOWN_NODE = -1;
+
+// Parses a Linux list format string ( say "0-3,8-11" ) into list of integers
+static inline std::vector<int>
+parse_list(const std::string& str)
+{
+  std::vector<int> res;
+
+  size_t pos = 0;
+  while (pos < str.size()) {
+    size_t end = str.find(',', pos);
+    if (end == std::string::npos) {
+      end = str.size();
+    }
+
+    const std::string item = str.substr(pos, end - pos);
+    const size_t dash = item.find('-');
+
+    try {
+      if (dash == std::string::npos) {
+        if (!item.empty()) {
+          res.push_back(std::stoi(item));
+        }
+      } else {
+        const int lo = std::stoi(item.substr(0, dash));
+        const int hi = std::stoi(item.substr(dash + 1));
+        for (int i = lo; i <= hi; i++) {
+          res.push_back(i);
+        }
+      }
+    } catch (...) {
+      // skip malformed items
+    }
+
+    pos = end + 1;
+  }
+
+  return res;
+}
+
+// Reads first line of a sysfs file, returning empty string if it can't be read
+static inline std::string
+read_line(const std::string& path)
+{
+  std::ifstream f{ path };
+  std::string line;
+  std::getline(f, line);
+  return line;
+}
+
+// Returns truth value if memory policy system calls are usable on this system
+static inline bool
+available()
+{
+  static const bool ok = [] {
+    int mode = 0;
+    return syscall(SYS_get_mempolicy, &mode, nullptr, 0ul, nullptr, 0ul) == 0;
+  }();
+  return ok;
+}
+
+// Returns ids of online NUMA nodes, in ascending order; single node 0, when
+// NUMA is unavailable
+static inline const std::vector<int>&
+nodes()
+{
+  static const std::vector<int> ids = [] {
+    std::vector<int> res;
+    if (available()) {
+      res = parse_list(read_line("/sys/devices/system/node/online"));
+    }
+    if (res.empty()) {
+      res.push_back(0);
+    }
+    return res;
+  }();
+  return ids;
+}
+
+// Returns ids of CPUs, belonging to given NUMA node, which calling thread is
+// allowed to run on
+static inline std::vector<int>
+cpus_of(const int node)
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+
+  std::vector<int> cpus;
+  if (nodes().size() > 1) {
+    cpus = parse_list(read_line("/sys/devices/system/node/node" +
+                                std::to_string(node) + "/cpulist"));
+  } else {
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+      cpus.push_back(i);
+    }
+  }
+
+  std::vector<int> res;
+  for (const int cpu : cpus) {
+    if ((cpu >= 0) && (cpu < CPU_SETSIZE) && CPU_ISSET(cpu, &allowed)) {
+      res.push_back(cpu);
+    }
+  }
+  return res;
+}
+
+// Returns id of NUMA node, calling thread is currently running on
+static inline int
+current_node()
+{
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return nodes().front();
+  }
+  return static_cast<int>(node);
+}
+
+// Returns id of NUMA node, owning page which holds given address, or
+// UNKNOWN_NODE, if that page is not yet faulted in
+static inline int
+node_of(const void* const addr)
+{
+  if (!available()) {
+    return nodes().front();
+  }
+
+  void* page = const_cast<void*>(addr);
+  int status = 0;
+
+  // with no target nodes, move_pages only reports placement of pages
+  const long r = syscall(SYS_move_pages, 0, 1ul, &page, nullptr, &status, 0);
+  if ((r != 0) || (status < 0)) {
+    return UNKNOWN_NODE;
+  }
+  return status;
+}
+
+// Computes id of NUMA node, owning first page of each of n chunks of a buffer,
+// where i -th chunk starts at `base + i * stride`, writing them to `homes`.
+// Chunks whose first page is not yet faulted in, are reported as UNKNOWN_NODE.
+static inline void
+nodes_of(const uint8_t* const base,
+         const size_t stride,
+         const size_t n,
+         int* const homes)
+{
+  if (!available()) {
+    std::fill(homes, homes + n, nodes().front());
+    return;
+  }
+
+  // query page placement in bounded batches
+  constexpr size_t batch = 512ul;
+  void* pages[batch];
+
+  for (size_t off = 0; off < n; off += batch) {
+    const size_t cnt = std::min(batch, n - off);
+
+    for (size_t i = 0; i < cnt; i++) {
+      pages[i] = const_cast<uint8_t*>(base + (off + i) * stride);
+    }
+
+    const long r =
+      syscall(SYS_move_pages, 0, cnt, pages, nullptr, homes + off, 0);
+    if (r != 0) {
+      std::fill(homes + off, homes + off + cnt, UNKNOWN_NODE);
+      continue;
+    }
+
+    for (size_t i = 0; i < cnt; i++) {
+      homes[off + i] = std::max(homes[off + i], UNKNOWN_NODE);
+    }
+  }
+}
+
+// Page aligned anonymous memory mapping, whose pages are bound to NUMA nodes,
+// chosen by the allocator; released when it goes out of scope
+class buffer
+{
+public:
+  buffer() = default;
+
+  // Maps `len` -bytes, with all pages bound to given NUMA node
+  buffer(const size_t len, const int node)
+    : buffer(len)
+  {
+    bind(0, len, node);
+  }
+
+  // Maps `len` -bytes, with pages of each `chunk` -bytes chunk bound to same
+  // NUMA node, which owns corresponding chunk of `like` buffer; so that output
+  // of a bulk routine lives on same node as its input. Chunk length should be
+  // a multiple of page size.
+  buffer(const size_t len, const uint8_t* const like, const size_t chunk)
+    : buffer(len)
+  {
+    if ((chunk == 0) || (len == 0)) {
+      return;
+    }
+
+    const size_t n = (len + chunk - 1) / chunk;
+    std::vector<int> homes(n);
+    nodes_of(like, chunk, n, homes.data());
+
+    for (size_t i = 0; i < n; i++) {
+      const size_t off = i * chunk;
+      bind(off, std::min(chunk, len - off), homes[i]);
+    }
+  }
+
+  buffer(const buffer&) = delete;
+  buffer& operator=(const buffer&) = delete;
+
+  buffer(buffer&& other) noexcept
+    : ptr(other.ptr)
+    , len(other.len)
+  {
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+
+  buffer& operator=(buffer&& other) noexcept
+  {
+    std::swap(ptr, other.ptr);
+    std::swap(len, other.len);
+    return *this;
+  }
+
+  ~buffer()
+  {
+    if (ptr != nullptr) {
+      munmap(ptr, len);
+    }
+  }
+
+  uint8_t* data() { return ptr; }
+  const uint8_t* data() const { return ptr; }
+  size_t size() const { return len; }
+
+  // Returns truth value, if mapping succeeded
+  explicit operator bool() const { return ptr != nullptr; }
+
+private:
+  explicit buffer(const size_t len)
+  {
+    if (len == 0) {
+      return;
+    }
+
+    void* p = mmap(nullptr,
+                   len,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    if (p != MAP_FAILED) {
+      ptr = static_cast<uint8_t*>(p);
+      this->len = len;
+    }
+  }
+
+  // Binds pages overlapping [off, off + cnt) to given node, if it's known;
+  // pages are placed at first touch, so this is only a policy
+  void bind(const size_t off, const size_t cnt, const int node)
+  {
+    if ((ptr == nullptr) || (node < 0) || !available()) {
+      return;
+    }
+
+    const size_t pg = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t beg = off & ~(pg - 1);
+    const size_t end = std::min(len, (off + cnt + pg - 1) & ~(pg - 1));
+
+    constexpr size_t bits = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(static_cast<size_t>(node) / bits + 1);
+    mask[static_cast<size_t>(node) / bits] |= 1ul << (node % bits);
+
+    syscall(SYS_mbind,
+            ptr + beg,
+            end - beg,
+            MPOL_PREFERRED,
+            mask.data(),
+            mask.size() * bits,
+            0u);
+  }
+
+  uint8_t* ptr = nullptr;
+  size_t len = 0;
+};
+
+// Thread pool, with a group of worker threads per NUMA node, each of them
+// pinned to CPUs of its node. It executes one data-parallel job at a time,
+// where each index of the job has a home node; workers of a node first execute
+// indices homed on it & only then help other nodes, so that no core idles,
+// unless job asks for strict placement, where they never help other nodes.
+//
+// Note, unlike parallel::thread_pool, calling thread only waits for job to
+// complete, because it may be running on any node.
+class pool
+{
+public:
+  // Creates a pool with given # -of workers per NUMA node, which defaults to
+  // # -of CPUs of that node, calling thread is allowed to run on
+  explicit pool(const size_t workers_per_node = 0)
+  {
+    const auto& ids = nodes();
+    n_groups = ids.size();
+    groups = std::make_unique<group[]>(n_groups);
+
+    for (size_t k = 0; k < ids.size(); k++) {
+      const auto cpus = cpus_of(ids[k]);
+      const size_t cnt =
+        std::max<size_t>((workers_per_node == 0) ? cpus.size()
+                                                 : workers_per_node,
+                         1ul);
+
+      for (size_t i = 0; i < cnt; i++) {
+        workers.emplace_back([this, k, cpus] { work(k, cpus); });
+      }
+    }
+  }
+
+  pool(const pool&) = delete;
+  pool& operator=(const pool&) = delete;
+
+  ~pool()
+  {
+    {
+      std::lock_guard<std::mutex> lk{ mtx };
+      stop = true;
+    }
+    cv_work.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of worker threads, across all nodes
+  size_t concurrency() const { return workers.size(); }
+
+  // # -of NUMA nodes, pool has workers on
+  size_t node_count() const { return n_groups; }
+
+  // Invokes `fn(i)` for each i ∈ [0, n), on a worker of node `homes[i]` (
+  // preferably, or always when `strict` holds ), returning only after all of
+  // them are done. Indices homed on an unknown/ offline node are spread evenly
+  // across nodes.
+  void for_each(const size_t n,
+                const int* const homes,
+                const std::function<void(size_t)>& fn,
+                const bool strict = false)
+  {
+    if (n == 0) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> submit{ submit_mtx };
+
+    const auto& ids = nodes();
+    for (size_t k = 0; k < n_groups; k++) {
+      groups[k].idx.clear();
+      groups[k].next.store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      const auto it = std::find(ids.begin(), ids.end(), homes[i]);
+      const size_t k = (it != ids.end())
+                         ? static_cast<size_t>(it - ids.begin())
+                         : (i * n_groups) / n;
+      groups[k].idx.push_back(i);
+    }
+
+    {
+      std::lock_guard<std::mutex> lk{ mtx };
+
+      job = &fn;
+      steal = !strict;
+      active = workers.size();
+      generation++;
+    }
+    cv_work.notify_all();
+
+    std::unique_lock<std::mutex> lk{ mtx };
+    cv_done.wait(lk, [this] { return active == 0; });
+    job = nullptr;
+  }
+
+  // Invokes `fn(i)` for each i ∈ [0, n), where i -th index works on a chunk of
+  // buffer, starting at `base + i * stride`, on a worker of node owning that
+  // chunk's first page
+  void for_each(const uint8_t* const base,
+                const size_t stride,
+                const size_t n,
+                const std::function<void(size_t)>& fn)
+  {
+    std::vector<int> homes(n);
+    nodes_of(base, stride, n, homes.data());
+    for_each(n, homes.data(), fn);
+  }
+
+private:
+  // Indices of current job, homed on a node
+  struct alignas(64) group
+  {
+    std::vector<size_t> idx;
+    std::atomic<size_t> next{ 0 };
+  };
+
+  // Executes indices of a node, until all of them are claimed
+  static void run(group& g, const std::function<void(size_t)>& fn)
+  {
+    size_t i = 0;
+    while ((i = g.next.fetch_add(1, std::memory_order_relaxed)) <
+           g.idx.size()) {
+      fn(g.idx[i]);
+    }
+  }
+
+  // Worker thread's event loop, which pins it to CPUs of k -th node
+  void work(const size_t k, const std::vector<int>& cpus)
+  {
+    if (!cpus.empty() && (n_groups > 1)) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (const int cpu : cpus) {
+        CPU_SET(cpu, &set);
+      }
+      sched_setaffinity(0, sizeof(set), &set);
+    }
+
+    uint64_t seen = 0;
+
+    while (true) {
+      std::unique_lock<std::mutex> lk{ mtx };
+      cv_work.wait(lk, [&] { return stop || (generation != seen); });
+
+      if (stop) {
+        return;
+      }
+
+      seen = generation;
+      const auto* fn = job;
+      const size_t reach = steal ? n_groups : 1ul;
+      lk.unlock();
+
+      // own node first, then help remote ones, unless placement is strict
+      for (size_t i = 0; i < reach; i++) {
+        run(groups[(k + i) % n_groups], *fn);
+      }
+
+      lk.lock();
+      if (--active == 0) {
+        cv_done.notify_one();
+      }
+    }
+  }
+
+  std::unique_ptr<group[]> groups;
+  size_t n_groups = 0;
+  std::vector<std::thread> workers;
+
+  std::mutex submit_mtx;
+  std::mutex mtx;
+  std::condition_variable cv_work;
+  std::condition_variable cv_done;
+
+  const std::function<void(size_t)>* job = nullptr;
+  bool steal = true;
+  size_t active = 0;
+  uint64_t generation = 0;
+  bool stop = false;
+};
+
+// Process wide NUMA aware pool, lazily created on first use, which keeps all
+// allowed CPUs of all nodes busy
+static inline pool&
+default_pool()
+{
+  static pool p{};
+  return p;
+}
+
+} // namespace numa
@@ -0,0 +1,901 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <memory>
+#include <sched.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "engine.hpp"
+
+// Local crypto offload daemon & its client, which lets many small processes,
+// on same host, share one set of crypto job engines, so that Esch hash &
+// Schwaemm seal/ open requests of all of them are gathered into batches, which
+// fill lanes of multi-lane Sparkle permutation
+//
+// Client talks to daemon over a UNIX domain ( SOCK_SEQPACKET ) socket. At
+// connection time, client hands over a sealed memfd arena, which both sides
+// map. For each request, client copies inputs into arena & sends a small
+// descriptor over socket; daemon executes job straight on arena & replies
+// with its status, after which client copies outputs out of arena. Each
+// connection has at most one outstanding request, so a client is meant to be
+// used by a single thread at a time.
+//
+// Daemon collects requests of all connections, which became ready in one pass
+// of its event loop, and submits them to engines together, before waking up
+// workers, so that same shaped jobs are executed on SIMD lanes.
+//
+// Both sides only talk to peers running as same user ( checked with
+// SO_PEERCRED ) & default socket lives in a per-user, 0700 directory, as
+// client hands over secret keys & plain text.
+namespace offload {
+
+// Environment variable, which can override path of daemon's socket
+constexpr const char* SOCKET_ENV = "SPARKLE_OFFLOAD_SOCKET";
+
+// File name of daemon's socket, in per-user runtime directory
+constexpr const char* SOCKET_NAME = "sparkle-offload.sock";
+
+// Per-user runtime directory, used when XDG_RUNTIME_DIR isn't set, is this
+// prefix followed by user id
+constexpr const char* FALLBACK_DIR = "/tmp/sparkle-offload-";
+
+// Identifies protocol, along with its version
+constexpr uint64_t MAGIC = 0x3166666f6b726170ul; // "parkoff1"
+
+// Default byte length of client's arena, bounding request size
+constexpr size_t DEFAULT_ARENA = 1ul << 20;
+
+// Default # -of milliseconds, client waits for daemon's reply, before giving
+// up on connection
+constexpr int DEFAULT_TIMEOUT_MS = 1000;
+
+// Byte offsets of key, nonce, tag & associated data, in arena; associated
+// data is followed by input & then by output of job
+constexpr size_t KEY_OFF = 0;
+constexpr size_t NONCE_OFF = 32;
+constexpr size_t TAG_OFF = 64;
+constexpr size_t DATA_OFF = 96;
+
+// Schwaemm variant, a seal/ open request is to be executed with
+enum class variant : uint8_t
+{
+  schwaemm256_128 = 0,
+  schwaemm192_192 = 1,
+  schwaemm128_128 = 2,
+  schwaemm256_256 = 3
+};
+
+// # -of Schwaemm variants, hence # -of engines daemon runs
+constexpr size_t VARIANTS = 4;
+
+// First message on a connection, carrying arena's memfd as ancillary data
+struct hello
+{
+  uint64_t magic;
+  uint64_t arena_len;
+};
+
+// Descriptor of a request, whose inputs live in arena
+struct request
+{
+  uint64_t id;
+  uint64_t d_len; // len(associated data)
+  uint64_t len;   // len(input)
+  uint8_t kind;   // engine::op
+  uint8_t var;    // variant, ignored for hash requests
+  uint8_t rsvd[6];
+};
+
+// Reply to a request
+struct response
+{
+  uint64_t id;
+  uint8_t ok; // verification flag for open requests, else truth value
+  uint8_t rsvd[7];
+};
+
+// Returns truth value, if `dir` is a directory ( not a symbolic link ),
+// owned by effective user, which no one else can access
+static inline bool
+private_dir(const char* const dir)
+{
+  struct stat st;
+  return (lstat(dir, &st) == 0) && S_ISDIR(st.st_mode) &&
+         (st.st_uid == geteuid()) && ((st.st_mode & 077) == 0);
+}
+
+// Returns path of daemon's socket, from environment, if set, else it lives in
+// $XDG_RUNTIME_DIR or, when that's not set, in /tmp/sparkle-offload-<uid>,
+// which is created with mode 0700. Returns empty string, when latter exists,
+// but isn't private to effective user.
+static inline std::string
+socket_path()
+{
+  const char* const p = std::getenv(SOCKET_ENV);
+  if ((p != nullptr) && (p[0] != '\0')) {
+    return p;
+  }
+
+  const char* const xdg = std::getenv("XDG_RUNTIME_DIR");
+  if ((xdg != nullptr) && (xdg[0] != '\0')) {
+    return std::string(xdg) + "/" + SOCKET_NAME;
+  }
+
+  const std::string dir = FALLBACK_DIR + std::to_string(geteuid());
+  mkdir(dir.c_str(), 0700);
+  if (!private_dir(dir.c_str())) {
+    return {};
+  }
+  return dir + "/" + SOCKET_NAME;
+}
+
+// Returns truth value, if peer of a connected UNIX domain socket runs as
+// effective user of this process
+static inline bool
+same_user(const int fd)
+{
+  ucred cred;
+  socklen_t n = sizeof(cred);
+  if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &n) != 0) {
+    return false;
+  }
+  return (n == sizeof(cred)) && (cred.uid == geteuid());
+}
+
+// Returns byte length of output of a job, with given kind & input length
+static inline constexpr size_t
+out_len(const engine::op kind, const size_t len)
+{
+  switch (kind) {
+    case engine::op::esch256:
+      return esch256::DIGEST_LEN;
+    case engine::op::esch384:
+      return esch384::DIGEST_LEN;
+    default:
+      return len;
+  }
+}
+
+// Returns truth value, if request is well formed & fits in `arena_len` -bytes
+// arena
+static inline bool
+valid(const request& r, const size_t arena_len)
+{
+  if ((r.kind > static_cast<uint8_t>(engine::op::open)) ||
+      (r.var >= VARIANTS) || (r.d_len > arena_len) || (r.len > arena_len)) {
+    return false;
+  }
+
+  const auto kind = static_cast<engine::op>(r.kind);
+  const uint64_t need = DATA_OFF + r.d_len + r.len + out_len(kind, r.len);
+  return need <= arena_len;
+}
+
+// Fills socket address, for given path, returning false if it's empty or too
+// long
+static inline bool
+make_addr(const char* const path, sockaddr_un& addr)
+{
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+
+  const size_t n = std::strlen(path);
+  if ((n == 0) || (n >= sizeof(addr.sun_path))) {
+    return false;
+  }
+
+  std::memcpy(addr.sun_path, path, n);
+  return true;
+}
+
+// Daemon, serving requests of many clients, on crypto job engines
+class server
+{
+public:
+  // Listens on given socket path ( replacing stale socket, if it's owned by
+  // effective user ), running one engine per Schwaemm variant, each with given
+  // # -of workers; use `ok` to find out whether it worked. Connections from
+  // other users are refused. When fewer requests than SIMD lanes are
+  // gathered in a pass of event loop, daemon keeps polling for more, for at
+  // most `linger_us` microseconds, before submitting them.
+  explicit server(
+    const char* const path,
+    const size_t n_workers = std::thread::hardware_concurrency(),
+    const size_t linger_us = 20)
+    : linger(linger_us)
+    , e0(n_workers)
+    , e1(n_workers)
+    , e2(n_workers)
+    , e3(n_workers)
+  {
+    sockaddr_un addr;
+    if (!make_addr(path, addr)) {
+      return;
+    }
+
+    lfd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (lfd < 0) {
+      return;
+    }
+
+    // never remove someone else's file; bind fails on it instead
+    struct stat st;
+    if ((lstat(path, &st) == 0) && S_ISSOCK(st.st_mode) &&
+        (st.st_uid == geteuid())) {
+      unlink(path);
+    }
+    if (bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      return;
+    }
+    bound = path;
+
+    if (chmod(path, 0600) != 0) {
+      return;
+    }
+
+    if (listen(lfd, SOMAXCONN) != 0) {
+      return;
+    }
+
+    efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if ((efd < 0) || (epfd < 0)) {
+      return;
+    }
+
+    if (!watch(lfd) || !watch(efd)) {
+      return;
+    }
+
+    ready = true;
+  }
+
+  server(const server&) = delete;
+  server& operator=(const server&) = delete;
+
+  ~server()
+  {
+    for (const int fd : { lfd, efd, epfd }) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+    if (!bound.empty()) {
+      unlink(bound.c_str());
+    }
+  }
+
+  // Returns truth value, if daemon is listening
+  bool ok() const { return ready; }
+
+  // Serves clients, on calling thread, until `stop` is called
+  void run()
+  {
+    using clk = std::chrono::steady_clock;
+
+    std::vector<engine::job> jobs[VARIANTS];
+    std::vector<engine::callback> dones[VARIANTS];
+
+    while (ready) {
+      bool stopping = poll(-1, jobs, dones);
+
+      // linger for more requests, so that batches fill SIMD lanes
+      const auto until = clk::now() + linger;
+      while (!stopping && (gathered(jobs) < multilane::LANES) &&
+             (gathered(jobs) > 0) && (clk::now() < until)) {
+        sched_yield();
+        stopping = poll(0, jobs, dones);
+      }
+
+      // submit all requests, gathered in this pass, together
+      dispatch(e0, jobs[0], dones[0]);
+      dispatch(e1, jobs[1], dones[1]);
+      dispatch(e2, jobs[2], dones[2]);
+      dispatch(e3, jobs[3], dones[3]);
+
+      if (stopping) {
+        break;
+      }
+    }
+  }
+
+  // Asks `run` to return; can be called from any thread or signal handler
+  void stop()
+  {
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t r = write(efd, &one, sizeof(one));
+  }
+
+  // # -of jobs executed so far, across all engines
+  uint64_t executed() const
+  {
+    return e0.executed() + e1.executed() + e2.executed() + e3.executed();
+  }
+
+  // # -of jobs executed so far, on SIMD lanes, across all engines
+  uint64_t laned() const
+  {
+    return e0.laned() + e1.laned() + e2.laned() + e3.laned();
+  }
+
+private:
+  // A client connection, along with mapping of its arena; kept alive by
+  // in-flight jobs
+  struct conn
+  {
+    int fd = -1;
+    uint8_t* arena = nullptr;
+    size_t arena_len = 0;
+    std::atomic<bool> busy{ false };
+
+    ~conn()
+    {
+      if (arena != nullptr) {
+        munmap(arena, arena_len);
+      }
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  };
+
+  // Waits for at most `timeout` milliseconds ( forever, if negative ), for
+  // events, & handles them, gathering requests as jobs. Returns truth value,
+  // if daemon is asked to stop.
+  bool poll(const int timeout,
+            std::vector<engine::job>* const jobs,
+            std::vector<engine::callback>* const dones)
+  {
+    constexpr int max_events = 256;
+    epoll_event evs[max_events];
+
+    const int n = epoll_wait(epfd, evs, max_events, timeout);
+    if (n < 0) {
+      return errno != EINTR;
+    }
+
+    bool stopping = false;
+    for (int i = 0; i < n; i++) {
+      const int fd = evs[i].data.fd;
+
+      if (fd == efd) {
+        stopping = true;
+      } else if (fd == lfd) {
+        accept_all();
+      } else {
+        serve(fd, jobs, dones);
+      }
+    }
+    return stopping;
+  }
+
+  // # -of gathered jobs, across all engines
+  static size_t gathered(const std::vector<engine::job>* const jobs)
+  {
+    size_t n = 0;
+    for (size_t v = 0; v < VARIANTS; v++) {
+      n += jobs[v].size();
+    }
+    return n;
+  }
+
+  // Registers a descriptor, for readability, with event loop
+  bool watch(const int fd)
+  {
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+  }
+
+  // Accepts all pending connections
+  void accept_all()
+  {
+    while (true) {
+      constexpr int flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+      const int fd = accept4(lfd, nullptr, nullptr, flags);
+      if (fd < 0) {
+        return;
+      }
+
+      auto c = std::make_shared<conn>();
+      c->fd = fd;
+      if (!same_user(fd) || !watch(fd)) {
+        continue;
+      }
+      conns.emplace(fd, std::move(c));
+    }
+  }
+
+  // Drops a connection; it's closed once its in-flight job, if any, completes
+  void drop(const int fd)
+  {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+    conns.erase(fd);
+  }
+
+  // Maps arena, handed over in first message of a connection. Arena memfd must
+  // be sealed against shrinking, so that client can't make daemon fault.
+  static bool handshake(conn& c)
+  {
+    hello h;
+    iovec iov{ &h, sizeof(h) };
+
+    alignas(cmsghdr) uint8_t cbuf[CMSG_SPACE(sizeof(int))];
+    msghdr m;
+    std::memset(&m, 0, sizeof(m));
+    m.msg_iov = &iov;
+    m.msg_iovlen = 1;
+    m.msg_control = cbuf;
+    m.msg_controllen = sizeof(cbuf);
+
+    const ssize_t r = recvmsg(c.fd, &m, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    if (r != static_cast<ssize_t>(sizeof(h))) {
+      return false;
+    }
+
+    const cmsghdr* const cm = CMSG_FIRSTHDR(&m);
+    if ((cm == nullptr) || (cm->cmsg_level != SOL_SOCKET) ||
+        (cm->cmsg_type != SCM_RIGHTS) ||
+        (cm->cmsg_len != CMSG_LEN(sizeof(int)))) {
+      return false;
+    }
+
+    int afd;
+    std::memcpy(&afd, CMSG_DATA(cm), sizeof(afd));
+
+    struct stat st;
+    const int seals = fcntl(afd, F_GET_SEALS);
+    const bool sane = (h.magic == MAGIC) && (h.arena_len > DATA_OFF) &&
+                      (seals >= 0) && ((seals & F_SEAL_SHRINK) != 0) &&
+                      (fstat(afd, &st) == 0) &&
+                      (static_cast<uint64_t>(st.st_size) >= h.arena_len);
+
+    void* p = MAP_FAILED;
+    if (sane) {
+      constexpr int prot = PROT_READ | PROT_WRITE;
+      p = mmap(nullptr, h.arena_len, prot, MAP_SHARED, afd, 0);
+    }
+    close(afd);
+
+    if (p == MAP_FAILED) {
+      return false;
+    }
+
+    c.arena = static_cast<uint8_t*>(p);
+    c.arena_len = h.arena_len;
+    return true;
+  }
+
+  // Reads next message of a connection, turning a request into a job
+  void serve(const int fd,
+             std::vector<engine::job>* const jobs,
+             std::vector<engine::callback>* const dones)
+  {
+    const auto it = conns.find(fd);
+    if (it == conns.end()) {
+      return;
+    }
+    std::shared_ptr<conn> c = it->second;
+
+    if (c->arena == nullptr) {
+      if (!handshake(*c)) {
+        drop(fd);
+      }
+      return;
+    }
+
+    request r;
+    const ssize_t n = recv(fd, &r, sizeof(r), MSG_DONTWAIT);
+    if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+      return;
+    }
+
+    const bool bad = (n != static_cast<ssize_t>(sizeof(r))) ||
+                     !valid(r, c->arena_len) ||
+                     c->busy.exchange(true, std::memory_order_acq_rel);
+    if (bad) {
+      drop(fd);
+      return;
+    }
+
+    const auto kind = static_cast<engine::op>(r.kind);
+    uint8_t* const a = c->arena;
+    const uint8_t* const data = a + DATA_OFF;
+    const uint8_t* const in = data + r.d_len;
+    uint8_t* const out = a + DATA_OFF + r.d_len + r.len;
+
+    engine::job j;
+    switch (kind) {
+      case engine::op::seal:
+        j = engine::seal_job(a + KEY_OFF,
+                             a + NONCE_OFF,
+                             data,
+                             r.d_len,
+                             in,
+                             out,
+                             r.len,
+                             a + TAG_OFF);
+        break;
+      case engine::op::open:
+        j = engine::open_job(a + KEY_OFF,
+                             a + NONCE_OFF,
+                             a + TAG_OFF,
+                             data,
+                             r.d_len,
+                             in,
+                             out,
+                             r.len);
+        break;
+      default:
+        j = engine::hash_job(kind, in, r.len, out);
+        break;
+    }
+
+    const size_t v = (r.kind <= static_cast<uint8_t>(engine::op::esch384))
+                       ? 0ul
+                       : static_cast<size_t>(r.var);
+    const uint64_t id = r.id;
+
+    jobs[v].push_back(j);
+    dones[v].emplace_back([c, id](const bool ok) {
+      response resp;
+      std::memset(&resp, 0, sizeof(resp));
+      resp.id = id;
+      resp.ok = ok;
+
+      c->busy.store(false, std::memory_order_release);
+      send(c->fd, &resp, sizeof(resp), MSG_DONTWAIT | MSG_NOSIGNAL);
+    });
+  }
+
+  // Submits gathered jobs to an engine
+  template<typename E>
+  static void dispatch(E& eng,
+                       std::vector<engine::job>& jobs,
+                       std::vector<engine::callback>& dones)
+  {
+    eng.submit(jobs.data(), dones.data(), jobs.size());
+    jobs.clear();
+    dones.clear();
+  }
+
+  int lfd = -1;
+  int efd = -1;
+  int epfd = -1;
+  std::string bound;
+  bool ready = false;
+  std::chrono::microseconds linger;
+
+  std::unordered_map<int, std::shared_ptr<conn>> conns;
+
+  // engines are declared last, so that they're stopped ( completing in-flight
+  // jobs ) before anything else is torn down
+  schwaemm256_128::crypto_engine e0;
+  schwaemm192_192::crypto_engine e1;
+  schwaemm128_128::crypto_engine e2;
+  schwaemm256_256::crypto_engine e3;
+};
+
+// Client of daemon, owning one connection & its arena; not thread-safe
+//
+// Each routine returns false, when daemon can't serve the request ( say
+// because it's larger than arena, connection is lost or daemon didn't reply in
+// time ), in which case caller is expected to compute it locally.
+class client
+{
+public:
+  // Connects to daemon, listening on given socket path ( defaults to
+  // `socket_path()` ) & running as same user, handing over a fresh arena of
+  // given byte length; use `ok` to find out whether it worked. Connection is
+  // given up on, when daemon doesn't reply within `timeout_ms` milliseconds.
+  explicit client(const char* path = nullptr,
+                  const size_t arena_len = DEFAULT_ARENA,
+                  const int timeout_ms = DEFAULT_TIMEOUT_MS)
+    : timeout(timeout_ms)
+  {
+    const std::string dflt = (path == nullptr) ? socket_path() : "";
+
+    sockaddr_un addr;
+    if (!make_addr((path != nullptr) ? path : dflt.c_str(), addr)) {
+      return;
+    }
+
+    const int afd = memfd_create("sparkle-offload",
+                                 MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (afd < 0) {
+      return;
+    }
+
+    const bool sized =
+      (ftruncate(afd, static_cast<off_t>(arena_len)) == 0) &&
+      (fcntl(afd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) == 0);
+
+    void* p = MAP_FAILED;
+    if (sized) {
+      p = mmap(nullptr, arena_len, PROT_READ | PROT_WRITE, MAP_SHARED, afd, 0);
+    }
+    if (p == MAP_FAILED) {
+      close(afd);
+      return;
+    }
+    arena = static_cast<uint8_t*>(p);
+    len = arena_len;
+
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    const bool conn =
+      (fd >= 0) &&
+      (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) &&
+      same_user(fd);
+
+    const bool sent = conn && send_hello(afd);
+    close(afd);
+
+    ready = sent;
+  }
+
+  client(const client&) = delete;
+  client& operator=(const client&) = delete;
+
+  ~client()
+  {
+    if (arena != nullptr) {
+      munmap(arena, len);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  // Returns truth value, if connected to daemon
+  bool ok() const { return ready; }
+
+  // Computes Esch256 ( kind = op::esch256 ) or Esch384 ( kind = op::esch384 )
+  // digest of N (>=0) -bytes message
+  bool hash(const engine::op kind,
+            const uint8_t* const __restrict in,
+            const size_t ilen,
+            uint8_t* const __restrict out)
+  {
+    request r = make(kind, variant::schwaemm256_128, 0, ilen);
+    if (!fits(r)) {
+      return false;
+    }
+
+    copy_in(in, ilen, DATA_OFF);
+
+    bool flag = false;
+    if (!call(r, flag)) {
+      return false;
+    }
+
+    std::memcpy(out, arena + DATA_OFF + ilen, out_len(kind, ilen));
+    return true;
+  }
+
+  // Seals plain text, using given Schwaemm variant; see aead::encrypt
+  bool seal(const variant var,
+            const uint8_t* const __restrict key,
+            const uint8_t* const __restrict nonce,
+            const uint8_t* const __restrict data,
+            const size_t d_len,
+            const uint8_t* const __restrict txt,
+            uint8_t* const __restrict enc,
+            const size_t ct_len,
+            uint8_t* const __restrict tag)
+  {
+    request r = make(engine::op::seal, var, d_len, ct_len);
+    if (!fits(r)) {
+      return false;
+    }
+
+    std::memcpy(arena + KEY_OFF, key, key_len(var));
+    std::memcpy(arena + NONCE_OFF, nonce, nonce_len(var));
+    copy_in(data, d_len, DATA_OFF);
+    copy_in(txt, ct_len, DATA_OFF + d_len);
+
+    bool flag = false;
+    if (!call(r, flag)) {
+      wipe();
+      return false;
+    }
+
+    copy_out(enc, ct_len, DATA_OFF + d_len + ct_len);
+    std::memcpy(tag, arena + TAG_OFF, key_len(var));
+    wipe();
+    return true;
+  }
+
+  // Opens cipher text, using given Schwaemm variant, setting `flag` to
+  // verification status; see aead::decrypt
+  bool open(const variant var,
+            const uint8_t* const __restrict key,
+            const uint8_t* const __restrict nonce,
+            const uint8_t* const __restrict tag,
+            const uint8_t* const __restrict data,
+            const size_t d_len,
+            const uint8_t* const __restrict enc,
+            uint8_t* const __restrict dec,
+            const size_t ct_len,
+            bool& flag)
+  {
+    request r = make(engine::op::open, var, d_len, ct_len);
+    if (!fits(r)) {
+      return false;
+    }
+
+    std::memcpy(arena + KEY_OFF, key, key_len(var));
+    std::memcpy(arena + NONCE_OFF, nonce, nonce_len(var));
+    std::memcpy(arena + TAG_OFF, tag, key_len(var));
+    copy_in(data, d_len, DATA_OFF);
+    copy_in(enc, ct_len, DATA_OFF + d_len);
+
+    const bool done = call(r, flag);
+    wipe();
+    if (!done) {
+      return false;
+    }
+
+    copy_out(dec, ct_len, DATA_OFF + d_len + ct_len);
+    return true;
+  }
+
+private:
+  // Byte length of secret key ( = tag ) of a Schwaemm variant
+  static constexpr size_t key_len(const variant var)
+  {
+    switch (var) {
+      case variant::schwaemm256_128:
+        return schwaemm256_128::C;
+      case variant::schwaemm192_192:
+        return schwaemm192_192::C;
+      case variant::schwaemm128_128:
+        return schwaemm128_128::C;
+      default:
+        return schwaemm256_256::C;
+    }
+  }
+
+  // Byte length of nonce of a Schwaemm variant
+  static constexpr size_t nonce_len(const variant var)
+  {
+    switch (var) {
+      case variant::schwaemm256_128:
+        return schwaemm256_128::R;
+      case variant::schwaemm192_192:
+        return schwaemm192_192::R;
+      case variant::schwaemm128_128:
+        return schwaemm128_128::R;
+      default:
+        return schwaemm256_256::R;
+    }
+  }
+
+  // Sends first message of connection, along with arena's memfd
+  bool send_hello(const int afd)
+  {
+    hello h{ MAGIC, len };
+    iovec iov{ &h, sizeof(h) };
+
+    alignas(cmsghdr) uint8_t cbuf[CMSG_SPACE(sizeof(int))];
+    std::memset(cbuf, 0, sizeof(cbuf));
+
+    msghdr m;
+    std::memset(&m, 0, sizeof(m));
+    m.msg_iov = &iov;
+    m.msg_iovlen = 1;
+    m.msg_control = cbuf;
+    m.msg_controllen = sizeof(cbuf);
+
+    cmsghdr* const cm = CMSG_FIRSTHDR(&m);
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type = SCM_RIGHTS;
+    cm->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cm), &afd, sizeof(afd));
+
+    return sendmsg(fd, &m, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(h));
+  }
+
+  // Prepares descriptor of next request
+  request make(const engine::op kind,
+               const variant var,
+               const size_t d_len,
+               const size_t ilen)
+  {
+    request r;
+    std::memset(&r, 0, sizeof(r));
+    r.id = ++next_id;
+    r.d_len = d_len;
+    r.len = ilen;
+    r.kind = static_cast<uint8_t>(kind);
+    r.var = static_cast<uint8_t>(var);
+    return r;
+  }
+
+  // Zeroes key, nonce & tag slots of arena, so that secrets don't outlive
+  // the call
+  void wipe() { explicit_bzero(arena + KEY_OFF, DATA_OFF - KEY_OFF); }
+
+  // Checks whether request can be sent to daemon
+  bool fits(const request& r) const { return ready && valid(r, len); }
+
+  void copy_in(const uint8_t* const src, const size_t n, const size_t off)
+  {
+    if (n > 0) {
+      std::memcpy(arena + off, src, n);
+    }
+  }
+
+  void copy_out(uint8_t* const dst, const size_t n, const size_t off) const
+  {
+    if (n > 0) {
+      std::memcpy(dst, arena + off, n);
+    }
+  }
+
+  // Sends request & waits, for at most `timeout` milliseconds, for its reply;
+  // on transport failure or timeout, connection is given up on
+  bool call(const request& r, bool& flag)
+  {
+    if (send(fd, &r, sizeof(r), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(sizeof(r))) {
+      ready = false;
+      return false;
+    }
+
+    using clk = std::chrono::steady_clock;
+    const auto until = clk::now() + std::chrono::milliseconds(timeout);
+
+    pollfd pfd{ fd, POLLIN, 0 };
+    int p;
+    do {
+      const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+        until - clk::now());
+      p = ::poll(&pfd, 1, std::max<int>(static_cast<int>(left.count()), 0));
+    } while ((p < 0) && (errno == EINTR));
+
+    if (p != 1) {
+      ready = false;
+      return false;
+    }
+
+    response resp;
+    ssize_t n;
+    do {
+      n = recv(fd, &resp, sizeof(resp), MSG_DONTWAIT);
+    } while ((n < 0) && (errno == EINTR));
+
+    if ((n != static_cast<ssize_t>(sizeof(resp))) || (resp.id != r.id)) {
+      ready = false;
+      return false;
+    }
+
+    flag = resp.ok != 0;
+    return true;
+  }
+
+  int fd = -1;
+  uint8_t* arena = nullptr;
+  size_t len = 0;
+  uint64_t next_id = 0;
+  int timeout = DEFAULT_TIMEOUT_MS;
+  bool ready = false;
+};
+
+} // namespace offload
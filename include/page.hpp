@@ -0,0 +1,327 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+
+#include "multilane.hpp"
+#include "parallel.hpp"
+#include "schwaemm.hpp"
+
+// In-place authenticated encryption of fixed size pages ( say 4/ 8/ 16 KB
+// database pages, living in frames of a buffer pool ), on top of SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}
+//
+// Each page is laid out as
+//
+// page = payload || le64(lsn) || tag
+//
+// where payload is encrypted in place, log sequence number is kept in clear (
+// so that reader can derive nonce ) & C -bytes authentication tag lives in the
+// page trailer. Per-page nonce is derived from page number & LSN, as
+//
+// nonce = salt ⊕ (le64(page_no) || le64(lsn) || 0^(R - 16))
+//
+// where salt is R -bytes random value, chosen once per key ( say per database
+// file ). Tampering with LSN or moving a page to another location makes its
+// verification fail.
+//
+// Note, nonce is unique only as long as LSN of a page strictly increases every
+// time it's sealed again under same key, which is how write-ahead logging
+// storage engines assign LSNs anyway.
+namespace page {
+
+// Byte length of log sequence number, kept in page trailer
+constexpr size_t LSN_LEN = 8ul;
+
+// Page cipher, which can be used with SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256};
+// see aead::encrypt for meaning of first nine template parameters, while L
+// denotes # -of pages, sealed/ opened together, when processing batches of
+// pages ( see multilane.hpp ).
+//
+// Batches of pages are split into groups of L pages, each group being
+// processed using multi-lane Schwaemm, while groups are spread over worker
+// threads. Pages which don't fill a whole group are processed one by one.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+class cipher
+{
+public:
+  static_assert(R >= (LSN_LEN << 1), "Rate must be >= 16 -bytes");
+
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of salt, from which per-page nonces are derived
+  static constexpr size_t SALT_LEN = R;
+
+  // Byte length of authentication tag, stored in page trailer
+  static constexpr size_t TAG_LEN = C;
+
+  // Byte length of page trailer i.e. LSN followed by authentication tag
+  static constexpr size_t TRAILER_LEN = LSN_LEN + TAG_LEN;
+
+  cipher(const uint8_t* const __restrict key,  // C -bytes secret key
+         const uint8_t* const __restrict salt, // R -bytes salt
+         const size_t page_len                 // page byte length | > C + 8
+         )
+    : page_len{ page_len }
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->salt, salt, SALT_LEN);
+  }
+
+  ~cipher() { std::memset(key, 0, KEY_LEN); }
+
+  // Returns byte length of page
+  size_t page_size() const { return page_len; }
+
+  // Returns byte length of encrypted part of page, which is placed before
+  // trailer; zero means configured page length is too short to hold trailer.
+  size_t payload_size() const
+  {
+    return (page_len > TRAILER_LEN) ? page_len - TRAILER_LEN : 0ul;
+  }
+
+  // Returns LSN stored in page trailer, which can be read without decrypting
+  // the page
+  uint64_t lsn(const uint8_t* const page) const
+  {
+    return sparkle_utils::from_le_bytes(page + payload_size());
+  }
+
+  // Encrypts payload of page in place, while writing LSN & authentication tag
+  // to page trailer. Returns false ( without touching the page ) if configured
+  // page length is too short to hold trailer.
+  bool seal(uint8_t* const page,   // page_len -bytes page
+            const uint64_t page_no, // page number
+            const uint64_t lsn      // log sequence number, of latest change
+  ) const
+  {
+    const size_t p_len = payload_size();
+    if (p_len == 0) {
+      return false;
+    }
+
+    uint8_t nonce[R];
+    derive_nonce(page_no, lsn, nonce);
+
+    sparkle_utils::to_le_bytes(lsn, page + p_len);
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, nullptr, 0, page, page, p_len, page + p_len + LSN_LEN);
+
+    return true;
+  }
+
+  // Verifies & decrypts payload of page in place, where nonce is derived from
+  // page number & LSN stored in page trailer. Returns boolean verification
+  // flag; on failure payload is zeroed.
+  bool open(uint8_t* const page,   // page_len -bytes page
+            const uint64_t page_no // page number
+  ) const
+  {
+    const size_t p_len = payload_size();
+    if (p_len == 0) {
+      std::memset(page, 0, page_len);
+      return false;
+    }
+
+    uint8_t nonce[R];
+    derive_nonce(page_no, lsn(page), nonce);
+
+    return aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, page + p_len + LSN_LEN, nullptr, 0, page, page, p_len);
+  }
+
+  // Encrypts a batch of n pages in place ( say all dirty pages, being flushed
+  // during checkpoint ), where i -th page is sealed under `page_nos[i]` &
+  // `lsns[i]`. Returns false ( without touching any page ) if configured page
+  // length is too short to hold trailer.
+  bool seal_many(parallel::thread_pool& pool, // pool of worker threads
+                 uint8_t* const* const pages, // n -many page_len -bytes pages
+                 const uint64_t* const page_nos, // n -many page numbers
+                 const uint64_t* const lsns,     // n -many LSNs
+                 const size_t n                  // # -of pages
+  ) const
+  {
+    const size_t p_len = payload_size();
+    if (p_len == 0) {
+      return false;
+    }
+
+    const size_t full = n / L;
+    const size_t groups = full + (n % L);
+
+    pool.for_each(groups, [&](const size_t g) {
+      if (g >= full) {
+        const size_t i = full * L + (g - full);
+        seal(pages[i], page_nos[i], lsns[i]);
+        return;
+      }
+
+      uint8_t nonces[L][R];
+      const uint8_t* keys[L];
+      const uint8_t* nonces_[L];
+      uint8_t* tags[L];
+
+      for (size_t l = 0; l < L; l++) {
+        const size_t i = g * L + l;
+        uint8_t* const page = pages[i];
+
+        derive_nonce(page_nos[i], lsns[i], nonces[l]);
+        sparkle_utils::to_le_bytes(lsns[i], page + p_len);
+
+        keys[l] = key;
+        nonces_[l] = nonces[l];
+        tags[l] = page + p_len + LSN_LEN;
+      }
+
+      multilane::encrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+        keys, nonces_, nullptr, 0, pages + g * L, pages + g * L, p_len, tags);
+    });
+
+    return true;
+  }
+
+  // Verifies & decrypts a batch of n pages in place ( say pages, just read
+  // from disk ), where i -th page is opened under `page_nos[i]`. Verification
+  // status of i -th page is written to `flags[i]`, while payload of each page,
+  // which failed verification, is zeroed. Returns truth value only if all
+  // pages are verified.
+  bool open_many(parallel::thread_pool& pool, // pool of worker threads
+                 uint8_t* const* const pages, // n -many page_len -bytes pages
+                 const uint64_t* const page_nos, // n -many page numbers
+                 bool* const flags,              // n -many verification flags
+                 const size_t n                  // # -of pages
+  ) const
+  {
+    const size_t p_len = payload_size();
+    if (p_len == 0) {
+      for (size_t i = 0; i < n; i++) {
+        std::memset(pages[i], 0, page_len);
+        flags[i] = false;
+      }
+      return n == 0;
+    }
+
+    const size_t full = n / L;
+    const size_t groups = full + (n % L);
+
+    std::atomic<bool> all{ true };
+
+    pool.for_each(groups, [&](const size_t g) {
+      bool f = true;
+
+      if (g >= full) {
+        const size_t i = full * L + (g - full);
+        f = flags[i] = open(pages[i], page_nos[i]);
+      } else {
+        uint8_t nonces[L][R];
+        const uint8_t* keys[L];
+        const uint8_t* nonces_[L];
+        const uint8_t* tags[L];
+
+        for (size_t l = 0; l < L; l++) {
+          const size_t i = g * L + l;
+          const uint8_t* const page = pages[i];
+
+          derive_nonce(page_nos[i], lsn(page), nonces[l]);
+
+          keys[l] = key;
+          nonces_[l] = nonces[l];
+          tags[l] = page + p_len + LSN_LEN;
+        }
+
+        f = multilane::decrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(keys,
+                                                                 nonces_,
+                                                                 tags,
+                                                                 nullptr,
+                                                                 0,
+                                                                 pages + g * L,
+                                                                 pages + g * L,
+                                                                 p_len,
+                                                                 flags + g * L);
+      }
+
+      if (!f) {
+        all.store(false, std::memory_order_relaxed);
+      }
+    });
+
+    return all.load(std::memory_order_relaxed);
+  }
+
+  // Batch encryption of pages, on process wide thread pool; see above
+  bool seal_many(uint8_t* const* const pages,
+                 const uint64_t* const page_nos,
+                 const uint64_t* const lsns,
+                 const size_t n) const
+  {
+    return seal_many(parallel::default_pool(), pages, page_nos, lsns, n);
+  }
+
+  // Batch decryption of pages, on process wide thread pool; see above
+  bool open_many(uint8_t* const* const pages,
+                 const uint64_t* const page_nos,
+                 bool* const flags,
+                 const size_t n) const
+  {
+    return open_many(parallel::default_pool(), pages, page_nos, flags, n);
+  }
+
+private:
+  // Derives R -bytes nonce of a page, from its page number & LSN
+  void derive_nonce(const uint64_t page_no,
+                    const uint64_t lsn,
+                    uint8_t* const __restrict nonce) const
+  {
+    uint8_t tmp[LSN_LEN << 1];
+    sparkle_utils::to_le_bytes(page_no, tmp);
+    sparkle_utils::to_le_bytes(lsn, tmp + LSN_LEN);
+
+    std::memcpy(nonce, salt, SALT_LEN);
+    for (size_t i = 0; i < sizeof(tmp); i++) {
+      nonce[i] ^= tmp[i];
+    }
+  }
+
+  uint8_t key[KEY_LEN];
+  uint8_t salt[SALT_LEN];
+  size_t page_len;
+};
+
+} // namespace page
+
+// In-place page encryption using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using page_cipher = page::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// In-place page encryption using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using page_cipher = page::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// In-place page encryption using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using page_cipher = page::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// In-place page encryption using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using page_cipher = page::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal fixed size thread pool, used for spreading independent pieces of
+// work ( say segments of a large buffer ) over all available CPU cores
+namespace parallel {
+
+// Fixed size pool of worker threads, which executes one data-parallel job at a
+// time. Calling thread also participates in executing the job, so a pool with
+// N workers keeps N + 1 threads busy.
+//
+// Note, calling `for_each` from inside a job, running on the same pool, results
+// into deadlock.
+class thread_pool
+{
+public:
+  explicit thread_pool(const size_t n_workers)
+  {
+    workers.reserve(n_workers);
+    for (size_t i = 0; i < n_workers; i++) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lk{ mtx };
+      stop = true;
+    }
+    cv_work.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of threads, executing a job, including the calling one
+  size_t concurrency() const { return workers.size() + 1; }
+
+  // Invokes `fn(i)` for each i ∈ [0, n), spreading indices over worker threads
+  // & calling thread, returning only after all of them are done
+  void for_each(const size_t n, const std::function<void(size_t)>& fn)
+  {
+    if ((n < 2) || workers.empty()) {
+      for (size_t i = 0; i < n; i++) {
+        fn(i);
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> submit{ submit_mtx };
+
+    {
+      std::lock_guard<std::mutex> lk{ mtx };
+
+      job = &fn;
+      job_n = n;
+      next.store(0, std::memory_order_relaxed);
+      active = workers.size();
+      generation++;
+    }
+    cv_work.notify_all();
+
+    run(fn, n);
+
+    std::unique_lock<std::mutex> lk{ mtx };
+    cv_done.wait(lk, [this] { return active == 0; });
+    job = nullptr;
+  }
+
+private:
+  // Executes indices of current job, until all of them are claimed
+  void run(const std::function<void(size_t)>& fn, const size_t n)
+  {
+    size_t i = 0;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < n) {
+      fn(i);
+    }
+  }
+
+  // Worker thread's event loop
+  void work()
+  {
+    uint64_t seen = 0;
+
+    while (true) {
+      std::unique_lock<std::mutex> lk{ mtx };
+      cv_work.wait(lk, [&] { return stop || (generation != seen); });
+
+      if (stop) {
+        return;
+      }
+
+      seen = generation;
+      const auto* fn = job;
+      const size_t n = job_n;
+      lk.unlock();
+
+      run(*fn, n);
+
+      lk.lock();
+      if (--active == 0) {
+        cv_done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers;
+
+  std::mutex submit_mtx;
+  std::mutex mtx;
+  std::condition_variable cv_work;
+  std::condition_variable cv_done;
+
+  const std::function<void(size_t)>* job = nullptr;
+  size_t job_n = 0;
+  std::atomic<size_t> next{ 0 };
+  size_t active = 0;
+  uint64_t generation = 0;
+  bool stop = false;
+};
+
+// Process wide thread pool, lazily created on first use, which keeps all
+// hardware threads busy ( calling thread included )
+static inline thread_pool&
+default_pool()
+{
+  static thread_pool pool{
+    std::max<size_t>(std::thread::hardware_concurrency(), 1ul) - 1ul
+  };
+  return pool;
+}
+
+} // namespace parallel
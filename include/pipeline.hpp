@@ -0,0 +1,940 @@
+#pragma once
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "container.hpp"
+#include "esch.hpp"
+#include "uring.hpp"
+
+// Pipelined file encryption/ decryption & hashing, on top of SchwaemmX-Y AEAD
+// | X, Y ∈ {128, 192, 256} & Esch{256, 384}, where reads of next segments,
+// crypto work on ready ones & writes of finished ones overlap, instead of
+// blocking alternately
+//
+// Input file is processed in fixed size segments, `depth` -many of them being
+// in flight at any time, each owning an input & an output buffer, which are
+// registered with io_uring, so that kernel can skip mapping them on every
+// request. Consecutive segments, whose reads have completed, are encrypted/
+// decrypted together, spread over all CPU cores, while hashing consumes them
+// in order, on calling thread. When io_uring isn't available ( or disabled ),
+// same pipeline runs on blocking pread/ pwrite, one batch of `depth` segments
+// at a time.
+//
+// Encrypted files use container format ( see container.hpp ), so they can also
+// be read back randomly, using container::reader.
+namespace pipeline {
+
+// Knobs of file pipeline
+struct options
+{
+  size_t chunk_len = 1ul << 20; // segment byte length | > 0
+  size_t depth = 8;             // # -of segments in flight | > 0
+  bool direct = false;          // read plain text files using O_DIRECT
+  bool uring = true;            // use io_uring, if kernel allows it
+};
+
+// Alignment of buffers & segment lengths, required by O_DIRECT
+constexpr size_t DIRECT_ALIGN = 4096ul;
+
+// Description of a pipelined transform, reading `total` -bytes from `in_fd`,
+// starting at `in_base`, in segments of `chunk_len` -bytes, passing each of
+// them to `work` & writing produced segment ( of same length ) to `out_fd` (
+// unless it's negative ), starting at `out_base`
+struct plan
+{
+  int in_fd = -1;
+  uint64_t in_base = 0;
+  int out_fd = -1;
+  uint64_t out_base = 0;
+  size_t total = 0;
+  bool direct = false;  // input is opened with O_DIRECT
+  bool ordered = false; // segments must be worked on in order, one at a time
+
+  // Processes i -th segment, returning false on failure
+  std::function<bool(size_t, const uint8_t*, uint8_t*, size_t)> work;
+};
+
+// Page aligned heap memory, released when it goes out of scope
+struct aligned_deleter
+{
+  void operator()(uint8_t* const ptr) const { std::free(ptr); }
+};
+using aligned_buffer = std::unique_ptr<uint8_t[], aligned_deleter>;
+
+// Allocates at least `len` -bytes of page aligned memory, returning empty
+// buffer ( with errno set ), when allocation fails
+static inline aligned_buffer
+alloc_aligned(const size_t len)
+{
+  const size_t sz = (len + DIRECT_ALIGN - 1) & ~(DIRECT_ALIGN - 1);
+  void* const ptr =
+    std::aligned_alloc(DIRECT_ALIGN, std::max(sz, DIRECT_ALIGN));
+  return aligned_buffer{ static_cast<uint8_t*>(ptr) };
+}
+
+// Byte length of a buffer slot, holding one segment, which is bounded by input
+// length, so that a small file ( or a container header, claiming a large chunk
+// length ) doesn't allocate whole chunks. It stays a multiple of DIRECT_ALIGN,
+// when chunk length is one.
+static inline size_t
+slot_len(const plan& p, const options& opt)
+{
+  const size_t total = (p.total + DIRECT_ALIGN - 1) & ~(DIRECT_ALIGN - 1);
+  return std::min(opt.chunk_len, std::max(total, DIRECT_ALIGN));
+}
+
+// Reads exactly `len` -bytes from file offset `off`, returning false on
+// failure or unexpected end of file
+static inline bool
+pread_full(const int fd, uint8_t* const buf, const size_t len, const size_t off)
+{
+  size_t done = 0;
+  while (done < len) {
+    const ssize_t r = ::pread(fd, buf + done, len - done, off + done);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r <= 0) {
+      return false;
+    }
+    done += static_cast<size_t>(r);
+  }
+  return true;
+}
+
+// Writes exactly `len` -bytes to file offset `off`, returning false on failure
+static inline bool
+pwrite_full(const int fd,
+            const uint8_t* const buf,
+            const size_t len,
+            const size_t off)
+{
+  size_t done = 0;
+  while (done < len) {
+    const ssize_t r = ::pwrite(fd, buf + done, len - done, off + done);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r <= 0) {
+      return false;
+    }
+    done += static_cast<size_t>(r);
+  }
+  return true;
+}
+
+// Reads `len` -bytes from file opened with O_DIRECT, at aligned offset `off`,
+// into aligned `buf`, which has room for `len` rounded up to DIRECT_ALIGN. Each
+// read has aligned offset & length, so a short read is resumed from last
+// aligned position it reached. Returns false on failure, unexpected end of
+// file or when a short read doesn't reach next aligned position.
+static inline bool
+pread_direct(const int fd,
+             uint8_t* const buf,
+             const size_t len,
+             const size_t off)
+{
+  size_t done = 0;
+  while (done < len) {
+    const size_t rlen = (len - done + DIRECT_ALIGN - 1) & ~(DIRECT_ALIGN - 1);
+
+    const ssize_t r = ::pread(fd, buf + done, rlen, off + done);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r <= 0) {
+      return false;
+    }
+
+    const size_t got = done + static_cast<size_t>(r);
+    if (got >= len) {
+      return true;
+    }
+
+    const size_t next = got & ~(DIRECT_ALIGN - 1);
+    if (next == done) {
+      return false;
+    }
+    done = next;
+  }
+  return true;
+}
+
+// Runs a pipelined transform using a batch of `depth` segments at a time,
+// with blocking pread/ pwrite
+static inline bool
+run_blocking(const plan& p, const options& opt)
+{
+  const size_t n = bulk::segment_count(p.total, opt.chunk_len);
+  const size_t depth = std::min(opt.depth, n);
+  const size_t stride = slot_len(p, opt);
+  const bool out = p.out_fd >= 0;
+
+  auto ibuf = alloc_aligned(depth * stride);
+  auto obuf = alloc_aligned(out ? depth * stride : 0);
+  if (!ibuf || !obuf) {
+    return false;
+  }
+
+  for (size_t b = 0; b < n; b += depth) {
+    const size_t cnt = std::min(depth, n - b);
+
+    auto len_of = [&](const size_t i) {
+      return std::min(opt.chunk_len, p.total - i * opt.chunk_len);
+    };
+
+    for (size_t k = 0; k < cnt; k++) {
+      const size_t i = b + k;
+      uint8_t* const dst = ibuf.get() + k * stride;
+      const size_t off = p.in_base + i * opt.chunk_len;
+
+      // O_DIRECT needs aligned length, while file may end earlier
+      const bool f = p.direct ? pread_direct(p.in_fd, dst, len_of(i), off)
+                              : pread_full(p.in_fd, dst, len_of(i), off);
+      if (!f) {
+        return false;
+      }
+    }
+
+    std::atomic<bool> flag{ true };
+    auto job = [&](const size_t k) {
+      const size_t i = b + k;
+      const uint8_t* const src = ibuf.get() + k * stride;
+      uint8_t* const dst = out ? obuf.get() + k * stride : nullptr;
+
+      if (!p.work(i, src, dst, len_of(i))) {
+        flag.store(false, std::memory_order_relaxed);
+      }
+    };
+
+    if (p.ordered) {
+      for (size_t k = 0; k < cnt; k++) {
+        job(k);
+      }
+    } else {
+      parallel::default_pool().for_each(cnt, job);
+    }
+
+    if (!flag.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    for (size_t k = 0; out && (k < cnt); k++) {
+      const size_t i = b + k;
+      const uint8_t* const src = obuf.get() + k * stride;
+      const size_t off = p.out_base + i * opt.chunk_len;
+
+      if (!pwrite_full(p.out_fd, src, len_of(i), off)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Runs a pipelined transform on io_uring, where i -th segment lives in slot (i
+// % depth), which is reused for segment (i + depth), once this one is written.
+// As writes may complete out of order, read of next segment waits for its own
+// slot to be freed, instead of taking whichever slot got freed first. Returns
+// -1, if io_uring can't be set up, so that caller can fall back to blocking
+// I/O, otherwise boolean status.
+//
+// Ring type is a template parameter, only so that completion order can be
+// shuffled, when testing; see example/pipeline.cpp.
+template<typename Ring = uring::ring>
+static inline int
+run_uring(const plan& p, const options& opt)
+{
+  const size_t n = bulk::segment_count(p.total, opt.chunk_len);
+  const size_t depth = std::min(opt.depth, n);
+  const size_t stride = slot_len(p, opt);
+  const bool out = p.out_fd >= 0;
+
+  Ring ring{ static_cast<unsigned>(2 * depth) };
+  if (!ring.ok()) {
+    return -1;
+  }
+
+  enum class state : uint8_t
+  {
+    free,
+    reading,
+    ready,
+    writing
+  };
+
+  struct slot
+  {
+    state st = state::free;
+    size_t seg = 0;
+    size_t done = 0;
+  };
+
+  auto ibuf = alloc_aligned(depth * stride);
+  auto obuf = alloc_aligned(out ? depth * stride : 0);
+  if (!ibuf || !obuf) {
+    return 0;
+  }
+  std::vector<slot> slots(depth);
+
+  // registered buffers: input ones first, followed by output ones
+  std::vector<iovec> iovs;
+  for (size_t s = 0; s < depth; s++) {
+    iovs.push_back(iovec{ ibuf.get() + s * stride, stride });
+  }
+  for (size_t s = 0; out && (s < depth); s++) {
+    iovs.push_back(iovec{ obuf.get() + s * stride, stride });
+  }
+
+  const bool fixed =
+    ring.register_buffers(iovs.data(), static_cast<unsigned>(iovs.size()));
+
+  auto len_of = [&](const size_t i) {
+    return std::min(opt.chunk_len, p.total - i * opt.chunk_len);
+  };
+
+  // queues ( remaining part of ) read/ write request of a slot
+  auto queue_io = [&](const size_t s) {
+    slot& sl = slots[s];
+    const size_t want = len_of(sl.seg);
+    const int idx = fixed ? static_cast<int>(s) : -1;
+
+    if (sl.st == state::reading) {
+      size_t rlen = want - sl.done;
+      if (p.direct) {
+        rlen = (rlen + DIRECT_ALIGN - 1) & ~(DIRECT_ALIGN - 1);
+      }
+
+      return ring.read(p.in_fd,
+                       ibuf.get() + s * stride + sl.done,
+                       static_cast<uint32_t>(rlen),
+                       p.in_base + sl.seg * opt.chunk_len + sl.done,
+                       idx,
+                       s);
+    }
+
+    return ring.write(p.out_fd,
+                      obuf.get() + s * stride + sl.done,
+                      static_cast<uint32_t>(want - sl.done),
+                      p.out_base + sl.seg * opt.chunk_len + sl.done,
+                      fixed ? static_cast<int>(depth + s) : -1,
+                      s);
+  };
+
+  size_t next_read = 0; // next segment to be read
+  size_t next_work = 0; // next segment to be worked on
+  size_t finished = 0;  // # -of segments, completely done
+  size_t inflight = 0;  // # -of requests, owned by kernel
+  bool ok = true;
+
+  auto issue = [&](const size_t s) {
+    if (queue_io(s)) {
+      inflight++;
+    } else {
+      ok = false;
+    }
+  };
+
+  // starts reading next segments, as long as their slots are free
+  auto start_reads = [&]() {
+    while (ok && (next_read < n)) {
+      const size_t s = next_read % depth;
+      if (slots[s].st != state::free) {
+        break;
+      }
+
+      slots[s] = slot{ state::reading, next_read++, 0 };
+      issue(s);
+    }
+  };
+
+  start_reads();
+
+  bool progressed = true;
+  while (ok && (finished < n)) {
+    if (!progressed && (inflight == 0)) {
+      // nothing to wait for, yet segments are left; must never happen
+      ok = false;
+      break;
+    }
+
+    ok &= ring.submit(progressed ? 0u : 1u);
+    progressed = false;
+
+    // reap completions, re-queueing short transfers
+    uring::completion c;
+    while (ok && ring.reap(c)) {
+      inflight--;
+      progressed = true;
+
+      slot& sl = slots[c.user];
+      const size_t want = len_of(sl.seg);
+
+      if ((c.res < 0) || ((c.res == 0) && (sl.done < want))) {
+        ok = false;
+        break;
+      }
+
+      size_t done = std::min(want, sl.done + static_cast<size_t>(c.res));
+      if (p.direct && (sl.st == state::reading) && (done < want)) {
+        // O_DIRECT read must be resumed at an aligned offset
+        const size_t next = done & ~(DIRECT_ALIGN - 1);
+        if (next == sl.done) {
+          ok = false;
+          break;
+        }
+        done = next;
+      }
+
+      sl.done = done;
+      if (sl.done < want) {
+        issue(c.user);
+        continue;
+      }
+
+      if (sl.st == state::reading) {
+        sl.st = state::ready;
+      } else {
+        sl.st = state::free;
+        finished++;
+        start_reads();
+      }
+    }
+
+    if (!ok) {
+      break;
+    }
+
+    // work on run of consecutive ready segments
+    size_t cnt = 0;
+    while (((next_work + cnt) < n) &&
+           (slots[(next_work + cnt) % depth].st == state::ready) &&
+           (slots[(next_work + cnt) % depth].seg == next_work + cnt) &&
+           (cnt < depth)) {
+      cnt++;
+    }
+    if (cnt == 0) {
+      continue;
+    }
+    progressed = true;
+
+    std::atomic<bool> flag{ true };
+    auto job = [&](const size_t k) {
+      const size_t i = next_work + k;
+      const size_t s = i % depth;
+      const uint8_t* const src = ibuf.get() + s * stride;
+      uint8_t* const dst = out ? obuf.get() + s * stride : nullptr;
+
+      if (!p.work(i, src, dst, len_of(i))) {
+        flag.store(false, std::memory_order_relaxed);
+      }
+    };
+
+    if (p.ordered || (cnt == 1)) {
+      for (size_t k = 0; k < cnt; k++) {
+        job(k);
+      }
+    } else {
+      parallel::default_pool().for_each(cnt, job);
+    }
+
+    if (!flag.load(std::memory_order_relaxed)) {
+      ok = false;
+      break;
+    }
+
+    for (size_t k = 0; k < cnt; k++) {
+      const size_t s = (next_work + k) % depth;
+
+      if (out && (len_of(slots[s].seg) > 0)) {
+        slots[s].st = state::writing;
+        slots[s].done = 0;
+        issue(s);
+      } else {
+        slots[s].st = state::free;
+        finished++;
+      }
+    }
+    next_work += cnt;
+    start_reads();
+  }
+
+  // kernel may still be using buffers, so wait for all requests, on failure
+  while (inflight > 0) {
+    if (!ring.submit(1)) {
+      break;
+    }
+
+    uring::completion c;
+    while (ring.reap(c)) {
+      inflight--;
+    }
+  }
+
+  return ok ? 1 : 0;
+}
+
+// Runs a pipelined transform, on io_uring, if it's enabled & usable, falling
+// back to blocking pread/ pwrite
+static inline bool
+run(const plan& p, const options& opt)
+{
+  if (opt.uring) {
+    const int r = run_uring(p, opt);
+    if (r >= 0) {
+      return r == 1;
+    }
+  }
+  return run_blocking(p, opt);
+}
+
+// Validates pipeline knobs, returning false if they are unusable
+static inline bool
+check(const options& opt)
+{
+  if ((opt.chunk_len == 0) || (opt.depth == 0)) {
+    return false;
+  }
+  if (opt.chunk_len > (1ul << 30)) {
+    return false;
+  }
+  if (opt.direct && ((opt.chunk_len % DIRECT_ALIGN) != 0)) {
+    return false;
+  }
+  return true;
+}
+
+// Opens plain input file, using O_DIRECT if requested, falling back to page
+// cache, if file system doesn't support it. Sets `direct` to whether O_DIRECT
+// is actually in use.
+static inline int
+open_input(const char* const path, const bool want_direct, bool& direct)
+{
+  direct = false;
+  if (want_direct) {
+    const int fd = ::open(path, O_RDONLY | O_DIRECT);
+    if (fd >= 0) {
+      direct = true;
+      return fd;
+    }
+  }
+  return ::open(path, O_RDONLY);
+}
+
+// Generic pipelined file sealing routine, which can be used with SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of template
+// parameters.
+//
+// Encrypts file at `in_path` into a container ( see container.hpp ) at
+// `out_path`, which is created or truncated, using C -bytes secret key & (R -
+// 5) -bytes base nonce. Returns false if knobs are unusable or any file
+// operation fails.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+seal_file(const char* const in_path,             // plain text file path
+          const char* const out_path,            // container file path
+          const uint8_t* const __restrict key,   // C -bytes secret key
+          const uint8_t* const __restrict nonce, // (R - 5) -bytes base nonce
+          const options& opt                     // pipeline knobs
+)
+{
+  constexpr size_t hlen = container::HEADER_LEN<R>;
+
+  if (!check(opt)) {
+    return false;
+  }
+
+  bool direct = false;
+  const int in = open_input(in_path, opt.direct, direct);
+  if (in < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(in, &st) != 0) {
+    ::close(in);
+    return false;
+  }
+
+  const size_t len = static_cast<size_t>(st.st_size);
+  const size_t n = bulk::segment_count(len, opt.chunk_len);
+  if (n > stream::MAX_SEGMENTS) {
+    ::close(in);
+    return false;
+  }
+
+  const int out = ::open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (out < 0) {
+    ::close(in);
+    return false;
+  }
+
+  const size_t size = container::sealed_size<R, C>(len, opt.chunk_len);
+  bool f = ::ftruncate(out, static_cast<off_t>(size)) == 0;
+
+  // header & tag table are written once all segments are sealed
+  std::vector<uint8_t> head(hlen + n * C);
+  std::memcpy(head.data(), container::MAGIC, sizeof(container::MAGIC));
+  sparkle_utils::to_le_bytes(opt.chunk_len, head.data() + 8);
+  sparkle_utils::to_le_bytes(len, head.data() + 16);
+  std::memcpy(head.data() + 24, nonce, R - stream::NONCE_SUFFIX_LEN);
+
+  uint8_t* const tags = head.data() + hlen;
+
+  plan p;
+  p.in_fd = in;
+  p.out_fd = out;
+  p.out_base = hlen + n * C;
+  p.total = len;
+  p.direct = direct;
+  p.work = [&](const size_t i,
+               const uint8_t* const txt,
+               uint8_t* const enc,
+               const size_t ct_len) {
+    uint8_t seg_nonce[R];
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(i), i == (n - 1), seg_nonce);
+
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, head.data(), hlen, txt, enc, ct_len, tags + i * C);
+    return true;
+  };
+
+  f = f && run(p, opt);
+  f = f && pwrite_full(out, head.data(), head.size(), 0);
+
+  ::close(in);
+  ::close(out);
+  return f;
+}
+
+// Generic pipelined file opening routine, which can be used with SchwaemmX-Y
+// AEAD | X, Y ∈ {128, 192, 256}; see aead::decrypt for meaning of template
+// parameters.
+//
+// Decrypts container at `in_path` ( see container.hpp ) into file at
+// `out_path`, which is created or truncated, using C -bytes secret key.
+// Returns false if knobs are unusable, container is malformed ( or its chunk
+// length is larger than 1 GB ), any segment fails verification or any file
+// operation fails; in which case output file is truncated to zero, so that no
+// unverified plain text is released.
+//
+// Note, O_DIRECT isn't used here, because segments of container are not
+// aligned.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+open_file(const char* const in_path,           // container file path
+          const char* const out_path,          // plain text file path
+          const uint8_t* const __restrict key, // C -bytes secret key
+          const options& opt                   // pipeline knobs
+)
+{
+  constexpr size_t hlen = container::HEADER_LEN<R>;
+
+  options o = opt;
+  o.direct = false;
+
+  const int in = ::open(in_path, O_RDONLY);
+  if (in < 0) {
+    return false;
+  }
+
+  struct stat st;
+  uint8_t hdr[hlen];
+
+  if ((::fstat(in, &st) != 0) || !pread_full(in, hdr, hlen, 0) ||
+      (std::memcmp(hdr, container::MAGIC, sizeof(container::MAGIC)) != 0)) {
+    ::close(in);
+    return false;
+  }
+
+  const size_t size = static_cast<size_t>(st.st_size);
+  o.chunk_len = sparkle_utils::from_le_bytes(hdr + 8);
+  const size_t len = sparkle_utils::from_le_bytes(hdr + 16);
+
+  if (!check(o) || (len > size)) {
+    ::close(in);
+    return false;
+  }
+
+  const size_t n = bulk::segment_count(len, o.chunk_len);
+  if ((n > stream::MAX_SEGMENTS) || (size != hlen + n * C + len)) {
+    ::close(in);
+    return false;
+  }
+
+  std::vector<uint8_t> tags(n * C);
+  if (!pread_full(in, tags.data(), tags.size(), hlen)) {
+    ::close(in);
+    return false;
+  }
+
+  const int out = ::open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (out < 0) {
+    ::close(in);
+    return false;
+  }
+
+  bool f = ::ftruncate(out, static_cast<off_t>(len)) == 0;
+
+  const uint8_t* const nonce = hdr + 24;
+
+  plan p;
+  p.in_fd = in;
+  p.in_base = hlen + n * C;
+  p.out_fd = out;
+  p.total = len;
+  p.work = [&](const size_t i,
+               const uint8_t* const enc,
+               uint8_t* const dec,
+               const size_t ct_len) {
+    uint8_t seg_nonce[R];
+    stream::derive_nonce<R>(
+      nonce, static_cast<uint32_t>(i), i == (n - 1), seg_nonce);
+
+    return aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, tags.data() + i * C, hdr, hlen, enc, dec, ct_len);
+  };
+
+  f = f && run(p, o);
+  if (!f) {
+    // don't release unverified plain text
+    [[maybe_unused]] const int r = ::ftruncate(out, 0);
+  }
+
+  ::close(in);
+  ::close(out);
+  return f;
+}
+
+// Generic pipelined file hashing routine, which can be used with Esch256 (
+// nb = 6 ) or Esch384 ( nb = 8 ); see hash::hasher for meaning of template
+// parameters.
+//
+// Computes dlen -bytes digest of file at `in_path`, returning false if knobs
+// are unusable or any file operation fails.
+template<const size_t nb,
+         const size_t ns_slim,
+         const size_t ns_big,
+         const size_t dlen>
+static inline bool
+hash_file(const char* const in_path,       // file path
+          uint8_t* const __restrict out,    // dlen -bytes digest
+          const options& opt                // pipeline knobs
+)
+{
+  if (!check(opt)) {
+    return false;
+  }
+
+  bool direct = false;
+  const int in = open_input(in_path, opt.direct, direct);
+  if (in < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(in, &st) != 0) {
+    ::close(in);
+    return false;
+  }
+
+  hash::hasher<nb, ns_slim, ns_big, dlen> h;
+
+  plan p;
+  p.in_fd = in;
+  p.total = static_cast<size_t>(st.st_size);
+  p.direct = direct;
+  p.ordered = true;
+  p.work = [&](const size_t,
+               const uint8_t* const msg,
+               uint8_t* const,
+               const size_t len) {
+    h.absorb(msg, len);
+    return true;
+  };
+
+  const bool f = run(p, opt);
+  if (f) {
+    h.finalize(out);
+  }
+
+  ::close(in);
+  return f;
+}
+
+} // namespace pipeline
+
+// Pipelined file hashing using Esch256
+namespace esch256 {
+
+// Computes Esch256 digest of a file; see pipeline::hash_file
+static inline bool
+hash_file(const char* const path,           // file path
+          uint8_t* const __restrict out,    // 32 -bytes digest
+          const pipeline::options& opt = {} // pipeline knobs
+)
+{
+  return pipeline::hash_file<6, 7, 11, DIGEST_LEN>(path, out, opt);
+}
+
+}
+
+// Pipelined file hashing using Esch384
+namespace esch384 {
+
+// Computes Esch384 digest of a file; see pipeline::hash_file
+static inline bool
+hash_file(const char* const path,           // file path
+          uint8_t* const __restrict out,    // 48 -bytes digest
+          const pipeline::options& opt = {} // pipeline knobs
+)
+{
+  return pipeline::hash_file<8, 8, 12, DIGEST_LEN>(path, out, opt);
+}
+
+}
+
+// Pipelined file encryption/ decryption using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+// Encrypts a file into a container file; see pipeline::seal_file
+static inline bool
+pipeline_seal_file(const char* const in_path,  // plain text file path
+                   const char* const out_path, // container file path
+                   const uint8_t* const __restrict key,   // 16 -bytes key
+                   const uint8_t* const __restrict nonce, // 27 -bytes nonce
+                   const pipeline::options& opt = {}     // pipeline knobs
+)
+{
+  return pipeline::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, nonce, opt);
+}
+
+// Decrypts a container file into a file; see pipeline::open_file
+static inline bool
+pipeline_open_file(const char* const in_path,  // container file path
+                   const char* const out_path, // plain text file path
+                   const uint8_t* const __restrict key, // 16 -bytes key
+                   const pipeline::options& opt = {}   // pipeline knobs
+)
+{
+  return pipeline::open_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, opt);
+}
+
+}
+
+// Pipelined file encryption/ decryption using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+// Encrypts a file into a container file; see pipeline::seal_file
+static inline bool
+pipeline_seal_file(const char* const in_path,  // plain text file path
+                   const char* const out_path, // container file path
+                   const uint8_t* const __restrict key,   // 24 -bytes key
+                   const uint8_t* const __restrict nonce, // 19 -bytes nonce
+                   const pipeline::options& opt = {}     // pipeline knobs
+)
+{
+  return pipeline::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, nonce, opt);
+}
+
+// Decrypts a container file into a file; see pipeline::open_file
+static inline bool
+pipeline_open_file(const char* const in_path,  // container file path
+                   const char* const out_path, // plain text file path
+                   const uint8_t* const __restrict key, // 24 -bytes key
+                   const pipeline::options& opt = {}   // pipeline knobs
+)
+{
+  return pipeline::open_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, opt);
+}
+
+}
+
+// Pipelined file encryption/ decryption using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+// Encrypts a file into a container file; see pipeline::seal_file
+static inline bool
+pipeline_seal_file(const char* const in_path,  // plain text file path
+                   const char* const out_path, // container file path
+                   const uint8_t* const __restrict key,   // 16 -bytes key
+                   const uint8_t* const __restrict nonce, // 11 -bytes nonce
+                   const pipeline::options& opt = {}     // pipeline knobs
+)
+{
+  return pipeline::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, nonce, opt);
+}
+
+// Decrypts a container file into a file; see pipeline::open_file
+static inline bool
+pipeline_open_file(const char* const in_path,  // container file path
+                   const char* const out_path, // plain text file path
+                   const uint8_t* const __restrict key, // 16 -bytes key
+                   const pipeline::options& opt = {}   // pipeline knobs
+)
+{
+  return pipeline::open_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, opt);
+}
+
+}
+
+// Pipelined file encryption/ decryption using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+// Encrypts a file into a container file; see pipeline::seal_file
+static inline bool
+pipeline_seal_file(const char* const in_path,  // plain text file path
+                   const char* const out_path, // container file path
+                   const uint8_t* const __restrict key,   // 32 -bytes key
+                   const uint8_t* const __restrict nonce, // 27 -bytes nonce
+                   const pipeline::options& opt = {}     // pipeline knobs
+)
+{
+  return pipeline::seal_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, nonce, opt);
+}
+
+// Decrypts a container file into a file; see pipeline::open_file
+static inline bool
+pipeline_open_file(const char* const in_path,  // container file path
+                   const char* const out_path, // plain text file path
+                   const uint8_t* const __restrict key, // 32 -bytes key
+                   const pipeline::options& opt = {}   // pipeline knobs
+)
+{
+  return pipeline::open_file<R, C, A0, A1, M0, M1, BR, S, B>(
+    in_path, out_path, key, opt);
+}
+
+}
@@ -0,0 +1,461 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#include "multilane.hpp"
+#include "schwaemm.hpp"
+
+// TLS-like record layer on top of SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}
+//
+// Each record is laid out, on the wire, as
+//
+// record = header || cipher text || tag
+//
+// header = type || be32(len)
+//
+// where type is 1 -byte content type, len is byte length of plain text ( =
+// byte length of cipher text ) & tag is C -bytes authentication tag. Header is
+// authenticated as associated data of the record, while nonce of i -th record
+// ( i = 0, 1, 2 ... ) is derived from R -bytes static IV, as
+//
+// nonce = iv ⊕ (0^(R - 8) || be64(i))
+//
+// so both sides must seal/ open records in same order. Records are written
+// directly into caller provided buffers, where header is placed in headroom
+// before payload, while tag is placed right after payload.
+namespace record {
+
+// Byte length of record header i.e. 1 -byte type & 4 -bytes length
+constexpr size_t HEADER_LEN = 5ul;
+
+// Parsed form of an opened record, whose plain text is decrypted in place,
+// inside receive buffer
+struct view
+{
+  uint8_t type;  // content type
+  uint8_t* data; // plain text
+  size_t len;    // plain text byte length
+};
+
+// Given R -bytes IV & record sequence number, this routine derives R -bytes
+// nonce, which is used for sealing/ opening that record
+template<const size_t R>
+static inline void
+derive_nonce(const uint8_t* const __restrict iv, // R -bytes static IV
+             const uint64_t seq,                 // record sequence number
+             uint8_t* const __restrict nonce     // R -bytes nonce
+)
+{
+  std::memcpy(nonce, iv, R);
+
+  for (size_t i = 0; i < 8; i++) {
+    nonce[R - 1 - i] ^= static_cast<uint8_t>(seq >> (i << 3));
+  }
+}
+
+// Writes record header, given content type & plain text byte length
+static inline void
+write_header(uint8_t* const hdr, const uint8_t type, const uint32_t len)
+{
+  hdr[0] = type;
+  hdr[1] = static_cast<uint8_t>(len >> 24);
+  hdr[2] = static_cast<uint8_t>(len >> 16);
+  hdr[3] = static_cast<uint8_t>(len >> 8);
+  hdr[4] = static_cast<uint8_t>(len >> 0);
+}
+
+// Reads plain text byte length from record header
+static inline size_t
+read_length(const uint8_t* const hdr)
+{
+  return (static_cast<size_t>(hdr[1]) << 24) |
+         (static_cast<size_t>(hdr[2]) << 16) |
+         (static_cast<size_t>(hdr[3]) << 8) | static_cast<size_t>(hdr[4]);
+}
+
+// Sealing side of record layer, which can be used with SchwaemmX-Y AEAD | X, Y
+// ∈ {128, 192, 256}; see aead::encrypt for meaning of first nine template
+// parameters, while L denotes # -of equal length records, sealed together,
+// when sealing a batch of records ( see multilane.hpp ).
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+class sealer
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of static IV, from which per-record nonces are derived
+  static constexpr size_t IV_LEN = R;
+
+  // Byte length of authentication tag, appended to each record
+  static constexpr size_t TAG_LEN = C;
+
+  // # -of bytes, each record takes on wire, in addition to its plain text
+  static constexpr size_t OVERHEAD = HEADER_LEN + TAG_LEN;
+
+  sealer(const uint8_t* const __restrict key, // C -bytes secret key
+         const uint8_t* const __restrict iv   // R -bytes static IV
+  )
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->iv, iv, IV_LEN);
+  }
+
+  ~sealer() { std::memset(key, 0, KEY_LEN); }
+
+  // Seals next record, given its content type & plain text, writing len +
+  // OVERHEAD -bytes record to `out`. Plain text can already be in place i.e.
+  // `txt` can be `out + HEADER_LEN`, for sealing without any copy. Returns
+  // byte length of written record, which is zero when plain text is too long
+  // to be described by record header.
+  size_t seal(const uint8_t type,       // content type
+              const uint8_t* const txt, // len -bytes plain text
+              const size_t len,         // len(txt) | < 2^32
+              uint8_t* const out        // len + OVERHEAD -bytes record
+  )
+  {
+    if (len > UINT32_MAX) {
+      return 0;
+    }
+
+    uint8_t nonce[R];
+    derive_nonce<R>(iv, seq, nonce);
+    write_header(out, type, static_cast<uint32_t>(len));
+
+    uint8_t* const enc = out + HEADER_LEN;
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, out, HEADER_LEN, txt, enc, len, enc + len);
+
+    seq++;
+    return len + OVERHEAD;
+  }
+
+  // Seals n records back to back into `out` ( say to be sent as a single
+  // packet ), where i -th record has content type `types[i]` & plain text
+  // `txts[i]` of `lens[i]` -bytes. Each run of L consecutive records with
+  // equal plain text length is sealed together, using multi-lane Schwaemm.
+  // Returns total byte length of written records, which is zero ( without
+  // sealing any record ) when any plain text is too long to be described by
+  // record header.
+  //
+  // Note, `out` must be able to hold Σ lens[i] + n * OVERHEAD -bytes, while
+  // plain text of a record can either be outside of `out` or already be in
+  // place, at the position where its cipher text is to be written.
+  size_t seal_many(const uint8_t* const types,      // n -many content types
+                   const uint8_t* const* const txts, // n -many plain texts
+                   const size_t* const lens,         // n -many lengths
+                   const size_t n,                   // # -of records
+                   uint8_t* const out                // records
+  )
+  {
+    for (size_t i = 0; i < n; i++) {
+      if (lens[i] > UINT32_MAX) {
+        return 0;
+      }
+    }
+
+    size_t off = 0;
+    size_t i = 0;
+
+    while (i < n) {
+      if (!same_length(lens + i, n - i)) {
+        off += seal(types[i], txts[i], lens[i], out + off);
+        i++;
+        continue;
+      }
+
+      const size_t len = lens[i];
+
+      uint8_t nonces[L][R];
+      const uint8_t* keys[L];
+      const uint8_t* nonces_[L];
+      const uint8_t* hdrs[L];
+      uint8_t* encs[L];
+      uint8_t* tags[L];
+
+      for (size_t l = 0; l < L; l++) {
+        uint8_t* const rec = out + off + l * (len + OVERHEAD);
+
+        derive_nonce<R>(iv, seq + l, nonces[l]);
+        write_header(rec, types[i + l], static_cast<uint32_t>(len));
+
+        keys[l] = key;
+        nonces_[l] = nonces[l];
+        hdrs[l] = rec;
+        encs[l] = rec + HEADER_LEN;
+        tags[l] = rec + HEADER_LEN + len;
+      }
+
+      multilane::encrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+        keys, nonces_, hdrs, HEADER_LEN, txts + i, encs, len, tags);
+
+      seq += L;
+      off += L * (len + OVERHEAD);
+      i += L;
+    }
+
+    return off;
+  }
+
+  // Returns sequence number of next record, to be sealed
+  uint64_t sequence() const { return seq; }
+
+private:
+  // Checks whether next L records ( out of n remaining ones ) have equal
+  // plain text length, so that they can be sealed together
+  static bool same_length(const size_t* const lens, const size_t n)
+  {
+    if (n < L) {
+      return false;
+    }
+
+    bool same = true;
+    for (size_t l = 1; l < L; l++) {
+      same &= lens[l] == lens[0];
+    }
+    return same;
+  }
+
+  uint8_t key[KEY_LEN];
+  uint8_t iv[IV_LEN];
+  uint64_t seq = 0;
+};
+
+// Opening side of record layer, which can be used with SchwaemmX-Y AEAD | X, Y
+// ∈ {128, 192, 256}; see record::sealer for meaning of template parameters.
+//
+// Records must be opened in the same order they were sealed in. After first
+// verification failure, this object refuses to open any more records.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B,
+         const size_t L = multilane::LANES>
+class opener
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of static IV, from which per-record nonces are derived
+  static constexpr size_t IV_LEN = R;
+
+  // Byte length of authentication tag, appended to each record
+  static constexpr size_t TAG_LEN = C;
+
+  // # -of bytes, each record takes on wire, in addition to its plain text
+  static constexpr size_t OVERHEAD = HEADER_LEN + TAG_LEN;
+
+  opener(const uint8_t* const __restrict key, // C -bytes secret key
+         const uint8_t* const __restrict iv   // R -bytes static IV
+  )
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->iv, iv, IV_LEN);
+  }
+
+  ~opener() { std::memset(key, 0, KEY_LEN); }
+
+  // Verifies & decrypts next record in place, given `rec_len` -bytes, which
+  // must hold exactly one complete record. On success, plain text is available
+  // at `rec + HEADER_LEN` & it's described by `out`. Returns boolean
+  // verification flag; on failure decrypted bytes are zeroed & this object is
+  // marked as failed.
+  bool open(uint8_t* const rec, const size_t rec_len, view& out)
+  {
+    if (failed || (rec_len < OVERHEAD) ||
+        (read_length(rec) != rec_len - OVERHEAD)) {
+      failed = true;
+      return false;
+    }
+
+    const size_t len = rec_len - OVERHEAD;
+
+    uint8_t nonce[R];
+    derive_nonce<R>(iv, seq, nonce);
+
+    uint8_t* const dec = rec + HEADER_LEN;
+    const bool f = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, dec + len, rec, HEADER_LEN, dec, dec, len);
+
+    out = view{ rec[0], dec, len };
+
+    failed = !f;
+    seq += f;
+    return f;
+  }
+
+  // Verifies & decrypts, in place, all complete records found at the start of
+  // a receive buffer of `buf_len` -bytes, writing description of at most
+  // `max_recs` opened records to `recs`. Each run of L consecutive records
+  // with equal plain text length is opened together, using multi-lane
+  // Schwaemm. Returns # -of opened records, while `consumed` is set to # -of
+  // bytes they take, so that trailing, incomplete record can be retained until
+  // more bytes arrive.
+  //
+  // Opening stops at first record which fails verification, after which this
+  // object is marked as failed & records following it aren't opened. Like
+  // failing record, ones following it, which were decrypted along with it on
+  // other SIMD lanes, are zeroed, as they're never reported.
+  size_t open_many(uint8_t* const buf,    // receive buffer
+                   const size_t buf_len,   // len(buf)
+                   view* const recs,       // max_recs -many opened records
+                   const size_t max_recs,  // capacity of `recs`
+                   size_t& consumed        // # -of bytes consumed from `buf`
+  )
+  {
+    consumed = 0;
+
+    size_t n = 0;
+    while (!failed && (n < max_recs)) {
+      // gather next run of complete records, with equal plain text length
+      size_t offs[L];
+      size_t cnt = 0;
+      size_t len = 0;
+      size_t off = consumed;
+
+      while ((cnt < L) && ((n + cnt) < max_recs)) {
+        if ((buf_len - off) < HEADER_LEN) {
+          break;
+        }
+
+        const size_t rlen = read_length(buf + off);
+        if ((buf_len - off - HEADER_LEN) < (rlen + TAG_LEN)) {
+          break;
+        }
+        if ((cnt > 0) && (rlen != len)) {
+          break;
+        }
+
+        offs[cnt++] = off;
+        len = rlen;
+        off += rlen + OVERHEAD;
+      }
+
+      if (cnt == 0) {
+        break;
+      }
+
+      if (cnt == L) {
+        n += open_lanes(buf, offs, len, recs + n, consumed);
+      } else {
+        if (!open(buf + consumed, len + OVERHEAD, recs[n])) {
+          break;
+        }
+
+        n++;
+        consumed += len + OVERHEAD;
+      }
+    }
+
+    return n;
+  }
+
+  // Returns truth value, if any record failed verification
+  bool error() const { return failed; }
+
+  // Returns sequence number of next record, to be opened
+  uint64_t sequence() const { return seq; }
+
+private:
+  // Opens L records of equal plain text length, living at given offsets of
+  // receive buffer, together; returns # -of records opened, before first
+  // failing one ( if any ), while zeroing all records from there on
+  size_t open_lanes(uint8_t* const buf,
+                    const size_t* const offs,
+                    const size_t len,
+                    view* const recs,
+                    size_t& consumed)
+  {
+    uint8_t nonces[L][R];
+    const uint8_t* keys[L];
+    const uint8_t* nonces_[L];
+    const uint8_t* hdrs[L];
+    const uint8_t* tags[L];
+    uint8_t* decs[L];
+    bool flags[L];
+
+    for (size_t l = 0; l < L; l++) {
+      uint8_t* const rec = buf + offs[l];
+
+      derive_nonce<R>(iv, seq + l, nonces[l]);
+
+      keys[l] = key;
+      nonces_[l] = nonces[l];
+      hdrs[l] = rec;
+      decs[l] = rec + HEADER_LEN;
+      tags[l] = rec + HEADER_LEN + len;
+    }
+
+    multilane::decrypt<R, C, A0, A1, M0, M1, BR, S, B, L>(
+      keys, nonces_, tags, hdrs, HEADER_LEN, decs, decs, len, flags);
+
+    size_t l = 0;
+    for (; (l < L) && flags[l]; l++) {
+      recs[l] = view{ buf[offs[l]], decs[l], len };
+    }
+
+    // records after failing one aren't reported, so don't release them either
+    for (size_t k = l; k < L; k++) {
+      std::memset(decs[k], 0, len);
+    }
+
+    failed = l < L;
+    seq += l;
+    consumed += l * (len + OVERHEAD);
+    return l;
+  }
+
+  uint8_t key[KEY_LEN];
+  uint8_t iv[IV_LEN];
+  uint64_t seq = 0;
+  bool failed = false;
+};
+
+} // namespace record
+
+// Record layer using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using record_sealer = record::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using record_opener = record::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Record layer using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using record_sealer = record::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using record_opener = record::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Record layer using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using record_sealer = record::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using record_opener = record::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Record layer using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using record_sealer = record::sealer<R, C, A0, A1, M0, M1, BR, S, B>;
+using record_opener = record::opener<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
@@ -58,8 +58,8 @@ encrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
         const uint8_t* const __restrict nonce, // 16 -bytes nonce
         const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
         const size_t d_len,                    // len(data) = N | N >= 0
-        const uint8_t* const __restrict txt,   // N (>=0) -bytes plain text
-        uint8_t* const __restrict enc,         // N (>=0) -bytes cipher text
+        const uint8_t* const txt,              // N (>=0) -bytes plain text
+        uint8_t* const enc,                    // N (>=0) -bytes cipher text
         const size_t ct_len,                   // len(txt) = len(enc) = N | >= 0
         uint8_t* const __restrict tag          // 16 -bytes authentication tag
 )
@@ -90,8 +90,8 @@ decrypt(const uint8_t* const __restrict key,   // 16 -bytes secret key
         const uint8_t* const __restrict tag,   // 16 -bytes authentication tag
         const uint8_t* const __restrict data,  // N (>=0) -bytes associated data
         const size_t d_len,                    // len(data) = N | N >= 0
-        const uint8_t* const __restrict enc,   // N (>=0) -bytes encrypted text
-        uint8_t* const __restrict dec,         // N (>=0) -bytes decrypted text
+        const uint8_t* const enc,              // N (>=0) -bytes encrypted text
+        uint8_t* const dec,                    // N (>=0) -bytes decrypted text
         const size_t ct_len                    // len(enc) = len(dec) = N | >= 0
 )
 {
@@ -0,0 +1,197 @@
+#pragma once
+#include <cstring>
+
+#include "schwaemm.hpp"
+
+// Duplex session mode on top of SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256},
+// which initializes permutation state once ( from secret key & session nonce )
+// & then seals/ opens an ordered sequence of messages, by continuing same
+// sponge state from one message to next one
+//
+// Each message absorbs its associated data ( if any ), using Schwaemm's
+// associated data domain separation constants, followed by its plain text (
+// even if empty ), using plain text domain separation constants, so that each
+// message ends with big variant of Sparkle permutation. Authentication tag of
+// a message is computed same way as Schwaemm does i.e. capacity part of state
+// XORed with secret key. Tag of a message authenticates all messages sealed
+// before it, in the session, so reordering, dropping or replaying messages is
+// detected.
+//
+// Compared to sealing each message with a fresh nonce, this saves
+// initialization i.e. one big Sparkle permutation per message, which dominates
+// cost of short messages. Note, this is an extension on top of Sparkle
+// specification, similar to session APIs of Cyclist based schemes ( e.g.
+// Xoodyak ). Only first message of a session ( when it's plain text is
+// non-empty ) is sealed exactly same way as Schwaemm does.
+namespace session {
+
+// Duplex session, which can be used with SchwaemmX-Y AEAD | X, Y ∈ {128, 192,
+// 256}; see aead::encrypt for meaning of template parameters.
+//
+// Both communicating parties must create a session with same key & nonce, and
+// seal/ open same sequence of messages, in same order, to keep their states in
+// step. A nonce must never be used for more than one session under same key.
+// After first verification failure, this object refuses to seal/ open any
+// more messages, because its state has diverged from peer's one.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class cipher
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of session nonce
+  static constexpr size_t NONCE_LEN = R;
+
+  // Byte length of authentication tag, produced for each message
+  static constexpr size_t TAG_LEN = C;
+
+  cipher(const uint8_t* const __restrict key,  // C -bytes secret key
+         const uint8_t* const __restrict nonce // R -bytes session nonce
+  )
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    aead::initialize<R, C, BR, B>(state, key, nonce);
+  }
+
+  cipher(const cipher&) = delete;
+  cipher& operator=(const cipher&) = delete;
+
+  ~cipher()
+  {
+    std::memset(key, 0, KEY_LEN);
+    std::memset(state, 0, sizeof(state));
+  }
+
+  // Encrypts next message of the session, while producing equal many cipher
+  // text bytes & C -bytes authentication tag. Associated data ( which is never
+  // encrypted ) is authenticated along with this message. Returns false (
+  // without touching output buffers ) if session has already failed.
+  //
+  // Note, `txt` & `enc` can point to same memory, for in-place encryption.
+  bool seal(const uint8_t* const __restrict data, // N (>=0) -bytes AD
+            const size_t d_len,                   // len(data) = N | N >= 0
+            const uint8_t* const txt,             // M (>=0) -bytes plain text
+            uint8_t* const enc,                   // M (>=0) -bytes cipher text
+            const size_t ct_len,                  // len(txt) = len(enc) = M
+            uint8_t* const __restrict tag         // C -bytes authentication tag
+  )
+  {
+    if (failed) {
+      return false;
+    }
+
+    if (d_len > 0) {
+      aead::process_data<R, C, A0, A1, BR, S, B>(state, data, d_len);
+    }
+
+    // empty plain text is still absorbed, as a padded block, so that each
+    // message is domain separated from next one
+    uint8_t empty[1]{};
+    const uint8_t* const txt_ = (ct_len > 0) ? txt : empty;
+    uint8_t* const enc_ = (ct_len > 0) ? enc : empty;
+
+    aead::process_text<R, C, M0, M1, BR, S, B>(state, txt_, enc_, ct_len);
+    aead::finalize<R, C>(state, key, tag);
+
+    counter++;
+    return true;
+  }
+
+  // Decrypts next message of the session, while producing equal many plain
+  // text bytes, only if authentication tag verification passes. Returns
+  // boolean verification flag; on failure decrypted bytes are zeroed & session
+  // is marked as failed.
+  //
+  // Note, `enc` & `dec` can point to same memory, for in-place decryption.
+  bool open(const uint8_t* const __restrict data, // N (>=0) -bytes AD
+            const size_t d_len,                   // len(data) = N | N >= 0
+            const uint8_t* const enc,             // M (>=0) -bytes cipher text
+            uint8_t* const dec,                   // M (>=0) -bytes plain text
+            const size_t ct_len,                  // len(enc) = len(dec) = M
+            const uint8_t* const __restrict tag   // C -bytes authentication tag
+  )
+  {
+    if (failed) {
+      if (ct_len > 0) {
+        std::memset(dec, 0, ct_len);
+      }
+      return false;
+    }
+
+    if (d_len > 0) {
+      aead::process_data<R, C, A0, A1, BR, S, B>(state, data, d_len);
+    }
+
+    uint8_t empty[1]{};
+    const uint8_t* const enc_ = (ct_len > 0) ? enc : empty;
+    uint8_t* const dec_ = (ct_len > 0) ? dec : empty;
+
+    aead::process_cipher<R, C, M0, M1, BR, S, B>(state, enc_, dec_, ct_len);
+
+    uint8_t tag_[C];
+    aead::finalize<R, C>(state, key, tag_);
+
+    bool flag = false;
+    for (size_t i = 0; i < C; i++) {
+      flag |= (tag[i] ^ tag_[i]);
+    }
+
+    // don't release unverified plain text
+    std::memset(dec_, 0, flag * ct_len);
+
+    failed = flag;
+    counter += !flag;
+    return !flag;
+  }
+
+  // Returns truth value, if any message failed verification
+  bool error() const { return failed; }
+
+  // Returns # -of messages sealed/ opened so far
+  uint64_t messages() const { return counter; }
+
+private:
+  uint32_t state[BR << 1];
+  uint8_t key[KEY_LEN];
+  uint64_t counter = 0;
+  bool failed = false;
+};
+
+} // namespace session
+
+// Duplex session mode using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using session_cipher = session::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Duplex session mode using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using session_cipher = session::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Duplex session mode using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using session_cipher = session::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Duplex session mode using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using session_cipher = session::cipher<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
@@ -0,0 +1,482 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+#include "schwaemm.hpp"
+
+// Lock-free message ring, living in a shared memory region ( say a memfd or
+// POSIX shared memory object ), for encrypted inter-process communication on
+// same host, using SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}
+//
+// Ring is a bounded, multi-producer single-consumer queue of fixed capacity
+// slots, where each slot carries a sequence word, which tells whether it's
+// free for a producer or holds a published message for the consumer. Single
+// producer single consumer usage is just a special case of it.
+//
+// Producer reserves a slot, writes plain text of message straight into it,
+// which is then sealed in place; consumer verifies & decrypts it in place,
+// before handing it out. So no message is ever copied into a temporary buffer
+// & nothing is allocated per message. Nonce of a message is derived from its
+// 64 -bit position in the ring, as
+//
+// nonce = salt ⊕ (le64(position) || 0^(R - 8))
+//
+// where R -bytes salt is randomly sampled when ring is formatted. As positions
+// never repeat, nonces never repeat under same key, while a message, which is
+// replayed, reordered or moved to another slot, fails verification.
+//
+// Secret key never lives in shared memory; it must be handed to all parties
+// out-of-band.
+namespace shm {
+
+// Identifies a formatted ring region, along with its layout version
+constexpr uint64_t MAGIC = 0x31676e6972687373ul; // "sshring1"
+
+// Byte length of cache line, which slots & cursors are aligned to
+constexpr size_t LINE = 64;
+
+// Header of a ring region, which is followed by its slots
+struct header
+{
+  uint64_t magic;
+  uint32_t slots;    // # -of slots | power of 2
+  uint32_t slot_cap; // maximum plain text byte length, a slot can carry
+  uint32_t slot_len; // byte length of a slot, including its header & tag
+  uint32_t tag_len;  // byte length of authentication tag
+  uint8_t salt[32];  // R -bytes salt, from which nonces are derived
+
+  alignas(LINE) std::atomic<uint64_t> tail; // next position to be reserved
+  alignas(LINE) std::atomic<uint64_t> head; // next position to be consumed
+};
+
+// Header of a slot, which is followed by payload & tag
+struct slot
+{
+  std::atomic<uint64_t> seq; // position + 1, when published; else position
+  uint32_t len;              // byte length of payload
+  uint32_t rsvd;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Ring needs address-free 64 -bit atomics");
+
+// Byte offset of payload, in a slot
+constexpr size_t PAYLOAD_OFF = sizeof(slot);
+
+// Returns byte length of a slot, carrying at most `cap` -bytes plain text &
+// `tag_len` -bytes tag, rounded up to cache line
+static inline constexpr size_t
+slot_size(const size_t cap, const size_t tag_len)
+{
+  return (PAYLOAD_OFF + cap + tag_len + LINE - 1) & ~(LINE - 1);
+}
+
+// Returns byte length of a ring region, having `slots` slots, each carrying at
+// most `cap` -bytes plain text & `tag_len` -bytes tag
+static inline constexpr size_t
+region_size(const size_t slots, const size_t cap, const size_t tag_len)
+{
+  return sizeof(header) + slots * slot_size(cap, tag_len);
+}
+
+// Shared memory mapping, along with file descriptor of shared memory object,
+// which can be passed to other processes ( inherited across fork or sent over
+// UNIX domain socket ), so that they can map same region
+class region
+{
+public:
+  region() = default;
+
+  // Maps `len` -bytes of shared memory object, referred to by `fd`, taking
+  // ownership of the descriptor; use `ok` to find out whether it worked
+  region(const int fd, const size_t len)
+    : fd_(fd)
+  {
+    if (fd_ < 0 || len == 0) {
+      return;
+    }
+
+    void* const p =
+      mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p != MAP_FAILED) {
+      ptr = static_cast<uint8_t*>(p);
+      len_ = len;
+    }
+  }
+
+  // Creates an anonymous, `len` -bytes shared memory object using
+  // memfd_create, & maps it
+  static region create(const size_t len)
+  {
+    const int fd = memfd_create("sparkle-shm", MFD_CLOEXEC);
+    if (fd < 0) {
+      return region{};
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(len)) != 0) {
+      ::close(fd);
+      return region{};
+    }
+
+    return region{ fd, len };
+  }
+
+  region(const region&) = delete;
+  region& operator=(const region&) = delete;
+
+  region(region&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1))
+    , ptr(std::exchange(other.ptr, nullptr))
+    , len_(std::exchange(other.len_, 0))
+  {
+  }
+
+  region& operator=(region&& other) noexcept
+  {
+    std::swap(fd_, other.fd_);
+    std::swap(ptr, other.ptr);
+    std::swap(len_, other.len_);
+    return *this;
+  }
+
+  ~region()
+  {
+    if (ptr != nullptr) {
+      munmap(ptr, len_);
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  // Returns truth value, if region is mapped
+  bool ok() const { return ptr != nullptr; }
+
+  int fd() const { return fd_; }
+  uint8_t* data() { return ptr; }
+  size_t size() const { return len_; }
+
+private:
+  int fd_ = -1;
+  uint8_t* ptr = nullptr;
+  size_t len_ = 0;
+};
+
+// Producer's handle to a reserved slot, whose payload is being written
+struct ticket
+{
+  uint64_t pos = 0;       // position of message, in ring
+  slot* s = nullptr;      // reserved slot
+  uint8_t* buf = nullptr; // payload of slot, to be filled with plain text
+};
+
+// Encrypted message ring, which can be used with SchwaemmX-Y AEAD | X, Y ∈
+// {128, 192, 256}; see aead::encrypt for meaning of template parameters.
+//
+// Each process ( producer or consumer ) attaches its own channel object to the
+// mapping of same region. Any # -of threads, across processes, can produce
+// concurrently, while only one thread may consume at a time.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class channel
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of authentication tag, of each message
+  static constexpr size_t TAG_LEN = C;
+
+  static_assert(R <= sizeof(header::salt), "Salt doesn't fit in header");
+
+  // Formats `len` -bytes memory, so that it holds an empty ring of `slots` (
+  // power of 2 ) slots, each carrying at most `cap` -bytes plain text. Must be
+  // done once, by creator of region, before any channel is attached to it.
+  // Returns false if memory is too short or slot count isn't a power of 2.
+  static bool format(uint8_t* const base,
+                     const size_t len,
+                     const uint32_t slots,
+                     const uint32_t cap)
+  {
+    const bool pow2 = (slots > 0) && ((slots & (slots - 1)) == 0);
+    if (!pow2 || (base == nullptr) || (len < region_size(slots, cap, C))) {
+      return false;
+    }
+
+    header* const h = new (base) header{};
+    h->slots = slots;
+    h->slot_cap = cap;
+    h->slot_len = static_cast<uint32_t>(slot_size(cap, C));
+    h->tag_len = C;
+    sparkle_utils::random_data(h->salt, R);
+    h->tail.store(0, std::memory_order_relaxed);
+    h->head.store(0, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < slots; i++) {
+      uint8_t* const sp = base + sizeof(header) + i * h->slot_len;
+      slot* const s = new (sp) slot{};
+      s->seq.store(i, std::memory_order_relaxed);
+    }
+
+    // publish layout, only after slots are initialized
+    std::atomic_ref<uint64_t>(h->magic).store(MAGIC,
+                                              std::memory_order_release);
+    return true;
+  }
+
+  // Attaches to a formatted ring, living in `len` -bytes memory; use `ok` to
+  // find out whether region holds a ring, compatible with this variant
+  channel(uint8_t* const base,
+          const size_t len,
+          const uint8_t* const __restrict key // C -bytes secret key
+          )
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+
+    if ((base == nullptr) || (len < sizeof(header))) {
+      return;
+    }
+
+    header* const h = reinterpret_cast<header*>(base);
+    const uint64_t magic =
+      std::atomic_ref<uint64_t>(h->magic).load(std::memory_order_acquire);
+
+    const uint32_t n = h->slots;
+    const bool pow2 = (n > 0) && ((n & (n - 1)) == 0);
+    const bool compat = (magic == MAGIC) && pow2 && (h->tag_len == C) &&
+                        (h->slot_len == slot_size(h->slot_cap, C)) &&
+                        (len >= region_size(n, h->slot_cap, C));
+    if (!compat) {
+      return;
+    }
+
+    hdr = h;
+    slots = base + sizeof(header);
+    mask = n - 1;
+    slot_len = h->slot_len;
+    cap = h->slot_cap;
+  }
+
+  channel(const channel&) = delete;
+  channel& operator=(const channel&) = delete;
+
+  ~channel() { std::memset(key, 0, KEY_LEN); }
+
+  // Returns truth value, if channel is attached to a compatible ring
+  bool ok() const { return hdr != nullptr; }
+
+  // Maximum plain text byte length, a message can have
+  size_t capacity() const { return cap; }
+
+  // Reserves next free slot, for a message of `len` -bytes, whose plain text
+  // is to be written into `t.buf`, before calling `commit`. Returns false if
+  // ring is full or message doesn't fit in a slot.
+  bool reserve(const size_t len, ticket& t)
+  {
+    if (!ok() || (len > cap)) {
+      return false;
+    }
+
+    uint64_t pos = hdr->tail.load(std::memory_order_relaxed);
+    while (true) {
+      slot* const s = at(pos);
+      const uint64_t seq = s->seq.load(std::memory_order_acquire);
+      const int64_t diff = static_cast<int64_t>(seq - pos);
+
+      if (diff == 0) {
+        if (hdr->tail.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+          s->len = static_cast<uint32_t>(len);
+          t.pos = pos;
+          t.s = s;
+          t.buf = payload(s);
+          return true;
+        }
+      } else if (diff < 0) {
+        // slot still holds a message, which hasn't been consumed
+        return false;
+      } else {
+        pos = hdr->tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Seals plain text of reserved slot in place & publishes it to the consumer
+  void commit(const ticket& t)
+  {
+    uint8_t nonce[R];
+    derive_nonce(t.pos, nonce);
+
+    const size_t len = t.s->len;
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, nullptr, 0, t.buf, t.buf, len, t.buf + cap);
+
+    t.s->seq.store(t.pos + 1, std::memory_order_release);
+  }
+
+  // Copies `len` -bytes message into next free slot, sealing & publishing it.
+  // Returns false if ring is full or message doesn't fit in a slot.
+  bool push(const uint8_t* const msg, const size_t len)
+  {
+    ticket t;
+    if (!reserve(len, t)) {
+      return false;
+    }
+
+    if (len > 0) {
+      std::memcpy(t.buf, msg, len);
+    }
+    commit(t);
+    return true;
+  }
+
+  // Verifies & decrypts next published message in place, returning pointer to
+  // its plain text ( valid until `release` ) & setting `len` to its byte
+  // length. Returns nullptr if no message is available or if it fails
+  // verification, in which case channel is marked as failed & stops handing
+  // out messages; see `error`.
+  //
+  // Must only be called by the consumer, which must `release` a message
+  // before peeking at next one.
+  const uint8_t* peek(size_t& len)
+  {
+    if (!ok() || failed) {
+      return nullptr;
+    }
+
+    const uint64_t pos = hdr->head.load(std::memory_order_relaxed);
+    slot* const s = at(pos);
+    if (s->seq.load(std::memory_order_acquire) != (pos + 1)) {
+      return nullptr;
+    }
+
+    const size_t mlen = s->len;
+    if (mlen > cap) {
+      failed = true;
+      return nullptr;
+    }
+
+    uint8_t nonce[R];
+    derive_nonce(pos, nonce);
+
+    uint8_t* const buf = payload(s);
+    const bool flag = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, nonce, buf + cap, nullptr, 0, buf, buf, mlen);
+    if (!flag) {
+      failed = true;
+      return nullptr;
+    }
+
+    len = mlen;
+    return buf;
+  }
+
+  // Hands slot of last peeked message back to producers
+  void release()
+  {
+    const uint64_t pos = hdr->head.load(std::memory_order_relaxed);
+    slot* const s = at(pos);
+
+    s->seq.store(pos + mask + 1, std::memory_order_release);
+    hdr->head.store(pos + 1, std::memory_order_relaxed);
+  }
+
+  // Verifies & decrypts next published message, copying it into `buf` (
+  // having `blen` -bytes capacity ) & releasing its slot. Returns false if no
+  // message is available, it fails verification or doesn't fit in `buf`.
+  bool pop(uint8_t* const buf, const size_t blen, size_t& len)
+  {
+    size_t mlen = 0;
+    const uint8_t* const msg = peek(mlen);
+    if ((msg == nullptr) || (mlen > blen)) {
+      return false;
+    }
+
+    if (mlen > 0) {
+      std::memcpy(buf, msg, mlen);
+    }
+    release();
+
+    len = mlen;
+    return true;
+  }
+
+  // Returns truth value, if a message failed verification
+  bool error() const { return failed; }
+
+private:
+  // Returns slot, which given position maps to
+  slot* at(const uint64_t pos) const
+  {
+    return reinterpret_cast<slot*>(slots + (pos & mask) * slot_len);
+  }
+
+  // Returns payload of a slot, which is followed by tag
+  static uint8_t* payload(slot* const s)
+  {
+    return reinterpret_cast<uint8_t*>(s) + PAYLOAD_OFF;
+  }
+
+  // Derives R -bytes nonce of a message, from its position in ring
+  void derive_nonce(const uint64_t pos, uint8_t* const __restrict nonce) const
+  {
+    uint8_t tmp[8];
+    sparkle_utils::to_le_bytes(pos, tmp);
+
+    std::memcpy(nonce, hdr->salt, R);
+    for (size_t i = 0; i < sizeof(tmp); i++) {
+      nonce[i] ^= tmp[i];
+    }
+  }
+
+  uint8_t key[KEY_LEN];
+  header* hdr = nullptr;
+  uint8_t* slots = nullptr;
+  uint64_t mask = 0;
+  size_t slot_len = 0;
+  size_t cap = 0;
+  bool failed = false;
+};
+
+} // namespace shm
+
+// Encrypted shared memory message ring using Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using shm_channel = shm::channel<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Encrypted shared memory message ring using Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using shm_channel = shm::channel<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Encrypted shared memory message ring using Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using shm_channel = shm::channel<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// Encrypted shared memory message ring using Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using shm_channel = shm::channel<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
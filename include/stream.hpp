@@ -0,0 +1,273 @@
+#pragma once
+#include <cstring>
+
+#include "schwaemm.hpp"
+
+// Segmented online authenticated encryption ( STREAM construction ) on top of
+// SchwaemmX-Y AEAD | X, Y ∈ {128, 192, 256}
+//
+// A long plain text is split into fixed size segments ( last one can be
+// shorter ), each of them being independently encrypted & authenticated using
+// a per-segment nonce, which is derived from (RATE - 5) -bytes base nonce, 4
+// -bytes segment counter & 1 -byte last segment flag. That way decryptor can
+// release plain text of each segment as soon as its tag is verified, while
+// reordering, dropping or truncation of segments is still detected.
+//
+// See "Online Authenticated-Encryption and its Nonce-Reuse Misuse-Resistance"
+// by Hoang, Reyhanitabar, Rogaway & Vizár https://eprint.iacr.org/2015/189.pdf
+namespace stream {
+
+// # -of trailing bytes of per-segment nonce, reserved for 4 -bytes big-endian
+// segment counter & 1 -byte last segment flag
+constexpr size_t NONCE_SUFFIX_LEN = 5ul;
+
+// Maximum # -of segments, which can be sealed under same key & base nonce
+constexpr uint64_t MAX_SEGMENTS = 1ul << 32;
+
+// Given (RATE - 5) -bytes base nonce, 32 -bit segment counter & last segment
+// flag, this routine derives RATE -bytes nonce, which is used for encrypting/
+// decrypting that segment, as
+//
+// seg_nonce = nonce || be32(counter) || last
+template<const size_t RATE>
+static inline void
+derive_nonce(const uint8_t* const __restrict nonce, // (RATE - 5) -bytes nonce
+             const uint32_t counter,                // segment index
+             const bool last,                       // is it last segment ?
+             uint8_t* const __restrict seg_nonce    // RATE -bytes nonce
+)
+{
+  static_assert(RATE > NONCE_SUFFIX_LEN, "Rate must be > 5 -bytes");
+  constexpr size_t off = RATE - NONCE_SUFFIX_LEN;
+
+  std::memcpy(seg_nonce, nonce, off);
+
+  seg_nonce[off + 0] = static_cast<uint8_t>(counter >> 24);
+  seg_nonce[off + 1] = static_cast<uint8_t>(counter >> 16);
+  seg_nonce[off + 2] = static_cast<uint8_t>(counter >> 8);
+  seg_nonce[off + 3] = static_cast<uint8_t>(counter >> 0);
+  seg_nonce[off + 4] = static_cast<uint8_t>(last);
+}
+
+// Sealing side of STREAM construction, which can be used with SchwaemmX-Y AEAD
+// | X, Y ∈ {128, 192, 256}; see aead::encrypt for meaning of template
+// parameters.
+//
+// Each call to `seal` encrypts next segment of the stream. All segments except
+// the last one must be exactly `seg_len` -bytes, while last one can be of
+// [0, seg_len] -bytes. Once last segment is sealed, this object can't be used
+// for sealing any more segments.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class encryptor
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of base nonce, from which per-segment nonces are derived
+  static constexpr size_t NONCE_LEN = R - NONCE_SUFFIX_LEN;
+
+  // Byte length of authentication tag, appended to each segment
+  static constexpr size_t TAG_LEN = C;
+
+  encryptor(const uint8_t* const __restrict key,   // C -bytes secret key
+            const uint8_t* const __restrict nonce, // (R - 5) -bytes nonce
+            const size_t seg_len                   // segment byte length | > 0
+            )
+    : seg_len{ seg_len }
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->nonce, nonce, NONCE_LEN);
+  }
+
+  ~encryptor() { std::memset(key, 0, KEY_LEN); }
+
+  // Encrypts next segment of plain text, while producing equal many cipher
+  // text bytes & C -bytes authentication tag. Associated data ( which is never
+  // encrypted ) is authenticated along with this segment.
+  //
+  // Returns false ( without touching output buffers ) if segment length
+  // doesn't conform to the configured one ( or zero segment length was
+  // configured ), stream has already been finished or segment counter is
+  // exhausted.
+  //
+  // Note, `txt` & `enc` can point to same memory, for in-place encryption; see
+  // aead::encrypt.
+  bool seal(const uint8_t* const __restrict data, // N (>=0) -bytes AD
+            const size_t d_len,                   // len(data) = N | N >= 0
+            const uint8_t* const txt,             // M (>=0) -bytes plain text
+            uint8_t* const enc,                   // M (>=0) -bytes cipher text
+            const size_t ct_len,                  // len(txt) = len(enc) = M
+            uint8_t* const __restrict tag,        // C -bytes authentication tag
+            const bool last                       // is it last segment ?
+  )
+  {
+    const bool bad_len = (seg_len == 0) || (last ? (ct_len > seg_len)
+                                                 : (ct_len != seg_len));
+    if (done || bad_len || (counter >= MAX_SEGMENTS)) {
+      return false;
+    }
+
+    uint8_t seg_nonce[R];
+    derive_nonce<R>(nonce, static_cast<uint32_t>(counter), last, seg_nonce);
+
+    aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, data, d_len, txt, enc, ct_len, tag);
+
+    counter++;
+    done = last;
+    return true;
+  }
+
+  // Returns truth value, if last segment has already been sealed
+  bool finished() const { return done; }
+
+  // Returns # -of segments sealed so far
+  uint64_t segments() const { return counter; }
+
+private:
+  uint8_t key[KEY_LEN];
+  uint8_t nonce[NONCE_LEN];
+  size_t seg_len;
+  uint64_t counter = 0;
+  bool done = false;
+};
+
+// Opening side of STREAM construction, which can be used with SchwaemmX-Y AEAD
+// | X, Y ∈ {128, 192, 256}; see aead::decrypt for meaning of template
+// parameters.
+//
+// Segments must be opened in the same order they were sealed in. Plain text of
+// a segment can be consumed as soon as `open` returns truth value for it, while
+// reaching end of input without `finished` returning truth value means the
+// stream has been truncated. After first verification failure, this object
+// refuses to open any more segments.
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+class decryptor
+{
+public:
+  // Byte length of secret key
+  static constexpr size_t KEY_LEN = C;
+
+  // Byte length of base nonce, from which per-segment nonces are derived
+  static constexpr size_t NONCE_LEN = R - NONCE_SUFFIX_LEN;
+
+  // Byte length of authentication tag, appended to each segment
+  static constexpr size_t TAG_LEN = C;
+
+  decryptor(const uint8_t* const __restrict key,   // C -bytes secret key
+            const uint8_t* const __restrict nonce, // (R - 5) -bytes nonce
+            const size_t seg_len                   // segment byte length | > 0
+            )
+    : seg_len{ seg_len }
+  {
+    std::memcpy(this->key, key, KEY_LEN);
+    std::memcpy(this->nonce, nonce, NONCE_LEN);
+  }
+
+  ~decryptor() { std::memset(key, 0, KEY_LEN); }
+
+  // Decrypts next segment of cipher text, while producing equal many plain text
+  // bytes, only if authentication tag verification passes. Returns boolean
+  // verification flag; on failure decrypted bytes are zeroed & stream is marked
+  // as failed. Zero segment length is never accepted, as such stream could
+  // never end.
+  //
+  // Note, `enc` & `dec` can point to same memory, for in-place decryption; see
+  // aead::decrypt.
+  bool open(const uint8_t* const __restrict data, // N (>=0) -bytes AD
+            const size_t d_len,                   // len(data) = N | N >= 0
+            const uint8_t* const enc,             // M (>=0) -bytes cipher text
+            uint8_t* const dec,                   // M (>=0) -bytes plain text
+            const size_t ct_len,                  // len(enc) = len(dec) = M
+            const uint8_t* const __restrict tag,  // C -bytes authentication tag
+            const bool last                       // is it last segment ?
+  )
+  {
+    const bool bad_len = (seg_len == 0) || (last ? (ct_len > seg_len)
+                                                 : (ct_len != seg_len));
+    if (done || failed || bad_len || (counter >= MAX_SEGMENTS)) {
+      failed = true;
+      std::memset(dec, 0, ct_len);
+      return false;
+    }
+
+    uint8_t seg_nonce[R];
+    derive_nonce<R>(nonce, static_cast<uint32_t>(counter), last, seg_nonce);
+
+    const bool flag = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+      key, seg_nonce, tag, data, d_len, enc, dec, ct_len);
+
+    failed = !flag;
+    counter += flag;
+    done = flag & last;
+    return flag;
+  }
+
+  // Returns truth value, if last segment has been successfully opened
+  bool finished() const { return done; }
+
+  // Returns truth value, if any segment failed verification
+  bool error() const { return failed; }
+
+  // Returns # -of segments opened so far
+  uint64_t segments() const { return counter; }
+
+private:
+  uint8_t key[KEY_LEN];
+  uint8_t nonce[NONCE_LEN];
+  size_t seg_len;
+  uint64_t counter = 0;
+  bool done = false;
+  bool failed = false;
+};
+
+} // namespace stream
+
+// STREAM construction instantiated with Schwaemm256-128 AEAD
+namespace schwaemm256_128 {
+
+using stream_encryptor = stream::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using stream_decryptor = stream::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// STREAM construction instantiated with Schwaemm192-192 AEAD
+namespace schwaemm192_192 {
+
+using stream_encryptor = stream::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using stream_decryptor = stream::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// STREAM construction instantiated with Schwaemm128-128 AEAD
+namespace schwaemm128_128 {
+
+using stream_encryptor = stream::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using stream_decryptor = stream::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
+
+// STREAM construction instantiated with Schwaemm256-256 AEAD
+namespace schwaemm256_256 {
+
+using stream_encryptor = stream::encryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+using stream_decryptor = stream::decryptor<R, C, A0, A1, M0, M1, BR, S, B>;
+
+}
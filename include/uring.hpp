@@ -0,0 +1,256 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Minimal io_uring submission/ completion ring, talking to kernel using raw
+// `io_uring_setup`, `io_uring_enter` & `io_uring_register` system calls, so
+// that liburing is not required
+//
+// Only what's needed for pipelining file reads & writes is implemented i.e.
+// (fixed buffer) read/ write requests, submission & reaping of completions.
+namespace uring {
+
+// Completion of a submitted request
+struct completion
+{
+  uint64_t user; // user data, attached to request when submitting it
+  int32_t res;   // # -of bytes transferred or negated errno
+};
+
+// Single threaded io_uring instance, along with its memory mapped submission
+// & completion queues
+class ring
+{
+public:
+  // Sets up a ring with ( at least ) given # -of submission queue entries; use
+  // `ok` to find out whether kernel supports ( and allows ) io_uring
+  explicit ring(const unsigned entries)
+  {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+
+    const long r = syscall(SYS_io_uring_setup, entries, &p);
+    if (r < 0) {
+      return;
+    }
+    fd = static_cast<int>(r);
+
+    sq_len = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    cq_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+    const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+      sq_len = cq_len = std::max(sq_len, cq_len);
+    }
+
+    constexpr int prot = PROT_READ | PROT_WRITE;
+    constexpr int flags = MAP_SHARED | MAP_POPULATE;
+
+    sq_ptr = mmap(nullptr, sq_len, prot, flags, fd, IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+      sq_ptr = nullptr;
+      close();
+      return;
+    }
+
+    if (single) {
+      cq_ptr = sq_ptr;
+    } else {
+      cq_ptr = mmap(nullptr, cq_len, prot, flags, fd, IORING_OFF_CQ_RING);
+      if (cq_ptr == MAP_FAILED) {
+        cq_ptr = nullptr;
+        close();
+        return;
+      }
+    }
+
+    sqes_len = p.sq_entries * sizeof(io_uring_sqe);
+    void* const s = mmap(nullptr, sqes_len, prot, flags, fd, IORING_OFF_SQES);
+    if (s == MAP_FAILED) {
+      close();
+      return;
+    }
+    sqes = static_cast<io_uring_sqe*>(s);
+
+    uint8_t* const sq = static_cast<uint8_t*>(sq_ptr);
+    sq_head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    sq_entries = p.sq_entries;
+
+    uint8_t* const cq = static_cast<uint8_t*>(cq_ptr);
+    cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+  }
+
+  ring(const ring&) = delete;
+  ring& operator=(const ring&) = delete;
+
+  ~ring() { close(); }
+
+  // Returns truth value, if ring is set up & usable
+  bool ok() const { return sqes != nullptr; }
+
+  // Registers buffers with kernel, so that fixed buffer read/ write requests
+  // can be issued against them. Returns false if registration fails ( say
+  // because of RLIMIT_MEMLOCK ), in which case plain requests can still be
+  // issued.
+  bool register_buffers(const iovec* const iovs, const unsigned cnt)
+  {
+    const long r =
+      syscall(SYS_io_uring_register, fd, IORING_REGISTER_BUFFERS, iovs, cnt);
+    return r == 0;
+  }
+
+  // Queues a read request of `len` -bytes from file offset `off` into `buf`,
+  // which lives in `buf_idx` -th registered buffer, if `buf_idx` >= 0. Returns
+  // false if submission queue is full.
+  bool read(const int file,
+            void* const buf,
+            const uint32_t len,
+            const uint64_t off,
+            const int buf_idx,
+            const uint64_t user)
+  {
+    const uint8_t op = (buf_idx < 0) ? IORING_OP_READ : IORING_OP_READ_FIXED;
+    return queue(op, file, buf, len, off, buf_idx, user);
+  }
+
+  // Queues a write request of `len` -bytes from `buf` to file offset `off`;
+  // see `read` above
+  bool write(const int file,
+             const void* const buf,
+             const uint32_t len,
+             const uint64_t off,
+             const int buf_idx,
+             const uint64_t user)
+  {
+    const uint8_t op = (buf_idx < 0) ? IORING_OP_WRITE : IORING_OP_WRITE_FIXED;
+    return queue(op, file, buf, len, off, buf_idx, user);
+  }
+
+  // Submits all queued requests & waits until at least `wait_nr` completions
+  // are available. Returns false on failure.
+  bool submit(const unsigned wait_nr)
+  {
+    const unsigned flags = (wait_nr > 0) ? IORING_ENTER_GETEVENTS : 0u;
+
+    while (true) {
+      const long r = syscall(
+        SYS_io_uring_enter, fd, queued, wait_nr, flags, nullptr, 0ul);
+      if (r >= 0) {
+        queued -= std::min(queued, static_cast<unsigned>(r));
+        return true;
+      }
+      if (errno != EINTR) {
+        return false;
+      }
+    }
+  }
+
+  // Takes next available completion, if any, returning truth value if found
+  bool reap(completion& c)
+  {
+    const unsigned head = *cq_head;
+    if (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+
+    const io_uring_cqe& cqe = cqes[head & cq_mask];
+    c.user = cqe.user_data;
+    c.res = cqe.res;
+
+    __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+private:
+  // Fills next submission queue entry, returning false if queue is full
+  bool queue(const uint8_t op,
+             const int file,
+             const void* const buf,
+             const uint32_t len,
+             const uint64_t off,
+             const int buf_idx,
+             const uint64_t user)
+  {
+    const unsigned tail = *sq_tail;
+    const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if ((tail - head) >= sq_entries) {
+      return false;
+    }
+
+    const unsigned idx = tail & sq_mask;
+    io_uring_sqe& sqe = sqes[idx];
+
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = op;
+    sqe.fd = file;
+    sqe.off = off;
+    sqe.addr = reinterpret_cast<uint64_t>(buf);
+    sqe.len = len;
+    sqe.buf_index = static_cast<uint16_t>((buf_idx < 0) ? 0 : buf_idx);
+    sqe.user_data = user;
+
+    sq_array[idx] = idx;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    queued++;
+    return true;
+  }
+
+  // Unmaps queues & closes ring
+  void close()
+  {
+    if (sqes != nullptr) {
+      munmap(sqes, sqes_len);
+    }
+    if ((cq_ptr != nullptr) && (cq_ptr != sq_ptr)) {
+      munmap(cq_ptr, cq_len);
+    }
+    if (sq_ptr != nullptr) {
+      munmap(sq_ptr, sq_len);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+
+    sqes = nullptr;
+    sq_ptr = cq_ptr = nullptr;
+    fd = -1;
+  }
+
+  int fd = -1;
+
+  void* sq_ptr = nullptr;
+  void* cq_ptr = nullptr;
+  size_t sq_len = 0;
+  size_t cq_len = 0;
+  size_t sqes_len = 0;
+
+  io_uring_sqe* sqes = nullptr;
+  unsigned* sq_head = nullptr;
+  unsigned* sq_tail = nullptr;
+  unsigned* sq_array = nullptr;
+  unsigned sq_mask = 0;
+  unsigned sq_entries = 0;
+  unsigned queued = 0;
+
+  io_uring_cqe* cqes = nullptr;
+  unsigned* cq_head = nullptr;
+  unsigned* cq_tail = nullptr;
+  unsigned cq_mask = 0;
+};
+
+} // namespace uring
@@ -162,6 +162,28 @@ copy_words_to_le_bytes(const uint32_t* const __restrict words,
   }
 }
 
+// Given a 64 -bit unsigned integer, this routine serializes it as 8 bytes, in
+// little-endian byte order
+static inline void
+to_le_bytes(const uint64_t v, uint8_t* const bytes)
+{
+  for (size_t i = 0; i < sizeof(v); i++) {
+    bytes[i] = static_cast<uint8_t>(v >> (i << 3));
+  }
+}
+
+// Given 8 bytes, this routine deserializes them as a 64 -bit unsigned integer,
+// in little-endian byte order
+static inline uint64_t
+from_le_bytes(const uint8_t* const bytes)
+{
+  uint64_t v = 0;
+  for (size_t i = 0; i < sizeof(v); i++) {
+    v |= static_cast<uint64_t>(bytes[i]) << (i << 3);
+  }
+  return v;
+}
+
 // Given a bytearray of length N, this function converts it to human readable
 // hex string of length N << 1
 static inline const std::string
@@ -3,7 +3,7 @@
 # Script for ease of execution of Known Answer Tests against Sparkle implementation
 
 # generate shared library object
-make lib
+make lib pyext
 
 # ---
 
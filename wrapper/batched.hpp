@@ -0,0 +1,777 @@
+#pragma once
+#include "batch.hpp"
+#include <cstring>
+#include <vector>
+
+// Thin C wrapper on top of batched Esch{256,384} hashing & Schwaemm AEAD ( see
+// include/batch.hpp ), so that a whole batch of messages crosses FFI boundary
+// in a single call. A batch is described either as
+//
+// - one flat buffer, where i-th message is given by its byte offset & length (
+//   `*_batch` functions ), which is how rows of a 2-D array ( say
+//   numpy.ndarray ) or variable length records, packed back to back, are laid
+//   out
+// - arrays of pointers & lengths ( `*_many` functions ), or one descriptor per
+//   message ( `sparkle_aead_desc` ), for messages scattered across memory
+
+namespace batched {
+
+// Pointers to n messages, living at given byte offsets of flat buffer
+template<typename T>
+static inline std::vector<T*>
+pointers(T* const buf, const size_t* const off, const size_t n)
+{
+  std::vector<T*> ptrs(n);
+  for (size_t i = 0; i < n; i++) {
+    ptrs[i] = buf + off[i];
+  }
+  return ptrs;
+}
+
+// Pointers to n fixed size entries, each `stride` -bytes apart; zero stride
+// makes all of them share the first entry
+static inline std::vector<const uint8_t*>
+strided(const uint8_t* const base, const size_t stride, const size_t n)
+{
+  std::vector<const uint8_t*> ptrs(n);
+  for (size_t i = 0; i < n; i++) {
+    ptrs[i] = base + i * stride;
+  }
+  return ptrs;
+}
+
+// Encrypts n messages, laid out in flat buffers; see batch::encrypt
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline void
+encrypt(const uint8_t* const __restrict key,
+        const size_t k_stride,
+        const uint8_t* const __restrict nonce,
+        const uint8_t* const __restrict data,
+        const size_t* const __restrict d_off,
+        const size_t* const __restrict d_len,
+        const uint8_t* const txt,
+        uint8_t* const enc,
+        const size_t* const __restrict t_off,
+        const size_t* const __restrict t_len,
+        uint8_t* const __restrict tag,
+        const size_t n)
+{
+  const auto keys = strided(key, k_stride, n);
+  const auto nonces = strided(nonce, R, n);
+  const auto datas = pointers(data, d_off, n);
+  const auto txts = pointers(txt, t_off, n);
+  const auto encs = pointers(enc, t_off, n);
+
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 keys.data(),
+                                                 nonces.data(),
+                                                 datas.data(),
+                                                 d_len,
+                                                 txts.data(),
+                                                 encs.data(),
+                                                 t_len,
+                                                 tag,
+                                                 n);
+}
+
+// Decrypts n messages, laid out in flat buffers; see batch::decrypt
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+decrypt(const uint8_t* const __restrict key,
+        const size_t k_stride,
+        const uint8_t* const __restrict nonce,
+        const uint8_t* const __restrict tag,
+        const uint8_t* const __restrict data,
+        const size_t* const __restrict d_off,
+        const size_t* const __restrict d_len,
+        const uint8_t* const enc,
+        uint8_t* const dec,
+        const size_t* const __restrict t_off,
+        const size_t* const __restrict t_len,
+        bool* const __restrict flag,
+        const size_t n)
+{
+  const auto keys = strided(key, k_stride, n);
+  const auto nonces = strided(nonce, R, n);
+  const auto datas = pointers(data, d_off, n);
+  const auto encs = pointers(enc, t_off, n);
+  const auto decs = pointers(dec, t_off, n);
+
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    keys.data(),
+    nonces.data(),
+    tag,
+    datas.data(),
+    d_len,
+    encs.data(),
+    decs.data(),
+    t_len,
+    flag,
+    n);
+}
+
+}
+
+// Describes one message of a Schwaemm batch, for `*_encrypt_many` ( where
+// `in` is plain text, `out` receives cipher text & `tag` receives C -bytes
+// authentication tag ) & `*_decrypt_many` ( where `in` is cipher text, `out`
+// receives plain text & `tag` is C -bytes authentication tag to verify ). `in`
+// & `out` may point to same memory.
+struct sparkle_aead_desc
+{
+  const uint8_t* key;   // C -bytes secret key
+  const uint8_t* nonce; // R -bytes nonce
+  const uint8_t* data;  // associated data
+  size_t d_len;         // byte length of associated data
+  const uint8_t* in;    // input text
+  uint8_t* out;         // output text
+  size_t len;           // byte length of input/ output text
+  uint8_t* tag;         // C -bytes authentication tag
+};
+
+namespace batched {
+
+// Encrypts n messages, described by descriptors; see batch::encrypt
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline void
+encrypt_many(const sparkle_aead_desc* const desc, const size_t n)
+{
+  std::vector<const uint8_t*> keys(n), nonces(n), datas(n), txts(n);
+  std::vector<uint8_t*> encs(n);
+  std::vector<size_t> d_len(n), t_len(n);
+  std::vector<uint8_t> tags(n * C);
+
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = desc[i].key;
+    nonces[i] = desc[i].nonce;
+    datas[i] = desc[i].data;
+    d_len[i] = desc[i].d_len;
+    txts[i] = desc[i].in;
+    encs[i] = desc[i].out;
+    t_len[i] = desc[i].len;
+  }
+
+  batch::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(parallel::default_pool(),
+                                                 keys.data(),
+                                                 nonces.data(),
+                                                 datas.data(),
+                                                 d_len.data(),
+                                                 txts.data(),
+                                                 encs.data(),
+                                                 t_len.data(),
+                                                 tags.data(),
+                                                 n);
+
+  for (size_t i = 0; i < n; i++) {
+    std::memcpy(desc[i].tag, tags.data() + i * C, C);
+  }
+}
+
+// Decrypts n messages, described by descriptors, writing verification status
+// of i-th message to `flag[i]`; see batch::decrypt
+template<const size_t R,
+         const size_t C,
+         const uint32_t A0,
+         const uint32_t A1,
+         const uint32_t M0,
+         const uint32_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static inline bool
+decrypt_many(const sparkle_aead_desc* const desc,
+             bool* const __restrict flag,
+             const size_t n)
+{
+  std::vector<const uint8_t*> keys(n), nonces(n), datas(n), encs(n);
+  std::vector<uint8_t*> decs(n);
+  std::vector<size_t> d_len(n), t_len(n);
+  std::vector<uint8_t> tags(n * C);
+
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = desc[i].key;
+    nonces[i] = desc[i].nonce;
+    datas[i] = desc[i].data;
+    d_len[i] = desc[i].d_len;
+    encs[i] = desc[i].in;
+    decs[i] = desc[i].out;
+    t_len[i] = desc[i].len;
+    std::memcpy(tags.data() + i * C, desc[i].tag, C);
+  }
+
+  return batch::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(
+    parallel::default_pool(),
+    keys.data(),
+    nonces.data(),
+    tags.data(),
+    datas.data(),
+    d_len.data(),
+    encs.data(),
+    decs.data(),
+    t_len.data(),
+    flag,
+    n);
+}
+
+}
+
+// Template arguments of Schwaemm variant, living in namespace `ns`
+#define SCHWAEMM_PARAMS(ns)                                                    \
+  ns::R, ns::C, ns::A0, ns::A1, ns::M0, ns::M1, ns::BR, ns::S, ns::B
+
+// Function prototype
+extern "C"
+{
+  void esch256_hash_batch(const uint8_t* const __restrict,
+                          const size_t* const __restrict,
+                          const size_t* const __restrict,
+                          const size_t,
+                          uint8_t* const __restrict);
+
+  void esch384_hash_batch(const uint8_t* const __restrict,
+                          const size_t* const __restrict,
+                          const size_t* const __restrict,
+                          const size_t,
+                          uint8_t* const __restrict);
+
+  void schwaemm256_128_encrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     uint8_t* const __restrict,
+                                     const size_t);
+
+  bool schwaemm256_128_decrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     bool* const __restrict,
+                                     const size_t);
+
+  void schwaemm192_192_encrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     uint8_t* const __restrict,
+                                     const size_t);
+
+  bool schwaemm192_192_decrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     bool* const __restrict,
+                                     const size_t);
+
+  void schwaemm128_128_encrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     uint8_t* const __restrict,
+                                     const size_t);
+
+  bool schwaemm128_128_decrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     bool* const __restrict,
+                                     const size_t);
+
+  void schwaemm256_256_encrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     uint8_t* const __restrict,
+                                     const size_t);
+
+  bool schwaemm256_256_decrypt_batch(const uint8_t* const __restrict,
+                                     const size_t,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const uint8_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     const uint8_t* const,
+                                     uint8_t* const,
+                                     const size_t* const __restrict,
+                                     const size_t* const __restrict,
+                                     bool* const __restrict,
+                                     const size_t);
+
+  void esch256_hash_many(const uint8_t* const* const,
+                         const size_t* const __restrict,
+                         const size_t,
+                         uint8_t* const __restrict);
+
+  void esch384_hash_many(const uint8_t* const* const,
+                         const size_t* const __restrict,
+                         const size_t,
+                         uint8_t* const __restrict);
+
+  void schwaemm256_128_encrypt_many(const sparkle_aead_desc* const,
+                                    const size_t);
+
+  bool schwaemm256_128_decrypt_many(const sparkle_aead_desc* const,
+                                    bool* const __restrict,
+                                    const size_t);
+
+  void schwaemm192_192_encrypt_many(const sparkle_aead_desc* const,
+                                    const size_t);
+
+  bool schwaemm192_192_decrypt_many(const sparkle_aead_desc* const,
+                                    bool* const __restrict,
+                                    const size_t);
+
+  void schwaemm128_128_encrypt_many(const sparkle_aead_desc* const,
+                                    const size_t);
+
+  bool schwaemm128_128_decrypt_many(const sparkle_aead_desc* const,
+                                    bool* const __restrict,
+                                    const size_t);
+
+  void schwaemm256_256_encrypt_many(const sparkle_aead_desc* const,
+                                    const size_t);
+
+  bool schwaemm256_256_decrypt_many(const sparkle_aead_desc* const,
+                                    bool* const __restrict,
+                                    const size_t);
+}
+
+// Function implementation
+extern "C"
+{
+  // Given n messages, i-th of them living at byte offset `off[i]` of `in` &
+  // being `len[i]` -bytes long, this routine computes their 32 -bytes Esch256
+  // digests, i-th one written at byte offset i * 32 of `out`
+  void esch256_hash_batch(const uint8_t* const __restrict in,
+                          const size_t* const __restrict off,
+                          const size_t* const __restrict len,
+                          const size_t n,
+                          uint8_t* const __restrict out)
+  {
+    const auto ins = batched::pointers(in, off, n);
+    batch::hash<6ul, 7ul, 11ul, esch256::DIGEST_LEN>(
+      parallel::default_pool(), ins.data(), len, n, out);
+  }
+
+  // Given n messages, i-th of them living at byte offset `off[i]` of `in` &
+  // being `len[i]` -bytes long, this routine computes their 48 -bytes Esch384
+  // digests, i-th one written at byte offset i * 48 of `out`
+  void esch384_hash_batch(const uint8_t* const __restrict in,
+                          const size_t* const __restrict off,
+                          const size_t* const __restrict len,
+                          const size_t n,
+                          uint8_t* const __restrict out)
+  {
+    const auto ins = batched::pointers(in, off, n);
+    batch::hash<8ul, 8ul, 12ul, esch384::DIGEST_LEN>(
+      parallel::default_pool(), ins.data(), len, n, out);
+  }
+
+  // Encrypts n messages, using Schwaemm256-128, where i-th message has
+  // - `t_len[i]` -bytes plain text, at byte offset `t_off[i]` of `txt`, which
+  //   is encrypted to same offset of `enc` ( that may be `txt` itself )
+  // - 16 -bytes key, at byte offset i * `k_stride` of `key`; zero stride
+  //   shares one key among all messages
+  // - 32 -bytes nonce, at byte offset i * 32 of `nonce`
+  // - `d_len[i]` -bytes associated data, at byte offset `d_off[i]` of `data`
+  // - 16 -bytes tag, written at byte offset i * 16 of `tag`
+  void schwaemm256_128_encrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const txt,
+                                     uint8_t* const enc,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     uint8_t* const __restrict tag,
+                                     const size_t n)
+  {
+    batched::encrypt<SCHWAEMM_PARAMS(schwaemm256_128)>(
+      key, k_stride, nonce, data, d_off, d_len, txt, enc, t_off, t_len, tag, n);
+  }
+
+  // Decrypts n messages, using Schwaemm256-128, laid out same way as it's done
+  // in schwaemm256_128_encrypt_batch, writing verification status of i-th
+  // message to `flag[i]`. Returns truth value only if all messages are
+  // verified.
+  bool schwaemm256_128_decrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict tag,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const enc,
+                                     uint8_t* const dec,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     bool* const __restrict flag,
+                                     const size_t n)
+  {
+    return batched::decrypt<SCHWAEMM_PARAMS(schwaemm256_128)>(
+      key,
+      k_stride,
+      nonce,
+      tag,
+      data,
+      d_off,
+      d_len,
+      enc,
+      dec,
+      t_off,
+      t_len,
+      flag,
+      n);
+  }
+
+  // Encrypts n messages, using Schwaemm192-192, where i-th message has
+  // - `t_len[i]` -bytes plain text, at byte offset `t_off[i]` of `txt`, which
+  //   is encrypted to same offset of `enc` ( that may be `txt` itself )
+  // - 24 -bytes key, at byte offset i * `k_stride` of `key`; zero stride
+  //   shares one key among all messages
+  // - 24 -bytes nonce, at byte offset i * 24 of `nonce`
+  // - `d_len[i]` -bytes associated data, at byte offset `d_off[i]` of `data`
+  // - 24 -bytes tag, written at byte offset i * 24 of `tag`
+  void schwaemm192_192_encrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const txt,
+                                     uint8_t* const enc,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     uint8_t* const __restrict tag,
+                                     const size_t n)
+  {
+    batched::encrypt<SCHWAEMM_PARAMS(schwaemm192_192)>(
+      key, k_stride, nonce, data, d_off, d_len, txt, enc, t_off, t_len, tag, n);
+  }
+
+  // Decrypts n messages, using Schwaemm192-192, laid out same way as it's done
+  // in schwaemm192_192_encrypt_batch, writing verification status of i-th
+  // message to `flag[i]`. Returns truth value only if all messages are
+  // verified.
+  bool schwaemm192_192_decrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict tag,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const enc,
+                                     uint8_t* const dec,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     bool* const __restrict flag,
+                                     const size_t n)
+  {
+    return batched::decrypt<SCHWAEMM_PARAMS(schwaemm192_192)>(
+      key,
+      k_stride,
+      nonce,
+      tag,
+      data,
+      d_off,
+      d_len,
+      enc,
+      dec,
+      t_off,
+      t_len,
+      flag,
+      n);
+  }
+
+  // Encrypts n messages, using Schwaemm128-128, where i-th message has
+  // - `t_len[i]` -bytes plain text, at byte offset `t_off[i]` of `txt`, which
+  //   is encrypted to same offset of `enc` ( that may be `txt` itself )
+  // - 16 -bytes key, at byte offset i * `k_stride` of `key`; zero stride
+  //   shares one key among all messages
+  // - 16 -bytes nonce, at byte offset i * 16 of `nonce`
+  // - `d_len[i]` -bytes associated data, at byte offset `d_off[i]` of `data`
+  // - 16 -bytes tag, written at byte offset i * 16 of `tag`
+  void schwaemm128_128_encrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const txt,
+                                     uint8_t* const enc,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     uint8_t* const __restrict tag,
+                                     const size_t n)
+  {
+    batched::encrypt<SCHWAEMM_PARAMS(schwaemm128_128)>(
+      key, k_stride, nonce, data, d_off, d_len, txt, enc, t_off, t_len, tag, n);
+  }
+
+  // Decrypts n messages, using Schwaemm128-128, laid out same way as it's done
+  // in schwaemm128_128_encrypt_batch, writing verification status of i-th
+  // message to `flag[i]`. Returns truth value only if all messages are
+  // verified.
+  bool schwaemm128_128_decrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict tag,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const enc,
+                                     uint8_t* const dec,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     bool* const __restrict flag,
+                                     const size_t n)
+  {
+    return batched::decrypt<SCHWAEMM_PARAMS(schwaemm128_128)>(
+      key,
+      k_stride,
+      nonce,
+      tag,
+      data,
+      d_off,
+      d_len,
+      enc,
+      dec,
+      t_off,
+      t_len,
+      flag,
+      n);
+  }
+
+  // Encrypts n messages, using Schwaemm256-256, where i-th message has
+  // - `t_len[i]` -bytes plain text, at byte offset `t_off[i]` of `txt`, which
+  //   is encrypted to same offset of `enc` ( that may be `txt` itself )
+  // - 32 -bytes key, at byte offset i * `k_stride` of `key`; zero stride
+  //   shares one key among all messages
+  // - 32 -bytes nonce, at byte offset i * 32 of `nonce`
+  // - `d_len[i]` -bytes associated data, at byte offset `d_off[i]` of `data`
+  // - 32 -bytes tag, written at byte offset i * 32 of `tag`
+  void schwaemm256_256_encrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const txt,
+                                     uint8_t* const enc,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     uint8_t* const __restrict tag,
+                                     const size_t n)
+  {
+    batched::encrypt<SCHWAEMM_PARAMS(schwaemm256_256)>(
+      key, k_stride, nonce, data, d_off, d_len, txt, enc, t_off, t_len, tag, n);
+  }
+
+  // Decrypts n messages, using Schwaemm256-256, laid out same way as it's done
+  // in schwaemm256_256_encrypt_batch, writing verification status of i-th
+  // message to `flag[i]`. Returns truth value only if all messages are
+  // verified.
+  bool schwaemm256_256_decrypt_batch(const uint8_t* const __restrict key,
+                                     const size_t k_stride,
+                                     const uint8_t* const __restrict nonce,
+                                     const uint8_t* const __restrict tag,
+                                     const uint8_t* const __restrict data,
+                                     const size_t* const __restrict d_off,
+                                     const size_t* const __restrict d_len,
+                                     const uint8_t* const enc,
+                                     uint8_t* const dec,
+                                     const size_t* const __restrict t_off,
+                                     const size_t* const __restrict t_len,
+                                     bool* const __restrict flag,
+                                     const size_t n)
+  {
+    return batched::decrypt<SCHWAEMM_PARAMS(schwaemm256_256)>(
+      key,
+      k_stride,
+      nonce,
+      tag,
+      data,
+      d_off,
+      d_len,
+      enc,
+      dec,
+      t_off,
+      t_len,
+      flag,
+      n);
+  }
+
+  // Given n messages, i-th of them pointed to by `in[i]` & being `len[i]`
+  // -bytes long, this routine computes their 32 -bytes Esch256 digests, i-th
+  // one written at byte offset i * 32 of `out`
+  void esch256_hash_many(const uint8_t* const* const in,
+                         const size_t* const __restrict len,
+                         const size_t n,
+                         uint8_t* const __restrict out)
+  {
+    batch::hash<6ul, 7ul, 11ul, esch256::DIGEST_LEN>(
+      parallel::default_pool(), in, len, n, out);
+  }
+
+  // Given n messages, i-th of them pointed to by `in[i]` & being `len[i]`
+  // -bytes long, this routine computes their 48 -bytes Esch384 digests, i-th
+  // one written at byte offset i * 48 of `out`
+  void esch384_hash_many(const uint8_t* const* const in,
+                         const size_t* const __restrict len,
+                         const size_t n,
+                         uint8_t* const __restrict out)
+  {
+    batch::hash<8ul, 8ul, 12ul, esch384::DIGEST_LEN>(
+      parallel::default_pool(), in, len, n, out);
+  }
+
+  // Encrypts n messages, using Schwaemm256-128, each described by a
+  // `sparkle_aead_desc`
+  void schwaemm256_128_encrypt_many(const sparkle_aead_desc* const desc,
+                                    const size_t n)
+  {
+    batched::encrypt_many<SCHWAEMM_PARAMS(schwaemm256_128)>(desc, n);
+  }
+
+  // Decrypts n messages, using Schwaemm256-128, each described by a
+  // `sparkle_aead_desc`, writing verification status of i-th message to
+  // `flag[i]`. Returns truth value only if all messages are verified.
+  bool schwaemm256_128_decrypt_many(const sparkle_aead_desc* const desc,
+                                    bool* const __restrict flag,
+                                    const size_t n)
+  {
+    return batched::decrypt_many<SCHWAEMM_PARAMS(schwaemm256_128)>(
+      desc, flag, n);
+  }
+
+  // Encrypts n messages, using Schwaemm192-192, each described by a
+  // `sparkle_aead_desc`
+  void schwaemm192_192_encrypt_many(const sparkle_aead_desc* const desc,
+                                    const size_t n)
+  {
+    batched::encrypt_many<SCHWAEMM_PARAMS(schwaemm192_192)>(desc, n);
+  }
+
+  // Decrypts n messages, using Schwaemm192-192, each described by a
+  // `sparkle_aead_desc`, writing verification status of i-th message to
+  // `flag[i]`. Returns truth value only if all messages are verified.
+  bool schwaemm192_192_decrypt_many(const sparkle_aead_desc* const desc,
+                                    bool* const __restrict flag,
+                                    const size_t n)
+  {
+    return batched::decrypt_many<SCHWAEMM_PARAMS(schwaemm192_192)>(
+      desc, flag, n);
+  }
+
+  // Encrypts n messages, using Schwaemm128-128, each described by a
+  // `sparkle_aead_desc`
+  void schwaemm128_128_encrypt_many(const sparkle_aead_desc* const desc,
+                                    const size_t n)
+  {
+    batched::encrypt_many<SCHWAEMM_PARAMS(schwaemm128_128)>(desc, n);
+  }
+
+  // Decrypts n messages, using Schwaemm128-128, each described by a
+  // `sparkle_aead_desc`, writing verification status of i-th message to
+  // `flag[i]`. Returns truth value only if all messages are verified.
+  bool schwaemm128_128_decrypt_many(const sparkle_aead_desc* const desc,
+                                    bool* const __restrict flag,
+                                    const size_t n)
+  {
+    return batched::decrypt_many<SCHWAEMM_PARAMS(schwaemm128_128)>(
+      desc, flag, n);
+  }
+
+  // Encrypts n messages, using Schwaemm256-256, each described by a
+  // `sparkle_aead_desc`
+  void schwaemm256_256_encrypt_many(const sparkle_aead_desc* const desc,
+                                    const size_t n)
+  {
+    batched::encrypt_many<SCHWAEMM_PARAMS(schwaemm256_256)>(desc, n);
+  }
+
+  // Decrypts n messages, using Schwaemm256-256, each described by a
+  // `sparkle_aead_desc`, writing verification status of i-th message to
+  // `flag[i]`. Returns truth value only if all messages are verified.
+  bool schwaemm256_256_decrypt_many(const sparkle_aead_desc* const desc,
+                                    bool* const __restrict flag,
+                                    const size_t n)
+  {
+    return batched::decrypt_many<SCHWAEMM_PARAMS(schwaemm256_256)>(
+      desc, flag, n);
+  }
+}
+
+#undef SCHWAEMM_PARAMS
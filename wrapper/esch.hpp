@@ -1,11 +1,24 @@
 #pragma once
 #include "esch256.hpp"
 #include "esch384.hpp"
+#include <cstdint>
+#include <new>
 
 // Thin C wrapper on top of underlying C++ implementation of Esch{256,384} hash
 // function, which can be used for producing shared library object with C-ABI &
 // used from other languages such as Rust, Python
 
+// Incremental Esch{256,384} hashing context, opaque to C-ABI users
+struct esch256_ctx
+{
+  esch256::hasher h;
+};
+
+struct esch384_ctx
+{
+  esch384::hasher h;
+};
+
 // Function prototype
 extern "C"
 {
@@ -16,11 +29,43 @@ extern "C"
   void esch384_hash(const uint8_t* const __restrict,
                     const size_t,
                     uint8_t* const __restrict);
+
+  esch256_ctx* esch256_create();
+  esch256_ctx* esch256_clone(const esch256_ctx* const);
+  void esch256_update(esch256_ctx* const,
+                      const uint8_t* const __restrict,
+                      const size_t);
+  void esch256_finalize(const esch256_ctx* const, uint8_t* const __restrict);
+  void esch256_destroy(esch256_ctx* const);
+
+  size_t esch256_ctx_size();
+  size_t esch256_ctx_align();
+  esch256_ctx* esch256_init(void* const);
+  esch256_ctx* esch256_clone_into(const esch256_ctx* const, void* const);
+  void esch256_release(esch256_ctx* const);
+
+  esch384_ctx* esch384_create();
+  esch384_ctx* esch384_clone(const esch384_ctx* const);
+  void esch384_update(esch384_ctx* const,
+                      const uint8_t* const __restrict,
+                      const size_t);
+  void esch384_finalize(const esch384_ctx* const, uint8_t* const __restrict);
+  void esch384_destroy(esch384_ctx* const);
+
+  size_t esch384_ctx_size();
+  size_t esch384_ctx_align();
+  esch384_ctx* esch384_init(void* const);
+  esch384_ctx* esch384_clone_into(const esch384_ctx* const, void* const);
+  void esch384_release(esch384_ctx* const);
 }
 
 // Function implementation
 extern "C"
 {
+  // One-shot hashing is left out of libsparkle_offload.so, which forwards it
+  // to offload daemon; see wrapper/offload_client.hpp
+#if !defined SPARKLE_OFFLOAD
+
   // Given N (>=0) -bytes input message, this routines computes 32 -bytes output
   // digest, using Esch256 hash algorithm
   void esch256_hash(const uint8_t* const __restrict in,
@@ -38,4 +83,140 @@ extern "C"
   {
     esch384::hash(in, ilen, out);
   }
+
+#endif
+
+  // Allocates an Esch256 hashing context, ready to absorb message; returns
+  // NULL when allocation fails
+  esch256_ctx* esch256_create()
+  {
+    return new (std::nothrow) esch256_ctx{};
+  }
+
+  // Allocates a copy of Esch256 hashing context, which continues from same
+  // absorbed message prefix; returns NULL when allocation fails
+  esch256_ctx* esch256_clone(const esch256_ctx* const ctx)
+  {
+    return new (std::nothrow) esch256_ctx{ *ctx };
+  }
+
+  // Absorbs next N (>=0) -bytes of message into Esch256 hashing context
+  void esch256_update(esch256_ctx* const ctx,
+                      const uint8_t* const __restrict in,
+                      const size_t ilen)
+  {
+    ctx->h.absorb(in, ilen);
+  }
+
+  // Computes 32 -bytes Esch256 digest of message absorbed so far, leaving
+  // context untouched, so that more message bytes can still be absorbed
+  void esch256_finalize(const esch256_ctx* const ctx,
+                        uint8_t* const __restrict out)
+  {
+    esch256::hasher h = ctx->h;
+    h.finalize(out);
+  }
+
+  // Releases Esch256 hashing context; NULL is ignored
+  void esch256_destroy(esch256_ctx* const ctx) { delete ctx; }
+
+  // Byte length & alignment of Esch256 hashing context, for embedders, who
+  // allocate contexts from their own storage; see esch256_init
+  size_t esch256_ctx_size() { return sizeof(esch256_ctx); }
+  size_t esch256_ctx_align() { return alignof(esch256_ctx); }
+
+  // Initializes Esch256 hashing context on caller provided storage, which must
+  // be at least esch256_ctx_size() -bytes & aligned to esch256_ctx_align();
+  // returns NULL when it's not. Such context is never passed to
+  // esch256_destroy, but to esch256_release, once done with it.
+  esch256_ctx* esch256_init(void* const mem)
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+    if ((addr == 0) || (addr % alignof(esch256_ctx) != 0)) {
+      return nullptr;
+    }
+    return new (mem) esch256_ctx{};
+  }
+
+  // Copies Esch256 hashing context onto caller provided storage, with same
+  // requirements as esch256_init; returns NULL when storage is unsuitable
+  esch256_ctx* esch256_clone_into(const esch256_ctx* const ctx, void* const mem)
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+    if ((addr == 0) || (addr % alignof(esch256_ctx) != 0)) {
+      return nullptr;
+    }
+    return new (mem) esch256_ctx{ *ctx };
+  }
+
+  // Releases Esch256 hashing context, living on caller provided storage, which
+  // can be reused afterwards
+  void esch256_release(esch256_ctx* const ctx) { ctx->~esch256_ctx(); }
+
+  // Allocates an Esch384 hashing context, ready to absorb message; returns
+  // NULL when allocation fails
+  esch384_ctx* esch384_create()
+  {
+    return new (std::nothrow) esch384_ctx{};
+  }
+
+  // Allocates a copy of Esch384 hashing context, which continues from same
+  // absorbed message prefix; returns NULL when allocation fails
+  esch384_ctx* esch384_clone(const esch384_ctx* const ctx)
+  {
+    return new (std::nothrow) esch384_ctx{ *ctx };
+  }
+
+  // Absorbs next N (>=0) -bytes of message into Esch384 hashing context
+  void esch384_update(esch384_ctx* const ctx,
+                      const uint8_t* const __restrict in,
+                      const size_t ilen)
+  {
+    ctx->h.absorb(in, ilen);
+  }
+
+  // Computes 48 -bytes Esch384 digest of message absorbed so far, leaving
+  // context untouched, so that more message bytes can still be absorbed
+  void esch384_finalize(const esch384_ctx* const ctx,
+                        uint8_t* const __restrict out)
+  {
+    esch384::hasher h = ctx->h;
+    h.finalize(out);
+  }
+
+  // Releases Esch384 hashing context; NULL is ignored
+  void esch384_destroy(esch384_ctx* const ctx) { delete ctx; }
+
+  // Byte length & alignment of Esch384 hashing context, for embedders, who
+  // allocate contexts from their own storage; see esch384_init
+  size_t esch384_ctx_size() { return sizeof(esch384_ctx); }
+  size_t esch384_ctx_align() { return alignof(esch384_ctx); }
+
+  // Initializes Esch384 hashing context on caller provided storage, which must
+  // be at least esch384_ctx_size() -bytes & aligned to esch384_ctx_align();
+  // returns NULL when it's not. Such context is never passed to
+  // esch384_destroy, but to esch384_release, once done with it.
+  esch384_ctx* esch384_init(void* const mem)
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+    if ((addr == 0) || (addr % alignof(esch384_ctx) != 0)) {
+      return nullptr;
+    }
+    return new (mem) esch384_ctx{};
+  }
+
+  // Copies Esch384 hashing context onto caller provided storage, with same
+  // requirements as esch384_init; returns NULL when storage is unsuitable
+  esch384_ctx* esch384_clone_into(const esch384_ctx* const ctx, void* const mem)
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+    if ((addr == 0) || (addr % alignof(esch384_ctx) != 0)) {
+      return nullptr;
+    }
+    return new (mem) esch384_ctx{ *ctx };
+  }
+
+  // Releases Esch384 hashing context, living on caller provided storage, which
+  // can be reused afterwards
+  void esch384_release(esch384_ctx* const ctx) { ctx->~esch384_ctx(); }
 }
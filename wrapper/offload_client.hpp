@@ -0,0 +1,367 @@
+#pragma once
+#include "offload.hpp"
+#include <chrono>
+#include <memory>
+#include <new>
+
+// C wrapper, exporting same one-shot Esch{256,384} hash & Schwaemm256-128,
+// Schwaemm192-192, Schwaemm128-128, Schwaemm256-256 AEAD functions ( with same
+// signatures ) as wrapper/esch.hpp & wrapper/schwaemm.hpp do, which forward
+// each call to local crypto offload daemon ( see include/offload.hpp ), so
+// that requests of many processes get batched together.
+//
+// wrapper/sparkle_offload.cpp defines SPARKLE_OFFLOAD, before including this
+// header along with wrapper/esch.hpp, wrapper/schwaemm.hpp &
+// wrapper/batched.hpp, which then leave their one-shot functions out, while
+// still exporting all other entry points ( scatter-gather, streaming contexts
+// & batches ), computed locally. Produced shared library object exports same
+// symbols as libsparkle.so, so it can be used in place of it, without changing
+// callers.
+//
+// Each calling thread gets its own connection to daemon, whose socket path is
+// taken from SPARKLE_OFFLOAD_SOCKET environment variable ( see
+// offload::socket_path ). When daemon isn't reachable, doesn't reply in time
+// or a request doesn't fit in connection's arena, call is served locally, same
+// way libsparkle.so does. Lost ( or never made ) connection is re-established
+// on a later call, with exponential backoff, so that long-lived threads get
+// back to batching, once daemon is up again.
+
+// Bounds of waiting time, in between attempts to connect to daemon
+constexpr std::chrono::milliseconds OFFLOAD_MIN_BACKOFF{ 100 };
+constexpr std::chrono::milliseconds OFFLOAD_MAX_BACKOFF{ 10'000 };
+
+// Connection of a thread to daemon, along with its reconnection schedule
+struct offload_conn
+{
+  using clock = std::chrono::steady_clock;
+
+  std::unique_ptr<offload::client> c;
+  clock::time_point since{};    // when last connection attempt was made
+  clock::time_point retry_at{}; // when next one may be made
+  std::chrono::milliseconds backoff = OFFLOAD_MIN_BACKOFF;
+};
+
+// Returns calling thread's connection to daemon, (re)connecting if it's due,
+// or NULL, when call must be served locally
+static inline offload::client*
+offload_client()
+{
+  thread_local offload_conn s;
+
+  if (s.c && s.c->ok()) {
+    return s.c.get();
+  }
+
+  const auto now = offload_conn::clock::now();
+  if (now < s.retry_at) {
+    return nullptr;
+  }
+
+  // connection, which stayed up for long, restarts backoff from scratch
+  if (s.c && ((now - s.since) > OFFLOAD_MAX_BACKOFF)) {
+    s.backoff = OFFLOAD_MIN_BACKOFF;
+  }
+
+  s.c.reset(new (std::nothrow) offload::client{});
+  s.since = now;
+  s.retry_at = now + s.backoff;
+  s.backoff = std::min(2 * s.backoff, OFFLOAD_MAX_BACKOFF);
+
+  return (s.c && s.c->ok()) ? s.c.get() : nullptr;
+}
+
+// Function prototype
+extern "C"
+{
+  void esch256_hash(const uint8_t* const __restrict,
+                    const size_t,
+                    uint8_t* const __restrict);
+
+  void esch384_hash(const uint8_t* const __restrict,
+                    const size_t,
+                    uint8_t* const __restrict);
+
+  void schwaemm256_128_encrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t,
+                               uint8_t* const __restrict);
+
+  bool schwaemm256_128_decrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t);
+
+  void schwaemm192_192_encrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t,
+                               uint8_t* const __restrict);
+
+  bool schwaemm192_192_decrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t);
+
+  void schwaemm128_128_encrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t,
+                               uint8_t* const __restrict);
+
+  bool schwaemm128_128_decrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t);
+
+  void schwaemm256_256_encrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t,
+                               uint8_t* const __restrict);
+
+  bool schwaemm256_256_decrypt(const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const uint8_t* const __restrict,
+                               const size_t,
+                               const uint8_t* const __restrict,
+                               uint8_t* const __restrict,
+                               const size_t);
+}
+
+// Function implementation
+extern "C"
+{
+  // Given N (>=0) -bytes input message, this routines computes 32 -bytes output
+  // digest, using Esch256 hash algorithm
+  void esch256_hash(const uint8_t* const __restrict in,
+                    const size_t ilen,
+                    uint8_t* const __restrict out)
+  {
+    offload::client* const c = offload_client();
+    if ((c == nullptr) || !c->hash(engine::op::esch256, in, ilen, out)) {
+      esch256::hash(in, ilen, out);
+    }
+  }
+
+  // Given N (>=0) -bytes input message, this routines computes 48 -bytes output
+  // digest, using Esch384 hash algorithm
+  void esch384_hash(const uint8_t* const __restrict in,
+                    const size_t ilen,
+                    uint8_t* const __restrict out)
+  {
+    offload::client* const c = offload_client();
+    if ((c == nullptr) || !c->hash(engine::op::esch384, in, ilen, out)) {
+      esch384::hash(in, ilen, out);
+    }
+  }
+
+  // Given 16 -bytes secret key, 32 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, this routine computes N -bytes cipher text & 16 -bytes
+  // authentication tag | N, M >= 0
+  void schwaemm256_128_encrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict txt,
+                               uint8_t* const __restrict enc,
+                               const size_t ct_len,
+                               uint8_t* const __restrict tag)
+  {
+    constexpr auto v = offload::variant::schwaemm256_128;
+    offload::client* const c = offload_client();
+    if ((c == nullptr) ||
+        !c->seal(v, key, nonce, data, d_len, txt, enc, ct_len, tag)) {
+      schwaemm256_128::encrypt(key, nonce, data, d_len, txt, enc, ct_len, tag);
+    }
+  }
+
+  // Given 16 -bytes secret key, 32 -bytes nonce, 16 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, this routine computes N
+  // -bytes deciphered text & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm256_128_decrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict tag,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict enc,
+                               uint8_t* const __restrict dec,
+                               const size_t ct_len)
+  {
+    constexpr auto v = offload::variant::schwaemm256_128;
+    offload::client* const c = offload_client();
+    bool f = false;
+    if ((c == nullptr) ||
+        !c->open(v, key, nonce, tag, data, d_len, enc, dec, ct_len, f)) {
+      using namespace schwaemm256_128;
+      f = decrypt(key, nonce, tag, data, d_len, enc, dec, ct_len);
+    }
+    return f;
+  }
+
+  // Given 24 -bytes secret key, 24 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, this routine computes N -bytes cipher text & 24 -bytes
+  // authentication tag | N, M >= 0
+  void schwaemm192_192_encrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict txt,
+                               uint8_t* const __restrict enc,
+                               const size_t ct_len,
+                               uint8_t* const __restrict tag)
+  {
+    constexpr auto v = offload::variant::schwaemm192_192;
+    offload::client* const c = offload_client();
+    if ((c == nullptr) ||
+        !c->seal(v, key, nonce, data, d_len, txt, enc, ct_len, tag)) {
+      schwaemm192_192::encrypt(key, nonce, data, d_len, txt, enc, ct_len, tag);
+    }
+  }
+
+  // Given 24 -bytes secret key, 24 -bytes nonce, 24 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, this routine computes N
+  // -bytes deciphered text & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm192_192_decrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict tag,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict enc,
+                               uint8_t* const __restrict dec,
+                               const size_t ct_len)
+  {
+    constexpr auto v = offload::variant::schwaemm192_192;
+    offload::client* const c = offload_client();
+    bool f = false;
+    if ((c == nullptr) ||
+        !c->open(v, key, nonce, tag, data, d_len, enc, dec, ct_len, f)) {
+      using namespace schwaemm192_192;
+      f = decrypt(key, nonce, tag, data, d_len, enc, dec, ct_len);
+    }
+    return f;
+  }
+
+  // Given 16 -bytes secret key, 16 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, this routine computes N -bytes cipher text & 16 -bytes
+  // authentication tag | N, M >= 0
+  void schwaemm128_128_encrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict txt,
+                               uint8_t* const __restrict enc,
+                               const size_t ct_len,
+                               uint8_t* const __restrict tag)
+  {
+    constexpr auto v = offload::variant::schwaemm128_128;
+    offload::client* const c = offload_client();
+    if ((c == nullptr) ||
+        !c->seal(v, key, nonce, data, d_len, txt, enc, ct_len, tag)) {
+      schwaemm128_128::encrypt(key, nonce, data, d_len, txt, enc, ct_len, tag);
+    }
+  }
+
+  // Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, this routine computes N
+  // -bytes deciphered text & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm128_128_decrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict tag,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict enc,
+                               uint8_t* const __restrict dec,
+                               const size_t ct_len)
+  {
+    constexpr auto v = offload::variant::schwaemm128_128;
+    offload::client* const c = offload_client();
+    bool f = false;
+    if ((c == nullptr) ||
+        !c->open(v, key, nonce, tag, data, d_len, enc, dec, ct_len, f)) {
+      using namespace schwaemm128_128;
+      f = decrypt(key, nonce, tag, data, d_len, enc, dec, ct_len);
+    }
+    return f;
+  }
+
+  // Given 32 -bytes secret key, 32 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, this routine computes N -bytes cipher text & 32 -bytes
+  // authentication tag | N, M >= 0
+  void schwaemm256_256_encrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict txt,
+                               uint8_t* const __restrict enc,
+                               const size_t ct_len,
+                               uint8_t* const __restrict tag)
+  {
+    constexpr auto v = offload::variant::schwaemm256_256;
+    offload::client* const c = offload_client();
+    if ((c == nullptr) ||
+        !c->seal(v, key, nonce, data, d_len, txt, enc, ct_len, tag)) {
+      schwaemm256_256::encrypt(key, nonce, data, d_len, txt, enc, ct_len, tag);
+    }
+  }
+
+  // Given 32 -bytes secret key, 32 -bytes nonce, 32 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, this routine computes N
+  // -bytes deciphered text & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm256_256_decrypt(const uint8_t* const __restrict key,
+                               const uint8_t* const __restrict nonce,
+                               const uint8_t* const __restrict tag,
+                               const uint8_t* const __restrict data,
+                               const size_t d_len,
+                               const uint8_t* const __restrict enc,
+                               uint8_t* const __restrict dec,
+                               const size_t ct_len)
+  {
+    constexpr auto v = offload::variant::schwaemm256_256;
+    offload::client* const c = offload_client();
+    bool f = false;
+    if ((c == nullptr) ||
+        !c->open(v, key, nonce, tag, data, d_len, enc, dec, ct_len, f)) {
+      using namespace schwaemm256_256;
+      f = decrypt(key, nonce, tag, data, d_len, enc, dec, ct_len);
+    }
+    return f;
+  }
+}
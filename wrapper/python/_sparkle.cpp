@@ -0,0 +1,333 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "esch.hpp"
+#include "schwaemm.hpp"
+
+// Native CPython extension module, exposing Esch{256,384} hash & Schwaemm AEAD
+// functions, which borrow memory of any ( contiguous ) buffer protocol object
+// i.e. `bytes`, `bytearray`, `memoryview`, numpy array etc. without copying,
+// optionally write into caller supplied writable buffers & release GIL while
+// crypto work is executed, so that Python threads run them concurrently.
+//
+// Build it with `make pyext`, which places `_sparkle` module next to
+// `sparkle.py`.
+
+namespace {
+
+// Owns a view of buffer protocol object, released when going out of scope
+struct view
+{
+  Py_buffer b{};
+  bool held = false;
+
+  ~view()
+  {
+    if (held) {
+      PyBuffer_Release(&b);
+    }
+  }
+
+  const uint8_t* ptr() const { return static_cast<const uint8_t*>(b.buf); }
+  uint8_t* mut() const { return static_cast<uint8_t*>(b.buf); }
+  size_t len() const { return static_cast<size_t>(b.len); }
+};
+
+// Acquires read-only, contiguous view of buffer protocol object, requiring it
+// to be of `len` -bytes, when `len` is non-negative
+static inline bool
+read_view(PyObject* const obj,
+          view& v,
+          const Py_ssize_t len,
+          const char* const name)
+{
+  if (PyObject_GetBuffer(obj, &v.b, PyBUF_SIMPLE) != 0) {
+    return false;
+  }
+  v.held = true;
+
+  if ((len >= 0) && (v.b.len != len)) {
+    PyErr_Format(PyExc_ValueError, "%s must be %zd -bytes", name, len);
+    return false;
+  }
+  return true;
+}
+
+// Acquires writable, contiguous view of buffer protocol object, requiring it to
+// be of `len` -bytes
+static inline bool
+write_view(PyObject* const obj,
+           view& v,
+           const Py_ssize_t len,
+           const char* const name)
+{
+  if (PyObject_GetBuffer(obj, &v.b, PyBUF_WRITABLE) != 0) {
+    return false;
+  }
+  v.held = true;
+
+  if (v.b.len != len) {
+    PyErr_Format(PyExc_ValueError, "%s must be %zd -bytes", name, len);
+    return false;
+  }
+  return true;
+}
+
+// Output buffer, which is either supplied by caller ( when `obj` is neither
+// NULL nor None ) or a freshly allocated `bytes` object, not yet visible to
+// any other thread, hence safe to be written into, without holding GIL
+static inline PyObject*
+out_buffer(PyObject* const obj,
+           view& v,
+           const Py_ssize_t len,
+           const char* const name,
+           uint8_t*& ptr)
+{
+  if ((obj == nullptr) || (obj == Py_None)) {
+    PyObject* const res = PyBytes_FromStringAndSize(nullptr, len);
+    if (res != nullptr) {
+      ptr = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(res));
+    }
+    return res;
+  }
+
+  if (!write_view(obj, v, len, name)) {
+    return nullptr;
+  }
+
+  ptr = v.mut();
+  Py_INCREF(obj);
+  return obj;
+}
+
+// Checks # -of positional arguments, passed to function `fn`
+static inline bool
+check_nargs(const char* const fn,
+            const Py_ssize_t nargs,
+            const Py_ssize_t min,
+            const Py_ssize_t max)
+{
+  if ((nargs < min) || (nargs > max)) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s() takes %zd to %zd positional arguments but %zd given",
+                 fn,
+                 min,
+                 max,
+                 nargs);
+    return false;
+  }
+  return true;
+}
+
+// hash(msg[, out]) -> digest
+//
+// Computes digest of message, writing it into `out` ( if supplied ), which is
+// also returned
+template<size_t dlen, void (*hash)(const uint8_t* const __restrict,
+                                   const size_t,
+                                   uint8_t* const __restrict)>
+static PyObject*
+py_hash(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("hash", nargs, 1, 2)) {
+    return nullptr;
+  }
+
+  view msg, out;
+  if (!read_view(args[0], msg, -1, "msg")) {
+    return nullptr;
+  }
+
+  uint8_t* dig = nullptr;
+  PyObject* const res =
+    out_buffer(nargs > 1 ? args[1] : nullptr, out, dlen, "out", dig);
+  if (res == nullptr) {
+    return nullptr;
+  }
+
+  Py_BEGIN_ALLOW_THREADS;
+  hash(msg.ptr(), msg.len(), dig);
+  Py_END_ALLOW_THREADS;
+
+  return res;
+}
+
+// encrypt(key, nonce, data, text[, enc, tag]) -> (enc, tag)
+//
+// Encrypts plain text, writing cipher text & authentication tag into `enc` &
+// `tag` ( if supplied ), which are also returned. Encryption can be performed
+// in-place, by passing same buffer as `text` & `enc`.
+template<const size_t R,
+         const size_t C,
+         const size_t A0,
+         const size_t A1,
+         const size_t M0,
+         const size_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static PyObject*
+py_encrypt(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("encrypt", nargs, 4, 6)) {
+    return nullptr;
+  }
+
+  view key, nonce, data, text, enc, tag;
+  if (!read_view(args[0], key, C, "key") ||
+      !read_view(args[1], nonce, R, "nonce") ||
+      !read_view(args[2], data, -1, "data") ||
+      !read_view(args[3], text, -1, "text")) {
+    return nullptr;
+  }
+
+  uint8_t* e = nullptr;
+  PyObject* const enc_ =
+    out_buffer(nargs > 4 ? args[4] : nullptr, enc, text.b.len, "enc", e);
+  if (enc_ == nullptr) {
+    return nullptr;
+  }
+
+  uint8_t* t = nullptr;
+  PyObject* const tag_ =
+    out_buffer(nargs > 5 ? args[5] : nullptr, tag, C, "tag", t);
+  if (tag_ == nullptr) {
+    Py_DECREF(enc_);
+    return nullptr;
+  }
+
+  Py_BEGIN_ALLOW_THREADS;
+  aead::encrypt<R, C, A0, A1, M0, M1, BR, S, B>(key.ptr(),
+                                                nonce.ptr(),
+                                                data.ptr(),
+                                                data.len(),
+                                                text.ptr(),
+                                                e,
+                                                text.len(),
+                                                t);
+  Py_END_ALLOW_THREADS;
+
+  return Py_BuildValue("(NN)", enc_, tag_);
+}
+
+// decrypt(key, nonce, tag, data, enc[, dec]) -> (flag, dec)
+//
+// Decrypts cipher text, writing plain text into `dec` ( if supplied ), which is
+// also returned, along with boolean verification flag. On verification failure,
+// `dec` is zeroed. Decryption can be performed in-place, by passing same buffer
+// as `enc` & `dec`.
+template<const size_t R,
+         const size_t C,
+         const size_t A0,
+         const size_t A1,
+         const size_t M0,
+         const size_t M1,
+         const size_t BR,
+         const size_t S,
+         const size_t B>
+static PyObject*
+py_decrypt(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("decrypt", nargs, 5, 6)) {
+    return nullptr;
+  }
+
+  view key, nonce, tag, data, enc, dec;
+  if (!read_view(args[0], key, C, "key") ||
+      !read_view(args[1], nonce, R, "nonce") ||
+      !read_view(args[2], tag, C, "tag") ||
+      !read_view(args[3], data, -1, "data") ||
+      !read_view(args[4], enc, -1, "enc")) {
+    return nullptr;
+  }
+
+  uint8_t* d = nullptr;
+  PyObject* const dec_ =
+    out_buffer(nargs > 5 ? args[5] : nullptr, dec, enc.b.len, "dec", d);
+  if (dec_ == nullptr) {
+    return nullptr;
+  }
+
+  bool f = false;
+
+  Py_BEGIN_ALLOW_THREADS;
+  f = aead::decrypt<R, C, A0, A1, M0, M1, BR, S, B>(key.ptr(),
+                                                    nonce.ptr(),
+                                                    tag.ptr(),
+                                                    data.ptr(),
+                                                    data.len(),
+                                                    enc.ptr(),
+                                                    d,
+                                                    enc.len());
+  Py_END_ALLOW_THREADS;
+
+  return Py_BuildValue("(NN)", PyBool_FromLong(f), dec_);
+}
+
+// Makes method table entry, for given function
+#define FN(name, fn, doc)                                                      \
+  {                                                                            \
+    name, reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(fn)),     \
+      METH_FASTCALL, doc                                                       \
+  }
+
+// Template arguments of Schwaemm variant, living in namespace `ns`
+#define VARIANT(ns)                                                            \
+  ns::R, ns::C, ns::A0, ns::A1, ns::M0, ns::M1, ns::BR, ns::S, ns::B
+
+#define ENC_DOC "encrypt(key, nonce, data, text[, enc, tag]) -> (enc, tag)"
+#define DEC_DOC "decrypt(key, nonce, tag, data, enc[, dec]) -> (flag, dec)"
+
+static PyMethodDef methods[] = {
+  FN("esch256_hash",
+     (py_hash<esch256::DIGEST_LEN, esch256::hash>),
+     "esch256_hash(msg[, out]) -> 32 -bytes digest"),
+  FN("esch384_hash",
+     (py_hash<esch384::DIGEST_LEN, esch384::hash>),
+     "esch384_hash(msg[, out]) -> 48 -bytes digest"),
+  FN("schwaemm256_128_encrypt",
+     (py_encrypt<VARIANT(schwaemm256_128)>),
+     ENC_DOC),
+  FN("schwaemm256_128_decrypt",
+     (py_decrypt<VARIANT(schwaemm256_128)>),
+     DEC_DOC),
+  FN("schwaemm192_192_encrypt",
+     (py_encrypt<VARIANT(schwaemm192_192)>),
+     ENC_DOC),
+  FN("schwaemm192_192_decrypt",
+     (py_decrypt<VARIANT(schwaemm192_192)>),
+     DEC_DOC),
+  FN("schwaemm128_128_encrypt",
+     (py_encrypt<VARIANT(schwaemm128_128)>),
+     ENC_DOC),
+  FN("schwaemm128_128_decrypt",
+     (py_decrypt<VARIANT(schwaemm128_128)>),
+     DEC_DOC),
+  FN("schwaemm256_256_encrypt",
+     (py_encrypt<VARIANT(schwaemm256_256)>),
+     ENC_DOC),
+  FN("schwaemm256_256_decrypt",
+     (py_decrypt<VARIANT(schwaemm256_256)>),
+     DEC_DOC),
+  { nullptr, nullptr, 0, nullptr }
+};
+
+static PyModuleDef module = {
+  PyModuleDef_HEAD_INIT,
+  "_sparkle",
+  "Native Esch{256,384} hash & Schwaemm AEAD, over buffer protocol objects",
+  -1,
+  methods,
+  nullptr,
+  nullptr,
+  nullptr,
+  nullptr
+};
+
+}
+
+PyMODINIT_FUNC
+PyInit__sparkle()
+{
+  return PyModule_Create(&module);
+}
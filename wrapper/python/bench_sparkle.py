@@ -0,0 +1,86 @@
+#!/usr/bin/python3
+
+'''
+  Compares per-call cost of ctypes based `sparkle` module against native
+  `_sparkle` extension module ( built with `make pyext` ), for small messages,
+  where foreign function call overhead dominates, and reports how native calls,
+  which release GIL, scale across Python threads.
+
+  Run it from this directory, after `make lib pyext`, as
+
+  python3 bench_sparkle.py
+'''
+
+import os
+import random
+import timeit
+from concurrent.futures import ThreadPoolExecutor
+from time import perf_counter
+
+import sparkle
+import _sparkle
+
+
+def per_call(fn, n: int = 20000) -> float:
+    '''
+    Returns mean wall clock time ( in microseconds ) of calling `fn`
+    '''
+    return min(timeit.repeat(fn, number=n, repeat=5)) / n * 1e6
+
+
+def overhead(m_len: int):
+    '''
+    Reports per-call time of hashing/ sealing a `m_len` -bytes message
+    '''
+    key = random.randbytes(16)
+    nonce = random.randbytes(32)
+    msg = random.randbytes(m_len)
+
+    dig = bytearray(32)
+    enc = bytearray(m_len)
+    tag = bytearray(16)
+
+    rows = [
+        ("esch256_hash", "ctypes",
+         lambda: sparkle.esch256_hash(msg)),
+        ("esch256_hash", "native",
+         lambda: _sparkle.esch256_hash(msg)),
+        ("esch256_hash", "native, out",
+         lambda: _sparkle.esch256_hash(msg, dig)),
+        ("schwaemm256_128_encrypt", "ctypes",
+         lambda: sparkle.schwaemm256_128_encrypt(key, nonce, b"", msg)),
+        ("schwaemm256_128_encrypt", "native",
+         lambda: _sparkle.schwaemm256_128_encrypt(key, nonce, b"", msg)),
+        ("schwaemm256_128_encrypt", "native, out",
+         lambda: _sparkle.schwaemm256_128_encrypt(key, nonce, b"", msg, enc, tag)),
+    ]
+
+    for fn, path, call in rows:
+        print(f"{fn:<24} {m_len:>6} B  {path:<12} {per_call(call):>8.2f} us/call")
+
+
+def scaling(m_len: int = 1 << 16, n_calls: int = 256):
+    '''
+    Reports throughput of hashing `n_calls` -many `m_len` -bytes messages, on
+    increasing # -of Python threads, using native extension module
+    '''
+    msg = random.randbytes(m_len)
+    n_cpu = os.cpu_count() or 1
+
+    threads = 1
+    while threads <= max(n_cpu, 1):
+        with ThreadPoolExecutor(threads) as pool:
+            beg = perf_counter()
+            list(pool.map(lambda _: _sparkle.esch256_hash(msg), range(n_calls)))
+            end = perf_counter()
+
+        mbps = (m_len * n_calls) / (end - beg) / (1 << 20)
+        print(f"esch256_hash {m_len:>6} B  {threads:>3} thread(s) {mbps:>10.2f} MB/s")
+        threads *= 2
+
+
+if __name__ == '__main__':
+    random.seed(0)
+    for m_len in [0, 64, 1024]:
+        overhead(m_len)
+    scaling()
@@ -11,7 +11,7 @@
   Project: https://github.com/itzmeanjan/sparkle
 '''
 
-from typing import Tuple
+from typing import List, Tuple
 import ctypes as ct
 import numpy as np
 from posixpath import exists, abspath
@@ -27,6 +27,78 @@ uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags='CONTIGUOUS')
 bool_t = ct.c_bool
 
 
+class iovec(ct.Structure):
+    '''
+    POSIX I/O vector i.e. `struct iovec`, describing a single buffer fragment
+    '''
+    _fields_ = [('iov_base', ct.c_void_p), ('iov_len', len_t)]
+
+
+iovec_p = ct.POINTER(iovec)
+
+
+def _iovecs(frags: List[np.ndarray]) -> ct.Array:
+    '''
+    Describes given list of byte arrays ( which must be kept alive, as long as
+    returned I/O vectors are in use ) as an array of I/O vectors
+    '''
+    vec = (iovec * max(len(frags), 1))()
+    for i, frag in enumerate(frags):
+        vec[i].iov_base = frag.ctypes.data
+        vec[i].iov_len = frag.size
+    return vec
+
+
+def _encryptv(
+    fn: str, c: int, key: bytes, nonce: bytes, data: List[bytes], text: List[bytes]
+) -> Tuple[List[bytes], bytes]:
+    '''
+    Scatter-gather encryption using C-ABI function `fn`, of Schwaemm variant
+    with c -bytes authentication tag
+    '''
+    key_ = np.frombuffer(key, dtype=u8)
+    nonce_ = np.frombuffer(nonce, dtype=u8)
+    data_ = [np.frombuffer(frag, dtype=u8) for frag in data]
+    text_ = [np.frombuffer(frag, dtype=u8) for frag in text]
+    enc = [np.empty(len(frag), dtype=u8) for frag in text]
+    tag = np.empty(c, dtype=u8)
+
+    func = getattr(SO_LIB, fn)
+    func.argtypes = [uint8_tp, uint8_tp, iovec_p, len_t,
+                     iovec_p, len_t, iovec_p, len_t, uint8_tp]
+    func.restype = bool_t
+
+    f = func(key_, nonce_, _iovecs(data_), len(data_),
+             _iovecs(text_), len(text_), _iovecs(enc), len(enc), tag)
+    assert f, "Plain text & cipher text fragments must be of same length !"
+
+    return [frag.tobytes() for frag in enc], tag.tobytes()
+
+
+def _decryptv(
+    fn: str, key: bytes, nonce: bytes, tag: bytes, data: List[bytes], enc: List[bytes]
+) -> Tuple[bool, List[bytes]]:
+    '''
+    Scatter-gather verified decryption using C-ABI function `fn`
+    '''
+    key_ = np.frombuffer(key, dtype=u8)
+    nonce_ = np.frombuffer(nonce, dtype=u8)
+    tag_ = np.frombuffer(tag, dtype=u8)
+    data_ = [np.frombuffer(frag, dtype=u8) for frag in data]
+    enc_ = [np.frombuffer(frag, dtype=u8) for frag in enc]
+    dec = [np.empty(len(frag), dtype=u8) for frag in enc]
+
+    func = getattr(SO_LIB, fn)
+    func.argtypes = [uint8_tp, uint8_tp, uint8_tp, iovec_p, len_t,
+                     iovec_p, len_t, iovec_p, len_t]
+    func.restype = bool_t
+
+    f = func(key_, nonce_, tag_, _iovecs(data_), len(data_),
+             _iovecs(enc_), len(enc_), _iovecs(dec), len(dec))
+
+    return f, [frag.tobytes() for frag in dec]
+
+
 def esch256_hash(msg: bytes) -> bytes:
     '''
     Given a N ( >= 0 ) -bytes input message, this function computes 32 -bytes
@@ -63,6 +135,115 @@ def esch384_hash(msg: bytes) -> bytes:
     return digest_
 
 
+class _esch:
+    '''
+    Incremental Esch{256,384} hasher, following `hashlib` object interface, so
+    that message can be hashed piece by piece ( say, while reading a file in
+    chunks ), without being joined into one `bytes` object first. Backed by
+    opaque hashing context of C-ABI.
+    '''
+    name: str
+    digest_size: int
+    block_size: int = 16
+
+    def __init__(self, data=b'', *, _ctx=None, _mem=None):
+        pfx = self.name
+        self._create = getattr(SO_LIB, pfx + '_create')
+        self._clone = getattr(SO_LIB, pfx + '_clone')
+        self._update = getattr(SO_LIB, pfx + '_update')
+        self._finalize = getattr(SO_LIB, pfx + '_finalize')
+        self._destroy = getattr(SO_LIB, pfx + '_destroy')
+        self._release = getattr(SO_LIB, pfx + '_release')
+
+        # context living on caller provided storage ( see `*_init` ), which is
+        # kept alive & only released, never destroyed
+        self._mem = _mem
+
+        self._ctx = _ctx if _ctx is not None else self._create()
+        if not self._ctx:
+            raise MemoryError(f'failed to allocate {pfx} context')
+
+        if len(data) > 0:
+            self.update(data)
+
+    def __del__(self):
+        if getattr(self, '_ctx', None):
+            if self._mem is not None:
+                self._release(self._ctx)
+            else:
+                self._destroy(self._ctx)
+            self._ctx = None
+
+    def update(self, data) -> None:
+        '''
+        Absorbs next piece of message, given as any contiguous buffer protocol
+        object i.e. `bytes`, `bytearray`, `memoryview` etc., without copying
+        '''
+        data_ = np.frombuffer(data, dtype=u8)
+        self._update(self._ctx, data_, data_.size)
+
+    def digest(self) -> bytes:
+        '''
+        Returns digest of message absorbed so far; more message can be absorbed
+        afterwards
+        '''
+        out = np.empty(self.digest_size, dtype=u8)
+        self._finalize(self._ctx, out)
+        return out.tobytes()
+
+    def hexdigest(self) -> str:
+        return self.digest().hex()
+
+    def copy(self) -> '_esch':
+        '''
+        Returns an independent hasher, which has absorbed same message prefix
+        '''
+        ctx = self._clone(self._ctx)
+        if not ctx:
+            raise MemoryError(f'failed to allocate {self.name} context')
+        return type(self)(_ctx=ctx)
+
+
+class esch256(_esch):
+    '''
+    Incremental Esch256 hasher, producing 32 -bytes digest
+    '''
+    name = 'esch256'
+    digest_size = 32
+
+
+class esch384(_esch):
+    '''
+    Incremental Esch384 hasher, producing 48 -bytes digest
+    '''
+    name = 'esch384'
+    digest_size = 48
+
+
+def _esch_ctx_abi():
+    '''
+    Declares signatures of incremental hashing context functions, once, given
+    that these are called many times, with small message pieces
+    '''
+    ctx_t = ct.c_void_p
+    for pfx in ('esch256', 'esch384'):
+        getattr(SO_LIB, pfx + '_create').argtypes = []
+        getattr(SO_LIB, pfx + '_create').restype = ctx_t
+        getattr(SO_LIB, pfx + '_clone').argtypes = [ctx_t]
+        getattr(SO_LIB, pfx + '_clone').restype = ctx_t
+        getattr(SO_LIB, pfx + '_update').argtypes = [ctx_t, uint8_tp, len_t]
+        getattr(SO_LIB, pfx + '_update').restype = None
+        getattr(SO_LIB, pfx + '_finalize').argtypes = [ctx_t, uint8_tp]
+        getattr(SO_LIB, pfx + '_finalize').restype = None
+        getattr(SO_LIB, pfx + '_destroy').argtypes = [ctx_t]
+        getattr(SO_LIB, pfx + '_destroy').restype = None
+        getattr(SO_LIB, pfx + '_release').argtypes = [ctx_t]
+        getattr(SO_LIB, pfx + '_release').restype = None
+
+
+_esch_ctx_abi()
+
+
 def schwaemm256_128_encrypt(
     key: bytes, nonce: bytes, data: bytes, text: bytes
 ) -> Tuple[bytes, bytes]:
@@ -347,5 +528,423 @@ def schwaemm256_256_decrypt(
     return f, dec_
 
 
+def schwaemm256_128_encryptv(
+    key: bytes, nonce: bytes, data: List[bytes], text: List[bytes]
+) -> Tuple[List[bytes], bytes]:
+    """
+    Encrypts M ( >=0 ) -many plain text bytes, given as a list of fragments, while
+    using 16 -bytes secret key, 32 -bytes public message nonce & N ( >=0 ) -bytes
+    associated data ( also given as a list of fragments ), while producing M -bytes
+    cipher text, fragmented same way as plain text, & 16 -bytes authentication tag
+    ( in order )
+    """
+    assert len(key) == 16, "Schwaemm256-128 takes 16 -bytes secret key !"
+    assert len(nonce) == 32, "Schwaemm256-128 takes 32 -bytes nonce !"
+
+    return _encryptv("schwaemm256_128_encryptv", 16, key, nonce, data, text)
+
+
+def schwaemm256_128_decryptv(
+    key: bytes, nonce: bytes, tag: bytes, data: List[bytes], enc: List[bytes]
+) -> Tuple[bool, List[bytes]]:
+    """
+    Decrypts M ( >=0 ) -many cipher text bytes, given as a list of fragments, while
+    using 16 -bytes secret key, 32 -bytes public message nonce, 16 -bytes
+    authentication tag & N ( >=0 ) -bytes associated data ( also given as a list of
+    fragments ), while producing boolean verification flag & M -bytes plain text,
+    fragmented same way as cipher text ( in order )
+    """
+    assert len(key) == 16, "Schwaemm256-128 takes 16 -bytes secret key !"
+    assert len(nonce) == 32, "Schwaemm256-128 takes 32 -bytes nonce !"
+    assert len(tag) == 16, "Schwaemm256-128 takes 16 -bytes authentication tag !"
+
+    return _decryptv("schwaemm256_128_decryptv", key, nonce, tag, data, enc)
+
+
+def schwaemm192_192_encryptv(
+    key: bytes, nonce: bytes, data: List[bytes], text: List[bytes]
+) -> Tuple[List[bytes], bytes]:
+    """
+    Encrypts M ( >=0 ) -many plain text bytes, given as a list of fragments, while
+    using 24 -bytes secret key, 24 -bytes public message nonce & N ( >=0 ) -bytes
+    associated data ( also given as a list of fragments ), while producing M -bytes
+    cipher text, fragmented same way as plain text, & 24 -bytes authentication tag
+    ( in order )
+    """
+    assert len(key) == 24, "Schwaemm192-192 takes 24 -bytes secret key !"
+    assert len(nonce) == 24, "Schwaemm192-192 takes 24 -bytes nonce !"
+
+    return _encryptv("schwaemm192_192_encryptv", 24, key, nonce, data, text)
+
+
+def schwaemm192_192_decryptv(
+    key: bytes, nonce: bytes, tag: bytes, data: List[bytes], enc: List[bytes]
+) -> Tuple[bool, List[bytes]]:
+    """
+    Decrypts M ( >=0 ) -many cipher text bytes, given as a list of fragments, while
+    using 24 -bytes secret key, 24 -bytes public message nonce, 24 -bytes
+    authentication tag & N ( >=0 ) -bytes associated data ( also given as a list of
+    fragments ), while producing boolean verification flag & M -bytes plain text,
+    fragmented same way as cipher text ( in order )
+    """
+    assert len(key) == 24, "Schwaemm192-192 takes 24 -bytes secret key !"
+    assert len(nonce) == 24, "Schwaemm192-192 takes 24 -bytes nonce !"
+    assert len(tag) == 24, "Schwaemm192-192 takes 24 -bytes authentication tag !"
+
+    return _decryptv("schwaemm192_192_decryptv", key, nonce, tag, data, enc)
+
+
+def schwaemm128_128_encryptv(
+    key: bytes, nonce: bytes, data: List[bytes], text: List[bytes]
+) -> Tuple[List[bytes], bytes]:
+    """
+    Encrypts M ( >=0 ) -many plain text bytes, given as a list of fragments, while
+    using 16 -bytes secret key, 16 -bytes public message nonce & N ( >=0 ) -bytes
+    associated data ( also given as a list of fragments ), while producing M -bytes
+    cipher text, fragmented same way as plain text, & 16 -bytes authentication tag
+    ( in order )
+    """
+    assert len(key) == 16, "Schwaemm128-128 takes 16 -bytes secret key !"
+    assert len(nonce) == 16, "Schwaemm128-128 takes 16 -bytes nonce !"
+
+    return _encryptv("schwaemm128_128_encryptv", 16, key, nonce, data, text)
+
+
+def schwaemm128_128_decryptv(
+    key: bytes, nonce: bytes, tag: bytes, data: List[bytes], enc: List[bytes]
+) -> Tuple[bool, List[bytes]]:
+    """
+    Decrypts M ( >=0 ) -many cipher text bytes, given as a list of fragments, while
+    using 16 -bytes secret key, 16 -bytes public message nonce, 16 -bytes
+    authentication tag & N ( >=0 ) -bytes associated data ( also given as a list of
+    fragments ), while producing boolean verification flag & M -bytes plain text,
+    fragmented same way as cipher text ( in order )
+    """
+    assert len(key) == 16, "Schwaemm128-128 takes 16 -bytes secret key !"
+    assert len(nonce) == 16, "Schwaemm128-128 takes 16 -bytes nonce !"
+    assert len(tag) == 16, "Schwaemm128-128 takes 16 -bytes authentication tag !"
+
+    return _decryptv("schwaemm128_128_decryptv", key, nonce, tag, data, enc)
+
+
+def schwaemm256_256_encryptv(
+    key: bytes, nonce: bytes, data: List[bytes], text: List[bytes]
+) -> Tuple[List[bytes], bytes]:
+    """
+    Encrypts M ( >=0 ) -many plain text bytes, given as a list of fragments, while
+    using 32 -bytes secret key, 32 -bytes public message nonce & N ( >=0 ) -bytes
+    associated data ( also given as a list of fragments ), while producing M -bytes
+    cipher text, fragmented same way as plain text, & 32 -bytes authentication tag
+    ( in order )
+    """
+    assert len(key) == 32, "Schwaemm256-256 takes 32 -bytes secret key !"
+    assert len(nonce) == 32, "Schwaemm256-256 takes 32 -bytes nonce !"
+
+    return _encryptv("schwaemm256_256_encryptv", 32, key, nonce, data, text)
+
+
+def schwaemm256_256_decryptv(
+    key: bytes, nonce: bytes, tag: bytes, data: List[bytes], enc: List[bytes]
+) -> Tuple[bool, List[bytes]]:
+    """
+    Decrypts M ( >=0 ) -many cipher text bytes, given as a list of fragments, while
+    using 32 -bytes secret key, 32 -bytes public message nonce, 32 -bytes
+    authentication tag & N ( >=0 ) -bytes associated data ( also given as a list of
+    fragments ), while producing boolean verification flag & M -bytes plain text,
+    fragmented same way as cipher text ( in order )
+    """
+    assert len(key) == 32, "Schwaemm256-256 takes 32 -bytes secret key !"
+    assert len(nonce) == 32, "Schwaemm256-256 takes 32 -bytes nonce !"
+    assert len(tag) == 32, "Schwaemm256-256 takes 32 -bytes authentication tag !"
+
+    return _decryptv("schwaemm256_256_decryptv", key, nonce, tag, data, enc)
+
+
+size_tp = np.ctypeslib.ndpointer(dtype=np.uintp, ndim=1, flags='CONTIGUOUS')
+bool_tp = np.ctypeslib.ndpointer(dtype=np.bool_, ndim=1, flags='CONTIGUOUS')
+
+
+def _flat(buf) -> np.ndarray:
+    '''
+    Views given uint8 numpy array or buffer protocol object as 1-D uint8 array,
+    copying only if array isn't contiguous
+    '''
+    if isinstance(buf, np.ndarray):
+        assert buf.dtype == u8, "Expected uint8 array !"
+        return np.ascontiguousarray(buf).reshape(-1)
+    return np.frombuffer(buf, dtype=u8)
+
+
+def _layout(msgs, offsets, lengths) -> Tuple[np.ndarray, np.ndarray, np.ndarray, tuple]:
+    '''
+    Describes a batch of messages, given either as 2-D uint8 array ( one
+    message per row ) or as a flat buffer along with byte offset & length of
+    each message, as flat buffer, offsets & lengths, along with shape of
+    output array, holding same layout
+    '''
+    if offsets is None and lengths is None:
+        rows = np.asarray(msgs)
+        assert rows.ndim == 2, "Expected 2-D uint8 array, with one message per row !"
+        n, w = rows.shape
+        off = np.arange(n, dtype=np.uintp) * w
+        len_ = np.full(n, w, dtype=np.uintp)
+        return _flat(rows), off, len_, rows.shape
+
+    flat = _flat(msgs)
+    off = np.ascontiguousarray(offsets, dtype=np.uintp)
+    len_ = np.ascontiguousarray(lengths, dtype=np.uintp)
+    assert off.ndim == 1 and off.shape == len_.shape, "Offsets & lengths must be 1-D arrays of same length !"
+    assert np.all(off + len_ <= flat.size), "Messages must lie within buffer !"
+    return flat, off, len_, flat.shape
+
+
+def _ad_layout(data, n: int, d_offsets, d_lengths) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    '''
+    Describes associated data of n messages, which is either absent, shared by
+    all messages ( 1-D ), one row per message ( 2-D ) or a flat buffer along
+    with byte offsets & lengths
+    '''
+    if data is None:
+        data = b''
+    if d_offsets is None and d_lengths is None and np.ndim(data) != 2:
+        flat = _flat(data)
+        return flat, np.zeros(n, dtype=np.uintp), np.full(n, flat.size, dtype=np.uintp)
+
+    flat, off, len_, _ = _layout(data, d_offsets, d_lengths)
+    assert off.size == n, "Expected associated data for each message !"
+    return flat, off, len_
+
+
+def _keys(key, c: int, n: int) -> Tuple[np.ndarray, int]:
+    '''
+    Returns flat secret key(s) & byte distance between keys of consecutive
+    messages, which is zero when all of them share one key
+    '''
+    key_ = _flat(key)
+    if key_.size == c:
+        return key_, 0
+    assert key_.size == n * c, f"Expected one {c} -bytes key or one per message !"
+    return key_, c
+
+
+def _hash_batch(fn: str, dlen: int, msgs, offsets, lengths) -> np.ndarray:
+    '''
+    Hashes a batch of messages, in one call to C-ABI function `fn`
+    '''
+    flat, off, len_, _ = _layout(msgs, offsets, lengths)
+    out = np.empty((off.size, dlen), dtype=u8)
+
+    getattr(SO_LIB, fn)(flat, off, len_, off.size, out.reshape(-1))
+    return out
+
+
+def _encrypt_batch(
+    fn: str, c: int, r: int, key, nonces, data, text, offsets, lengths, d_offsets, d_lengths
+) -> Tuple[np.ndarray, np.ndarray]:
+    '''
+    Encrypts a batch of messages, in one call to C-ABI function `fn`, of
+    Schwaemm variant with c -bytes key/ tag & r -bytes nonce
+    '''
+    txt, off, len_, shape = _layout(text, offsets, lengths)
+    n = off.size
+
+    key_, k_stride = _keys(key, c, n)
+    nonce_ = _flat(nonces)
+    assert nonce_.size == n * r, f"Expected one {r} -bytes nonce per message !"
+    ad, d_off, d_len = _ad_layout(data, n, d_offsets, d_lengths)
+
+    # bytes of buffer, not covered by any message, are never written
+    enc = np.zeros(txt.size, dtype=u8)
+    tags = np.empty((n, c), dtype=u8)
+
+    func = getattr(SO_LIB, fn)
+    func(key_, k_stride, nonce_, ad, d_off, d_len, txt, enc, off, len_, tags.reshape(-1), n)
+    return enc.reshape(shape), tags
+
+
+def _decrypt_batch(
+    fn: str, c: int, r: int, key, nonces, tags, data, enc, offsets, lengths, d_offsets, d_lengths
+) -> Tuple[np.ndarray, np.ndarray]:
+    '''
+    Decrypts a batch of messages, in one call to C-ABI function `fn`, of
+    Schwaemm variant with c -bytes key/ tag & r -bytes nonce
+    '''
+    enc_, off, len_, shape = _layout(enc, offsets, lengths)
+    n = off.size
+
+    key_, k_stride = _keys(key, c, n)
+    nonce_ = _flat(nonces)
+    assert nonce_.size == n * r, f"Expected one {r} -bytes nonce per message !"
+    tag_ = _flat(tags)
+    assert tag_.size == n * c, f"Expected one {c} -bytes tag per message !"
+    ad, d_off, d_len = _ad_layout(data, n, d_offsets, d_lengths)
+
+    dec = np.zeros(enc_.size, dtype=u8)
+    flags = np.empty(n, dtype=np.bool_)
+
+    func = getattr(SO_LIB, fn)
+    func(key_, k_stride, nonce_, tag_, ad, d_off, d_len, enc_, dec, off, len_, flags, n)
+    return flags, dec.reshape(shape)
+
+
+def _batch_abi():
+    '''
+    Declares signatures of batch functions, once, so that per-call overhead
+    isn't paid on each batch
+    '''
+    for pfx in ('esch256', 'esch384'):
+        func = getattr(SO_LIB, pfx + '_hash_batch')
+        func.argtypes = [uint8_tp, size_tp, size_tp, len_t, uint8_tp]
+        func.restype = None
+
+    for pfx in ('schwaemm256_128', 'schwaemm192_192', 'schwaemm128_128', 'schwaemm256_256'):
+        func = getattr(SO_LIB, pfx + '_encrypt_batch')
+        func.argtypes = [uint8_tp, len_t, uint8_tp, uint8_tp, size_tp, size_tp,
+                         uint8_tp, uint8_tp, size_tp, size_tp, uint8_tp, len_t]
+        func.restype = None
+
+        func = getattr(SO_LIB, pfx + '_decrypt_batch')
+        func.argtypes = [uint8_tp, len_t, uint8_tp, uint8_tp, uint8_tp, size_tp, size_tp,
+                         uint8_tp, uint8_tp, size_tp, size_tp, bool_tp, len_t]
+        func.restype = bool_t
+
+
+_batch_abi()
+
+
+def esch256_hash_batch(msgs, offsets=None, lengths=None) -> np.ndarray:
+    '''
+    Computes 32 -bytes Esch256 digest of each message of a batch, given either
+    as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message, returning ( n, 32 ) uint8 array
+    '''
+    return _hash_batch("esch256_hash_batch", 32, msgs, offsets, lengths)
+
+
+def esch384_hash_batch(msgs, offsets=None, lengths=None) -> np.ndarray:
+    '''
+    Computes 48 -bytes Esch384 digest of each message of a batch, given either
+    as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message, returning ( n, 48 ) uint8 array
+    '''
+    return _hash_batch("esch384_hash_batch", 48, msgs, offsets, lengths)
+
+
+def schwaemm256_128_encrypt_batch(
+    key, nonces, data, text, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Encrypts a batch of n messages, using Schwaemm256-128, where plain texts are given
+    either as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message. Takes one 16 -bytes secret key ( shared )
+    or ( n, 16 ) keys, ( n, 32 ) nonces & associated data, which is either None,
+    shared by all messages ( 1-D ), one row per message ( 2-D ) or a flat buffer along
+    with byte offsets & lengths. Returns cipher texts, laid out same way as plain
+    texts, & ( n, 16 ) authentication tags ( in order )
+    """
+    return _encrypt_batch("schwaemm256_128_encrypt_batch", 16, 32, key, nonces, data, text,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm256_128_decrypt_batch(
+    key, nonces, tags, data, enc, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Decrypts a batch of n messages, using Schwaemm256-128, laid out same way as it's done in
+    `schwaemm256_128_encrypt_batch`, while producing ( n, ) boolean verification flags &
+    decrypted texts, laid out same way as cipher texts ( in order ). Decrypted text
+    of each message, which failed verification, is zeroed
+    """
+    return _decrypt_batch("schwaemm256_128_decrypt_batch", 16, 32, key, nonces, tags, data, enc,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm192_192_encrypt_batch(
+    key, nonces, data, text, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Encrypts a batch of n messages, using Schwaemm192-192, where plain texts are given
+    either as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message. Takes one 24 -bytes secret key ( shared )
+    or ( n, 24 ) keys, ( n, 24 ) nonces & associated data, which is either None,
+    shared by all messages ( 1-D ), one row per message ( 2-D ) or a flat buffer along
+    with byte offsets & lengths. Returns cipher texts, laid out same way as plain
+    texts, & ( n, 24 ) authentication tags ( in order )
+    """
+    return _encrypt_batch("schwaemm192_192_encrypt_batch", 24, 24, key, nonces, data, text,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm192_192_decrypt_batch(
+    key, nonces, tags, data, enc, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Decrypts a batch of n messages, using Schwaemm192-192, laid out same way as it's done in
+    `schwaemm192_192_encrypt_batch`, while producing ( n, ) boolean verification flags &
+    decrypted texts, laid out same way as cipher texts ( in order ). Decrypted text
+    of each message, which failed verification, is zeroed
+    """
+    return _decrypt_batch("schwaemm192_192_decrypt_batch", 24, 24, key, nonces, tags, data, enc,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm128_128_encrypt_batch(
+    key, nonces, data, text, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Encrypts a batch of n messages, using Schwaemm128-128, where plain texts are given
+    either as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message. Takes one 16 -bytes secret key ( shared )
+    or ( n, 16 ) keys, ( n, 16 ) nonces & associated data, which is either None,
+    shared by all messages ( 1-D ), one row per message ( 2-D ) or a flat buffer along
+    with byte offsets & lengths. Returns cipher texts, laid out same way as plain
+    texts, & ( n, 16 ) authentication tags ( in order )
+    """
+    return _encrypt_batch("schwaemm128_128_encrypt_batch", 16, 16, key, nonces, data, text,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm128_128_decrypt_batch(
+    key, nonces, tags, data, enc, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Decrypts a batch of n messages, using Schwaemm128-128, laid out same way as it's done in
+    `schwaemm128_128_encrypt_batch`, while producing ( n, ) boolean verification flags &
+    decrypted texts, laid out same way as cipher texts ( in order ). Decrypted text
+    of each message, which failed verification, is zeroed
+    """
+    return _decrypt_batch("schwaemm128_128_decrypt_batch", 16, 16, key, nonces, tags, data, enc,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm256_256_encrypt_batch(
+    key, nonces, data, text, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Encrypts a batch of n messages, using Schwaemm256-256, where plain texts are given
+    either as 2-D uint8 array ( one message per row ) or as a flat buffer along with
+    byte offset & length of each message. Takes one 32 -bytes secret key ( shared )
+    or ( n, 32 ) keys, ( n, 32 ) nonces & associated data, which is either None,
+    shared by all messages ( 1-D ), one row per message ( 2-D ) or a flat buffer along
+    with byte offsets & lengths. Returns cipher texts, laid out same way as plain
+    texts, & ( n, 32 ) authentication tags ( in order )
+    """
+    return _encrypt_batch("schwaemm256_256_encrypt_batch", 32, 32, key, nonces, data, text,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
+def schwaemm256_256_decrypt_batch(
+    key, nonces, tags, data, enc, offsets=None, lengths=None, d_offsets=None, d_lengths=None
+) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Decrypts a batch of n messages, using Schwaemm256-256, laid out same way as it's done in
+    `schwaemm256_256_encrypt_batch`, while producing ( n, ) boolean verification flags &
+    decrypted texts, laid out same way as cipher texts ( in order ). Decrypted text
+    of each message, which failed verification, is zeroed
+    """
+    return _decrypt_batch("schwaemm256_256_decrypt_batch", 32, 32, key, nonces, tags, data, enc,
+                          offsets, lengths, d_offsets, d_lengths)
+
+
 if __name__ == '__main__':
     print('Use `sparkle` as library module !')
@@ -1,6 +1,7 @@
 #!/usr/bin/python3
 
 import sparkle
+import pytest
 import numpy as np
 
 u8 = np.uint8
@@ -370,5 +371,495 @@ def test_schwaemm256_256_kat():
             fd.readline()
 
 
+def test_schwaemm_scatter_gather():
+    """
+    Tests that scatter-gather ( I/O vector based ) Schwaemm AEAD routines compute
+    same cipher text & authentication tag as contiguous ones do, for randomly
+    fragmented associated data & plain text, for all Schwaemm variants
+    """
+    import random
+
+    def split(msg: bytes) -> list:
+        frags = []
+        off = 0
+        while off < len(msg):
+            n = random.choice([0, 1, 3, 7, 16, 33, 100])
+            frags.append(msg[off: off + n])
+            off += n
+        return frags
+
+    variants = [(sparkle.schwaemm256_128_encrypt, sparkle.schwaemm256_128_encryptv, sparkle.schwaemm256_128_decryptv, 16, 32),
+                (sparkle.schwaemm192_192_encrypt, sparkle.schwaemm192_192_encryptv, sparkle.schwaemm192_192_decryptv, 24, 24),
+                (sparkle.schwaemm128_128_encrypt, sparkle.schwaemm128_128_encryptv, sparkle.schwaemm128_128_decryptv, 16, 16),
+                (sparkle.schwaemm256_256_encrypt, sparkle.schwaemm256_256_encryptv, sparkle.schwaemm256_256_decryptv, 32, 32)]
+
+    random.seed(0)
+    for encrypt, encryptv, decryptv, c, r in variants:
+        for _ in range(200):
+            key = random.randbytes(c)
+            nonce = random.randbytes(r)
+            ad = random.randbytes(random.randrange(100))
+            pt = random.randbytes(random.randrange(300))
+
+            cipher, tag = encrypt(key, nonce, ad, pt)
+
+            ad_ = split(ad)
+            pt_ = split(pt)
+
+            cipher_, tag_ = encryptv(key, nonce, ad_, pt_)
+            assert [len(frag) for frag in cipher_] == [len(frag) for frag in pt_]
+            assert b"".join(cipher_) == cipher and tag_ == tag
+
+            flag, text = decryptv(key, nonce, tag, ad_, split(cipher))
+            assert flag and b"".join(text) == pt
+
+            if len(pt) > 0:
+                bad = bytearray(cipher)
+                bad[random.randrange(len(bad))] ^= 1
+
+                flag, text = decryptv(key, nonce, tag, ad_, split(bytes(bad)))
+                assert not flag and b"".join(text) == bytes(len(pt))
+
+
+def test_native_extension():
+    """
+    Tests that native extension module computes same digests, cipher texts &
+    authentication tags as ctypes based wrapper does, for any buffer protocol
+    input, while writing into caller supplied output buffers, when asked to
+    """
+    import random
+    _sparkle = pytest.importorskip("_sparkle")
+
+    random.seed(1)
+    for hash_, dlen in [("esch256_hash", 32), ("esch384_hash", 48)]:
+        for mlen in [0, 1, 16, 17, 100, 1000]:
+            msg = random.randbytes(mlen)
+            dig = getattr(sparkle, hash_)(msg)
+
+            assert getattr(_sparkle, hash_)(msg) == dig
+            assert getattr(_sparkle, hash_)(memoryview(bytearray(msg))) == dig
+
+            out = bytearray(dlen)
+            assert getattr(_sparkle, hash_)(msg, out) is out and out == dig
+
+            with pytest.raises(ValueError):
+                getattr(_sparkle, hash_)(msg, bytearray(dlen - 1))
+
+    variants = ["schwaemm256_128", "schwaemm192_192", "schwaemm128_128", "schwaemm256_256"]
+    lens = [(16, 32), (24, 24), (16, 16), (32, 32)]
+
+    for name, (c, r) in zip(variants, lens):
+        encrypt = getattr(_sparkle, name + "_encrypt")
+        decrypt = getattr(_sparkle, name + "_decrypt")
+
+        for _ in range(100):
+            key = random.randbytes(c)
+            nonce = random.randbytes(r)
+            ad = random.randbytes(random.randrange(64))
+            pt = random.randbytes(random.randrange(256))
+
+            cipher, tag = getattr(sparkle, name + "_encrypt")(key, nonce, ad, pt)
+            assert encrypt(key, nonce, ad, pt) == (cipher, tag)
+
+            # in-place, into caller supplied buffers
+            buf = bytearray(pt)
+            tag_ = bytearray(c)
+            enc, t = encrypt(key, nonce, ad, buf, buf, tag_)
+            assert enc is buf and t is tag_
+            assert buf == cipher and tag_ == tag
+
+            flag, dec = decrypt(key, nonce, tag_, memoryview(ad), buf, buf)
+            assert flag and dec is buf and buf == pt
+
+            flag, dec = decrypt(key, nonce, tag, ad, cipher)
+            assert flag and dec == pt
+
+            bad = bytearray(tag)
+            bad[0] ^= 1
+            flag, dec = decrypt(key, nonce, bytes(bad), ad, cipher)
+            assert not flag and dec == bytes(len(pt))
+
+        with pytest.raises(ValueError):
+            encrypt(bytes(c - 1), bytes(r), b"", b"")
+        with pytest.raises(ValueError):
+            encrypt(bytes(c), bytes(r), b"", b"abc", bytearray(2))
+        with pytest.raises(BufferError):
+            encrypt(bytes(c), bytes(r), b"", b"abc", b"xyz")
+
+
+def test_esch_incremental():
+    """
+    Tests that incremental Esch{256,384} hashers compute same digest as hashing
+    whole message at once does, when message is absorbed in random pieces, and
+    that copied hashers continue independently from shared message prefix
+    """
+    import hashlib
+    import io
+    import random
+
+    random.seed(2)
+    for cls, hash_ in [(sparkle.esch256, sparkle.esch256_hash),
+                       (sparkle.esch384, sparkle.esch384_hash)]:
+        for _ in range(100):
+            msg = random.randbytes(random.randrange(600))
+
+            h = cls()
+            off = 0
+            while off < len(msg):
+                n = random.choice([0, 1, 15, 16, 17, 64, 100])
+                h.update(memoryview(msg)[off: off + n])
+                off += n
+
+            assert h.digest() == hash_(msg)
+            assert h.hexdigest() == hash_(msg).hex()
+            assert len(h.digest()) == h.digest_size
+
+            # prefix cloning
+            cut = random.randrange(len(msg) + 1)
+            a = cls(msg[:cut])
+            b = a.copy()
+            a.update(msg[cut:])
+            b.update(bytearray(b"suffix"))
+            assert a.digest() == hash_(msg)
+            assert b.digest() == hash_(msg[:cut] + b"suffix")
+
+            # digest doesn't finish hasher
+            a.update(b"more")
+            assert a.digest() == hash_(msg + b"more")
+
+        msg = random.randbytes(1 << 20)
+        assert hashlib.file_digest(io.BytesIO(msg), cls).digest() == hash_(msg)
+
+
+def test_batch():
+    """
+    Tests that batched Esch{256,384} hashing & Schwaemm AEAD over 2-D arrays or
+    flat buffers with offsets & lengths, computes same digests, cipher texts &
+    authentication tags as hashing/ encrypting each message on its own does
+    """
+    rng = np.random.default_rng(3)
+
+    for batch, hash_, dlen in [(sparkle.esch256_hash_batch, sparkle.esch256_hash, 32),
+                               (sparkle.esch384_hash_batch, sparkle.esch384_hash, 48)]:
+        # rows, enough of them to fill all lanes & spread over thread pool
+        for n, w in [(0, 8), (1, 0), (37, 64), (4096, 24)]:
+            rows = rng.integers(0, 256, (n, w), dtype=u8)
+            digs = batch(rows)
+            assert digs.shape == (n, dlen)
+            for i in range(min(n, 64)):
+                assert digs[i].tobytes() == hash_(rows[i].tobytes())
+
+        # variable length records, packed back to back
+        lens = rng.choice([0, 5, 16, 17, 64], 300).astype(np.uintp)
+        offs = np.concatenate(([0], np.cumsum(lens)[:-1])).astype(np.uintp)
+        buf = rng.integers(0, 256, int(lens.sum()), dtype=u8).tobytes()
+
+        digs = batch(buf, offs, lens)
+        for i in range(lens.size):
+            assert digs[i].tobytes() == hash_(buf[offs[i]: offs[i] + lens[i]])
+
+    variants = [("schwaemm256_128", 16, 32), ("schwaemm192_192", 24, 24),
+                ("schwaemm128_128", 16, 16), ("schwaemm256_256", 32, 32)]
+
+    for name, c, r in variants:
+        encrypt = getattr(sparkle, name + "_encrypt")
+        encrypt_batch = getattr(sparkle, name + "_encrypt_batch")
+        decrypt_batch = getattr(sparkle, name + "_decrypt_batch")
+
+        n, w = 100, 48
+        keys = rng.integers(0, 256, (n, c), dtype=u8)
+        nonces = rng.integers(0, 256, (n, r), dtype=u8)
+        ads = rng.integers(0, 256, (n, 12), dtype=u8)
+        texts = rng.integers(0, 256, (n, w), dtype=u8)
+
+        # per-message keys & associated data
+        enc, tags = encrypt_batch(keys, nonces, ads, texts)
+        assert enc.shape == (n, w) and tags.shape == (n, c)
+        for i in range(n):
+            e, t = encrypt(keys[i].tobytes(), nonces[i].tobytes(),
+                           ads[i].tobytes(), texts[i].tobytes())
+            assert enc[i].tobytes() == e and tags[i].tobytes() == t
+
+        flags, dec = decrypt_batch(keys, nonces, tags, ads, enc)
+        assert flags.all() and np.array_equal(dec, texts)
+
+        # shared key & associated data, tampered messages fail alone
+        key = keys[0].tobytes()
+        enc, tags = encrypt_batch(key, nonces, b"header", texts)
+        e, t = encrypt(key, nonces[7].tobytes(), b"header", texts[7].tobytes())
+        assert enc[7].tobytes() == e and tags[7].tobytes() == t
+
+        enc[3, 0] ^= 1
+        tags[9, 0] ^= 1
+        flags, dec = decrypt_batch(key, nonces, tags, b"header", enc)
+        assert not flags[3] and not flags[9] and flags.sum() == n - 2
+        assert not dec[3].any() and not dec[9].any()
+        assert np.array_equal(np.delete(dec, [3, 9], 0), np.delete(texts, [3, 9], 0))
+
+        # variable length records, packed back to back
+        lens = rng.choice([0, 1, 31, 32, 33, 100], n).astype(np.uintp)
+        offs = np.concatenate(([0], np.cumsum(lens)[:-1])).astype(np.uintp)
+        buf = rng.integers(0, 256, int(lens.sum()), dtype=u8)
+
+        enc, tags = encrypt_batch(keys, nonces, None, buf, offs, lens)
+        for i in range(n):
+            e, t = encrypt(keys[i].tobytes(), nonces[i].tobytes(), b"",
+                           buf[offs[i]: offs[i] + lens[i]].tobytes())
+            assert enc[offs[i]: offs[i] + lens[i]].tobytes() == e
+            assert tags[i].tobytes() == t
+
+        flags, dec = decrypt_batch(keys, nonces, tags, None, enc, offs, lens)
+        assert flags.all() and np.array_equal(dec, buf)
+
+        # gaps between records are zeroed, never left uninitialized
+        gapped = np.arange(n, dtype=np.uintp) * 128
+        enc, _ = encrypt_batch(keys, nonces, None, np.full(n * 128, 0xff, dtype=u8), gapped, lens)
+        for i in range(n):
+            assert not enc[gapped[i] + lens[i]: gapped[i] + 128].any()
+
+
+def test_streaming_ctx_abi():
+    """
+    Tests opaque-context C-ABI of streaming Schwaemm AEAD & Esch hashing, both on
+    heap & on caller provided storage, against one-shot functions, when input is
+    supplied in random pieces
+    """
+    import ctypes as ct
+    import random
+
+    lib = sparkle.SO_LIB
+    vp, u8p, sz = ct.c_void_p, ct.c_char_p, ct.c_size_t
+
+    def split(msg: bytes) -> list:
+        frags, off = [], 0
+        while off < len(msg):
+            n = random.choice([0, 1, 7, 16, 33, 100])
+            frags.append(msg[off: off + n])
+            off += n
+        return frags
+
+    def storage(pfx: str):
+        # caller owned, suitably aligned memory, for a context
+        size, align = getattr(lib, pfx + "_ctx_size")(), getattr(lib, pfx + "_ctx_align")()
+        buf = ct.create_string_buffer(size + align)
+        addr = ct.addressof(buf)
+        return buf, addr + (-addr % align)
+
+    variants = [("schwaemm256_128", 16, 32), ("schwaemm192_192", 24, 24),
+                ("schwaemm128_128", 16, 16), ("schwaemm256_256", 32, 32)]
+
+    random.seed(4)
+    for v, c, r in variants:
+        def fn(name: str, args: list, res):
+            func = getattr(lib, f"{v}_{name}")
+            func.argtypes, func.restype = args, res
+            return func
+
+        size, align = fn("ctx_size", [], sz), fn("ctx_align", [], sz)
+        create = fn("create", [u8p, u8p, ct.c_bool], vp)
+        init = fn("init", [vp, u8p, u8p, ct.c_bool], vp)
+        clone = fn("clone", [vp], vp)
+        clone_into = fn("clone_into", [vp, vp], vp)
+        absorb = fn("absorb_ad", [vp, u8p, sz], ct.c_bool)
+        enc_upd = fn("encrypt_update", [vp, u8p, vp, sz], ct.c_bool)
+        dec_upd = fn("decrypt_update", [vp, u8p, vp, sz], ct.c_bool)
+        enc_fin = fn("encrypt_finalize", [vp, vp], ct.c_bool)
+        dec_fin = fn("decrypt_finalize", [vp, u8p], ct.c_bool)
+        destroy = fn("destroy", [vp], None)
+        release = fn("release", [vp], None)
+
+        assert size() > 0 and align() > 0
+
+        def seal(ctx, ad: bytes, pt: bytes):
+            for frag in split(ad):
+                assert absorb(ctx, frag, len(frag))
+            out = b""
+            for frag in split(pt):
+                buf = ct.create_string_buffer(len(frag))
+                assert enc_upd(ctx, frag, buf, len(frag))
+                out += buf.raw
+            tag = ct.create_string_buffer(c)
+            assert enc_fin(ctx, tag)
+            return out, tag.raw
+
+        for _ in range(50):
+            key, nonce = random.randbytes(c), random.randbytes(r)
+            ad, pt = random.randbytes(random.randrange(80)), random.randbytes(random.randrange(300))
+            cipher, tag = getattr(sparkle, v + "_encrypt")(key, nonce, ad, pt)
+
+            # heap allocated context
+            ctx = create(key, nonce, False)
+            assert seal(ctx, ad, pt) == (cipher, tag)
+            destroy(ctx)
+
+            # context on caller storage, cloned after associated data
+            mem, addr = storage(v)
+            ctx = init(addr, key, nonce, False)
+            assert ctx == addr
+            assert absorb(ctx, ad, len(ad))
+            mem_, addr_ = storage(v)
+            fork = clone_into(ctx, addr_)
+            heap = clone(ctx)
+            assert seal(ctx, b"", pt) == (cipher, tag)
+            assert seal(fork, b"", pt) == (cipher, tag)
+            assert seal(heap, b"", pt) == (cipher, tag)
+            release(ctx)
+            release(fork)
+            destroy(heap)
+
+            # decryption, which can't be used for encrypting
+            ctx = create(key, nonce, True)
+            assert not enc_upd(ctx, b"", None, 0)
+            assert absorb(ctx, ad, len(ad))
+            out = ct.create_string_buffer(len(pt))
+            assert dec_upd(ctx, cipher, out, len(cipher))
+            assert out.raw == pt
+            destroy(ctx)
+
+            ctx = create(key, nonce, True)
+            assert absorb(ctx, ad, len(ad)) and dec_upd(ctx, cipher, out, len(cipher))
+            assert not dec_fin(ctx, bytes([tag[0] ^ 1]) + tag[1:])
+            destroy(ctx)
+
+            ctx = create(key, nonce, True)
+            assert absorb(ctx, ad, len(ad)) and dec_upd(ctx, cipher, out, len(cipher))
+            assert dec_fin(ctx, tag)
+            assert not dec_fin(ctx, tag)
+            destroy(ctx)
+
+        # misaligned or NULL storage is refused
+        if align() > 1:
+            mem, addr = storage(v)
+            assert init(addr + 1, bytes(c), bytes(r), False) is None
+        assert init(None, bytes(c), bytes(r), False) is None
+        ctx = create(bytes(c), bytes(r), False)
+        assert clone_into(ctx, None) is None
+        destroy(ctx)
+
+    for h, dlen in [("esch256", 32), ("esch384", 48)]:
+        getattr(lib, h + "_init").argtypes = [vp]
+        getattr(lib, h + "_init").restype = vp
+        getattr(lib, h + "_ctx_size").restype = sz
+        getattr(lib, h + "_ctx_align").restype = sz
+
+        msg = random.randbytes(500)
+        mem, addr = storage(h)
+        ctx = getattr(lib, h + "_init")(addr)
+        assert ctx == addr
+
+        hasher = getattr(sparkle, h)(_ctx=ctx, _mem=mem)
+        for frag in split(msg):
+            hasher.update(frag)
+        assert hasher.digest() == getattr(sparkle, h + "_hash")(msg)
+        del hasher  # context is released, not destroyed, so storage is reusable
+
+        ctx = getattr(lib, h + "_init")(addr)
+        assert ctx == addr
+        getattr(lib, h + "_release")(ctx)
+
+
+def test_many():
+    """
+    Tests `*_many` C-ABI batch functions, which take arrays of pointers/
+    descriptors of messages scattered across memory, against one-shot functions,
+    also ensuring tampered messages are reported in status array
+    """
+    import ctypes as ct
+    import random
+
+    lib = sparkle.SO_LIB
+    u8p, sz = ct.POINTER(ct.c_uint8), ct.c_size_t
+
+    class desc(ct.Structure):
+        _fields_ = [("key", ct.c_char_p), ("nonce", ct.c_char_p),
+                    ("data", ct.c_char_p), ("d_len", sz),
+                    ("in_", ct.c_char_p), ("out", u8p), ("len", sz),
+                    ("tag", u8p)]
+
+    def ptr(buf) -> u8p:
+        return ct.cast(buf, u8p)
+
+    random.seed(5)
+    n = 37
+
+    for h, dlen in [("esch256", 32), ("esch384", 48)]:
+        fn = getattr(lib, h + "_hash_many")
+        fn.argtypes = [ct.POINTER(ct.c_char_p), ct.POINTER(sz), sz, u8p]
+        fn.restype = None
+
+        msgs = [random.randbytes(random.choice([0, 1, 16, 17, 64, 300])) for _ in range(n)]
+        ins = (ct.c_char_p * n)(*msgs)
+        lens = (sz * n)(*map(len, msgs))
+        out = ct.create_string_buffer(n * dlen)
+        fn(ins, lens, n, ptr(out))
+
+        for i in range(n):
+            assert out.raw[i * dlen: (i + 1) * dlen] == getattr(sparkle, h + "_hash")(msgs[i])
+
+    variants = [("schwaemm256_128", 16, 32), ("schwaemm192_192", 24, 24),
+                ("schwaemm128_128", 16, 16), ("schwaemm256_256", 32, 32)]
+
+    for v, c, r in variants:
+        enc_many = getattr(lib, v + "_encrypt_many")
+        enc_many.argtypes, enc_many.restype = [ct.POINTER(desc), sz], None
+        dec_many = getattr(lib, v + "_decrypt_many")
+        dec_many.argtypes = [ct.POINTER(desc), ct.POINTER(ct.c_bool), sz]
+        dec_many.restype = ct.c_bool
+
+        keys = [random.randbytes(c) for _ in range(n)]
+        nonces = [random.randbytes(r) for _ in range(n)]
+        ads = [random.randbytes(random.choice([0, 5, 40])) for _ in range(n)]
+        pts = [random.randbytes(random.choice([0, 1, 31, 64, 100])) for _ in range(n)]
+        encs = [ct.create_string_buffer(len(p)) for p in pts]
+        decs = [ct.create_string_buffer(len(p)) for p in pts]
+        tags = [ct.create_string_buffer(c) for _ in range(n)]
+
+        seal = (desc * n)(*[desc(keys[i], nonces[i], ads[i], len(ads[i]), pts[i],
+                                 ptr(encs[i]), len(pts[i]), ptr(tags[i]))
+                            for i in range(n)])
+        enc_many(seal, n)
+
+        for i in range(n):
+            e, t = getattr(sparkle, v + "_encrypt")(keys[i], nonces[i], ads[i], pts[i])
+            assert encs[i].raw == e and tags[i].raw == t
+
+        tags[5][0] = tags[5][0][0] ^ 1
+        open_ = (desc * n)(*[desc(keys[i], nonces[i], ads[i], len(ads[i]), encs[i].raw,
+                                  ptr(decs[i]), len(pts[i]), ptr(tags[i]))
+                             for i in range(n)])
+        flags = (ct.c_bool * n)()
+        assert not dec_many(open_, flags, n)
+
+        for i in range(n):
+            assert flags[i] == (i != 5)
+            assert decs[i].raw == (pts[i] if i != 5 else bytes(len(pts[i])))
+
+
+
+def test_offload_abi():
+    """
+    Tests that libsparkle_offload.so exports same C-ABI functions as
+    libsparkle.so, so that either of them can be loaded by callers
+    """
+    import shutil
+    import subprocess
+    from posixpath import dirname, exists, join
+
+    off = join(dirname(sparkle.SO_PATH), "libsparkle_offload.so")
+    if not exists(off):
+        pytest.skip("use `make offload` to generate offload shared library object")
+    if shutil.which("nm") is None:
+        pytest.skip("nm isn't available")
+
+    def exported(path: str) -> set:
+        out = subprocess.run(["nm", "-D", "--defined-only", path],
+                             capture_output=True, text=True, check=True).stdout
+        # C++ symbols ( say inline functions/ templates ) aren't part of C-ABI
+        return {l.split()[-1] for l in out.splitlines() if not l.split()[-1].startswith("_Z")}
+
+    assert exported(off) == exported(sparkle.SO_PATH)
+    assert "schwaemm256_128_decryptv" in exported(off)
+
+
 if __name__ == '__main__':
     print('Use `pytest` for driving Sparkle tests against Known Answer Tests ( KAT ) !')
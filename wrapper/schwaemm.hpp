@@ -3,6 +3,11 @@
 #include "schwaemm192_192.hpp"
 #include "schwaemm256_128.hpp"
 #include "schwaemm256_256.hpp"
+#include "iov.hpp"
+#include "context.hpp"
+#include <cstdint>
+#include <new>
+#include <variant>
 
 // Thin C wrapper on top of underlying C++ implementation of Schwaemm256-128,
 // Schwaemm192-192, Schwaemm128-128, Schwaemm256-256 AEAD ( authenticated
@@ -10,6 +15,137 @@
 // shared library object with C-ABI & used from other languages such as Rust,
 // Python
 
+// Incremental SchwaemmX-Y AEAD context, opaque to C-ABI users, which either
+// encrypts or decrypts, as chosen when it's created
+struct schwaemm256_128_ctx
+{
+  std::variant<schwaemm256_128::aead_encryptor,
+               schwaemm256_128::aead_decryptor>
+    c;
+};
+
+struct schwaemm192_192_ctx
+{
+  std::variant<schwaemm192_192::aead_encryptor,
+               schwaemm192_192::aead_decryptor>
+    c;
+};
+
+struct schwaemm128_128_ctx
+{
+  std::variant<schwaemm128_128::aead_encryptor,
+               schwaemm128_128::aead_decryptor>
+    c;
+};
+
+struct schwaemm256_256_ctx
+{
+  std::variant<schwaemm256_256::aead_encryptor,
+               schwaemm256_256::aead_decryptor>
+    c;
+};
+
+// Helpers, shared by streaming AEAD context functions of all Schwaemm variants
+namespace aead_ctx {
+
+// Whether `mem` is non-null & suitably aligned storage for T
+template<typename T>
+static inline bool
+suitable(const void* const mem)
+{
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+  return (addr != 0) && (addr % alignof(T) == 0);
+}
+
+// Allocates encryption ( dec = false ) or decryption ( dec = true ) context
+// on heap; returns NULL when allocation fails
+template<typename T>
+static inline T*
+create(const uint8_t* const __restrict key,
+       const uint8_t* const __restrict nonce,
+       const bool dec)
+{
+  using V = decltype(T::c);
+
+  if (dec) {
+    return new (std::nothrow) T{ V{ std::in_place_index<1>, key, nonce } };
+  }
+  return new (std::nothrow) T{ V{ std::in_place_index<0>, key, nonce } };
+}
+
+// Constructs encryption ( dec = false ) or decryption ( dec = true ) context
+// on caller provided storage; returns NULL when it's NULL or misaligned
+template<typename T>
+static inline T*
+make(void* const mem,
+     const uint8_t* const __restrict key,
+     const uint8_t* const __restrict nonce,
+     const bool dec)
+{
+  using V = decltype(T::c);
+
+  if (!suitable<T>(mem)) {
+    return nullptr;
+  }
+  if (dec) {
+    return new (mem) T{ V{ std::in_place_index<1>, key, nonce } };
+  }
+  return new (mem) T{ V{ std::in_place_index<0>, key, nonce } };
+}
+
+// Allocates a copy of context on heap; returns NULL when allocation fails
+template<typename T>
+static inline T*
+clone(const T* const ctx)
+{
+  return new (std::nothrow) T{ ctx->c };
+}
+
+// Copies context onto caller provided storage; returns NULL when it's NULL or
+// misaligned
+template<typename T>
+static inline T*
+copy(const T* const ctx, void* const mem)
+{
+  if (!suitable<T>(mem)) {
+    return nullptr;
+  }
+  return new (mem) T{ ctx->c };
+}
+
+// Absorbs next piece of associated data, into either kind of context
+template<typename T>
+static inline bool
+absorb(T* const ctx, const uint8_t* const data, const size_t d_len)
+{
+  return std::visit([&](auto& c) { return c.absorb(data, d_len); }, ctx->c);
+}
+
+// Processes next piece of text, if context is of expected kind ( I = 0 for
+// encryption, I = 1 for decryption )
+template<const size_t I, typename T>
+static inline bool
+update(T* const ctx,
+       const uint8_t* const in,
+       uint8_t* const out,
+       const size_t len)
+{
+  auto* const c = std::get_if<I>(&ctx->c);
+  return (c != nullptr) && c->update(in, out, len);
+}
+
+// Produces ( I = 0 ) or verifies ( I = 1 ) authentication tag, if context is
+// of expected kind
+template<const size_t I, typename T, typename U>
+static inline bool
+finalize(T* const ctx, U* const __restrict tag)
+{
+  auto* const c = std::get_if<I>(&ctx->c);
+  return (c != nullptr) && c->finalize(tag);
+}
+
+}
+
 // Function prototype
 extern "C"
 {
@@ -84,10 +220,217 @@ extern "C"
                                const uint8_t* const __restrict,
                                uint8_t* const __restrict,
                                const size_t);
+
+  bool schwaemm256_128_encryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                uint8_t* const __restrict);
+
+  bool schwaemm256_128_decryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t);
+
+  bool schwaemm192_192_encryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                uint8_t* const __restrict);
+
+  bool schwaemm192_192_decryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t);
+
+  bool schwaemm128_128_encryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                uint8_t* const __restrict);
+
+  bool schwaemm128_128_decryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t);
+
+  bool schwaemm256_256_encryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                uint8_t* const __restrict);
+
+  bool schwaemm256_256_decryptv(const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const uint8_t* const __restrict,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t,
+                                const struct iovec* const,
+                                const size_t);
+
+  size_t schwaemm256_128_ctx_size();
+  size_t schwaemm256_128_ctx_align();
+  schwaemm256_128_ctx* schwaemm256_128_create(const uint8_t* const __restrict,
+                                              const uint8_t* const __restrict,
+                                              const bool);
+  schwaemm256_128_ctx* schwaemm256_128_init(void* const,
+                                            const uint8_t* const __restrict,
+                                            const uint8_t* const __restrict,
+                                            const bool);
+  schwaemm256_128_ctx* schwaemm256_128_clone(const schwaemm256_128_ctx* const);
+  schwaemm256_128_ctx* schwaemm256_128_clone_into(
+    const schwaemm256_128_ctx* const,
+    void* const);
+  bool schwaemm256_128_absorb_ad(schwaemm256_128_ctx* const,
+                                 const uint8_t* const,
+                                 const size_t);
+  bool schwaemm256_128_encrypt_update(schwaemm256_128_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm256_128_decrypt_update(schwaemm256_128_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm256_128_encrypt_finalize(schwaemm256_128_ctx* const,
+                                        uint8_t* const __restrict);
+  bool schwaemm256_128_decrypt_finalize(schwaemm256_128_ctx* const,
+                                        const uint8_t* const __restrict);
+  void schwaemm256_128_destroy(schwaemm256_128_ctx* const);
+  void schwaemm256_128_release(schwaemm256_128_ctx* const);
+
+  size_t schwaemm192_192_ctx_size();
+  size_t schwaemm192_192_ctx_align();
+  schwaemm192_192_ctx* schwaemm192_192_create(const uint8_t* const __restrict,
+                                              const uint8_t* const __restrict,
+                                              const bool);
+  schwaemm192_192_ctx* schwaemm192_192_init(void* const,
+                                            const uint8_t* const __restrict,
+                                            const uint8_t* const __restrict,
+                                            const bool);
+  schwaemm192_192_ctx* schwaemm192_192_clone(const schwaemm192_192_ctx* const);
+  schwaemm192_192_ctx* schwaemm192_192_clone_into(
+    const schwaemm192_192_ctx* const,
+    void* const);
+  bool schwaemm192_192_absorb_ad(schwaemm192_192_ctx* const,
+                                 const uint8_t* const,
+                                 const size_t);
+  bool schwaemm192_192_encrypt_update(schwaemm192_192_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm192_192_decrypt_update(schwaemm192_192_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm192_192_encrypt_finalize(schwaemm192_192_ctx* const,
+                                        uint8_t* const __restrict);
+  bool schwaemm192_192_decrypt_finalize(schwaemm192_192_ctx* const,
+                                        const uint8_t* const __restrict);
+  void schwaemm192_192_destroy(schwaemm192_192_ctx* const);
+  void schwaemm192_192_release(schwaemm192_192_ctx* const);
+
+  size_t schwaemm128_128_ctx_size();
+  size_t schwaemm128_128_ctx_align();
+  schwaemm128_128_ctx* schwaemm128_128_create(const uint8_t* const __restrict,
+                                              const uint8_t* const __restrict,
+                                              const bool);
+  schwaemm128_128_ctx* schwaemm128_128_init(void* const,
+                                            const uint8_t* const __restrict,
+                                            const uint8_t* const __restrict,
+                                            const bool);
+  schwaemm128_128_ctx* schwaemm128_128_clone(const schwaemm128_128_ctx* const);
+  schwaemm128_128_ctx* schwaemm128_128_clone_into(
+    const schwaemm128_128_ctx* const,
+    void* const);
+  bool schwaemm128_128_absorb_ad(schwaemm128_128_ctx* const,
+                                 const uint8_t* const,
+                                 const size_t);
+  bool schwaemm128_128_encrypt_update(schwaemm128_128_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm128_128_decrypt_update(schwaemm128_128_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm128_128_encrypt_finalize(schwaemm128_128_ctx* const,
+                                        uint8_t* const __restrict);
+  bool schwaemm128_128_decrypt_finalize(schwaemm128_128_ctx* const,
+                                        const uint8_t* const __restrict);
+  void schwaemm128_128_destroy(schwaemm128_128_ctx* const);
+  void schwaemm128_128_release(schwaemm128_128_ctx* const);
+
+  size_t schwaemm256_256_ctx_size();
+  size_t schwaemm256_256_ctx_align();
+  schwaemm256_256_ctx* schwaemm256_256_create(const uint8_t* const __restrict,
+                                              const uint8_t* const __restrict,
+                                              const bool);
+  schwaemm256_256_ctx* schwaemm256_256_init(void* const,
+                                            const uint8_t* const __restrict,
+                                            const uint8_t* const __restrict,
+                                            const bool);
+  schwaemm256_256_ctx* schwaemm256_256_clone(const schwaemm256_256_ctx* const);
+  schwaemm256_256_ctx* schwaemm256_256_clone_into(
+    const schwaemm256_256_ctx* const,
+    void* const);
+  bool schwaemm256_256_absorb_ad(schwaemm256_256_ctx* const,
+                                 const uint8_t* const,
+                                 const size_t);
+  bool schwaemm256_256_encrypt_update(schwaemm256_256_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm256_256_decrypt_update(schwaemm256_256_ctx* const,
+                                      const uint8_t* const,
+                                      uint8_t* const,
+                                      const size_t);
+  bool schwaemm256_256_encrypt_finalize(schwaemm256_256_ctx* const,
+                                        uint8_t* const __restrict);
+  bool schwaemm256_256_decrypt_finalize(schwaemm256_256_ctx* const,
+                                        const uint8_t* const __restrict);
+  void schwaemm256_256_destroy(schwaemm256_256_ctx* const);
+  void schwaemm256_256_release(schwaemm256_256_ctx* const);
 }
 
 extern "C"
 {
+  // One-shot encryption/ decryption is left out of libsparkle_offload.so,
+  // which forwards it to offload daemon; see wrapper/offload_client.hpp
+#if !defined SPARKLE_OFFLOAD
 
   // Given 16 -bytes secret key, 32 -bytes nonce, N -bytes plain text & M -bytes
   // associated data, this routine computes N -bytes cipher text & 16 -bytes
@@ -224,4 +567,613 @@ extern "C"
     using namespace schwaemm256_256;
     return decrypt(key, nonce, tag, data, d_len, enc, dec, ct_len);
   }
+
+#endif
+
+  // Given 16 -bytes secret key, 32 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, each given as a vector of fragments, this routine computes
+  // N -bytes cipher text ( scattered over given output fragments ) & 16 -bytes
+  // authentication tag | N, M >= 0
+  //
+  // Returns false, without touching output buffers, if plain text & cipher text
+  // fragments don't add up to same byte length.
+  bool schwaemm256_128_encryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const txt,
+                                const size_t t_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                uint8_t* const __restrict tag)
+  {
+    using namespace schwaemm256_128;
+    return encryptv(key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+  }
+
+  // Given 16 -bytes secret key, 32 -bytes nonce, 16 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, each given as a vector of
+  // fragments, this routine computes N -bytes deciphered text ( scattered over
+  // given output fragments ) & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm256_128_decryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const uint8_t* const __restrict tag,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                const struct iovec* const dec,
+                                const size_t t_cnt)
+  {
+    using namespace schwaemm256_128;
+    return decryptv(key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+  }
+
+  // Given 24 -bytes secret key, 24 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, each given as a vector of fragments, this routine computes
+  // N -bytes cipher text ( scattered over given output fragments ) & 24 -bytes
+  // authentication tag | N, M >= 0
+  //
+  // Returns false, without touching output buffers, if plain text & cipher text
+  // fragments don't add up to same byte length.
+  bool schwaemm192_192_encryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const txt,
+                                const size_t t_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                uint8_t* const __restrict tag)
+  {
+    using namespace schwaemm192_192;
+    return encryptv(key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+  }
+
+  // Given 24 -bytes secret key, 24 -bytes nonce, 24 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, each given as a vector of
+  // fragments, this routine computes N -bytes deciphered text ( scattered over
+  // given output fragments ) & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm192_192_decryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const uint8_t* const __restrict tag,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                const struct iovec* const dec,
+                                const size_t t_cnt)
+  {
+    using namespace schwaemm192_192;
+    return decryptv(key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+  }
+
+  // Given 16 -bytes secret key, 16 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, each given as a vector of fragments, this routine computes
+  // N -bytes cipher text ( scattered over given output fragments ) & 16 -bytes
+  // authentication tag | N, M >= 0
+  //
+  // Returns false, without touching output buffers, if plain text & cipher text
+  // fragments don't add up to same byte length.
+  bool schwaemm128_128_encryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const txt,
+                                const size_t t_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                uint8_t* const __restrict tag)
+  {
+    using namespace schwaemm128_128;
+    return encryptv(key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+  }
+
+  // Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, each given as a vector of
+  // fragments, this routine computes N -bytes deciphered text ( scattered over
+  // given output fragments ) & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm128_128_decryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const uint8_t* const __restrict tag,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                const struct iovec* const dec,
+                                const size_t t_cnt)
+  {
+    using namespace schwaemm128_128;
+    return decryptv(key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+  }
+
+  // Given 32 -bytes secret key, 32 -bytes nonce, N -bytes plain text & M -bytes
+  // associated data, each given as a vector of fragments, this routine computes
+  // N -bytes cipher text ( scattered over given output fragments ) & 32 -bytes
+  // authentication tag | N, M >= 0
+  //
+  // Returns false, without touching output buffers, if plain text & cipher text
+  // fragments don't add up to same byte length.
+  bool schwaemm256_256_encryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const txt,
+                                const size_t t_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                uint8_t* const __restrict tag)
+  {
+    using namespace schwaemm256_256;
+    return encryptv(key, nonce, data, d_cnt, txt, t_cnt, enc, e_cnt, tag);
+  }
+
+  // Given 32 -bytes secret key, 32 -bytes nonce, 32 -bytes authentication tag,
+  // N -bytes cipher text & M -bytes associated data, each given as a vector of
+  // fragments, this routine computes N -bytes deciphered text ( scattered over
+  // given output fragments ) & a boolean verification flag | N, M >= 0
+  //
+  // Before consuming decrypted bytes ensure presence of truth value in returned
+  // boolean flag !
+  bool schwaemm256_256_decryptv(const uint8_t* const __restrict key,
+                                const uint8_t* const __restrict nonce,
+                                const uint8_t* const __restrict tag,
+                                const struct iovec* const data,
+                                const size_t d_cnt,
+                                const struct iovec* const enc,
+                                const size_t e_cnt,
+                                const struct iovec* const dec,
+                                const size_t t_cnt)
+  {
+    using namespace schwaemm256_256;
+    return decryptv(key, nonce, tag, data, d_cnt, enc, e_cnt, dec, t_cnt);
+  }
+  // Byte length & alignment of Schwaemm256-128 streaming context, for
+  // embedders, who allocate contexts from their own storage; see
+  // schwaemm256_128_init
+  size_t schwaemm256_128_ctx_size() { return sizeof(schwaemm256_128_ctx); }
+  size_t schwaemm256_128_ctx_align() { return alignof(schwaemm256_128_ctx); }
+
+  // Allocates a Schwaemm256-128 streaming context under 16 -bytes secret key &
+  // 32 -bytes nonce, which decrypts if `dec` holds, otherwise encrypts; returns
+  // NULL when allocation fails
+  schwaemm256_128_ctx* schwaemm256_128_create(
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::create<schwaemm256_128_ctx>(key, nonce, dec);
+  }
+
+  // Initializes a Schwaemm256-128 streaming context, same as
+  // schwaemm256_128_create does, on caller provided storage, which must be at
+  // least schwaemm256_128_ctx_size() -bytes & aligned to
+  // schwaemm256_128_ctx_align(); returns NULL when it's not. Such context is
+  // passed to schwaemm256_128_release, instead of schwaemm256_128_destroy, once
+  // done with.
+  schwaemm256_128_ctx* schwaemm256_128_init(
+    void* const mem,
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::make<schwaemm256_128_ctx>(mem, key, nonce, dec);
+  }
+
+  // Allocates a copy of Schwaemm256-128 streaming context, which continues from
+  // same point of the stream; returns NULL when allocation fails
+  schwaemm256_128_ctx* schwaemm256_128_clone(
+    const schwaemm256_128_ctx* const ctx)
+  {
+    return aead_ctx::clone(ctx);
+  }
+
+  // Copies Schwaemm256-128 streaming context onto caller provided storage, with
+  // same requirements as schwaemm256_128_init; returns NULL when storage is
+  // unsuitable
+  schwaemm256_128_ctx* schwaemm256_128_clone_into(
+    const schwaemm256_128_ctx* const ctx,
+    void* const mem)
+  {
+    return aead_ctx::copy(ctx, mem);
+  }
+
+  // Absorbs next N (>=0) -bytes piece of associated data; returns false, if
+  // text processing has already begun
+  bool schwaemm256_128_absorb_ad(schwaemm256_128_ctx* const ctx,
+                                 const uint8_t* const data,
+                                 const size_t d_len)
+  {
+    return aead_ctx::absorb(ctx, data, d_len);
+  }
+
+  // Encrypts next N (>=0) -bytes piece of plain text, writing equal many cipher
+  // text bytes, possibly in-place; returns false, if context doesn't encrypt or
+  // tag is already produced
+  bool schwaemm256_128_encrypt_update(schwaemm256_128_ctx* const ctx,
+                                      const uint8_t* const txt,
+                                      uint8_t* const enc,
+                                      const size_t len)
+  {
+    return aead_ctx::update<0>(ctx, txt, enc, len);
+  }
+
+  // Decrypts next N (>=0) -bytes piece of cipher text, writing equal many plain
+  // text bytes, possibly in-place, which mustn't be trusted until
+  // schwaemm256_128_decrypt_finalize returns truth value; returns false, if
+  // context doesn't decrypt or tag is already verified
+  bool schwaemm256_128_decrypt_update(schwaemm256_128_ctx* const ctx,
+                                      const uint8_t* const enc,
+                                      uint8_t* const dec,
+                                      const size_t len)
+  {
+    return aead_ctx::update<1>(ctx, enc, dec, len);
+  }
+
+  // Finishes encryption, producing 16 -bytes authentication tag; returns false,
+  // if context doesn't encrypt or tag is already produced
+  bool schwaemm256_128_encrypt_finalize(schwaemm256_128_ctx* const ctx,
+                                        uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<0>(ctx, tag);
+  }
+
+  // Finishes decryption, verifying 16 -bytes authentication tag; returns
+  // boolean verification flag, which is false also when context doesn't decrypt
+  // or tag is already verified
+  bool schwaemm256_128_decrypt_finalize(schwaemm256_128_ctx* const ctx,
+                                        const uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<1>(ctx, tag);
+  }
+
+  // Wipes & releases Schwaemm256-128 streaming context, allocated by
+  // schwaemm256_128_create or schwaemm256_128_clone; NULL is ignored
+  void schwaemm256_128_destroy(schwaemm256_128_ctx* const ctx) { delete ctx; }
+
+  // Wipes Schwaemm256-128 streaming context, living on caller provided storage,
+  // which can be reused afterwards
+  void schwaemm256_128_release(schwaemm256_128_ctx* const ctx)
+  {
+    ctx->~schwaemm256_128_ctx();
+  }
+
+  // Byte length & alignment of Schwaemm192-192 streaming context, for
+  // embedders, who allocate contexts from their own storage; see
+  // schwaemm192_192_init
+  size_t schwaemm192_192_ctx_size() { return sizeof(schwaemm192_192_ctx); }
+  size_t schwaemm192_192_ctx_align() { return alignof(schwaemm192_192_ctx); }
+
+  // Allocates a Schwaemm192-192 streaming context under 24 -bytes secret key &
+  // 24 -bytes nonce, which decrypts if `dec` holds, otherwise encrypts; returns
+  // NULL when allocation fails
+  schwaemm192_192_ctx* schwaemm192_192_create(
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::create<schwaemm192_192_ctx>(key, nonce, dec);
+  }
+
+  // Initializes a Schwaemm192-192 streaming context, same as
+  // schwaemm192_192_create does, on caller provided storage, which must be at
+  // least schwaemm192_192_ctx_size() -bytes & aligned to
+  // schwaemm192_192_ctx_align(); returns NULL when it's not. Such context is
+  // passed to schwaemm192_192_release, instead of schwaemm192_192_destroy, once
+  // done with.
+  schwaemm192_192_ctx* schwaemm192_192_init(
+    void* const mem,
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::make<schwaemm192_192_ctx>(mem, key, nonce, dec);
+  }
+
+  // Allocates a copy of Schwaemm192-192 streaming context, which continues from
+  // same point of the stream; returns NULL when allocation fails
+  schwaemm192_192_ctx* schwaemm192_192_clone(
+    const schwaemm192_192_ctx* const ctx)
+  {
+    return aead_ctx::clone(ctx);
+  }
+
+  // Copies Schwaemm192-192 streaming context onto caller provided storage, with
+  // same requirements as schwaemm192_192_init; returns NULL when storage is
+  // unsuitable
+  schwaemm192_192_ctx* schwaemm192_192_clone_into(
+    const schwaemm192_192_ctx* const ctx,
+    void* const mem)
+  {
+    return aead_ctx::copy(ctx, mem);
+  }
+
+  // Absorbs next N (>=0) -bytes piece of associated data; returns false, if
+  // text processing has already begun
+  bool schwaemm192_192_absorb_ad(schwaemm192_192_ctx* const ctx,
+                                 const uint8_t* const data,
+                                 const size_t d_len)
+  {
+    return aead_ctx::absorb(ctx, data, d_len);
+  }
+
+  // Encrypts next N (>=0) -bytes piece of plain text, writing equal many cipher
+  // text bytes, possibly in-place; returns false, if context doesn't encrypt or
+  // tag is already produced
+  bool schwaemm192_192_encrypt_update(schwaemm192_192_ctx* const ctx,
+                                      const uint8_t* const txt,
+                                      uint8_t* const enc,
+                                      const size_t len)
+  {
+    return aead_ctx::update<0>(ctx, txt, enc, len);
+  }
+
+  // Decrypts next N (>=0) -bytes piece of cipher text, writing equal many plain
+  // text bytes, possibly in-place, which mustn't be trusted until
+  // schwaemm192_192_decrypt_finalize returns truth value; returns false, if
+  // context doesn't decrypt or tag is already verified
+  bool schwaemm192_192_decrypt_update(schwaemm192_192_ctx* const ctx,
+                                      const uint8_t* const enc,
+                                      uint8_t* const dec,
+                                      const size_t len)
+  {
+    return aead_ctx::update<1>(ctx, enc, dec, len);
+  }
+
+  // Finishes encryption, producing 24 -bytes authentication tag; returns false,
+  // if context doesn't encrypt or tag is already produced
+  bool schwaemm192_192_encrypt_finalize(schwaemm192_192_ctx* const ctx,
+                                        uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<0>(ctx, tag);
+  }
+
+  // Finishes decryption, verifying 24 -bytes authentication tag; returns
+  // boolean verification flag, which is false also when context doesn't decrypt
+  // or tag is already verified
+  bool schwaemm192_192_decrypt_finalize(schwaemm192_192_ctx* const ctx,
+                                        const uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<1>(ctx, tag);
+  }
+
+  // Wipes & releases Schwaemm192-192 streaming context, allocated by
+  // schwaemm192_192_create or schwaemm192_192_clone; NULL is ignored
+  void schwaemm192_192_destroy(schwaemm192_192_ctx* const ctx) { delete ctx; }
+
+  // Wipes Schwaemm192-192 streaming context, living on caller provided storage,
+  // which can be reused afterwards
+  void schwaemm192_192_release(schwaemm192_192_ctx* const ctx)
+  {
+    ctx->~schwaemm192_192_ctx();
+  }
+
+  // Byte length & alignment of Schwaemm128-128 streaming context, for
+  // embedders, who allocate contexts from their own storage; see
+  // schwaemm128_128_init
+  size_t schwaemm128_128_ctx_size() { return sizeof(schwaemm128_128_ctx); }
+  size_t schwaemm128_128_ctx_align() { return alignof(schwaemm128_128_ctx); }
+
+  // Allocates a Schwaemm128-128 streaming context under 16 -bytes secret key &
+  // 16 -bytes nonce, which decrypts if `dec` holds, otherwise encrypts; returns
+  // NULL when allocation fails
+  schwaemm128_128_ctx* schwaemm128_128_create(
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::create<schwaemm128_128_ctx>(key, nonce, dec);
+  }
+
+  // Initializes a Schwaemm128-128 streaming context, same as
+  // schwaemm128_128_create does, on caller provided storage, which must be at
+  // least schwaemm128_128_ctx_size() -bytes & aligned to
+  // schwaemm128_128_ctx_align(); returns NULL when it's not. Such context is
+  // passed to schwaemm128_128_release, instead of schwaemm128_128_destroy, once
+  // done with.
+  schwaemm128_128_ctx* schwaemm128_128_init(
+    void* const mem,
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::make<schwaemm128_128_ctx>(mem, key, nonce, dec);
+  }
+
+  // Allocates a copy of Schwaemm128-128 streaming context, which continues from
+  // same point of the stream; returns NULL when allocation fails
+  schwaemm128_128_ctx* schwaemm128_128_clone(
+    const schwaemm128_128_ctx* const ctx)
+  {
+    return aead_ctx::clone(ctx);
+  }
+
+  // Copies Schwaemm128-128 streaming context onto caller provided storage, with
+  // same requirements as schwaemm128_128_init; returns NULL when storage is
+  // unsuitable
+  schwaemm128_128_ctx* schwaemm128_128_clone_into(
+    const schwaemm128_128_ctx* const ctx,
+    void* const mem)
+  {
+    return aead_ctx::copy(ctx, mem);
+  }
+
+  // Absorbs next N (>=0) -bytes piece of associated data; returns false, if
+  // text processing has already begun
+  bool schwaemm128_128_absorb_ad(schwaemm128_128_ctx* const ctx,
+                                 const uint8_t* const data,
+                                 const size_t d_len)
+  {
+    return aead_ctx::absorb(ctx, data, d_len);
+  }
+
+  // Encrypts next N (>=0) -bytes piece of plain text, writing equal many cipher
+  // text bytes, possibly in-place; returns false, if context doesn't encrypt or
+  // tag is already produced
+  bool schwaemm128_128_encrypt_update(schwaemm128_128_ctx* const ctx,
+                                      const uint8_t* const txt,
+                                      uint8_t* const enc,
+                                      const size_t len)
+  {
+    return aead_ctx::update<0>(ctx, txt, enc, len);
+  }
+
+  // Decrypts next N (>=0) -bytes piece of cipher text, writing equal many plain
+  // text bytes, possibly in-place, which mustn't be trusted until
+  // schwaemm128_128_decrypt_finalize returns truth value; returns false, if
+  // context doesn't decrypt or tag is already verified
+  bool schwaemm128_128_decrypt_update(schwaemm128_128_ctx* const ctx,
+                                      const uint8_t* const enc,
+                                      uint8_t* const dec,
+                                      const size_t len)
+  {
+    return aead_ctx::update<1>(ctx, enc, dec, len);
+  }
+
+  // Finishes encryption, producing 16 -bytes authentication tag; returns false,
+  // if context doesn't encrypt or tag is already produced
+  bool schwaemm128_128_encrypt_finalize(schwaemm128_128_ctx* const ctx,
+                                        uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<0>(ctx, tag);
+  }
+
+  // Finishes decryption, verifying 16 -bytes authentication tag; returns
+  // boolean verification flag, which is false also when context doesn't decrypt
+  // or tag is already verified
+  bool schwaemm128_128_decrypt_finalize(schwaemm128_128_ctx* const ctx,
+                                        const uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<1>(ctx, tag);
+  }
+
+  // Wipes & releases Schwaemm128-128 streaming context, allocated by
+  // schwaemm128_128_create or schwaemm128_128_clone; NULL is ignored
+  void schwaemm128_128_destroy(schwaemm128_128_ctx* const ctx) { delete ctx; }
+
+  // Wipes Schwaemm128-128 streaming context, living on caller provided storage,
+  // which can be reused afterwards
+  void schwaemm128_128_release(schwaemm128_128_ctx* const ctx)
+  {
+    ctx->~schwaemm128_128_ctx();
+  }
+
+  // Byte length & alignment of Schwaemm256-256 streaming context, for
+  // embedders, who allocate contexts from their own storage; see
+  // schwaemm256_256_init
+  size_t schwaemm256_256_ctx_size() { return sizeof(schwaemm256_256_ctx); }
+  size_t schwaemm256_256_ctx_align() { return alignof(schwaemm256_256_ctx); }
+
+  // Allocates a Schwaemm256-256 streaming context under 32 -bytes secret key &
+  // 32 -bytes nonce, which decrypts if `dec` holds, otherwise encrypts; returns
+  // NULL when allocation fails
+  schwaemm256_256_ctx* schwaemm256_256_create(
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::create<schwaemm256_256_ctx>(key, nonce, dec);
+  }
+
+  // Initializes a Schwaemm256-256 streaming context, same as
+  // schwaemm256_256_create does, on caller provided storage, which must be at
+  // least schwaemm256_256_ctx_size() -bytes & aligned to
+  // schwaemm256_256_ctx_align(); returns NULL when it's not. Such context is
+  // passed to schwaemm256_256_release, instead of schwaemm256_256_destroy, once
+  // done with.
+  schwaemm256_256_ctx* schwaemm256_256_init(
+    void* const mem,
+    const uint8_t* const __restrict key,
+    const uint8_t* const __restrict nonce,
+    const bool dec)
+  {
+    return aead_ctx::make<schwaemm256_256_ctx>(mem, key, nonce, dec);
+  }
+
+  // Allocates a copy of Schwaemm256-256 streaming context, which continues from
+  // same point of the stream; returns NULL when allocation fails
+  schwaemm256_256_ctx* schwaemm256_256_clone(
+    const schwaemm256_256_ctx* const ctx)
+  {
+    return aead_ctx::clone(ctx);
+  }
+
+  // Copies Schwaemm256-256 streaming context onto caller provided storage, with
+  // same requirements as schwaemm256_256_init; returns NULL when storage is
+  // unsuitable
+  schwaemm256_256_ctx* schwaemm256_256_clone_into(
+    const schwaemm256_256_ctx* const ctx,
+    void* const mem)
+  {
+    return aead_ctx::copy(ctx, mem);
+  }
+
+  // Absorbs next N (>=0) -bytes piece of associated data; returns false, if
+  // text processing has already begun
+  bool schwaemm256_256_absorb_ad(schwaemm256_256_ctx* const ctx,
+                                 const uint8_t* const data,
+                                 const size_t d_len)
+  {
+    return aead_ctx::absorb(ctx, data, d_len);
+  }
+
+  // Encrypts next N (>=0) -bytes piece of plain text, writing equal many cipher
+  // text bytes, possibly in-place; returns false, if context doesn't encrypt or
+  // tag is already produced
+  bool schwaemm256_256_encrypt_update(schwaemm256_256_ctx* const ctx,
+                                      const uint8_t* const txt,
+                                      uint8_t* const enc,
+                                      const size_t len)
+  {
+    return aead_ctx::update<0>(ctx, txt, enc, len);
+  }
+
+  // Decrypts next N (>=0) -bytes piece of cipher text, writing equal many plain
+  // text bytes, possibly in-place, which mustn't be trusted until
+  // schwaemm256_256_decrypt_finalize returns truth value; returns false, if
+  // context doesn't decrypt or tag is already verified
+  bool schwaemm256_256_decrypt_update(schwaemm256_256_ctx* const ctx,
+                                      const uint8_t* const enc,
+                                      uint8_t* const dec,
+                                      const size_t len)
+  {
+    return aead_ctx::update<1>(ctx, enc, dec, len);
+  }
+
+  // Finishes encryption, producing 32 -bytes authentication tag; returns false,
+  // if context doesn't encrypt or tag is already produced
+  bool schwaemm256_256_encrypt_finalize(schwaemm256_256_ctx* const ctx,
+                                        uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<0>(ctx, tag);
+  }
+
+  // Finishes decryption, verifying 32 -bytes authentication tag; returns
+  // boolean verification flag, which is false also when context doesn't decrypt
+  // or tag is already verified
+  bool schwaemm256_256_decrypt_finalize(schwaemm256_256_ctx* const ctx,
+                                        const uint8_t* const __restrict tag)
+  {
+    return aead_ctx::finalize<1>(ctx, tag);
+  }
+
+  // Wipes & releases Schwaemm256-256 streaming context, allocated by
+  // schwaemm256_256_create or schwaemm256_256_clone; NULL is ignored
+  void schwaemm256_256_destroy(schwaemm256_256_ctx* const ctx) { delete ctx; }
+
+  // Wipes Schwaemm256-256 streaming context, living on caller provided storage,
+  // which can be reused afterwards
+  void schwaemm256_256_release(schwaemm256_256_ctx* const ctx)
+  {
+    ctx->~schwaemm256_256_ctx();
+  }
 }
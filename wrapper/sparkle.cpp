@@ -1,2 +1,3 @@
 #include "esch.hpp"
 #include "schwaemm.hpp"
+#include "batched.hpp"
@@ -0,0 +1,5 @@
+#define SPARKLE_OFFLOAD
+#include "offload_client.hpp"
+#include "esch.hpp"
+#include "schwaemm.hpp"
+#include "batched.hpp"